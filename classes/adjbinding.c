@@ -0,0 +1,156 @@
+/*****************************************************************************
+ *
+ * gtk-mui - a wrapper library to wrap GTK+ calls to MUI
+ *
+ * Copyright (C) 2005 Oliver Brunner
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+ *
+ * Contact information:
+ *
+ * Oliver Brunner
+ *
+ * E-Mail: gtk-mui "at" oliver-brunner.de
+ *
+ * $Id: adjbinding.c,v 1.1 2026/10/19 22:00:00 o1i Exp $
+ *
+ *****************************************************************************/
+
+/* views of a GtkAdjustment, see adjbinding.h */
+
+#include "adjbinding.h"
+
+MgtkBinding *mgtk_binding_new(void) {
+
+  return g_new0(MgtkBinding,1);
+}
+
+void mgtk_binding_free(MgtkBinding *binding) {
+  GSList *g;
+
+  for(g=binding->views;g;g=g->next) {
+    g_free(g->data);
+  }
+  g_slist_free(binding->views);
+  g_free(binding);
+}
+
+MgtkBindingView *mgtk_binding_find(MgtkBinding *binding, gpointer widget) {
+  GSList *g;
+
+  for(g=binding->views;g;g=g->next) {
+    if(((MgtkBindingView *) g->data)->widget==widget) {
+      return (MgtkBindingView *) g->data;
+    }
+  }
+  return NULL;
+}
+
+/* a widget is only bound once, returns the new view or NULL */
+MgtkBindingView *mgtk_binding_add(MgtkBinding *binding, gpointer widget,
+                                  const MgtkBindingViewClass *klass) {
+  MgtkBindingView *view;
+
+  if(mgtk_binding_find(binding,widget)) {
+    return NULL;
+  }
+
+  view=g_new0(MgtkBindingView,1);
+  view->widget=widget;
+  view->klass=klass;
+  binding->views=g_slist_append(binding->views,view);
+
+  return view;
+}
+
+gboolean mgtk_binding_remove(MgtkBinding *binding, gpointer widget) {
+  MgtkBindingView *view;
+
+  view=mgtk_binding_find(binding,widget);
+  if(!view) {
+    return FALSE;
+  }
+
+  binding->views=g_slist_remove(binding->views,view);
+  g_free(view);
+
+  return TRUE;
+}
+
+/* returns TRUE, if the view got a new position */
+static gboolean show_view(MgtkBindingView *view, gpointer data) {
+  gdouble pos;
+
+  if(!view->klass->position(view,data,&pos)) {
+    return FALSE;
+  }
+  if(view->valid && view->shown==pos) {
+    return FALSE;
+  }
+
+  view->klass->show(view,data,pos);
+  view->shown=pos;
+  view->valid=TRUE;
+
+  return TRUE;
+}
+
+/* source already shows the value, it only forgets what it showed.
+ * Returns the number of views, which got a new position.
+ */
+guint mgtk_binding_push(MgtkBinding *binding, gpointer data, gpointer source) {
+  MgtkBindingView *view;
+  GSList *g;
+  guint shown=0;
+
+  binding->pushing++;
+  for(g=binding->views;g;g=g->next) {
+    view=(MgtkBindingView *) g->data;
+    if(view->widget==source) {
+      view->valid=FALSE;
+    }
+    else if(show_view(view,data)) {
+      shown++;
+    }
+  }
+  binding->pushing--;
+
+  return shown;
+}
+
+/* the view shows the value in another format now */
+void mgtk_binding_push_view(MgtkBinding *binding, MgtkBindingView *view, gpointer data) {
+
+  view->valid=FALSE;
+  binding->pushing++;
+  show_view(view,data);
+  binding->pushing--;
+}
+
+/* bounds changed, everything has to be pushed again */
+void mgtk_binding_invalidate(MgtkBinding *binding, gpointer data) {
+  MgtkBindingView *view;
+  GSList *g;
+
+  binding->pushing++;
+  for(g=binding->views;g;g=g->next) {
+    view=(MgtkBindingView *) g->data;
+    view->valid=FALSE;
+    if(view->klass->invalidate) {
+      view->klass->invalidate(view,data);
+    }
+  }
+  binding->pushing--;
+}
@@ -0,0 +1,86 @@
+/*****************************************************************************
+ *
+ * gtk-mui - a wrapper library to wrap GTK+ calls to MUI
+ *
+ * Copyright (C) 2005 Oliver Brunner
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+ *
+ * Contact information:
+ *
+ * Oliver Brunner
+ *
+ * E-Mail: gtk-mui "at" oliver-brunner.de
+ *
+ * $Id: adjbinding.h,v 1.1 2026/10/19 22:00:00 o1i Exp $
+ *
+ *****************************************************************************/
+
+
+#ifndef MGTK_ADJBINDING_H
+#define MGTK_ADJBINDING_H
+
+/* The views of one GtkAdjustment.
+ *
+ * Every widget showing an adjustment is a view with a class, which knows
+ * the position the widget would show for the current value (an integer
+ * MUI position, the value in units of the last digit, ..) and how to show
+ * it. A push gives every view the new value, but skips views, which
+ * already show that position, and the view the change came from.
+ *
+ * While pushing, the binding is marked, so the MUI hooks of the views can
+ * ignore the notifications caused by our own sets instead of feeding the
+ * value back into the adjustment.
+ *
+ * Only depends on glib, so it can be built and tried out on any host.
+ */
+
+#include <glib.h>
+
+typedef struct _MgtkBindingView MgtkBindingView;
+
+typedef struct {
+  /* position for the current value, FALSE if the view can't show anything now */
+  gboolean (*position)  (MgtkBindingView *view, gpointer data, gdouble *pos);
+  void     (*show)      (MgtkBindingView *view, gpointer data, gdouble pos);
+  /* bounds changed, may be NULL */
+  void     (*invalidate)(MgtkBindingView *view, gpointer data);
+} MgtkBindingViewClass;
+
+struct _MgtkBindingView {
+  gpointer                    widget;
+  const MgtkBindingViewClass *klass;
+  gdouble                     shown;   /* position the view shows */
+  gboolean                    valid;
+};
+
+typedef struct {
+  GSList *views;
+  guint   pushing;
+} MgtkBinding;
+
+MgtkBinding     *mgtk_binding_new       (void);
+void             mgtk_binding_free      (MgtkBinding *binding);
+MgtkBindingView *mgtk_binding_find      (MgtkBinding *binding, gpointer widget);
+MgtkBindingView *mgtk_binding_add       (MgtkBinding *binding, gpointer widget,
+                                         const MgtkBindingViewClass *klass);
+gboolean         mgtk_binding_remove    (MgtkBinding *binding, gpointer widget);
+guint            mgtk_binding_push      (MgtkBinding *binding, gpointer data, gpointer source);
+void             mgtk_binding_push_view (MgtkBinding *binding, MgtkBindingView *view, gpointer data);
+void             mgtk_binding_invalidate(MgtkBinding *binding, gpointer data);
+
+#define mgtk_binding_pushing(binding) ((binding) && (binding)->pushing)
+
+#endif
@@ -203,6 +203,18 @@ static int mAddMember(struct Data *data, Object *obj,struct opMember *msg,struct
   }
 }
 
+static int mRemMember(struct Data *data, Object *obj,struct opMember *msg,struct IClass *cl) {
+
+  DebOut("mRemMember(%lx,%lx)\n",obj,msg->opam_Object);
+
+  if(data->button) {
+    /* children are members of the button, see mAddMember */
+    DoMethod(data->button,OM_REMMEMBER,(ULONG) msg->opam_Object);
+    return TRUE;
+  }
+  return DoSuperMethodA(cl, obj, (Msg)msg);
+}
+
 /*******************************************
  * mSet
  *******************************************/
@@ -264,6 +276,7 @@ GETDATA;
     case OM_SET          :        mSet        (data, obj, (APTR)msg); break;
     case OM_GET          : return mGet        (data, obj, (APTR)msg, cl);
     case OM_ADDMEMBER    : return mAddMember  (data, obj, (APTR)msg, cl);
+    case OM_REMMEMBER    : return mRemMember  (data, obj, (APTR)msg, cl);
 //    case MUIM_AskMinMax  : return mgtk_askminmax (cl, obj, (APTR)msg, 0, 0);
   }
 
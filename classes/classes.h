@@ -153,7 +153,7 @@ for (  \
 #endif
 #endif
 
-#define ENDMTABLE return DoSuperMethodA(cl, obj, msg); }
+#define ENDMTABLE return mgtk_super_method(cl, obj, msg); }
 
 
 /**********************************************************************
@@ -222,9 +222,27 @@ int  mgtk_create_window_class(void);
 void mgtk_delete_window_class(void);
 int  mgtk_create_scrolledwindow_class(void);
 void mgtk_delete_scrolledwindow_class(void);
+int  mgtk_create_image_class(void);
+void mgtk_delete_image_class(void);
 
+/* GTK-MUI private: custom classes are created the first time they are
+ * needed, so always use MGTK_CLASS(CL_X) instead of CL_X->mcc_Class.
+ * Returns NULL, if the class could not be created.
+ */
+struct IClass *mgtk_need_class(struct MUI_CustomClass **cl);
+#define MGTK_CLASS(cl) ((cl) ? (cl)->mcc_Class : mgtk_need_class(&(cl)))
+
+/* GTK-MUI private: TRUE, if obj is an instance of one of the classes
+ * above, so its unhandled methods end up in mgtk_super_method.
+ *
+ * That only holds, as long as dispatchers break out of their switch for
+ * unknown methods and let ENDMTABLE pass them on, never with a
+ * "default: return DoSuperMethodA" of their own.
+ */
+gboolean mgtk_is_custom_object(Object *obj);
 
 ULONG mgtk_askminmax(struct IClass *cl, APTR obj, struct MUIP_AskMinMax *msg, LONG defwidth, LONG defheight);
+ULONG mgtk_super_method(struct IClass *cl, APTR obj, Msg msg);
 
 /**********************************************************************
 	Return IDs
@@ -280,6 +298,7 @@ enum
 
   /* progressbar */
   MA_Pulse,
+  MM_ProgressBar_Frame,
 
   /* fixed */
   MA_Fixed_Move,
@@ -353,6 +372,10 @@ enum
   /* frame */
   MA_GtkFrame_Label,
 
+  /* image */
+  MA_Image_Entry,
+  MM_Image_Loaded,
+
   /* menu */
   MA_Menu_Is_Item,
   MA_Menu_Attached,
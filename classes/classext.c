@@ -193,6 +193,30 @@ ULONG mgtk_askminmax(struct IClass *cl, APTR obj, struct MUIP_AskMinMax *msg, LO
   return 0;
 }
 
+/**********************************************************************
+  mgtk_super_method
+
+  Every method, our classes do not handle themselves, ends up here
+  (see ENDMTABLE) before it is passed to the super class. So this is
+  the place for things all of them do the same way.
+
+  MUIM_CreateShortHelp: tooltips are not pushed into MUIA_ShortHelp
+  anymore, MUI asks for the text, when the bubble is about to appear.
+**********************************************************************/
+
+ULONG mgtk_super_method(struct IClass *cl, APTR obj, Msg msg) {
+  STRPTR help;
+
+  if(msg->MethodID == MUIM_CreateShortHelp) {
+    if(mgtk_tooltips_short_help(obj,&help)) {
+      DebOut("mgtk_super_method(%lx): short help %s\n",obj,help);
+      return (ULONG) help;
+    }
+  }
+
+  return DoSuperMethodA(cl, obj, msg);
+}
+
 /****************************
  * mgtk_get_widget_from_obj
  *
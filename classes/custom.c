@@ -36,6 +36,8 @@
 #include <clib/alib_protos.h>
 #include <proto/utility.h>
 #include <exec/types.h>
+#include <graphics/clip.h>
+#include <graphics/regions.h>
 #include <mui.h>
 
 #include "classes.h"
@@ -53,6 +55,16 @@ struct Data {
   struct MinList ChildList;
 
   ULONG columns, rows, vertspacing, horizspacing;
+
+  /* expose state, reused for every MUIM_Draw */
+  GdkEventExpose expose;
+  GdkRegion     *region;
+  GtkAllocation  last_alloc;
+  WORD           last_left, last_top;
+  BOOL           have_alloc;
+
+  /* double buffered expose, sized like our inner box */
+  GdkPixmap     *backing;
 };
 
 struct CustomNode {
@@ -204,6 +216,9 @@ static ULONG mNew(struct IClass *cl, APTR obj, Msg msg) {
   data->defheight = 0;
   data->is_resizable = 1;
 
+  data->region=gdk_region_new();
+  data->have_alloc=FALSE;
+
 //o  set(obj, MUIA_Group_LayoutHook, &data->LayoutHook);
   mSet(data, obj, (APTR)msg, TRUE);
 
@@ -324,6 +339,33 @@ static ULONG mAttach(struct Data *data, APTR obj, struct MUIP_Custom_Attach *in)
 }
 #endif
 
+static VOID free_backing(struct Data *data) {
+
+  if(data->backing) {
+    g_object_unref(data->backing);
+    data->backing=NULL;
+  }
+}
+
+static VOID mDispose(struct Data *data, APTR obj) {
+
+  DebOut("custom.c: mDispose(%lx)\n",obj);
+
+  if(data->region) {
+    gdk_region_destroy(data->region);
+    data->region=NULL;
+  }
+  free_backing(data);
+}
+
+/* the backing bitmap is a friend of the screen, which may go now */
+static ULONG mCleanup(struct IClass *cl, struct Data *data, Object *obj, Msg msg) {
+
+  free_backing(data);
+
+  return DoSuperMethodA(cl, obj, msg);
+}
+
 static ULONG mAskMinMax(struct Data *data, APTR obj, struct MUIP_AskMinMax *msg, struct IClass *cl) {
 
   GtkWidget *widget;
@@ -429,11 +471,122 @@ static ULONG mAskMinMax(struct Data *data, APTR obj, struct MUIP_AskMinMax *msg,
 }
 
 
+/* more damage rectangles are exposed as their bounding box */
+#define MAX_EXPOSE_AREAS 8
+
+/* get the parts of our inner box, which really need to be redrawn,
+ * relative to _mleft/_mtop. If we are called during a layer refresh,
+ * these are the damaged rectangles, otherwise it is the whole box.
+ * Returns the number of areas, 0 if nothing of us is visible.
+ */
+static int get_expose_areas(Object *obj, GdkRectangle *areas) {
+  struct Layer *layer;
+  struct Region *damaged;
+  struct RegionRectangle *r;
+  GdkRectangle box;
+  GdkRectangle damage;
+  int n;
+
+  box.x=0;
+  box.y=0;
+  box.width=_mright(obj)-_mleft(obj)+1;
+  box.height=_mbottom(obj)-_mtop(obj)+1;
+
+  if(box.width <= 0 || box.height <= 0) {
+    return 0;
+  }
+
+  layer=_rp(obj)->Layer;
+  if(!layer || !(layer->Flags & LAYERUPDATING) || !layer->DamageList) {
+    areas[0]=box;
+    return 1;
+  }
+
+  /* region rectangles are relative to the region bounds */
+  damaged=layer->DamageList;
+  n=0;
+  for(r=damaged->RegionRectangle; r && n < MAX_EXPOSE_AREAS; r=r->Next) {
+    damage.x=damaged->bounds.MinX + r->bounds.MinX - _mleft(obj);
+    damage.y=damaged->bounds.MinY + r->bounds.MinY - _mtop(obj);
+    damage.width=r->bounds.MaxX - r->bounds.MinX + 1;
+    damage.height=r->bounds.MaxY - r->bounds.MinY + 1;
+    DebOut("  damage: %d,%d %dx%d\n",damage.x,damage.y,damage.width,damage.height);
+
+    if(gdk_rectangle_intersect(&box, &damage, &areas[n])) {
+      n++;
+    }
+  }
+
+  if(r) {
+    damage.x=damaged->bounds.MinX - _mleft(obj);
+    damage.y=damaged->bounds.MinY - _mtop(obj);
+    damage.width=damaged->bounds.MaxX - damaged->bounds.MinX + 1;
+    damage.height=damaged->bounds.MaxY - damaged->bounds.MinY + 1;
+    DebOut("  damage bounds: %d,%d %dx%d\n",damage.x,damage.y,damage.width,damage.height);
+
+    return gdk_rectangle_intersect(&box, &damage, &areas[0]) ? 1 : 0;
+  }
+
+  return n;
+}
+
+/*
+ * Double buffered expose: the widget draws into data->backing instead
+ * of the window (see gdk_draw.c), the exposed area then goes to the
+ * screen with one blit, so clearing and redrawing never shows. The
+ * backing starts as a copy of what MUI has drawn there, our background.
+ */
+static BOOL backing_begin(struct Data *data, Object *obj, GtkWidget *widget, GdkRectangle *area) {
+  struct RastPort *rp;
+
+  if(!GTK_WIDGET_DOUBLE_BUFFERED(widget) || !widget->window) {
+    return FALSE;
+  }
+
+  if(data->backing &&
+     (data->backing->mgtk_width  != _mwidth(obj) ||
+      data->backing->mgtk_height != _mheight(obj))) {
+    free_backing(data);
+  }
+  if(!data->backing) {
+    data->backing=gdk_pixmap_new(widget->window, _mwidth(obj), _mheight(obj), -1);
+  }
+
+  rp=data->backing ? (struct RastPort *) data->backing->mgtk_rastport : NULL;
+  if(!rp) {
+    DebOut("  no backing store, drawing directly\n");
+    free_backing(data);
+    return FALSE;
+  }
+
+  ClipBlit(_rp(obj), _mleft(obj)+area->x, _mtop(obj)+area->y,
+           rp, area->x, area->y, area->width, area->height, 0xc0);
+
+  widget->window->mgtk_backing=data->backing;
+
+  return TRUE;
+}
+
+static VOID backing_end(struct Data *data, Object *obj, GtkWidget *widget, GdkRectangle *area) {
+
+  if(widget->window) {
+    widget->window->mgtk_backing=NULL;
+  }
+
+  ClipBlit((struct RastPort *) data->backing->mgtk_rastport, area->x, area->y,
+           _rp(obj), _mleft(obj)+area->x, _mtop(obj)+area->y,
+           area->width, area->height, 0xc0);
+}
+
 static ULONG mDraw(struct IClass *cl,struct Data *data,Object *obj,struct MUIP_Draw *msg)
 {
   gint ret;
   GtkWidget *widget;
   GdkEventExpose *event;
+  GdkRectangle areas[MAX_EXPOSE_AREAS];
+  int n;
+  int i;
+  APTR clip;
   static gint (*callme)(GtkWidget *widget, GdkEventExpose *event);
   static void (*callme2) (GtkWidget *widget, GtkAllocation *allocation);
 
@@ -474,9 +627,23 @@ static ULONG mDraw(struct IClass *cl,struct Data *data,Object *obj,struct MUIP_D
   if(GTK_WIDGET_GET_CLASS(widget)) {
     DebOut("  widget->class=%lx\n",GTK_WIDGET_GET_CLASS(widget));
     if(GTK_WIDGET_GET_CLASS(widget)->size_allocate) {
-      callme2=GTK_WIDGET_GET_CLASS(widget)->size_allocate;
-      DebOut("  calling widget->class->size_allocate: %lx\n",callme2);
-      (*callme2)(widget,&widget->allocation);
+      /* a redraw without resize or move must not relayout the gtk widget */
+      if(!data->have_alloc ||
+         data->last_left         != _mleft(obj) ||
+         data->last_top          != _mtop(obj) ||
+         data->last_alloc.width  != widget->allocation.width ||
+         data->last_alloc.height != widget->allocation.height) {
+        callme2=GTK_WIDGET_GET_CLASS(widget)->size_allocate;
+        DebOut("  calling widget->class->size_allocate: %lx\n",callme2);
+        (*callme2)(widget,&widget->allocation);
+        data->last_alloc=widget->allocation;
+        data->last_left=_mleft(obj);
+        data->last_top=_mtop(obj);
+        data->have_alloc=TRUE;
+      }
+      else {
+        DebOut("  allocation unchanged, no size_allocate\n");
+      }
     }
     else {
       DebOut("  no size_allocate defined in widget class\n");
@@ -493,13 +660,45 @@ static ULONG mDraw(struct IClass *cl,struct Data *data,Object *obj,struct MUIP_D
         /*gtk_widget_realize(widget); is just a dummy :( */
         g_signal_emit_by_name (widget, "realize");
       }
+
+      n=get_expose_areas(obj, areas);
+      if(!n) {
+        DebOut("  nothing to expose\n");
+        return(0);
+      }
+
       callme=GTK_WIDGET_GET_CLASS(widget)->expose_event;
-      DebOut("  calling widget->expose_event: %lx\n",callme);
-      event=g_new0(GdkEventExpose,1);
-      event->count=0;
-      ret=(*callme)(widget,event);
-      g_free(event);
-      DebOut("  ret=%d\n",ret);
+      event=&data->expose;
+
+      /* one expose per area, like gdk does for every damaged rectangle */
+      for(i=0; i<n; i++) {
+        event->type=GDK_EXPOSE;
+        event->window=widget->window;
+        event->send_event=FALSE;
+        event->area=areas[i];
+        event->count=n-1-i;
+        mgtk_region_set_rectangle(data->region, &event->area);
+        event->region=data->region;
+
+        DebOut("  expose area: %d,%d %dx%d\n",event->area.x,event->area.y,event->area.width,event->area.height);
+
+        /* don't let the widget paint outside the exposed area */
+        clip=MUI_AddClipping(muiRenderInfo(obj),
+                             _mleft(obj)+event->area.x, _mtop(obj)+event->area.y,
+                             event->area.width, event->area.height);
+
+        DebOut("  calling widget->expose_event: %lx\n",callme);
+        if(backing_begin(data, obj, widget, &event->area)) {
+          ret=(*callme)(widget,event);
+          backing_end(data, obj, widget, &event->area);
+        }
+        else {
+          ret=(*callme)(widget,event);
+        }
+        DebOut("  ret=%d\n",ret);
+
+        MUI_RemoveClipping(muiRenderInfo(obj),clip);
+      }
     }
     else {
       DebOut("  no expose_event defined in widget %lx\n", widget);
@@ -522,7 +721,9 @@ DebOut("(%lx)->msg->MethodID: %lx\n",obj,msg->MethodID);
     case OM_NEW         : return mNew           (cl,   obj, msg);
   	case OM_SET         :        mSet           (data, obj, (APTR)msg, FALSE); break;
     case OM_GET         : return mGet           (data, obj, (APTR)msg, cl);
+    case OM_DISPOSE     :        mDispose       (data, obj); break;
     case MUIM_AskMinMax : return mAskMinMax     (data, obj, (APTR)msg, cl);
+    case MUIM_Cleanup   : return mCleanup       (cl,   data, obj, msg);
     case MUIM_Draw      : return mDraw          (cl,   data, obj, (APTR)msg);
 #if 0
     case OM_REMMEMBER   :        mRemMember     (data,      (APTR)msg); break;
@@ -224,6 +224,19 @@ static int mAddMember(struct Data *data, Object *obj,struct opMember *msg,struct
   }
 }
 
+static int mRemMember(struct Data *data, Object *obj,struct opMember *msg,struct IClass *cl) {
+
+  DebOut("frame.c: mRemMember(%lx,%lx)\n",obj,msg->opam_Object);
+
+  if(!data->init) {
+    /* children are members of the frame, see mAddMember */
+    DoMethod(data->frame,OM_REMMEMBER,(ULONG) msg->opam_Object);
+    data->childlist = g_slist_remove (data->childlist, msg->opam_Object);
+    return TRUE;
+  }
+  return DoSuperMethodA(cl, obj, (Msg)msg);
+}
+
 STATIC VOID mDispose(struct Data *data) {
 
   DebOut("frame.c: mDispose\n");
@@ -250,6 +263,7 @@ DebOut("(%lx)->msg->MethodID: %lx\n",obj,msg->MethodID);
     case OM_GET          : return mGet           (data, obj, (APTR)msg, cl);
     case OM_SET          :        mSet           (data, obj, (APTR)msg); break;
     case OM_ADDMEMBER    : return mAddMember     (data, obj, (APTR)msg, cl);
+    case OM_REMMEMBER    : return mRemMember     (data, obj, (APTR)msg, cl);
     case OM_DISPOSE      :        mDispose       (data); break;
     case MUIM_AskMinMax  : return mgtk_askminmax (cl, obj, (APTR)msg, AskMin_Unlimited, AskMin_Unlimited);
   }
@@ -31,6 +31,7 @@
 #include <clib/alib_protos.h>
 #include <proto/utility.h>
 #include <exec/types.h>
+#include <string.h>
 #include <mui.h>
 #include "gtk/gtk.h"
 #include "gtk/gtkaccellabel.h"
@@ -112,10 +113,10 @@ AROS_UFH3(static ULONG, LayoutHook, AROS_UFHA(struct Hook *, hook, a0), AROS_UFH
       DebOut(" vvvvvvvvvvvvvvvvvvv MUILM_MINMAX vvvvvvvvvvvvvvvvvvv\n");
 
       GtkWidget *table;
-      GtkRequisition *requisition;
+      GtkRequisition requisition;
 
       table=mgtk_get_widget_from_obj(obj);
-      requisition=mgtk_allocmem(sizeof(GtkRequisition),MEMF_CLEAR);
+      memset(&requisition,0,sizeof(requisition));
 
       /* 
        * MUI knows three kinds of requisitions: min, def and max.
@@ -135,29 +136,28 @@ AROS_UFH3(static ULONG, LayoutHook, AROS_UFHA(struct Hook *, hook, a0), AROS_UFH
        * 3: maxwidth
        */
 
-      requisition->gtkmui_type=1;
-      gtk_table_size_request(table,requisition);
-      lm->lm_MinMax.MinWidth  = requisition->width;
-      lm->lm_MinMax.MinHeight = requisition->height;
-      DebOut("  MUILM_MINMAX: min width: %d height: %d\n",requisition->width,requisition->height);
-
-      requisition->gtkmui_type=3;
-      gtk_table_size_request(table,requisition);
-      lm->lm_MinMax.MaxWidth  = requisition->width;
-      lm->lm_MinMax.MaxHeight = requisition->height;
-      DebOut("  MUILM_MINMAX: max width: %d height: %d\n",requisition->width,requisition->height);
+      requisition.gtkmui_type=1;
+      gtk_table_size_request(table,&requisition);
+      lm->lm_MinMax.MinWidth  = requisition.width;
+      lm->lm_MinMax.MinHeight = requisition.height;
+      DebOut("  MUILM_MINMAX: min width: %d height: %d\n",requisition.width,requisition.height);
+
+      requisition.gtkmui_type=3;
+      gtk_table_size_request(table,&requisition);
+      lm->lm_MinMax.MaxWidth  = requisition.width;
+      lm->lm_MinMax.MaxHeight = requisition.height;
+      DebOut("  MUILM_MINMAX: max width: %d height: %d\n",requisition.width,requisition.height);
  
       /* we call type 2 after all others, as those values
        * are "the best fitting" for GTK and the call to gtk_table_size_request
        * sets some values, which are used later on.
        */
-      requisition->gtkmui_type=2;
-      gtk_table_size_request(table,requisition);
-      lm->lm_MinMax.DefWidth  = (LONG) requisition->width;
-      lm->lm_MinMax.DefHeight = (LONG) requisition->height;
-      DebOut("  MUILM_MINMAX: def width: %d height: %d\n",requisition->width,requisition->height);
+      requisition.gtkmui_type=2;
+      gtk_table_size_request(table,&requisition);
+      lm->lm_MinMax.DefWidth  = (LONG) requisition.width;
+      lm->lm_MinMax.DefHeight = (LONG) requisition.height;
+      DebOut("  MUILM_MINMAX: def width: %d height: %d\n",requisition.width,requisition.height);
 
-      mgtk_freemem(requisition,sizeof(GtkRequisition));
       DebOut(" ^^^^^^^^^^^^^^^^^^^ MUILM_MINMAX ^^^^^^^^^^^^^^^^^^^\n");
       return 0;
     }
@@ -165,25 +165,22 @@ AROS_UFH3(static ULONG, LayoutHook, AROS_UFHA(struct Hook *, hook, a0), AROS_UFH
 
     case MUILM_LAYOUT: {
       GtkWidget *table;
-      GtkAllocation *allocation;
+      GtkAllocation allocation;
 
       DebOut(" vvvvvvvvvvvvvvvvvvv MUILM_LAYOUT vvvvvvvvvvvvvvvvvvv\n");
 
       table=mgtk_get_widget_from_obj(obj);
-      allocation=mgtk_allocmem(sizeof(GtkAllocation),MEMF_CLEAR);
 
-      allocation->width = (gint) lm->lm_Layout.Width; 
-      allocation->height= (gint) lm->lm_Layout.Height;
-      allocation->x= 0;
-      allocation->y= 0;
+      allocation.width = (gint) lm->lm_Layout.Width; 
+      allocation.height= (gint) lm->lm_Layout.Height;
+      allocation.x= 0;
+      allocation.y= 0;
 
       /* up to here, everything seems ok */
-      DebOut("MUILM_LAYOUT: x=y=0, width=%d height=%d\n",allocation->width,allocation->height);
+      DebOut("MUILM_LAYOUT: x=y=0, width=%d height=%d\n",allocation.width,allocation.height);
 
-      gtk_table_size_allocate(table,allocation);
+      gtk_table_size_allocate(table,&allocation);
 
-      mgtk_freemem(allocation,sizeof(GtkAllocation));
- 
       DebOut(" ^^^^^^^^^^^^^^^^^^^ MUILM_LAYOUT ^^^^^^^^^^^^^^^^^^^\n");
       return TRUE;
     }
@@ -416,7 +413,7 @@ static void mgtk_menu_append(APTR menuitem, GtkWidget *child, unsigned int level
   DebOut("mgtk_menu_append(%lx,%lx,%d)\n",menuitem,child,level);
 
   /* create new menuitem */
-  label=gtk_label_get_text(GTK_LABEL(mgtk_get_accel(child)));
+  label=mgtk_get_accel_text(mgtk_get_accel(child));
 
   DebOut("  label=%s\n",label);
 
@@ -458,7 +455,7 @@ static void mgtk_menu_append(APTR menuitem, GtkWidget *child, unsigned int level
     case 3:
       /* menuitem object */
 
-      GTK_MUI(child)->MuiMenu=NewObject(CL_Menu->mcc_Class,NULL,
+      GTK_MUI(child)->MuiMenu=NewObject(MGTK_CLASS(CL_Menu),NULL,
                                 MUIA_Menuitem_Title, (ULONG) label,
                                 MA_Widget, (ULONG) child, TAG_DONE);
       break;
@@ -505,7 +502,7 @@ static ULONG mContextMenu(struct Data *data, APTR obj, struct opGet *msg, struct
   menu_item_accel=(GtkWidget *) xget(obj,MA_Widget); 
 
   /* The accel widget contains the (root) label of our new menu */
-  label=gtk_label_get_text(GTK_LABEL(menu_item_accel));
+  label=mgtk_get_accel_text(menu_item_accel);
   DebOut("root label=%s\n",label);
 
   menu_item=mgtk_get_accel_parent(menu_item_accel);
@@ -0,0 +1,271 @@
+/*****************************************************************************
+ *
+ * gtk-mui - a wrapper library to wrap GTK+ calls to MUI
+ *
+ * Copyright (C) 2005 Oliver Brunner
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+ *
+ * Contact information:
+ *
+ * Oliver Brunner
+ *
+ * E-Mail: gtk-mui "at" oliver-brunner.de
+ *
+ * $Id: image.c,v 1.1 2026/10/19 10:00:00 o1i Exp $
+ *
+ *****************************************************************************/
+
+
+/* image class
+**
+** shows a picture from the decoded image cache. Until the loader has
+** decoded the file, an empty placeholder of MGTK_IMAGE_PLACEHOLDER
+** pixels is shown, the parent group is relayouted, once the real size
+** is known.
+*/
+
+#include <clib/alib_protos.h>
+#include <proto/utility.h>
+#include <proto/graphics.h>
+#include <mui.h>
+
+#include "classes.h"
+#include "gtk_globals.h"
+#include "gtk.h"
+#include "debug.h"
+#include "imagecache.h"
+
+#define MGTK_IMAGE_PLACEHOLDER 16
+
+struct Data {
+  MgtkImageEntry *entry;
+  BOOL            setup;
+  LONG            shown_width;  /* size of the last layout */
+  LONG            shown_height;
+};
+
+static void image_size(struct Data *data, LONG *width, LONG *height) {
+
+  if(data->entry && data->entry->state == MGTK_IMAGE_READY) {
+    *width =data->entry->width;
+    *height=data->entry->height;
+  }
+  else {
+    *width =MGTK_IMAGE_PLACEHOLDER;
+    *height=MGTK_IMAGE_PLACEHOLDER;
+  }
+}
+
+/* redraw us, or let our parent relayout, if our size changed */
+static void image_update(struct Data *data, Object *obj) {
+  LONG width, height;
+  Object *parent;
+
+  if(!data->setup) {
+    return;
+  }
+
+  image_size(data, &width, &height);
+  parent=_parent(obj);
+
+  if(parent && (width != data->shown_width || height != data->shown_height)) {
+    DoMethod(parent, MUIM_Group_InitChange);
+    DoMethod(parent, MUIM_Group_ExitChange);
+  }
+  else {
+    MUI_Redraw(obj, MADF_DRAWOBJECT);
+  }
+}
+
+static void image_set_entry(struct Data *data, Object *obj, MgtkImageEntry *entry) {
+  MgtkImageEntry *old;
+
+  old=data->entry;
+  if(old == entry) {
+    return;
+  }
+
+  data->entry=entry ? mgtk_image_cache_ref(entry) : NULL;
+  if(entry) {
+    mgtk_image_cache_wait(entry, obj);
+  }
+
+  if(old) {
+    mgtk_image_cache_unwait(old, obj);
+    mgtk_image_cache_unref(old);
+  }
+
+  image_update(data, obj);
+}
+
+static ULONG mNew(struct IClass *cl, APTR obj, Msg msg) {
+  struct TagItem *tstate, *tag;
+
+  obj = (APTR)DoSuperMethodA(cl, obj, msg);
+
+  DebOut("mNew(image)\n");
+
+  if (!obj) {
+    ErrOut("image: unable to create object!");
+    return (ULONG) NULL;
+  }
+
+  tstate=((struct opSet *)msg)->ops_AttrList;
+
+  while ((tag = (struct TagItem *) NextTagItem((APTR) &tstate))) {
+    switch (tag->ti_Tag) {
+      case MA_Image_Entry:
+        {
+          GETDATA;
+          image_set_entry(data, obj, (MgtkImageEntry *) tag->ti_Data);
+        }
+        break;
+    }
+  }
+
+  return (ULONG)obj;
+}
+
+static VOID mSet(struct Data *data, APTR obj, struct opSet *msg) {
+  struct TagItem *tstate, *tag;
+
+  tstate=msg->ops_AttrList;
+
+  while ((tag = (struct TagItem *) NextTagItem((APTR) &tstate))) {
+    switch (tag->ti_Tag) {
+      case MA_Image_Entry:
+        image_set_entry(data, obj, (MgtkImageEntry *) tag->ti_Data);
+        break;
+    }
+  }
+}
+
+static VOID mDispose(struct Data *data, APTR obj) {
+
+  DebOut("image.c: mDispose(%lx)\n",obj);
+
+  data->setup=FALSE;
+  image_set_entry(data, obj, NULL);
+}
+
+static ULONG mSetup(struct IClass *cl, struct Data *data, APTR obj, Msg msg) {
+
+  if(!DoSuperMethodA(cl, obj, msg)) {
+    return FALSE;
+  }
+  data->setup=TRUE;
+
+  return TRUE;
+}
+
+static ULONG mCleanup(struct IClass *cl, struct Data *data, APTR obj, Msg msg) {
+
+  data->setup=FALSE;
+
+  return DoSuperMethodA(cl, obj, msg);
+}
+
+static ULONG mAskMinMax(struct IClass *cl, struct Data *data, APTR obj, struct MUIP_AskMinMax *msg) {
+  LONG width, height;
+
+  DoSuperMethodA(cl, obj, (Msg) msg);
+
+  image_size(data, &width, &height);
+  data->shown_width =width;
+  data->shown_height=height;
+
+  msg->MinMaxInfo->MinWidth  += width;
+  msg->MinMaxInfo->DefWidth  += width;
+  msg->MinMaxInfo->MaxWidth  += width;
+  msg->MinMaxInfo->MinHeight += height;
+  msg->MinMaxInfo->DefHeight += height;
+  msg->MinMaxInfo->MaxHeight += height;
+
+  return 0;
+}
+
+static ULONG mDraw(struct IClass *cl, struct Data *data, APTR obj, struct MUIP_Draw *msg) {
+  MgtkImageEntry *entry;
+  MgtkImagePic *pic;
+  LONG width, height;
+
+  DoSuperMethodA(cl, obj, (Msg) msg);
+
+  if(!(msg->flags & MADF_DRAWOBJECT)) {
+    return 0;
+  }
+
+  entry=data->entry;
+  if(!entry || entry->state != MGTK_IMAGE_READY) {
+    return 0;
+  }
+
+  width =MIN(entry->width,  _mwidth(obj));
+  height=MIN(entry->height, _mheight(obj));
+
+  pic=MGTK_IMAGE_PIC(entry);
+  if(pic->mask) {
+    BltMaskBitMapRastPort(pic->bitmap, 0, 0, _rp(obj), _mleft(obj), _mtop(obj),
+                          width, height, (ABC|ABNC|ANBC), pic->mask);
+  }
+  else {
+    BltBitMapRastPort(pic->bitmap, 0, 0, _rp(obj), _mleft(obj), _mtop(obj),
+                      width, height, 0xc0);
+  }
+
+  return 0;
+}
+
+/*******************************************
+ * Dispatcher
+ *******************************************/
+BEGINMTABLE
+GETDATA;
+
+  switch (msg->MethodID) {
+    case OM_NEW         : return mNew       (cl, obj, msg);
+    case OM_SET         :        mSet       (data, obj, (APTR)msg); break;
+    case OM_DISPOSE     :        mDispose   (data, obj); break;
+    case MUIM_Setup     : return mSetup     (cl, data, obj, msg);
+    case MUIM_Cleanup   : return mCleanup   (cl, data, obj, msg);
+    case MUIM_AskMinMax : return mAskMinMax (cl, data, obj, (APTR)msg);
+    case MUIM_Draw      : return mDraw      (cl, data, obj, (APTR)msg);
+    case MM_Image_Loaded:        image_update(data, obj); return 0;
+  }
+
+ENDMTABLE
+
+/*******************************************
+ * Custom class create/delete
+ *******************************************/
+int mgtk_create_image_class(void) {
+
+  DebOut("mgtk_create_image_class()\n");
+
+  CL_Image = MUI_CreateCustomClass(NULL, MUIC_Area, NULL, sizeof(struct Data), (APTR)&mDispatcher);
+
+  DebOut("CL_Image=%lx\n",CL_Image);
+
+  return CL_Image ? 1 : 0;
+}
+
+void mgtk_delete_image_class(void) {
+
+  if (CL_Image) {
+    MUI_DeleteCustomClass(CL_Image);
+    CL_Image=NULL;
+  }
+}
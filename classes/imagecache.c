@@ -0,0 +1,428 @@
+/*****************************************************************************
+ *
+ * gtk-mui - a wrapper library to wrap GTK+ calls to MUI
+ *
+ * Copyright (C) 2005 Oliver Brunner
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+ *
+ * Contact information:
+ *
+ * Oliver Brunner
+ *
+ * E-Mail: gtk-mui "at" oliver-brunner.de
+ *
+ * $Id: imagecache.c,v 1.1 2026/10/19 10:00:00 o1i Exp $
+ *
+ *****************************************************************************/
+
+
+/* decoded image cache
+**
+** The GUI task only looks up entries and hands new files to the loader
+** process, which does the datatype decoding (and remapping to the
+** public screen). The loader replies the request message, gtk_main
+** picks the reply up via mgtk_image_cache_dispatch and tells the
+** waiting image objects.
+** Entries, LRU and budget are handled by the glib only imagecore.c.
+*/
+
+#include <string.h>
+#include <clib/alib_protos.h>
+#include <proto/exec.h>
+#include <proto/dos.h>
+#include <proto/graphics.h>
+#include <proto/datatypes.h>
+#include <datatypes/pictureclass.h>
+#include <dos/dostags.h>
+#include <mui.h>
+
+#include "classes.h"
+#include "gtk_globals.h"
+#include "gtk.h"
+#include "debug.h"
+#include "imagecache.h"
+
+struct LoaderMsg {
+  struct Message   msg;
+  MgtkImageEntry  *entry;  /* NULL: quit */
+  /* results, copied into the entry on the GUI task */
+  Object          *dto;
+  struct BitMap   *bitmap;
+  PLANEPTR         mask;
+  LONG             width;
+  LONG             height;
+};
+
+static MgtkImageCore   core;
+static BOOL            core_ready;
+
+static struct MsgPort *reply_port;
+static struct MsgPort *loader_port;  /* owned by the loader process */
+static struct Task    *loader_parent;
+static struct Screen  *loader_screen;
+static guint           pending;      /* requests not yet replied */
+static BOOL            loader_failed;
+static BOOL            own_datatypes;
+
+#ifdef __AMIGAOS4__
+struct DataTypesIFace *IDataTypes;
+#endif
+
+/*********************************
+ * decoding, runs on the loader
+ *********************************/
+static void loader_decode(struct LoaderMsg *msg) {
+  struct BitMapHeader *bmhd;
+  struct BitMap *bitmap;
+  PLANEPTR mask;
+  Object *dto;
+
+  bmhd=NULL;
+  bitmap=NULL;
+  mask=NULL;
+
+  dto=NewDTObject((APTR) msg->entry->path,
+                  DTA_SourceType,       DTST_FILE,
+                  DTA_GroupID,          GID_PICTURE,
+                  PDTA_Remap,           loader_screen ? TRUE : FALSE,
+                  PDTA_Screen,          (ULONG) loader_screen,
+                  PDTA_DestMode,        PMODE_V43,
+                  PDTA_UseFriendBitMap, TRUE,
+                  OBP_Precision,        PRECISION_IMAGE,
+                  TAG_DONE);
+
+  if(dto) {
+    if(DoMethod(dto, DTM_PROCLAYOUT, NULL, 1)) {
+      GetDTAttrs(dto, PDTA_BitMapHeader, (ULONG) &bmhd,
+                      PDTA_DestBitMap,   (ULONG) &bitmap,
+                      PDTA_MaskPlane,    (ULONG) &mask,
+                      TAG_DONE);
+      if(!bitmap) {
+        GetDTAttrs(dto, PDTA_BitMap, (ULONG) &bitmap, TAG_DONE);
+      }
+    }
+    if(!bitmap || !bmhd) {
+      DisposeDTObject(dto);
+      dto=NULL;
+    }
+  }
+
+  msg->dto=dto;
+  if(dto) {
+    msg->bitmap=bitmap;
+    msg->mask  =mask;
+    msg->width =bmhd->bmh_Width;
+    msg->height=bmhd->bmh_Height;
+  }
+}
+
+static LONG loader_main(void) {
+  struct MsgPort *port;
+  struct LoaderMsg *msg;
+
+  port=CreateMsgPort();
+  loader_port=port;
+  Signal(loader_parent, SIGF_SINGLE);
+
+  if(!port) {
+    return RETURN_FAIL;
+  }
+
+  while(TRUE) {
+    WaitPort(port);
+    while((msg=(struct LoaderMsg *) GetMsg(port))) {
+      if(!msg->entry) {
+        /* no more requests can arrive, the GUI task waits for this reply */
+        DeleteMsgPort(port);
+        Forbid();
+        ReplyMsg(&msg->msg);
+        return RETURN_OK;
+      }
+      loader_decode(msg);
+      ReplyMsg(&msg->msg);
+    }
+  }
+}
+
+static BOOL loader_start(void) {
+  GETGLOBAL
+
+  if(loader_port) {
+    return TRUE;
+  }
+  if(loader_failed) {
+    return FALSE;
+  }
+
+  if(!DataTypesBase) {
+    DataTypesBase=OpenLibrary("datatypes.library",39);
+    own_datatypes=TRUE;
+#ifdef __AMIGAOS4__
+    if(DataTypesBase) {
+      IDataTypes=(struct DataTypesIFace *) GetInterface(DataTypesBase,"main",1,NULL);
+    }
+#endif
+  }
+
+  reply_port=CreateMsgPort();
+  if(!DataTypesBase || !reply_port) {
+    ErrOut("imagecache: unable to open datatypes.library or create port\n");
+    loader_failed=TRUE;
+    return FALSE;
+  }
+
+  loader_screen=mgtk ? mgtk->screen : NULL;
+  loader_parent=FindTask(NULL);
+
+  SetSignal(0, SIGF_SINGLE);
+  if(!CreateNewProcTags(NP_Entry,     (ULONG) loader_main,
+                        NP_Name,      (ULONG) "GTK-MUI image loader",
+                        NP_Priority,  -1,
+                        NP_StackSize, 16384,
+                        TAG_DONE)) {
+    WarnOut("imagecache: no loader process, decoding on the GUI task\n");
+    loader_failed=TRUE;
+    return FALSE;
+  }
+  Wait(SIGF_SINGLE);
+
+  if(!loader_port) {
+    WarnOut("imagecache: loader process failed, decoding on the GUI task\n");
+    loader_failed=TRUE;
+    return FALSE;
+  }
+
+  return TRUE;
+}
+
+/*********************************
+ * imagecore callbacks
+ *********************************/
+static gboolean cache_stamp(MgtkImageCore *c, const gchar *path, MgtkImageStamp *stamp) {
+  struct FileInfoBlock *fib;
+  BPTR lock;
+
+  lock=Lock((STRPTR) path, ACCESS_READ);
+  if(!lock) {
+    return FALSE;
+  }
+  memset(stamp, 0, sizeof(*stamp));
+  if((fib=AllocDosObject(DOS_FIB, NULL))) {
+    if(Examine(lock, fib)) {
+      stamp->days  =fib->fib_Date.ds_Days;
+      stamp->minute=fib->fib_Date.ds_Minute;
+      stamp->tick  =fib->fib_Date.ds_Tick;
+    }
+    FreeDosObject(DOS_FIB, fib);
+  }
+  UnLock(lock);
+
+  return TRUE;
+}
+
+/* results of loader_decode, on the GUI task */
+static void cache_loaded(struct LoaderMsg *msg) {
+  MgtkImagePic *pic;
+  gulong bytes;
+
+  if(!msg->dto) {
+    WarnOut("imagecache: %s can't be loaded\n",msg->entry->path);
+    mgtk_image_core_loaded(&core, msg->entry, NULL, 0, 0, 0);
+    return;
+  }
+
+  pic=g_new(MgtkImagePic, 1);
+  pic->dto   =msg->dto;
+  pic->bitmap=msg->bitmap;
+  pic->mask  =msg->mask;
+
+  bytes=RASSIZE(msg->width, msg->height) * GetBitMapAttr(msg->bitmap, BMA_DEPTH);
+  if(msg->mask) {
+    bytes+=RASSIZE(msg->width, msg->height);
+  }
+
+  mgtk_image_core_loaded(&core, msg->entry, pic, msg->width, msg->height, bytes);
+}
+
+static void cache_decode(MgtkImageCore *c, MgtkImageEntry *entry) {
+  struct LoaderMsg *msg;
+  struct LoaderMsg sync;
+
+  if(loader_start()) {
+    msg=g_new0(struct LoaderMsg, 1);
+    msg->msg.mn_ReplyPort=reply_port;
+    msg->msg.mn_Length=sizeof(struct LoaderMsg);
+    msg->entry=entry;
+    pending++;
+    PutMsg(loader_port, &msg->msg);
+    return;
+  }
+
+  memset(&sync, 0, sizeof(sync));
+  sync.entry=entry;
+  if(DataTypesBase) {
+    loader_screen=global_mgtk ? global_mgtk->screen : NULL;
+    loader_decode(&sync);
+  }
+  cache_loaded(&sync);
+}
+
+static void cache_release(MgtkImageCore *c, gpointer data) {
+  MgtkImagePic *pic=(MgtkImagePic *) data;
+
+  DisposeDTObject(pic->dto);
+  g_free(pic);
+}
+
+static void cache_notify(MgtkImageCore *c, MgtkImageEntry *entry, gpointer obj) {
+
+  DoMethod((Object *) obj, MM_Image_Loaded);
+}
+
+static const MgtkImageCoreClass cache_class = {
+  cache_stamp,
+  cache_decode,
+  cache_release,
+  cache_notify
+};
+
+/* seconds since 1978, only differences matter */
+static gdouble cache_now(void) {
+  struct DateStamp now;
+
+  DateStamp(&now);
+  return now.ds_Days * 86400.0 + now.ds_Minute * 60.0 + now.ds_Tick / (gdouble) TICKS_PER_SECOND;
+}
+
+/*********************************
+ * mgtk_image_cache_get
+ *
+ * returns a referenced entry for path or NULL,
+ * if path does not exist.
+ * Files, which are in the cache, are only looked at
+ * again every MGTK_IMAGE_CACHE_RECHECK seconds, so
+ * lots of images of the same file don't hit the disk.
+ *********************************/
+MgtkImageEntry *mgtk_image_cache_get(const gchar *path) {
+
+  DebOut("mgtk_image_cache_get(%s)\n",path);
+
+  if(!core_ready) {
+    mgtk_image_core_init(&core, &cache_class, NULL, MGTK_IMAGE_CACHE_BUDGET, MGTK_IMAGE_CACHE_RECHECK);
+    core_ready=TRUE;
+  }
+
+  return mgtk_image_core_get(&core, path, cache_now());
+}
+
+MgtkImageEntry *mgtk_image_cache_ref(MgtkImageEntry *entry) {
+
+  return mgtk_image_core_ref(&core, entry);
+}
+
+void mgtk_image_cache_unref(MgtkImageEntry *entry) {
+
+  mgtk_image_core_unref(&core, entry);
+}
+
+/*********************************
+ * waiting objects
+ *********************************/
+void mgtk_image_cache_wait(MgtkImageEntry *entry, Object *obj) {
+
+  mgtk_image_core_wait(entry, obj);
+}
+
+void mgtk_image_cache_unwait(MgtkImageEntry *entry, Object *obj) {
+
+  mgtk_image_core_unwait(entry, obj);
+}
+
+/*********************************
+ * gtk_main interface
+ *********************************/
+ULONG mgtk_image_cache_signals(void) {
+
+  if(!reply_port) {
+    return 0;
+  }
+  return 1L << reply_port->mp_SigBit;
+}
+
+void mgtk_image_cache_dispatch(void) {
+  struct LoaderMsg *msg;
+
+  if(!reply_port) {
+    return;
+  }
+
+  while((msg=(struct LoaderMsg *) GetMsg(reply_port))) {
+    pending--;
+    cache_loaded(msg);
+    g_free(msg);
+  }
+}
+
+void mgtk_image_cache_cleanup(void) {
+  struct LoaderMsg quit;
+  struct LoaderMsg *msg;
+
+  DebOut("mgtk_image_cache_cleanup()\n");
+
+  if(loader_port) {
+    /* let the loader finish, what it is doing. Nobody waits anymore. */
+    while(pending) {
+      WaitPort(reply_port);
+      while((msg=(struct LoaderMsg *) GetMsg(reply_port))) {
+        pending--;
+        cache_loaded(msg);
+        g_free(msg);
+      }
+    }
+
+    memset(&quit, 0, sizeof(quit));
+    quit.msg.mn_ReplyPort=reply_port;
+    quit.msg.mn_Length=sizeof(quit);
+    PutMsg(loader_port, &quit.msg);
+    WaitPort(reply_port);
+    GetMsg(reply_port);
+    loader_port=NULL;
+  }
+
+  if(reply_port) {
+    DeleteMsgPort(reply_port);
+    reply_port=NULL;
+  }
+
+  /* image objects are gone, together with the application */
+  if(core_ready) {
+    mgtk_image_core_cleanup(&core);
+    core_ready=FALSE;
+  }
+
+  if(own_datatypes) {
+#ifdef __AMIGAOS4__
+    if(IDataTypes) {
+      DropInterface((struct Interface *) IDataTypes);
+      IDataTypes=NULL;
+    }
+#endif
+    CloseLibrary(DataTypesBase);
+    DataTypesBase=NULL;
+    own_datatypes=FALSE;
+  }
+  loader_failed=FALSE;
+}
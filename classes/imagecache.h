@@ -0,0 +1,76 @@
+/*****************************************************************************
+ *
+ * gtk-mui - a wrapper library to wrap GTK+ calls to MUI
+ *
+ * Copyright (C) 2005 Oliver Brunner
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+ *
+ * Contact information:
+ *
+ * Oliver Brunner
+ *
+ * E-Mail: gtk-mui "at" oliver-brunner.de
+ *
+ * $Id: imagecache.h,v 1.1 2026/10/19 10:00:00 o1i Exp $
+ *
+ *****************************************************************************/
+
+
+#ifndef MGTK_IMAGECACHE_H
+#define MGTK_IMAGECACHE_H
+
+/* Process wide cache of decoded picture files for GtkImage.
+ *
+ * Entries are keyed by path and modification date and shared between
+ * all image objects showing the same file. Decoding is done by a loader
+ * process, the image objects waiting for an entry get MM_Image_Loaded,
+ * once it is ready. Unused entries are kept in LRU order and dropped,
+ * when the decoded bitmaps exceed MGTK_IMAGE_CACHE_BUDGET.
+ *
+ * The bookkeeping is in imagecore.c, this is the datatypes part.
+ */
+
+#include <exec/types.h>
+#include <dos/dos.h>
+#include <graphics/gfx.h>
+#include <intuition/classusr.h>
+#include <glib.h>
+
+#include "imagecore.h"
+
+#define MGTK_IMAGE_CACHE_BUDGET  (2*1024*1024)
+/* seconds a cached file is not looked at again */
+#define MGTK_IMAGE_CACHE_RECHECK 2
+
+/* MgtkImageEntry.pic of a READY entry */
+typedef struct {
+  Object        *dto;     /* datatype object, owns bitmap, mask and pens */
+  struct BitMap *bitmap;
+  PLANEPTR       mask;
+} MgtkImagePic;
+
+#define MGTK_IMAGE_PIC(entry) ((MgtkImagePic *) (entry)->pic)
+
+MgtkImageEntry *mgtk_image_cache_get      (const gchar *path);
+MgtkImageEntry *mgtk_image_cache_ref      (MgtkImageEntry *entry);
+void            mgtk_image_cache_unref    (MgtkImageEntry *entry);
+void            mgtk_image_cache_wait     (MgtkImageEntry *entry, Object *obj);
+void            mgtk_image_cache_unwait   (MgtkImageEntry *entry, Object *obj);
+ULONG           mgtk_image_cache_signals  (void);
+void            mgtk_image_cache_dispatch (void);
+void            mgtk_image_cache_cleanup  (void);
+
+#endif
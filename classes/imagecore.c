@@ -0,0 +1,218 @@
+/*****************************************************************************
+ *
+ * gtk-mui - a wrapper library to wrap GTK+ calls to MUI
+ *
+ * Copyright (C) 2005 Oliver Brunner
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+ *
+ * Contact information:
+ *
+ * Oliver Brunner
+ *
+ * E-Mail: gtk-mui "at" oliver-brunner.de
+ *
+ * $Id: imagecore.c,v 1.1 2026/10/19 22:00:00 o1i Exp $
+ *
+ *****************************************************************************/
+
+/* decoded picture cache bookkeeping, see imagecore.h */
+
+#include "imagecore.h"
+
+static gboolean stamp_equal(const MgtkImageStamp *a, const MgtkImageStamp *b) {
+
+  return a->days == b->days && a->minute == b->minute && a->tick == b->tick;
+}
+
+static void entry_free(MgtkImageCore *core, MgtkImageEntry *entry) {
+
+  if(entry->pic) {
+    core->bytes-=entry->bytes;
+    core->klass->release(core, entry->pic);
+  }
+  g_slist_free(entry->waiting);
+  g_free(entry->path);
+  g_free(entry);
+}
+
+/* drop least recently used entries, until we are within the budget */
+static void core_trim(MgtkImageCore *core) {
+  MgtkImageEntry *entry;
+  GList *link;
+
+  while(core->bytes > core->budget && (link=g_queue_peek_tail_link(&core->unused))) {
+    entry=(MgtkImageEntry *) link->data;
+    g_queue_unlink(&core->unused, link);
+    g_hash_table_remove(core->table, entry->path);
+    entry_free(core, entry);
+  }
+}
+
+void mgtk_image_core_init(MgtkImageCore *core, const MgtkImageCoreClass *klass,
+                          gpointer user_data, gulong budget, gdouble recheck) {
+
+  core->klass=klass;
+  core->user_data=user_data;
+  core->budget=budget;
+  core->recheck=recheck;
+  core->table=g_hash_table_new(g_str_hash, g_str_equal);
+  g_queue_init(&core->unused);
+  core->bytes=0;
+}
+
+static gboolean core_free_entry(gpointer key, gpointer value, gpointer user_data) {
+
+  entry_free((MgtkImageCore *) user_data, (MgtkImageEntry *) value);
+  return TRUE;
+}
+
+/* entries still in use are lost, stale ones are not in the table anymore */
+void mgtk_image_core_cleanup(MgtkImageCore *core) {
+
+  if(!core->table) {
+    return;
+  }
+  g_hash_table_foreach_remove(core->table, core_free_entry, core);
+  g_hash_table_destroy(core->table);
+  core->table=NULL;
+  g_queue_init(&core->unused);
+}
+
+/* returns a referenced entry for path or NULL, if there is no such file */
+MgtkImageEntry *mgtk_image_core_get(MgtkImageCore *core, const gchar *path, gdouble now) {
+  MgtkImageEntry *entry;
+  MgtkImageStamp stamp;
+
+  entry=(MgtkImageEntry *) g_hash_table_lookup(core->table, path);
+
+  if(entry && now >= entry->checked && now - entry->checked < core->recheck) {
+    return mgtk_image_core_ref(core, entry);
+  }
+
+  if(!core->klass->stamp(core, path, &stamp)) {
+    return NULL;
+  }
+
+  if(entry) {
+    if(stamp_equal(&entry->stamp, &stamp)) {
+      entry->checked=now;
+      return mgtk_image_core_ref(core, entry);
+    }
+    /* file changed, still in use entries keep the old picture */
+    g_hash_table_remove(core->table, entry->path);
+    entry->stale=1;
+    if(!entry->refcount && entry->state != MGTK_IMAGE_LOADING) {
+      g_queue_unlink(&core->unused, &entry->lru);
+      entry_free(core, entry);
+    }
+  }
+
+  entry=g_new0(MgtkImageEntry, 1);
+  entry->path=g_strdup(path);
+  entry->stamp=stamp;
+  entry->checked=now;
+  entry->refcount=1;
+  entry->state=MGTK_IMAGE_LOADING;
+  entry->lru.data=entry;
+  g_hash_table_insert(core->table, entry->path, entry);
+
+  core->klass->decode(core, entry);
+
+  return entry;
+}
+
+MgtkImageEntry *mgtk_image_core_ref(MgtkImageCore *core, MgtkImageEntry *entry) {
+
+  if(!entry->refcount && entry->state != MGTK_IMAGE_LOADING) {
+    g_queue_unlink(&core->unused, &entry->lru);
+  }
+  entry->refcount++;
+
+  return entry;
+}
+
+void mgtk_image_core_unref(MgtkImageCore *core, MgtkImageEntry *entry) {
+
+  g_return_if_fail(entry->refcount > 0);
+
+  entry->refcount--;
+  if(entry->refcount || entry->state == MGTK_IMAGE_LOADING) {
+    return;
+  }
+
+  if(entry->stale) {
+    entry_free(core, entry);
+    return;
+  }
+
+  g_queue_push_head_link(&core->unused, &entry->lru);
+  core_trim(core);
+}
+
+/* pic NULL: the file could not be decoded */
+void mgtk_image_core_loaded(MgtkImageCore *core, MgtkImageEntry *entry, gpointer pic,
+                            glong width, glong height, gulong bytes) {
+  GSList *waiting;
+  GSList *l;
+
+  g_return_if_fail(entry->state == MGTK_IMAGE_LOADING);
+
+  if(pic) {
+    entry->pic=pic;
+    entry->width=width;
+    entry->height=height;
+    entry->bytes=bytes;
+    core->bytes+=bytes;
+    entry->state=MGTK_IMAGE_READY;
+  }
+  else {
+    entry->state=MGTK_IMAGE_FAILED;
+  }
+
+  waiting=entry->waiting;
+  entry->waiting=NULL;
+
+  /* all users are gone, while we were loading */
+  if(!entry->refcount) {
+    if(entry->stale) {
+      entry_free(core, entry);
+      entry=NULL;
+    }
+    else {
+      g_queue_push_head_link(&core->unused, &entry->lru);
+    }
+  }
+
+  /* waiting objects hold a reference, so entry is still there */
+  for(l=waiting; l; l=l->next) {
+    core->klass->notify(core, entry, l->data);
+  }
+  g_slist_free(waiting);
+
+  core_trim(core);
+}
+
+void mgtk_image_core_wait(MgtkImageEntry *entry, gpointer object) {
+
+  if(entry->state == MGTK_IMAGE_LOADING) {
+    entry->waiting=g_slist_prepend(entry->waiting, object);
+  }
+}
+
+void mgtk_image_core_unwait(MgtkImageEntry *entry, gpointer object) {
+
+  entry->waiting=g_slist_remove(entry->waiting, object);
+}
@@ -0,0 +1,114 @@
+/*****************************************************************************
+ *
+ * gtk-mui - a wrapper library to wrap GTK+ calls to MUI
+ *
+ * Copyright (C) 2005 Oliver Brunner
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+ *
+ * Contact information:
+ *
+ * Oliver Brunner
+ *
+ * E-Mail: gtk-mui "at" oliver-brunner.de
+ *
+ * $Id: imagecore.h,v 1.1 2026/10/19 22:00:00 o1i Exp $
+ *
+ *****************************************************************************/
+
+
+#ifndef MGTK_IMAGECORE_H
+#define MGTK_IMAGECORE_H
+
+/* Bookkeeping of the decoded picture cache (see imagecache.h).
+ *
+ * Entries are keyed by path and shared. An entry in use is referenced,
+ * unused ones are kept in LRU order and dropped, once the bytes of all
+ * decoded pictures exceed the budget. Pictures are decoded by the
+ * decode callback, which calls mgtk_image_core_loaded right away or
+ * later. Until then, interested objects can wait for the entry.
+ *
+ * The modification stamp of a cached file is compared at most once per
+ * recheck seconds. A changed file gets a new entry, users of the old
+ * one keep the old picture, which is freed with its last reference.
+ *
+ * Only depends on glib, so it can be built and tried out on any host.
+ */
+
+#include <glib.h>
+
+/* MgtkImageEntry.state */
+#define MGTK_IMAGE_LOADING 0
+#define MGTK_IMAGE_READY   1
+#define MGTK_IMAGE_FAILED  2
+
+/* a struct DateStamp on the Amiga */
+typedef struct {
+  glong days;
+  glong minute;
+  glong tick;
+} MgtkImageStamp;
+
+typedef struct _MgtkImageEntry MgtkImageEntry;
+typedef struct _MgtkImageCore  MgtkImageCore;
+
+struct _MgtkImageEntry {
+  gchar          *path;
+  MgtkImageStamp  stamp;
+  gdouble         checked;    /* when stamp was last compared with the file */
+  guint           refcount;
+  guint           state;
+  guint           stale : 1;  /* file changed, no longer in the cache table */
+  gpointer        pic;        /* decoded picture, NULL unless READY */
+  glong           width;
+  glong           height;
+  gulong          bytes;
+  GSList         *waiting;    /* objects to notify, while loading */
+  GList           lru;        /* link in the unused list, while refcount is 0 */
+};
+
+typedef struct {
+  /* stamp of path, FALSE if there is no such file */
+  gboolean (*stamp)  (MgtkImageCore *core, const gchar *path, MgtkImageStamp *stamp);
+  /* start decoding, mgtk_image_core_loaded may be called from here */
+  void     (*decode) (MgtkImageCore *core, MgtkImageEntry *entry);
+  /* free a picture passed to mgtk_image_core_loaded */
+  void     (*release)(MgtkImageCore *core, gpointer pic);
+  /* entry is no longer loading */
+  void     (*notify) (MgtkImageCore *core, MgtkImageEntry *entry, gpointer object);
+} MgtkImageCoreClass;
+
+struct _MgtkImageCore {
+  const MgtkImageCoreClass *klass;
+  gpointer    user_data;
+  gulong      budget;
+  gdouble     recheck;   /* seconds */
+  GHashTable *table;     /* path -> current entry */
+  GQueue      unused;    /* refcount 0, most recently used first */
+  gulong      bytes;     /* decoded bytes of all entries */
+};
+
+void            mgtk_image_core_init    (MgtkImageCore *core, const MgtkImageCoreClass *klass,
+                                         gpointer user_data, gulong budget, gdouble recheck);
+void            mgtk_image_core_cleanup (MgtkImageCore *core);
+MgtkImageEntry *mgtk_image_core_get     (MgtkImageCore *core, const gchar *path, gdouble now);
+MgtkImageEntry *mgtk_image_core_ref     (MgtkImageCore *core, MgtkImageEntry *entry);
+void            mgtk_image_core_unref   (MgtkImageCore *core, MgtkImageEntry *entry);
+void            mgtk_image_core_loaded  (MgtkImageCore *core, MgtkImageEntry *entry, gpointer pic,
+                                         glong width, glong height, gulong bytes);
+void            mgtk_image_core_wait    (MgtkImageEntry *entry, gpointer object);
+void            mgtk_image_core_unwait  (MgtkImageEntry *entry, gpointer object);
+
+#endif
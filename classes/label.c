@@ -37,58 +37,16 @@
 
 #include <clib/alib_protos.h>
 #include <proto/graphics.h>
+#include <graphics/text.h>
 #include <proto/utility.h>
 #include "mui.h"
 
 #include "debug.h"
 #include "classes.h"
 #include "gtk_globals.h"
-
-typedef enum {
-   PANGO_NONE,
-   PANGO_SPAN,
-   PANGO_BOLD,
-   PANGO_BIG,
-   PANGO_ITALIC,
-   PANGO_STRIKETHROUGH,
-   PANGO_SUBSCRIPT,
-   PANGO_SUPERSCRIPT,
-   PANGO_SMALL,
-   PANGO_MONOSPACE,
-   PANGO_UNDERLINE,
-} mPANGOTAG;
-
-struct PangoTag {
-   CONST_STRPTR tagname;
-   mPANGOTAG    tagnum;
-};
-
-STATIC CONST struct PangoTag PangoTag[] = {
-   { "span"         , PANGO_SPAN          },
-   { "b"            , PANGO_BOLD          },
-   { "big"          , PANGO_BIG           },
-   { "italic"       , PANGO_ITALIC        },
-   { "strikethrough", PANGO_STRIKETHROUGH },
-   { "sub"          , PANGO_SUBSCRIPT     },
-   { "sup"          , PANGO_SUPERSCRIPT   },
-   { "small"        , PANGO_SMALL         },
-   { "tt"           , PANGO_MONOSPACE     },
-   { "u"            , PANGO_UNDERLINE     },
-   { NULL           , PANGO_NONE          },
-};
-
-struct TextNode {
-   struct MinNode link;
-
-   mPANGOTAG pangotag;
-   BYTE   enable;
-
-   LONG   textlen;
-   STRPTR text;
-};
+#include "markup.h"
 
 struct Data {
-   struct MinList   textlist;
    CONST_STRPTR     text;
    LONG             nrlines;
    gchar**          line;
@@ -96,6 +54,12 @@ struct Data {
    LONG             defheight;
    struct Hook      LayoutHook;
    struct RastPort *rp;
+
+   /* markup text (MA_GtkLabel_PangoText) */
+   MgtkMarkup      *markup;
+   LONG            *pens;     /* pen per run, -1 if not obtained yet */
+   UBYTE           *pen_owner; /* TRUE, if the run did the ObtainBestPenA */
+   struct ColorMap *pen_cm;   /* colormap, the pens are obtained from */
 };
 
 /*******************************************************
@@ -260,212 +224,66 @@ AROS_UFH3(static ULONG, LayoutHook, AROS_UFHA(struct Hook *, hook, a0), AROS_UFH
   return MUILM_UNKNOWN;
 }
 
-STATIC struct TextNode *mNewTag(void)
-{
-   struct TextNode *node;
-
-   node = mgtk_allocmem(sizeof(*node), MEMF_ANY);
-
-   if (node) {
-      node->pangotag = PANGO_NONE;
-      node->enable = 0;
-      node->text = NULL;
-   }
-
-   return node;
-}
-
-/* Returns length of text -1 indicating an error */
-STATIC LONG mAddText(struct MinList *minlist, struct TextNode *node, CONST_STRPTR start, CONST_STRPTR end)
-{
-   LONG len, rc;
-
-   len = end - start;
-   rc = 0;
-
-   if (len >= 0)
-   {
-      node->textlen = len;
-      node->text = mgtk_allocmem(len + 1, MEMF_ANY);
-      rc = -1;
-
-      if (node->text)
-      {
-         CopyMem((void *)start, node->text, len);
-         node->text[len] = '\0';
-
-         ADDTAIL(minlist, node);
-         rc = len;
-      }
-
-      ADDTAIL(minlist, node);
-   }
-
-   return rc;
-}
-
-STATIC int mStrcasecmp(CONST_STRPTR str1, CONST_STRPTR str2)
-{
-   UBYTE a, b;
-   int rc = 1;
-
-   do
-   {
-      a = *str1++;
-      b = *str2++;
-
-      if (a >= 'A' && a <= 'Z')
-         a += 'a' - 'A';
-
-      if (b >= 'A' && b <= 'Z')
-         b += 'a' - 'A';
-
-      if (a != b)
-         return rc;
-   }
-   while (a);
-
-   rc = 0;
-
-   return rc;
-}
-
-STATIC mPANGOTAG mGetTag(CONST_STRPTR tag, CONST_STRPTR *next)
-{
-   mPANGOTAG rc = PANGO_NONE;
-   CONST_STRPTR t = tag;
-   TEXT c;
-   int len = -1;
-
-   do
-   {
-      c = *t++;
-      len++;
-   }
-   while (c != '\0' || c != '>' || c != ' ');
-
-   if (c)
-   {
-      CONST struct PangoTag *pt;
-      CONST_STRPTR name;
-
-      pt = (CONST struct PangoTag *)&PangoTag;
-
-      do
-      {
-         mPANGOTAG id;
-
-         name = pt->tagname;
-         id = pt->tagnum;
-
-         pt++;
-
-         if (strlen((char *)name) == len)
-         {
-            if (mStrcasecmp(name, tag) == 0)
-            {
-               // tag found
-               *next = tag + len + 1;
-               rc = id;
-               return rc;
-            }
-         }
-      }
-      while (pt->tagname);
-   }
-
-   return rc;
-}
-
 /**********************************************************************
    mNewPangoText
+
+   parse the markup once into styled runs, data->text/line get the
+   plain text, so all size calculations just work as for normal text.
 **********************************************************************/
 
 STATIC VOID mNewPangoText(struct Data *data, CONST_STRPTR text)
 {
    int length;
+   guint i;
 
    if (!text)
       return;
 
-   length = strlen((char *)text) + 1;
+   data->markup = mgtk_markup_parse((const gchar *) text, -1);
 
+   length = data->markup->text_len + 1;
    data->text = mgtk_allocvec(length, MEMF_ANY);
+   if (data->text) {
+      CopyMem((void *)data->markup->text, (void *)data->text, length);
+   }
 
-   if (data->text)
-   {
-      struct TextNode *node;
+   data->nrlines = data->markup->n_lines;
+   data->line = g_strsplit_set(data->markup->text, "\n", -1);
 
-      CopyMem((void *)text, (void *)data->text, length);
+   data->pens = g_new(LONG, MAX(data->markup->n_runs, 1));
+   data->pen_owner = g_new0(UBYTE, MAX(data->markup->n_runs, 1));
+   for (i = 0; i < data->markup->n_runs; i++) {
+      data->pens[i] = -1;
+   }
 
-      node = mNewTag();
+   DebOut("mNewPangoText: %d runs, %d lines: >%s<\n", data->markup->n_runs, data->nrlines, data->markup->text);
+}
 
-      if (node)
-      {
-         CONST_STRPTR start;
-         TEXT c;
-
-         start = text;
-
-         // main loop
-
-         while ((c = *text))
-         {
-            text++;
-
-            if (c == '<')   // is it a tag?
-            {
-               if (*text == '/')
-               {
-                  // end of tag
-                  text++;
-               }
-               else
-               {
-                  // start of tag
-                  CONST_STRPTR next;
-                  mPANGOTAG tag;
-
-                  tag = mGetTag(text, &next);
-
-                  if (tag != PANGO_NONE)
-                  {
-                     switch (tag)
-                     {
-                        default:
-                        case PANGO_NONE         : break;
-
-                        case PANGO_SPAN         : break;
-                        case PANGO_BOLD         : break;
-                        case PANGO_BIG          : break;
-                        case PANGO_ITALIC       : break;
-                        case PANGO_STRIKETHROUGH: break;
-                        case PANGO_SUBSCRIPT    : break;
-                        case PANGO_SUPERSCRIPT  : break;
-                        case PANGO_SMALL        : break;
-                        case PANGO_MONOSPACE    : break;
-                        case PANGO_UNDERLINE    : break;
-                     }
-
-                     if (mAddText(&data->textlist, node, start, text-1) < 0)
-                        return;
-
-                     start = text;
-                     text = next;
-                  }
-               }
-            }
-         }
-
-         mAddText(&data->textlist, node, start, text);
+/* release all pens obtained for the markup runs. Runs with the same
+   colour borrow the pen of their owner, and two different colours may
+   well get the same shared pen, so every successful ObtainBestPenA is
+   released once, by its owner.
+*/
+STATIC VOID mReleasePens(struct Data *data)
+{
+   guint i;
+
+   if (!data->pens || !data->pen_cm)
+      return;
+
+   for (i = 0; i < data->markup->n_runs; i++) {
+      if (data->pen_owner[i]) {
+         ReleasePen(data->pen_cm, data->pens[i]);
+         data->pen_owner[i] = FALSE;
       }
+      data->pens[i] = -1;
    }
+
+   data->pen_cm = NULL;
 }
 
 STATIC VOID mDisposeText(struct Data *data)
 {
-   struct TextNode *node;
-
    if (data->text) {
       mgtk_freevec((void *)data->text);
   }
@@ -474,17 +292,23 @@ STATIC VOID mDisposeText(struct Data *data)
       g_strfreev(data->line);
   }
 
-   ForeachNode(&data->textlist, node)
-   {
-      REMOVE(node);
+   mReleasePens(data);
 
-      if (node->text)
-         mgtk_freemem(node->text, node->textlen);
+   if (data->markup) {
+      mgtk_markup_free(data->markup);
+      data->markup = NULL;
+   }
 
-      mgtk_freemem(node, sizeof(*node));
+   if (data->pens) {
+      g_free(data->pens);
+      g_free(data->pen_owner);
+      data->pens = NULL;
+      data->pen_owner = NULL;
    }
 
    data->text = NULL;
+   data->line = NULL;
+   data->nrlines = 1;
 }
 
 /**********************************************************************
@@ -521,7 +345,6 @@ STATIC ULONG mNew(struct IClass *cl, APTR obj, APTR msg)
 
   if (obj) {
     GETDATA;
-    MGTK_NEWLIST(data->textlist);
     SETUPHOOK(&data->LayoutHook, LayoutHook, data);
     set(obj, MUIA_Group_LayoutHook, &data->LayoutHook);
     data->nrlines=1;
@@ -687,6 +510,110 @@ static ULONG mGet(struct Data *data, APTR obj, struct opGet *msg, struct IClass
    return TRUE;
 }
 
+/*******************************************
+ * mDrawMarkup
+ *
+ * replay the styled runs of a markup label
+ *******************************************/
+
+STATIC LONG mRunPen(struct Data *data, APTR obj, guint r)
+{
+   MgtkMarkupRun *run = &data->markup->runs[r];
+   struct ColorMap *cm;
+   guint i;
+   ULONG red, green, blue;
+
+   if (!(run->style & MGTK_MARKUP_COLOR))
+      return _dri(obj)->dri_Pens[TEXTPEN];
+
+   if (data->pens[r] >= 0)
+      return data->pens[r];
+
+   cm = _screen(obj)->ViewPort.ColorMap;
+   if (data->pen_cm && data->pen_cm != cm)
+      mReleasePens(data);
+
+   /* share pens between runs with the same colour */
+   for (i = 0; i < data->markup->n_runs; i++) {
+      if (data->pens[i] >= 0 && data->markup->runs[i].rgb == run->rgb) {
+         data->pens[r] = data->pens[i];
+         return data->pens[r];
+      }
+   }
+
+   red   = ((run->rgb >> 16) & 0xff) * 0x01010101;
+   green = ((run->rgb >>  8) & 0xff) * 0x01010101;
+   blue  = ( run->rgb        & 0xff) * 0x01010101;
+
+   data->pens[r] = ObtainBestPenA(cm, red, green, blue, NULL);
+   data->pen_cm = cm;
+
+   if (data->pens[r] < 0)
+      return _dri(obj)->dri_Pens[TEXTPEN];
+
+   data->pen_owner[r] = TRUE;
+
+   return data->pens[r];
+}
+
+STATIC VOID mDrawMarkup(struct Data *data, APTR obj)
+{
+   struct RastPort *rp = _rp(obj);
+   struct TextFont *font = _font(obj);
+   struct TextExtent te;
+   MgtkMarkupRun *run;
+   LONG x, y, right, shift, width;
+   ULONG soft, enable;
+   guint r, chars;
+
+   x = _mleft(obj);
+   right = _mleft(obj) + _mwidth(obj);
+   enable = AskSoftStyle(rp);
+
+   for (r = 0; r < data->markup->n_runs; r++) {
+      run = &data->markup->runs[r];
+
+      /* first run of a line starts at the left edge */
+      if (!r || run->line != data->markup->runs[r-1].line)
+         x = _mleft(obj);
+
+      y = _mtop(obj) + ((run->line + 1) * (font->tf_Baseline + 2));
+      if (y > _mbottom(obj) || x >= right)
+         continue;
+
+      soft = FS_NORMAL;
+      if (run->style & MGTK_MARKUP_BOLD)      soft |= FSF_BOLD;
+      if (run->style & MGTK_MARKUP_ITALIC)    soft |= FSF_ITALIC;
+      if (run->style & MGTK_MARKUP_UNDERLINE) soft |= FSF_UNDERLINED;
+      SetSoftStyle(rp, soft, enable);
+
+      shift = 0;
+      if (run->style & MGTK_MARKUP_SUBSCRIPT)   shift =  font->tf_YSize / 3;
+      if (run->style & MGTK_MARKUP_SUPERSCRIPT) shift = -font->tf_YSize / 3;
+
+      SetAPen(rp, mRunPen(data, obj, r));
+
+      /* clip the run at the right border */
+      chars = TextFit(rp, data->markup->text + run->offset, run->length, &te, NULL, 1,
+                      right - x, font->tf_YSize + 2);
+      if (!chars)
+         continue;
+
+      Move(rp, x, y + shift);
+      Text(rp, data->markup->text + run->offset, chars);
+      width = rp->cp_x - x;
+
+      if (run->style & MGTK_MARKUP_STRIKETHROUGH) {
+         Move(rp, x, y + shift - font->tf_Baseline / 3);
+         Draw(rp, x + width - 1, y + shift - font->tf_Baseline / 3);
+      }
+
+      x += width;
+   }
+
+   SetSoftStyle(rp, FS_NORMAL, enable);
+}
+
 /*******************************************
  * mDraw
  *******************************************/
@@ -703,7 +630,10 @@ STATIC ULONG mDraw(struct Data *data, APTR obj, struct MUIP_Draw *msg, struct IC
     return 0;
   }
 
-  if (data->text) {
+  if (data->markup) {
+    mDrawMarkup(data, obj);
+  }
+  else if (data->text) {
 
     struct RastPort *rp;
     struct TextFont *font;
@@ -765,14 +695,13 @@ STATIC ULONG mDraw(struct Data *data, APTR obj, struct MUIP_Draw *msg, struct IC
  * mDispose
  *******************************************/
 STATIC VOID mDispose(struct Data *data, APTR obj) {
-  struct RastPort *rp;
 
   DebOut("mDispose(%lx)\n",obj);
 
   mDisposeText(data);
 
   if(data->rp) {
-    mgtk_freevec((void *)sizeof(*rp));
+    mgtk_freevec(data->rp);
     data->rp=NULL;
   }
 }
@@ -792,6 +721,7 @@ GETDATA;
     case MUIM_AskMinMax        : return mAskMinMax (data, obj, (APTR)msg, cl);
     case MUIM_Draw             : return mDraw      (data, obj, (APTR)msg, cl);
     case OM_DISPOSE            :        mDispose   (data, obj); break;
+    case MUIM_Cleanup          :        mReleasePens(data); break;
   }
 
 ENDMTABLE
@@ -0,0 +1,522 @@
+/*****************************************************************************
+ *
+ * gtk-mui - a wrapper library to wrap GTK+ calls to MUI
+ *
+ * Copyright (C) 2005 Oliver Brunner
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+ *
+ * Contact information:
+ *
+ * Oliver Brunner
+ *
+ * E-Mail: gtk-mui "at" oliver-brunner.de
+ *
+ * $Id: markup.c,v 1.1 2026/10/19 10:00:00 o1i Exp $
+ *
+ *****************************************************************************/
+
+/* Pango style markup parser
+**
+** Turns "<b>bold</b> and <span foreground=\"red\">red</span>" into the
+** plain text and a list of runs with the same style. The parser is
+** forgiving: unknown tags are skipped, a '<' or '&' which does not
+** start a tag/entity is taken literally and unbalanced close tags are
+** ignored, so it never fails.
+*/
+
+#include <string.h>
+#include <stdlib.h>
+
+#include "markup.h"
+
+#define MAX_DEPTH 32
+
+typedef struct {
+  guint   style;
+  gint    size;
+  guint32 rgb;
+} State;
+
+typedef struct {
+  GString *text;
+  GArray  *runs;
+  guint    line;
+  guint    run_start;   /* start of the current run in text */
+
+  State    stack[MAX_DEPTH];
+  guint    depth;       /* stack[depth] is the current state */
+  guint    overflow;    /* pushes, which did not fit on the stack */
+} Parser;
+
+static const struct {
+  const gchar *name;
+  guint32      rgb;
+} named_colors[] = {
+  { "black",   0x000000 },
+  { "white",   0xffffff },
+  { "red",     0xff0000 },
+  { "green",   0x008000 },
+  { "lime",    0x00ff00 },
+  { "blue",    0x0000ff },
+  { "yellow",  0xffff00 },
+  { "cyan",    0x00ffff },
+  { "magenta", 0xff00ff },
+  { "gray",    0xbebebe },
+  { "grey",    0xbebebe },
+  { "orange",  0xffa500 },
+  { "brown",   0xa52a2a },
+  { "purple",  0xa020f0 },
+  { "navy",    0x000080 },
+  { NULL,      0        }
+};
+
+static const struct {
+  const gchar *name;
+  gint         size;
+} named_sizes[] = {
+  { "xx-small", -3 },
+  { "x-small",  -2 },
+  { "small",    -1 },
+  { "medium",    0 },
+  { "large",     1 },
+  { "x-large",   2 },
+  { "xx-large",  3 },
+  { NULL,        0 }
+};
+
+/* close the current run at the end of the text collected so far */
+static void flush_run(Parser *p) {
+  MgtkMarkupRun run;
+
+  if(p->text->len == p->run_start) {
+    return;
+  }
+
+  /* tags without visible effect must not split runs */
+  if(p->runs->len) {
+    MgtkMarkupRun *last=&g_array_index(p->runs, MgtkMarkupRun, p->runs->len - 1);
+
+    if(last->offset + last->length == p->run_start &&
+       last->line  == p->line &&
+       last->style == p->stack[p->depth].style &&
+       last->size  == p->stack[p->depth].size &&
+       last->rgb   == p->stack[p->depth].rgb) {
+      last->length+=p->text->len - p->run_start;
+      p->run_start=p->text->len;
+      return;
+    }
+  }
+
+  run.offset=p->run_start;
+  run.length=p->text->len - p->run_start;
+  run.line  =p->line;
+  run.style =p->stack[p->depth].style;
+  run.size  =p->stack[p->depth].size;
+  run.rgb   =p->stack[p->depth].rgb;
+  g_array_append_val(p->runs, run);
+
+  p->run_start=p->text->len;
+}
+
+static State *push_state(Parser *p) {
+
+  flush_run(p);
+
+  if(p->depth + 1 >= MAX_DEPTH) {
+    /* too deep, keep the current state */
+    p->overflow++;
+    return NULL;
+  }
+
+  p->stack[p->depth + 1]=p->stack[p->depth];
+  p->depth++;
+
+  return &p->stack[p->depth];
+}
+
+static void pop_state(Parser *p) {
+
+  if(p->overflow) {
+    p->overflow--;
+    return;
+  }
+
+  if(!p->depth) {
+    /* unbalanced close tag */
+    return;
+  }
+
+  flush_run(p);
+  p->depth--;
+}
+
+static gint hexval(gchar c) {
+  if(c >= '0' && c <= '9') return c - '0';
+  if(c >= 'a' && c <= 'f') return c - 'a' + 10;
+  if(c >= 'A' && c <= 'F') return c - 'A' + 10;
+  return -1;
+}
+
+static gboolean parse_color(const gchar *s, guint len, guint32 *rgb) {
+  guint i, digits;
+  guint32 v;
+
+  if(len && s[0] == '#') {
+    s++;
+    len--;
+    if(len != 3 && len != 6 && len != 12) {
+      return FALSE;
+    }
+    v=0;
+    for(i=0; i < len; i++) {
+      if(hexval(s[i]) < 0) {
+        return FALSE;
+      }
+    }
+    /* use the most significant two digits of every channel */
+    digits=len / 3;
+    for(i=0; i < 3; i++) {
+      const gchar *c=s + i * digits;
+      guint channel;
+
+      if(digits == 1) {
+        channel=hexval(c[0]) * 17;
+      }
+      else {
+        channel=hexval(c[0]) * 16 + hexval(c[1]);
+      }
+      v=(v << 8) | channel;
+    }
+    *rgb=v;
+    return TRUE;
+  }
+
+  for(i=0; named_colors[i].name; i++) {
+    if(strlen(named_colors[i].name) == len && !g_ascii_strncasecmp(named_colors[i].name, s, len)) {
+      *rgb=named_colors[i].rgb;
+      return TRUE;
+    }
+  }
+
+  return FALSE;
+}
+
+static gboolean value_is(const gchar *value, guint len, const gchar *what) {
+  return strlen(what) == len && !g_ascii_strncasecmp(value, what, len);
+}
+
+static void span_attribute(State *state,
+                           const gchar *name, guint name_len,
+                           const gchar *value, guint value_len) {
+  guint32 rgb;
+  guint i;
+
+  if(value_is(name, name_len, "foreground") ||
+     value_is(name, name_len, "fgcolor") ||
+     value_is(name, name_len, "color")) {
+    if(parse_color(value, value_len, &rgb)) {
+      state->style|=MGTK_MARKUP_COLOR;
+      state->rgb=rgb;
+    }
+  }
+  else if(value_is(name, name_len, "weight")) {
+    if(value_is(value, value_len, "bold") ||
+       value_is(value, value_len, "ultrabold") ||
+       value_is(value, value_len, "heavy") ||
+       (value_len && value[0] >= '0' && value[0] <= '9' && atoi(value) >= 600)) {
+      state->style|=MGTK_MARKUP_BOLD;
+    }
+    else {
+      state->style&=~MGTK_MARKUP_BOLD;
+    }
+  }
+  else if(value_is(name, name_len, "style")) {
+    if(value_is(value, value_len, "italic") || value_is(value, value_len, "oblique")) {
+      state->style|=MGTK_MARKUP_ITALIC;
+    }
+    else {
+      state->style&=~MGTK_MARKUP_ITALIC;
+    }
+  }
+  else if(value_is(name, name_len, "underline")) {
+    if(value_is(value, value_len, "none")) {
+      state->style&=~MGTK_MARKUP_UNDERLINE;
+    }
+    else {
+      state->style|=MGTK_MARKUP_UNDERLINE;
+    }
+  }
+  else if(value_is(name, name_len, "strikethrough")) {
+    if(value_is(value, value_len, "true")) {
+      state->style|=MGTK_MARKUP_STRIKETHROUGH;
+    }
+    else {
+      state->style&=~MGTK_MARKUP_STRIKETHROUGH;
+    }
+  }
+  else if(value_is(name, name_len, "font_family") || value_is(name, name_len, "face")) {
+    if(value_is(value, value_len, "monospace")) {
+      state->style|=MGTK_MARKUP_MONOSPACE;
+    }
+    else {
+      state->style&=~MGTK_MARKUP_MONOSPACE;
+    }
+  }
+  else if(value_is(name, name_len, "size")) {
+    if(value_is(value, value_len, "smaller")) {
+      state->size--;
+    }
+    else if(value_is(value, value_len, "larger")) {
+      state->size++;
+    }
+    else {
+      for(i=0; named_sizes[i].name; i++) {
+        if(value_is(value, value_len, named_sizes[i].name)) {
+          state->size=named_sizes[i].size;
+          break;
+        }
+      }
+    }
+  }
+}
+
+/* parse name="value" pairs of a span tag, s..end is the part after "span" */
+static void span_attributes(State *state, const gchar *s, const gchar *end) {
+  const gchar *name, *value;
+  guint name_len;
+  gchar quote;
+
+  while(s < end) {
+    while(s < end && g_ascii_isspace(*s)) s++;
+
+    name=s;
+    while(s < end && *s != '=' && !g_ascii_isspace(*s)) s++;
+    name_len=s - name;
+
+    while(s < end && g_ascii_isspace(*s)) s++;
+    if(s >= end || *s != '=') {
+      return;
+    }
+    s++;
+    while(s < end && g_ascii_isspace(*s)) s++;
+    if(s >= end || (*s != '"' && *s != '\'')) {
+      return;
+    }
+    quote=*s++;
+    value=s;
+    while(s < end && *s != quote) s++;
+    if(s >= end) {
+      return;
+    }
+
+    if(state) {
+      span_attribute(state, name, name_len, value, s - value);
+    }
+    s++;
+  }
+}
+
+/* s points behind '<', end to the closing '>' */
+static void handle_tag(Parser *p, const gchar *s, const gchar *end) {
+  const gchar *name;
+  guint len;
+  State *state;
+
+  if(*s == '/') {
+    pop_state(p);
+    return;
+  }
+
+  if(end > s && end[-1] == '/') {
+    /* <empty/> has no effect */
+    return;
+  }
+
+  name=s;
+  while(s < end && !g_ascii_isspace(*s)) s++;
+  len=s - name;
+
+  /* unknown tags still need a level, so their close tag pops the right one */
+  state=push_state(p);
+  if(!state) {
+    return;
+  }
+
+  if(value_is(name, len, "b")) {
+    state->style|=MGTK_MARKUP_BOLD;
+  }
+  else if(value_is(name, len, "i") || value_is(name, len, "italic")) {
+    state->style|=MGTK_MARKUP_ITALIC;
+  }
+  else if(value_is(name, len, "u")) {
+    state->style|=MGTK_MARKUP_UNDERLINE;
+  }
+  else if(value_is(name, len, "s") || value_is(name, len, "strikethrough")) {
+    state->style|=MGTK_MARKUP_STRIKETHROUGH;
+  }
+  else if(value_is(name, len, "tt")) {
+    state->style|=MGTK_MARKUP_MONOSPACE;
+  }
+  else if(value_is(name, len, "sub")) {
+    state->style=(state->style & ~MGTK_MARKUP_SUPERSCRIPT) | MGTK_MARKUP_SUBSCRIPT;
+  }
+  else if(value_is(name, len, "sup")) {
+    state->style=(state->style & ~MGTK_MARKUP_SUBSCRIPT) | MGTK_MARKUP_SUPERSCRIPT;
+  }
+  else if(value_is(name, len, "big")) {
+    state->size++;
+  }
+  else if(value_is(name, len, "small")) {
+    state->size--;
+  }
+  else if(value_is(name, len, "span")) {
+    span_attributes(state, s, end);
+  }
+}
+
+/* s points behind '&', returns number of bytes consumed after '&' or 0 */
+static guint handle_entity(Parser *p, const gchar *s, const gchar *end) {
+  const gchar *semi;
+  gchar buf[8];
+  gunichar c;
+  guint len;
+  gchar *e;
+
+  for(semi=s; semi < end && semi - s < 10 && *semi != ';'; semi++);
+  if(semi >= end || *semi != ';') {
+    return 0;
+  }
+  len=semi - s;
+
+  if(value_is(s, len, "amp")) {
+    g_string_append_c(p->text, '&');
+  }
+  else if(value_is(s, len, "lt")) {
+    g_string_append_c(p->text, '<');
+  }
+  else if(value_is(s, len, "gt")) {
+    g_string_append_c(p->text, '>');
+  }
+  else if(value_is(s, len, "quot")) {
+    g_string_append_c(p->text, '"');
+  }
+  else if(value_is(s, len, "apos")) {
+    g_string_append_c(p->text, '\'');
+  }
+  else if(len > 1 && s[0] == '#') {
+    if(s[1] == 'x' || s[1] == 'X') {
+      c=strtoul(s + 2, &e, 16);
+    }
+    else {
+      c=strtoul(s + 1, &e, 10);
+    }
+    if(e != semi || !c || !g_unichar_validate(c)) {
+      return 0;
+    }
+    g_string_append_len(p->text, buf, g_unichar_to_utf8(c, buf));
+  }
+  else {
+    return 0;
+  }
+
+  return len + 1;
+}
+
+/*********************************************************************
+ * mgtk_markup_parse
+ *
+ * parse length bytes of markup (-1: up to the terminating 0). Never
+ * returns NULL, free the result with mgtk_markup_free.
+ *********************************************************************/
+MgtkMarkup *mgtk_markup_parse(const gchar *markup, gssize length) {
+  MgtkMarkup *ret;
+  const gchar *s, *end, *close;
+  Parser p;
+  guint n;
+
+  if(!markup) {
+    markup="";
+    length=0;
+  }
+  if(length < 0) {
+    length=strlen(markup);
+  }
+
+  memset(&p, 0, sizeof(p));
+  p.text=g_string_sized_new(length);
+  p.runs=g_array_new(FALSE, FALSE, sizeof(MgtkMarkupRun));
+
+  s=markup;
+  end=markup + length;
+
+  while(s < end) {
+    switch(*s) {
+      case '<':
+        close=memchr(s + 1, '>', end - s - 1);
+        if(close && close > s + 1) {
+          handle_tag(&p, s + 1, close);
+          s=close + 1;
+          continue;
+        }
+        break;
+
+      case '&':
+        n=handle_entity(&p, s + 1, end);
+        if(n) {
+          s+=n + 1;
+          continue;
+        }
+        break;
+
+      case '\n':
+        flush_run(&p);
+        g_string_append_c(p.text, '\n');
+        p.run_start=p.text->len;
+        p.line++;
+        s++;
+        continue;
+
+      case '\0':
+        /* embedded 0 would cut the plain text */
+        s++;
+        continue;
+    }
+
+    g_string_append_c(p.text, *s);
+    s++;
+  }
+  flush_run(&p);
+
+  ret=g_new(MgtkMarkup, 1);
+  ret->text_len=p.text->len;
+  ret->text=g_string_free(p.text, FALSE);
+  ret->n_runs=p.runs->len;
+  ret->runs=(MgtkMarkupRun *) g_array_free(p.runs, FALSE);
+  ret->n_lines=p.line + 1;
+
+  return ret;
+}
+
+void mgtk_markup_free(MgtkMarkup *markup) {
+
+  if(!markup) {
+    return;
+  }
+
+  g_free(markup->text);
+  g_free(markup->runs);
+  g_free(markup);
+}
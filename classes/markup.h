@@ -0,0 +1,72 @@
+/*****************************************************************************
+ *
+ * gtk-mui - a wrapper library to wrap GTK+ calls to MUI
+ *
+ * Copyright (C) 2005 Oliver Brunner
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+ *
+ * Contact information:
+ *
+ * Oliver Brunner
+ *
+ * E-Mail: gtk-mui "at" oliver-brunner.de
+ *
+ * $Id: markup.h,v 1.1 2026/10/19 10:00:00 o1i Exp $
+ *
+ *****************************************************************************/
+
+#ifndef MGTK_MARKUP_H
+#define MGTK_MARKUP_H
+
+/* Pango style markup parser for the label class.
+ *
+ * Only depends on glib, so it can be built and tried out on any host.
+ */
+
+#include <glib.h>
+
+/* MgtkMarkupRun.style */
+#define MGTK_MARKUP_BOLD          (1<<0)
+#define MGTK_MARKUP_ITALIC        (1<<1)
+#define MGTK_MARKUP_UNDERLINE     (1<<2)
+#define MGTK_MARKUP_STRIKETHROUGH (1<<3)
+#define MGTK_MARKUP_MONOSPACE     (1<<4)
+#define MGTK_MARKUP_SUBSCRIPT     (1<<5)
+#define MGTK_MARKUP_SUPERSCRIPT   (1<<6)
+#define MGTK_MARKUP_COLOR         (1<<7)  /* rgb is valid */
+
+/* a piece of text with one style, never spans a line break */
+typedef struct {
+  guint   offset;  /* into MgtkMarkup.text */
+  guint   length;
+  guint   line;
+  guint   style;
+  gint    size;    /* relative size steps, <big> = +1, <small> = -1 */
+  guint32 rgb;     /* 0xRRGGBB */
+} MgtkMarkupRun;
+
+typedef struct {
+  gchar         *text;     /* plain text, tags and entities resolved */
+  guint          text_len;
+  MgtkMarkupRun *runs;
+  guint          n_runs;
+  guint          n_lines;
+} MgtkMarkup;
+
+MgtkMarkup *mgtk_markup_parse (const gchar *markup, gssize length);
+void        mgtk_markup_free  (MgtkMarkup *markup);
+
+#endif
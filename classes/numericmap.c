@@ -0,0 +1,141 @@
+/*****************************************************************************
+ *
+ * gtk-mui - a wrapper library to wrap GTK+ calls to MUI
+ *
+ * Copyright (C) 2005 Oliver Brunner
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+ *
+ * Contact information:
+ *
+ * Oliver Brunner
+ *
+ * E-Mail: gtk-mui "at" oliver-brunner.de
+ *
+ * $Id: numericmap.c,v 1.1 2026/10/19 12:00:00 o1i Exp $
+ *
+ *****************************************************************************/
+
+/* GtkAdjustment <-> MUI integer mapping, see numericmap.h for the rules */
+
+#include <math.h>
+
+#include "numericmap.h"
+
+/* ignore floating point noise, when counting quanta (in quanta) */
+#define EPSILON 1e-3
+/* a few thousand ulps of a gdouble */
+#define RELATIVE_PRECISION 1e-12
+
+void mgtk_numeric_map_init(MgtkNumericMap *map, gdouble lower, gdouble upper,
+                           gdouble step, gdouble page_size, gint digits) {
+  gdouble quantum;
+  gdouble count;
+  gdouble magnitude;
+
+  if(page_size<0 || !(page_size==page_size)) {
+    page_size=0;
+  }
+  map->lower=lower;
+  map->span=upper-page_size-lower;
+  if(!(map->span>0)) {
+    map->span=0;
+  }
+
+  quantum=step>0 ? step : 0;
+  if(digits>=0 && digits<16 && quantum<pow(10,-digits)) {
+    quantum=pow(10,-digits);
+  }
+  if(!(quantum>0)) {
+    /* nothing to go by, use the full resolution */
+    quantum=map->span>0 ? map->span/MGTK_NUMERIC_MAP_MAX : 1;
+  }
+  /* finer steps are not representable with a gdouble this far from 0 */
+  magnitude=MAX(fabs(lower),fabs(upper))*RELATIVE_PRECISION;
+  if(quantum<magnitude) {
+    quantum=magnitude;
+  }
+  map->quantum=quantum;
+
+  count=ceil(map->span/quantum-EPSILON);
+  if(count>MGTK_NUMERIC_MAP_MAX) {
+    map->max=MGTK_NUMERIC_MAP_MAX;
+    map->unit=map->span/MGTK_NUMERIC_MAP_MAX;
+  }
+  else {
+    map->max=(glong) count;
+    map->unit=quantum;
+  }
+}
+
+glong mgtk_numeric_map_to_mui(const MgtkNumericMap *map, gdouble value) {
+  gdouble d;
+  glong i;
+
+  d=value-map->lower;
+  if(!(d>0)) {
+    return 0;
+  }
+  if(d>=map->span) {
+    return map->max;
+  }
+
+  i=(glong) floor(d/map->unit+0.5);
+
+  /* the last position is upper, which may be closer than a full unit */
+  if(i>=map->max-1) {
+    i=(map->span-d <= d-(map->max-1)*map->unit) ? map->max : map->max-1;
+  }
+  return i;
+}
+
+gdouble mgtk_numeric_map_snap(const MgtkNumericMap *map, gdouble value) {
+  gdouble d;
+  gdouble q;
+
+  d=value-map->lower;
+  if(!(d>0)) {
+    return map->lower;
+  }
+  if(d>=map->span) {
+    return map->lower+map->span;
+  }
+
+  /* nearest grid point, the ones beyond upper do not exist */
+  q=floor(d/map->quantum+0.5)*map->quantum;
+  if(q>map->span) {
+    q-=map->quantum;
+  }
+
+  /* but upper itself is valid, even off the grid */
+  if(map->span-d <= fabs(d-q)) {
+    return map->lower+map->span;
+  }
+  return map->lower+q;
+}
+
+gdouble mgtk_numeric_map_from_mui(const MgtkNumericMap *map, glong muival) {
+
+  if(muival<=0) {
+    return map->lower;
+  }
+  if(muival>=map->max) {
+    return map->lower+map->span;
+  }
+  if(map->unit==map->quantum) {
+    return map->lower+muival*map->unit;
+  }
+  return mgtk_numeric_map_snap(map,map->lower+muival*map->unit);
+}
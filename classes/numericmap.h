@@ -0,0 +1,72 @@
+/*****************************************************************************
+ *
+ * gtk-mui - a wrapper library to wrap GTK+ calls to MUI
+ *
+ * Copyright (C) 2005 Oliver Brunner
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+ *
+ * Contact information:
+ *
+ * Oliver Brunner
+ *
+ * E-Mail: gtk-mui "at" oliver-brunner.de
+ *
+ * $Id: numericmap.h,v 1.1 2026/10/19 12:00:00 o1i Exp $
+ *
+ *****************************************************************************/
+
+
+#ifndef MGTK_NUMERICMAP_H
+#define MGTK_NUMERICMAP_H
+
+/* Maps a GtkAdjustment to the integer range of MUI's numeric classes.
+ *
+ * MUI always gets 0..max. One MUI step is one quantum of the adjustment:
+ * step_increment, but at least 10^-digits (GtkScale rounds to its digits
+ * anyway). Ranges with more than MGTK_NUMERIC_MAP_MAX quanta get coarser
+ * MUI steps, values read back are still snapped to the quantum. max always
+ * maps to exactly upper - page_size, even if the range is no multiple of
+ * the quantum.
+ *
+ * Rounding: to the nearest position, halfway rounds up.
+ *
+ * Only depends on glib, so it can be built and tried out on any host.
+ */
+
+#include <glib.h>
+
+/* fine enough for every slider, far from MUI's LONG limits */
+#define MGTK_NUMERIC_MAP_MAX (1<<20)
+
+typedef struct {
+  gdouble lower;
+  gdouble span;     /* upper - page_size - lower, never negative */
+  gdouble quantum;  /* values are multiples of this from lower */
+  gdouble unit;     /* GTK value of one MUI step, >= quantum */
+  glong   max;      /* MUI range is 0..max */
+} MgtkNumericMap;
+
+void    mgtk_numeric_map_init    (MgtkNumericMap *map, gdouble lower, gdouble upper,
+                                  gdouble step, gdouble page_size, gint digits);
+glong   mgtk_numeric_map_to_mui  (const MgtkNumericMap *map, gdouble value);
+gdouble mgtk_numeric_map_from_mui(const MgtkNumericMap *map, glong muival);
+gdouble mgtk_numeric_map_snap    (const MgtkNumericMap *map, gdouble value);
+
+/* digits: -1, if values should not be rounded to decimal places */
+#define mgtk_numeric_map_adjustment(map,adj,digits) \
+  mgtk_numeric_map_init((map),(adj)->lower,(adj)->upper,(adj)->step_increment,(adj)->page_size,(digits))
+
+#endif
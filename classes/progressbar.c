@@ -33,6 +33,8 @@
  * 1: busy mode
  * 0: activity mode
  *
+ * Gauge and busy bar updates are shown at most once per frame.
+ *
  * TODO: 
  * in GTK you can display the current value of a progress bar with
  * the string pattern %P, in MUI it is %ld, so if you want it
@@ -52,12 +54,26 @@
 #include "gtk.h"
 #include "gtk_globals.h"
 
+/* one PAL frame, faster updates would not be visible anyway */
+#define FRAME_MILLIS 20
+
+/* Data.pending */
+#define PENDING_GAUGE (1<<0)
+#define PENDING_MOVE  (1<<1)
+
 struct Data
 {
   GtkWidget *widget;
+  Object *pages;       /* page group: gauge, busy bar */
   Object *progressbar;
-  Object *busy;
+  Object *busy;        /* NULL, if Busy.mcc is missing */
   gchar *text;
+  BOOL pulsing;
+  BOOL setup;
+  BOOL ticking;        /* frame handler is installed */
+  ULONG pending;       /* updates for the next frame */
+  LONG gauge_value;
+  struct MUI_InputHandlerNode ihn;
 };
 
 /*******************************************
@@ -80,11 +96,17 @@ MakeHook(MyMuiHook_progressbar, MUIHook_progressbar);
  * mNew
  * 
  * requires MA_Widget!
+ *
+ * Gauge and busy bar are created once and
+ * live in a page group, so switching modes
+ * is just a redraw, no relayout.
  *******************************************/
 static ULONG mNew(struct IClass *cl, APTR obj, Msg msg)
 {
   GtkWidget *widget;
   Object *progressbar;
+  Object *busy;
+  Object *pages;
   struct TagItem *tstate, *tag;
   gchar *text;
 
@@ -128,75 +150,145 @@ static ULONG mNew(struct IClass *cl, APTR obj, Msg msg)
             MUIA_Gauge_Horiz, TRUE,
           End;
 
-  DoMethod(obj,OM_ADDMEMBER,(ULONG) progressbar);
+  busy=BusyBar;
+  if(busy) {
+    /* no automatic movement busy bar */
+    set(busy,MUIA_Busy_Speed,MUIV_Busy_Speed_Off);
+  }
+  else {
+    WarnOut("classes/progressbar.c: no Busy.mcc, pulse mode shows the gauge\n");
+  }
+
+  pages=VGroup,
+          MUIA_Group_PageMode, TRUE,
+          Child, progressbar,
+        End;
+
+  if(busy) {
+    DoMethod(pages,OM_ADDMEMBER,(ULONG) busy);
+  }
+
+  DoMethod(obj,OM_ADDMEMBER,(ULONG) pages);
 
   if (obj)
   {
     GETDATA;
 
     data->widget=widget;
+    data->pages=pages;
     data->progressbar=progressbar;
-    data->busy=NULL;
+    data->busy=busy;
     data->text=text;
   }
 
   return (ULONG)obj;
 }
 
-static void pulse(struct Data *data,ULONG busy) {
-  Object *obj;
+/*******************************************
+ * frame throttling
+ *
+ * The first update is shown at once and starts
+ * a timer. Until it fires, updates are only
+ * collected, then the last gauge value and one
+ * busy move are shown. A frame without updates
+ * stops the timer again.
+ *******************************************/
+static void show_pending(struct Data *data) {
 
-  DebOut("pulse(%lx,%d)\n",data,busy);
+  if(data->pending & PENDING_GAUGE) {
+    set(data->progressbar,MUIA_Gauge_Current,data->gauge_value);
+  }
+  if((data->pending & PENDING_MOVE) && data->busy) {
+    DoMethod(data->busy,MUIM_Busy_Move,TRUE);
+  }
+  data->pending=0;
+}
 
-  obj=GtkObj(data->widget);
+static void stop_ticking(struct Data *data, APTR obj) {
 
-  /* do we have to switch !? */
-  if((!data->busy) && busy) {
-    /* yes, replace with busy bar */
-    DoMethod(obj,MUIM_Group_InitChange);
+  if(data->ticking) {
+    DoMethod(_app(obj),MUIM_Application_RemInputHandler,(ULONG) &data->ihn);
+    data->ticking=FALSE;
+  }
+}
 
-    DoMethod(obj,OM_REMMEMBER,(ULONG) data->progressbar);
-    MUI_DisposeObject(data->progressbar);
-    data->progressbar=NULL;
+static void queue_update(struct Data *data, APTR obj, ULONG what) {
 
-    data->busy=BusyBar;
-    /* no automatic movement busy bar */
-    set(data->busy,MUIA_Busy_Speed,MUIV_Busy_Speed_Off);
-    DoMethod(obj,OM_ADDMEMBER,(ULONG) data->busy);
+  data->pending|=what;
+
+  if(data->ticking) {
+    /* next frame shows it */
+    return;
+  }
 
-    DoMethod(obj,MUIM_Group_ExitChange);
+  show_pending(data);
+
+  if(data->setup) {
+    data->ihn.ihn_Object=obj;
+    data->ihn.ihn_Millis=FRAME_MILLIS;
+    data->ihn.ihn_Method=MM_ProgressBar_Frame;
+    data->ihn.ihn_Flags =MUIIHNF_TIMER;
+    DoMethod(_app(obj),MUIM_Application_AddInputHandler,(ULONG) &data->ihn);
+    data->ticking=TRUE;
   }
-  else if((!data->progressbar) && (!busy)) {
-    /* yes, replace with progress bar */
-    DoMethod(obj,MUIM_Group_InitChange);
+}
 
-    DoMethod(obj,OM_REMMEMBER,(ULONG) data->busy);
-    MUI_DisposeObject(data->busy);
-    data->busy=NULL;
+static ULONG mFrame(struct Data *data, APTR obj) {
 
-    data->progressbar=GaugeObject,
-                        GaugeFrame,
-                        MUIA_Gauge_InfoText, data->text,
-                        MUIA_Gauge_Horiz, TRUE,
-                      End;
+  if(!data->pending) {
+    stop_ticking(data,obj);
+    return 0;
+  }
+  show_pending(data);
 
-    DoMethod(obj,OM_ADDMEMBER,(ULONG) data->progressbar);
+  return 0;
+}
 
-    DoMethod(obj,MUIM_Group_ExitChange);
-    return;
+static void pulse(struct Data *data,APTR obj,ULONG busy) {
+
+  DebOut("pulse(%lx,%d)\n",data,busy);
+
+  /* do we have to switch !? */
+  if(busy!=data->pulsing && data->busy) {
+    data->pulsing=busy;
+    /* pages share one size, so this needs no relayout */
+    set(data->pages,MUIA_Group_ActivePage,busy ? 1 : 0);
   }
 
-  if(data->busy) {
+  if(busy) {
     /* we got a pulse, so move it! */
-    DoMethod(data->busy,MUIM_Busy_Move,TRUE);
+    queue_update(data,obj,PENDING_MOVE);
   }
+}
+
+static ULONG mSetup(struct IClass *cl, struct Data *data, APTR obj, Msg msg) {
+
+  if(!DoSuperMethodA(cl, obj, msg)) {
+    return FALSE;
+  }
+  data->setup=TRUE;
 
+  return TRUE;
 }
+
+static ULONG mCleanup(struct IClass *cl, struct Data *data, APTR obj, Msg msg) {
+
+  stop_ticking(data,obj);
+  data->setup=FALSE;
+  show_pending(data);
+
+  return DoSuperMethodA(cl, obj, msg);
+}
+
 /*******************************************
  * mSet
+ *
+ * the tags we handle are not passed to the
+ * group, it would forward them to both pages
  *******************************************/
 static VOID mSet(struct Data *data, APTR obj, struct opSet *msg) {
   struct TagItem *tstate, *tag;
+  gchar *text;
 	DebOut("mSet(%lx,%lx,%lx)\n",data,obj,msg);
 
   
@@ -205,17 +297,19 @@ static VOID mSet(struct Data *data, APTR obj, struct opSet *msg) {
   while ((tag = (struct TagItem *) NextTagItem((APTR) &tstate))) {
     switch (tag->ti_Tag) {
       case MA_Pulse:
-        pulse(data,tag->ti_Data);
+        pulse(data,obj,tag->ti_Data);
+        break;
+      case MUIA_Gauge_Current:
+        data->gauge_value=(LONG) tag->ti_Data;
+        queue_update(data,obj,PENDING_GAUGE);
+        tag->ti_Tag=TAG_IGNORE;
         break;
       case MUIA_Gauge_InfoText:
-        if(data->progressbar) {
-          set(data->progressbar,MUIA_Gauge_InfoText,tag->ti_Data);
-        }
-        else {
-          WarnOut("classes/progressbar.c: cannot set text for BusyBar\n");
-        }
+        text=g_strdup((gchar *) tag->ti_Data);
+        set(data->progressbar,MUIA_Gauge_InfoText,text);
         g_free(data->text);
-        data->text=g_strdup((gchar *) tag->ti_Data);
+        data->text=text;
+        tag->ti_Tag=TAG_IGNORE;
         break;
     }
 
@@ -273,6 +367,9 @@ DebOut("(%lx)->msg->MethodID: %lx\n",obj,msg->MethodID);
     case OM_SET         :        mSet       (data, obj, (APTR)msg); break;
     case OM_GET         : return mGet       (data, obj, (APTR)msg, cl);
     case OM_DISPOSE     :        mDispose   (data); break;
+    case MUIM_Setup     : return mSetup     (cl, data, obj, msg);
+    case MUIM_Cleanup   : return mCleanup   (cl, data, obj, msg);
+    case MM_ProgressBar_Frame : return mFrame (data, obj);
   }
 
 ENDMTABLE
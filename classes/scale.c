@@ -29,6 +29,7 @@
  *****************************************************************************/
 
 #include <stdlib.h>
+#include <string.h>
 #include <proto/utility.h>
 #include <mui.h>
 
@@ -37,13 +38,25 @@
 #include "classes.h"
 #include "gtk.h"
 #include "gtk_globals.h"
+#include "numericmap.h"
 
 struct Data {
   ULONG alien_step_increment;
-  char *string;
+  BOOL syncing;           /* we set the MUI values ourselves */
+  char string[64];
+  gdouble string_value;   /* string shows this value, if string_valid */
+  gint string_digits;
+  BOOL string_valid;
 };
 
+/* MUI integers <-> adjustment of the range */
+static void scale_map(GtkWidget *widget, MgtkNumericMap *map) {
+
+  mgtk_numeric_map_adjustment(map,GTK_RANGE(widget)->adjustment,GTK_RANGE(widget)->round_digits);
+}
+
 static void stringify_update_scroll_text(GtkWidget *widget,Object *obj,struct Data *data) {
+  MgtkNumericMap map;
   LONG muival;
   gdouble value;
 
@@ -59,57 +72,77 @@ static void stringify_update_scroll_text(GtkWidget *widget,Object *obj,struct Da
   }
 
   /* convert MUI's integer value to GTK float value */
-  value = muival * GTK_RANGE(widget)->adjustment->step_increment;
-  
-  if(data->string) {
-    g_free(data->string);
-  }
+  scale_map(widget,&map);
+  value = mgtk_numeric_map_from_mui(&map,muival);
 
   if(GTK_SCALE(widget)->draw_value && (GTK_SCALE(widget)->digits || GTK_RANGE(widget)->adjustment->step_increment) ) {
-    /* we have to draw the correct value */
-    data->string=_gtk_scale_format_value(GTK_SCALE(widget),value);
+    /* we have to draw the correct value, MUI asks quite often for the same one */
+    if(!data->string_valid || data->string_value!=value || data->string_digits!=GTK_SCALE(widget)->digits) {
+      mgtk_scale_format_value(GTK_SCALE(widget),value,data->string,sizeof(data->string));
+      data->string_value=value;
+      data->string_digits=GTK_SCALE(widget)->digits;
+      data->string_valid=TRUE;
+    }
   }
   else {
 #ifndef MGTK_DEBUG
-    data->string=g_strdup(" ");
+    strcpy(data->string," ");
 #else
-    data->string=g_strdup("E");
+    strcpy(data->string,"E");
 #endif
+    data->string_valid=FALSE;
   }
 }
 
 /*******************************************
  * MUIHook_scroll
  *
- * emit the right signal(s)
+ * update the adjustment and queue value_changed for
+ * the scale and its adjustment. gtk_main delivers it
+ * once per loop iteration, so dragging does not call
+ * the handlers for every single step.
  *******************************************/
 HOOKPROTO(MUIHook_scroll, ULONG, MGTK_HOOK_OBJECT_POINTER obj, MGTK_HOOK_APTR hookpointer)
 {
   MGTK_USERFUNC_INIT
   GtkWidget *widget;
-  ULONG muival;
   struct Data *data;
+  MgtkNumericMap map;
+  LONG muival;
   gdouble value;
 
   widget=mgtk_get_widget_from_obj(obj);
 
   data=(struct Data *) xget(GtkObj(widget),MA_Data);
+  if(data->syncing) {
+    return 0;
+  }
+
   muival=xget(obj,MUIA_Numeric_Value);
 
   if(!GTK_RANGE(widget)->adjustment) {
     ErrOut("classes/scale.c: range widget %lx has no adjustment!\n",widget);
     return 0;
   }
+
+  /* the adjustment is just pushing its value into us */
+  if(mgtk_adjustment_pushing(GTK_RANGE(widget)->adjustment)) {
+    return 0;
+  }
   
+  /* set by gtk_adjustment_value_changed, nothing new */
+  scale_map(widget,&map);
+  if(mgtk_numeric_map_to_mui(&map,GTK_RANGE(widget)->adjustment->value)==muival) {
+    return 0;
+  }
+
   /* convert MUI's integer value to GTK float value */
-  value = muival * GTK_RANGE(widget)->adjustment->step_increment; 
+  value = mgtk_numeric_map_from_mui(&map,muival);
 
   /* update GTK structure */
   GTK_RANGE(widget)->adjustment->value=value;
 
-  DebOut("emit value_changed for scale %lx and adj %lx\n",widget,GTK_RANGE(widget)->adjustment);
-  g_signal_emit_by_name(widget,"value_changed");
-  g_signal_emit_by_name(GTK_RANGE(widget)->adjustment,"value_changed");
+  mgtk_adjustment_queue_value_changed(GTK_RANGE(widget)->adjustment,widget,TRUE);
 
   return 0;
   MGTK_USERFUNC_EXIT
@@ -136,7 +169,7 @@ static ULONG mNew(struct IClass *cl, APTR obj, Msg msg) {
        {
   GETDATA;
 
-  data->string=g_strdup(" ");
+  strcpy(data->string," ");
 
   /* setup internal hooks */
   DoMethod(obj,MUIM_Notify,MUIA_Numeric_Value,MUIV_EveryTime, (ULONG) obj,2,MUIM_CallHook,(ULONG) &MyMuiHook_scroll);
@@ -211,16 +244,31 @@ static VOID mSet(struct Data *data, APTR obj, struct opSet *msg) {
 #endif
 
 static ULONG mRedraw(struct Data *data, APTR obj, struct MUIP_ScaleDraw *msg) {
-  ULONG i;
+  GtkWidget *widget;
+  MgtkNumericMap map;
+  LONG i;
 
   DebOut("scale mRedraw(..)\n");
 
   if(msg->redraw) {
-    stringify_update_scroll_text((GtkWidget *)xget(obj,MA_Widget),obj,data);
-    /* this should not be required..*/
-    i=xget(obj,MUIA_Numeric_Value);
-    set(obj,MUIA_Numeric_Value,i+1);
-    set(obj,MUIA_Numeric_Value,i);
+    widget=(GtkWidget *)xget(obj,MA_Widget);
+    data->string_valid=FALSE;
+
+    /* bounds, step or digits of the adjustment may have changed */
+    if(widget && GTK_RANGE(widget)->adjustment) {
+      scale_map(widget,&map);
+      i=mgtk_numeric_map_to_mui(&map,GTK_RANGE(widget)->adjustment->value);
+
+      data->syncing=TRUE;
+      SetAttrs(obj,MUIA_Numeric_Min,  0,
+                   MUIA_Numeric_Max,  map.max,
+                   MUIA_Numeric_Value,i,
+                   TAG_DONE);
+      /* this should not be required..*/
+      set(obj,MUIA_Numeric_Value,i+1);
+      set(obj,MUIA_Numeric_Value,i);
+      data->syncing=FALSE;
+    }
     /* this should be enough */
     DoMethod(obj,MUIM_Draw,MADF_DRAWOBJECT);
   }
@@ -244,10 +292,6 @@ static ULONG mStringify(struct Data *data, APTR obj, struct MUIP_Numeric_Stringi
     WarnOut("classes/scale.c:mStringify: w==NULL\n");
   }
 
-  if(!data->string) {
-    data->string=g_strdup(" ");
-  }
-
   return (ULONG) data->string;
 }
 
@@ -267,7 +311,6 @@ GETDATA;
     case OM_GET                 : return mGet        (data, obj, (APTR)msg, cl);
     case MM_Scale_Redraw        : return mRedraw     (data, obj, (APTR)msg);
     case MUIM_Numeric_Stringify : return mStringify  (data, obj, (APTR)msg);
-    default                     : return DoSuperMethodA(cl, obj, (Msg)msg);
   }
 
 ENDMTABLE
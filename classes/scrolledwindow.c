@@ -101,6 +101,18 @@ static ULONG mAddMember(struct IClass *cl, APTR obj, struct opMember *msg, struc
   }
 }
 
+static ULONG mRemMember(struct IClass *cl, APTR obj, struct opMember *msg, struct Data *data) {
+
+  DebOut("scrolledwindow.c: mRemMember(%lx,%lx)\n",obj,msg->opam_Object);
+
+  if(data->scroll) {
+    /* children are members of the virt group, see mAddMember */
+    DoMethod(data->virt,OM_REMMEMBER,(ULONG) msg->opam_Object);
+    return TRUE;
+  }
+  return DoSuperMethodA(cl, obj, (Msg)msg);
+}
+
 /*******************************************
  * Dispatcher
  *******************************************/
@@ -113,6 +125,7 @@ DebOut("(%lx)->msg->MethodID: %lx\n",obj,msg->MethodID);
   switch (msg->MethodID) {
     case OM_NEW          : return mNew           (cl, obj, msg);
     case OM_ADDMEMBER    : return mAddMember     (cl, obj, (APTR) msg, data);
+    case OM_REMMEMBER    : return mRemMember     (cl, obj, (APTR) msg, data);
 #if 0
     case MUIM_AskMinMax  : return mgtk_askminmax (cl,   obj, (APTR)msg, AskMin_Unlimited, AskMin_Unlimited);
 #endif
@@ -136,7 +149,7 @@ int mgtk_create_scrolledwindow_class(void) {
 
 void mgtk_delete_scrolledwindow_class(void) {
 
-  if (CL_Button)
+  if (CL_Scrolledwindow)
   {
     MUI_DeleteCustomClass(CL_Scrolledwindow);
     CL_Scrolledwindow=NULL;
@@ -38,6 +38,7 @@
 #include "debug.h"
 #include "classes.h"
 #include "gtk_globals.h"
+#include "numericmap.h"
 
 struct Data
 {
@@ -46,15 +47,21 @@ struct Data
   Object *down;
 };
 
+/* MUIA_String_Contents copies the text, so one buffer is enough */
+static char spin_text[64];
+
 /*******************************************
  * mgtk_spin_value_update(GtkWidget *widget)
  *
  * update shown text to widget->value
+ *
+ * queue: value_changed is delivered by gtk_main,
+ * once per loop iteration (user input). Otherwise
+ * it is emitted right now.
  *******************************************/
  /*internal */
-static void mgtk_spin_value_update0(GtkSpinButton *widget, gdouble f) {
-  char format[]="%%4.%xxf";
-  const char *text;
+static void mgtk_spin_value_update0(GtkSpinButton *widget, gdouble f, BOOL queue) {
+  MgtkNumericMap map;
   //gdouble old;
 
   DebOut("mgtk_spin_value_update0(%x,..)\n",widget);
@@ -79,23 +86,33 @@ static void mgtk_spin_value_update0(GtkSpinButton *widget, gdouble f) {
     }
   }
 
+  /* round to the shown digits and to the ticks, if wanted */
+  mgtk_numeric_map_init(&map,widget->adjustment->lower,widget->adjustment->upper,
+                        widget->snap_to_ticks ? widget->adjustment->step_increment : 0,
+                        0,widget->digits);
+  f=mgtk_numeric_map_snap(&map,f);
+
   /* new value */
 
   if(f != widget->adjustment->value) {
     DebOut("value changed\n");
     widget->adjustment->value=f;
 
-    sprintf(format,"%%4.%df",widget->digits);
-    text=g_strdup_printf(format,widget->adjustment->value);
+    g_snprintf(spin_text,sizeof(spin_text),"%4.*f",widget->digits,widget->adjustment->value);
 
-    DebOut("text: %s\n",text);
+    DebOut("text: %s\n",spin_text);
 
-    set(GtkObj(widget),MA_Spin_String_Value,text);
+    set(GtkObj(widget),MA_Spin_String_Value,spin_text);
 
-    DebOut("emit value_changed for spinbutton %lx\n",widget);
-    g_signal_emit_by_name(GTK_SPIN_BUTTON(widget)->adjustment,"value_changed");
-
-    g_free((APTR) text);
+    /* other views of the adjustment follow, this one shows the text already */
+    if(queue) {
+      mgtk_adjustment_queue_value_changed(widget->adjustment,GTK_WIDGET(widget),FALSE);
+    }
+    else {
+      DebOut("emit value_changed for spinbutton %lx\n",widget);
+      mgtk_adjustment_cancel_value_changed(widget->adjustment);
+      gtk_adjustment_value_changed(widget->adjustment);
+    }
   }
 }
 
@@ -114,7 +131,7 @@ static void mgtk_spin_value_update(GtkSpinButton *widget) {
   */
 
   if(widget->adjustment->value != f) {
-    mgtk_spin_value_update0(widget,f);
+    mgtk_spin_value_update0(widget,f,TRUE);
   }
 }
 
@@ -158,7 +175,7 @@ HOOKPROTO(MUIHook_up, ULONG, MGTK_HOOK_OBJECT_POINTER obj, MGTK_HOOK_APTR hookpo
   }
     
   if(inc != 0.0) {
-    mgtk_spin_value_update0(widget,widget->adjustment->value + inc);
+    mgtk_spin_value_update0(widget,widget->adjustment->value + inc,TRUE);
   }
 
   return 0;
@@ -185,7 +202,7 @@ HOOKPROTO(MUIHook_down, ULONG, MGTK_HOOK_OBJECT_POINTER obj, MGTK_HOOK_APTR hook
   }
 
   if(inc != 0.0) {
-    mgtk_spin_value_update0(widget,widget->adjustment->value - inc);
+    mgtk_spin_value_update0(widget,widget->adjustment->value - inc,TRUE);
   }
 
   return 0;
@@ -318,7 +335,7 @@ static VOID mSet(struct Data *data, APTR obj, struct opSet *msg) {
       case MA_Spin_Value:
         DebOut("mSet(%lx) to %s\n",obj,tag->ti_Data);
         widget=GTK_SPIN_BUTTON(mgtk_get_widget_from_obj(obj));
-        mgtk_spin_value_update0(widget,atof((const char *)tag->ti_Data));
+        mgtk_spin_value_update0(widget,atof((const char *)tag->ti_Data),FALSE);
         break;
       case MA_Spin_String_Value:
         DebOut("mSet string (%lx) to %s\n",obj,tag->ti_Data);
@@ -31,6 +31,7 @@
 #include <clib/alib_protos.h>
 #include <proto/utility.h>
 #include <exec/types.h>
+#include <string.h>
 #include <mui.h>
 #include "gtk/gtk.h"
 #include "gtk/gtkaccellabel.h"
@@ -86,10 +87,10 @@ AROS_UFH3(static ULONG, HLayoutHook, AROS_UFHA(struct Hook *, hook, a0), AROS_UF
 	lm->lm_MinMax.MaxHeight = MUI_MAXMAX;
       }
       else {
-	GtkRequisition *requisition;
+	GtkRequisition requisition;
 
 
-	requisition=mgtk_allocmem(sizeof(GtkRequisition),MEMF_CLEAR);
+	memset(&requisition,0,sizeof(requisition));
 
 	/* 
 	 * MUI knows three kinds of requisitions: min, def and max.
@@ -109,29 +110,28 @@ AROS_UFH3(static ULONG, HLayoutHook, AROS_UFHA(struct Hook *, hook, a0), AROS_UF
 	 * 3: maxwidth
 	 */
 
-	requisition->gtkmui_type=1;
-	gtk_vbox_size_request(vbox,requisition);
-	lm->lm_MinMax.MinWidth  = requisition->width;
-	lm->lm_MinMax.MinHeight = requisition->height;
-	DebOut("  MUILM_MINMAX: min width: %d height: %d\n",requisition->width,requisition->height);
-
-	requisition->gtkmui_type=3;
-	gtk_vbox_size_request(vbox,requisition);
-	lm->lm_MinMax.MaxWidth  = requisition->width;
-	lm->lm_MinMax.MaxHeight = requisition->height;
-	DebOut("  MUILM_MINMAX: max width: %d height: %d\n",requisition->width,requisition->height);
+	requisition.gtkmui_type=1;
+	gtk_vbox_size_request(vbox,&requisition);
+	lm->lm_MinMax.MinWidth  = requisition.width;
+	lm->lm_MinMax.MinHeight = requisition.height;
+	DebOut("  MUILM_MINMAX: min width: %d height: %d\n",requisition.width,requisition.height);
+
+	requisition.gtkmui_type=3;
+	gtk_vbox_size_request(vbox,&requisition);
+	lm->lm_MinMax.MaxWidth  = requisition.width;
+	lm->lm_MinMax.MaxHeight = requisition.height;
+	DebOut("  MUILM_MINMAX: max width: %d height: %d\n",requisition.width,requisition.height);
    
 	/* we call type 2 after all others, as those values
 	 * are "the best fitting" for GTK and the call to gtk_vbox_size_request
 	 * sets some values, which are used later on.
 	 */
-	requisition->gtkmui_type=2;
-	gtk_vbox_size_request(vbox,requisition);
-	lm->lm_MinMax.DefWidth  = (LONG) requisition->width;
-	lm->lm_MinMax.DefHeight = (LONG) requisition->height;
-	DebOut("  MUILM_MINMAX: def width: %d height: %d\n",requisition->width,requisition->height);
+	requisition.gtkmui_type=2;
+	gtk_vbox_size_request(vbox,&requisition);
+	lm->lm_MinMax.DefWidth  = (LONG) requisition.width;
+	lm->lm_MinMax.DefHeight = (LONG) requisition.height;
+	DebOut("  MUILM_MINMAX: def width: %d height: %d\n",requisition.width,requisition.height);
 
-	mgtk_freemem(requisition,sizeof(GtkRequisition));
       }
       DebOut(" ^^^^^^^^^^^^^^^^^^^ MUILM_MINMAX ^^^^^^^^^^^^^^^^^^^\n");
       return 0;
@@ -139,7 +139,7 @@ AROS_UFH3(static ULONG, HLayoutHook, AROS_UFHA(struct Hook *, hook, a0), AROS_UF
     /* ======== MUILM_LAYOUT ======= */
 
     case MUILM_LAYOUT: {
-      GtkAllocation *allocation;
+      GtkAllocation allocation;
 
       DebOut(" vvvvvvvvvvvvvvvvvvv MUILM_LAYOUT vvvvvvvvvvvvvvvvvvv\n");
 
@@ -154,19 +154,17 @@ AROS_UFH3(static ULONG, HLayoutHook, AROS_UFHA(struct Hook *, hook, a0), AROS_UF
 	/* here we crash.. */
       }
       else {
-	allocation=mgtk_allocmem(sizeof(GtkAllocation),MEMF_CLEAR);
 
-	allocation->width = (gint) lm->lm_Layout.Width; 
-	allocation->height= (gint) lm->lm_Layout.Height;
-	allocation->x= 0;
-	allocation->y= 0;
+	allocation.width = (gint) lm->lm_Layout.Width; 
+	allocation.height= (gint) lm->lm_Layout.Height;
+	allocation.x= 0;
+	allocation.y= 0;
 
 	/* up to here, everything seems ok */
-	DebOut("MUILM_LAYOUT: x=y=0, width=%d height=%d\n",allocation->width,allocation->height);
+	DebOut("MUILM_LAYOUT: x=y=0, width=%d height=%d\n",allocation.width,allocation.height);
 
-	gtk_vbox_size_allocate(vbox,allocation);
+	gtk_vbox_size_allocate(vbox,&allocation);
 
-	mgtk_freemem(allocation,sizeof(GtkAllocation));
       }
    
       DebOut(" ^^^^^^^^^^^^^^^^^^^ MUILM_LAYOUT ^^^^^^^^^^^^^^^^^^^\n");
@@ -0,0 +1,154 @@
+/*
+ * GTK-MUI accelerator group benchmark
+ *
+ * Connects 10000 accelerators to a group, one by one with
+ * gtk_accel_group_connect and at once with gtk_accel_group_connect_many,
+ * looks every one of them up (and as many keys, which are not bound)
+ * and disconnects them again, by closure and by key. Prints the time
+ * of each step.
+ *
+ * Every lookup has to find exactly its own closure, misses nothing,
+ * and the group has to be empty at the end.
+ *
+ * $Id: accel_bench.c,v 1.1 2026/10/19 22:00:00 o1i Exp $
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <gtk/gtk.h>
+
+#define N_ACCELS 10000
+
+/* directly encoded CJK characters, 10000 different keys without case */
+#define KEY(i)  (0x01000000 | (0x4e00 + (i)))
+#define MODS(i) ((i) & 1 ? GDK_CONTROL_MASK : GDK_CONTROL_MASK | GDK_SHIFT_MASK)
+
+static GClosure *closures[N_ACCELS];
+static gint      bad=0;
+
+static gboolean activate(GtkAccelGroup *group, GObject *acceleratable, guint key,
+                         GdkModifierType mods, gpointer data) {
+  return TRUE;
+}
+
+static void new_closures(void) {
+  gint i;
+
+  for(i=0;i<N_ACCELS;i++) {
+    closures[i]=g_closure_ref(g_cclosure_new(G_CALLBACK(activate), GINT_TO_POINTER(i), NULL));
+    g_closure_sink(closures[i]);
+  }
+}
+
+static void free_closures(void) {
+  gint i;
+
+  for(i=0;i<N_ACCELS;i++) {
+    g_closure_unref(closures[i]);
+  }
+}
+
+static void lookup(const gchar *step, GtkAccelGroup *group) {
+  GtkAccelGroupEntry *entries;
+  guint n;
+  gint wrong=0;
+  gint i;
+
+  for(i=0;i<N_ACCELS;i++) {
+    entries=gtk_accel_group_query(group, KEY(i), MODS(i), &n);
+    if(n != 1 || entries[0].closure != closures[i]) {
+      wrong++;
+    }
+    /* same key, other modifiers */
+    gtk_accel_group_query(group, KEY(i), GDK_MOD1_MASK, &n);
+    if(n) {
+      wrong++;
+    }
+  }
+
+  if(wrong) {
+    printf("  %s: %d wrong lookups\n", step, wrong);
+    bad++;
+  }
+}
+
+static void check_empty(const gchar *step, GtkAccelGroup *group) {
+
+  if(group->n_accels) {
+    printf("  %s: %d accelerators left\n", step, group->n_accels);
+    bad++;
+  }
+}
+
+int main(int argc, char *argv[]) {
+  GtkAccelGroup *group;
+  GtkAccelKey *keys;
+  GTimer *timer;
+  gdouble t_connect, t_many, t_lookup, t_disconnect, t_disconnect_key;
+  gint i;
+
+  gtk_init(&argc, &argv);
+
+  group=gtk_accel_group_new();
+  timer=g_timer_new();
+
+  /* one by one, lookups, disconnect by closure */
+  new_closures();
+  g_timer_start(timer);
+  for(i=0;i<N_ACCELS;i++) {
+    gtk_accel_group_connect(group, KEY(i), MODS(i), GTK_ACCEL_VISIBLE, closures[i]);
+  }
+  t_connect=g_timer_elapsed(timer, NULL);
+
+  g_timer_start(timer);
+  lookup("connect", group);
+  t_lookup=g_timer_elapsed(timer, NULL);
+
+  g_timer_start(timer);
+  for(i=0;i<N_ACCELS;i++) {
+    if(!gtk_accel_group_disconnect(group, closures[i])) {
+      bad++;
+    }
+  }
+  t_disconnect=g_timer_elapsed(timer, NULL);
+  check_empty("disconnect", group);
+  free_closures();
+
+  /* at once, disconnect by key */
+  new_closures();
+  keys=g_new(GtkAccelKey, N_ACCELS);
+  for(i=0;i<N_ACCELS;i++) {
+    keys[i].accel_key=KEY(i);
+    keys[i].accel_mods=MODS(i);
+    keys[i].accel_flags=GTK_ACCEL_VISIBLE;
+  }
+  g_timer_start(timer);
+  gtk_accel_group_connect_many(group, N_ACCELS, keys, closures);
+  t_many=g_timer_elapsed(timer, NULL);
+  g_free(keys);
+
+  lookup("connect_many", group);
+
+  g_timer_start(timer);
+  for(i=0;i<N_ACCELS;i++) {
+    if(!gtk_accel_group_disconnect_key(group, KEY(i), MODS(i))) {
+      bad++;
+    }
+  }
+  t_disconnect_key=g_timer_elapsed(timer, NULL);
+  check_empty("disconnect_key", group);
+  free_closures();
+
+  g_timer_destroy(timer);
+  g_object_unref(group);
+
+  printf("%d accelerators:\n", N_ACCELS);
+  printf("  connect          %8.3fs\n", t_connect);
+  printf("  connect_many     %8.3fs\n", t_many);
+  printf("  lookup (2x)      %8.3fs\n", t_lookup);
+  printf("  disconnect       %8.3fs\n", t_disconnect);
+  printf("  disconnect_key   %8.3fs\n", t_disconnect_key);
+
+  printf("%s\n", bad ? "FAILED" : "PASSED");
+  return bad ? EXIT_FAILURE : EXIT_SUCCESS;
+}
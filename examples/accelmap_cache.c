@@ -0,0 +1,126 @@
+/*
+ * GTK-MUI accel map cache round trip
+ *
+ * Saves a map with N_ENTRIES accelerators, loads it back from the text
+ * file (which writes <file>.cache), then from the cache and at last
+ * from a changed text file, which must not use the stale cache.
+ * Every load has to give back exactly what was saved.
+ *
+ * $Id: accelmap_cache.c,v 1.1 2026/10/19 21:00:00 o1i Exp $
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <gtk/gtk.h>
+
+#define N_ENTRIES 2000
+#define MAP_FILE  "T:gtk-mui-accelmap-test"
+
+static gchar *paths[N_ENTRIES];
+
+static guint expected_key(gint i) {
+  return GDK_a + i % 26;
+}
+
+static GdkModifierType expected_mods(gint i) {
+  return (i & 1) ? GDK_CONTROL_MASK : GDK_MOD1_MASK;
+}
+
+static void clear_entries(void) {
+  gint i;
+
+  for(i=0;i<N_ENTRIES;i++) {
+    gtk_accel_map_change_entry(paths[i], 0, 0, TRUE);
+  }
+}
+
+/* count the entries, which differ from what was saved */
+static gint check_entries(const gchar *what, gint changed) {
+  GtkAccelKey key;
+  gint bad=0;
+  gint i;
+
+  for(i=0;i<N_ENTRIES;i++) {
+    if(!gtk_accel_map_lookup_entry(paths[i], &key)) {
+      bad++;
+      continue;
+    }
+    if(i == changed) {
+      if(key.accel_key != GDK_F1 || key.accel_mods != 0) {
+        bad++;
+      }
+    }
+    else if(key.accel_key != expected_key(i) || key.accel_mods != expected_mods(i)) {
+      bad++;
+    }
+  }
+
+  printf("%-24s %s (%d bad entries)\n", what, bad ? "FAILED" : "ok", bad);
+  return bad;
+}
+
+static gdouble timed_load(void) {
+  GTimer *timer;
+  gdouble t;
+
+  timer=g_timer_new();
+  gtk_accel_map_load(MAP_FILE);
+  t=g_timer_elapsed(timer, NULL);
+  g_timer_destroy(timer);
+
+  return t;
+}
+
+int main(int argc, char *argv[]) {
+  gchar *cache_name;
+  gdouble t_text;
+  gdouble t_cache;
+  gint bad=0;
+  gint i;
+
+  gtk_init(&argc, &argv);
+
+  cache_name=g_strconcat(MAP_FILE, ".cache", NULL);
+  unlink(MAP_FILE);
+  unlink(cache_name);
+
+  for(i=0;i<N_ENTRIES;i++) {
+    paths[i]=g_strdup_printf("<AccelMapTest>/Menu%d/Item%d", i / 100, i);
+    gtk_accel_map_add_entry(paths[i], 0, 0);
+    gtk_accel_map_change_entry(paths[i], expected_key(i), expected_mods(i), TRUE);
+  }
+  gtk_accel_map_save(MAP_FILE);
+
+  /* text file, writes the cache */
+  clear_entries();
+  t_text=timed_load();
+  bad+=check_entries("load from text:", -1);
+  if(!g_file_test(cache_name, G_FILE_TEST_IS_REGULAR)) {
+    printf("no cache written\n");
+    bad++;
+  }
+
+  /* same file again, now from the cache */
+  clear_entries();
+  t_cache=timed_load();
+  bad+=check_entries("load from cache:", -1);
+
+  /* changed text file, the cache is stale now */
+  gtk_accel_map_change_entry(paths[0], GDK_F1, 0, TRUE);
+  sleep(2); /* so the mtime surely differs */
+  gtk_accel_map_save(MAP_FILE);
+  clear_entries();
+  timed_load();
+  bad+=check_entries("load after change:", 0);
+
+  printf("%d entries: text %.3fs, cache %.3fs\n", N_ENTRIES, t_text, t_cache);
+
+  unlink(MAP_FILE);
+  unlink(cache_name);
+  g_free(cache_name);
+
+  printf("%s\n", bad ? "FAILED" : "PASSED");
+  return bad ? EXIT_FAILURE : EXIT_SUCCESS;
+}
@@ -0,0 +1,200 @@
+/*
+ * GTK-MUI clist benchmark
+ *
+ * Fills a list with 100000 rows of four columns. The name column is
+ * different in every row, status, type and host only have a handful
+ * of values and are interned. Prints the time to fill and to clear
+ * the list, next to the time it takes to g_strdup and g_free the same
+ * texts one by one, which is what every cell cost before the text
+ * arena. Also prints the bytes interning saved.
+ *
+ * Checks on the way:
+ *  - a text from gtk_clist_get_text does not move while other cells
+ *    change on an unfrozen list, even after lots of garbage
+ *  - all texts are still right after the last thaw compacted them
+ *  - the list is empty after gtk_clist_clear, and can be filled again
+ *
+ * $Id: clist_bench.c,v 1.1 2026/10/19 22:00:00 o1i Exp $
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <gtk/gtk.h>
+
+#define N_ROWS    100000
+#define N_COLUMNS 4
+#define N_CHURN   20000
+
+static const gchar *status[]={ "ok", "warning", "error", "unknown" };
+static const gchar *type[]={ "file", "directory", "link" };
+static const gchar *host[]={ "alpha", "beta", "gamma", "delta", "epsilon" };
+
+static gint bad=0;
+
+static void row_texts(gint row, gchar *name, gchar **texts) {
+  sprintf(name, "entry number %d", row);
+  texts[0]=name;
+  texts[1]=(gchar *) status[row % 4];
+  texts[2]=(gchar *) type[row % 3];
+  texts[3]=(gchar *) host[row % 5];
+}
+
+static void fill(GtkCList *clist) {
+  gchar *texts[N_COLUMNS];
+  gchar name[32];
+  gint row;
+
+  gtk_clist_freeze(clist);
+  for(row=0;row<N_ROWS;row++) {
+    row_texts(row, name, texts);
+    gtk_clist_append(clist, texts);
+  }
+  gtk_clist_thaw(clist);
+}
+
+/* what set_cell_contents and row_delete did per cell before */
+static gdouble strdup_baseline(void) {
+  gchar **copies;
+  gchar *texts[N_COLUMNS];
+  gchar name[32];
+  GTimer *timer;
+  gdouble t;
+  gint row, col;
+
+  copies=g_new(gchar *, N_ROWS * N_COLUMNS);
+  for(row=0;row<N_ROWS;row++) {
+    row_texts(row, name, texts);
+    for(col=0;col<N_COLUMNS;col++) {
+      copies[row*N_COLUMNS + col]=g_strdup(texts[col]);
+    }
+  }
+
+  timer=g_timer_new();
+  for(row=0;row<N_ROWS*N_COLUMNS;row++) {
+    g_free(copies[row]);
+  }
+  t=g_timer_elapsed(timer, NULL);
+  g_timer_destroy(timer);
+  g_free(copies);
+
+  return t;
+}
+
+static gboolean cell_is(GtkCList *clist, gint row, gint col, const gchar *want) {
+  gchar *text=NULL;
+
+  if(!gtk_clist_get_text(clist, row, col, &text) || !text) {
+    return FALSE;
+  }
+  return !strcmp(text, want);
+}
+
+/* change the name of every row but the first one N_CHURN times */
+static void churn(GtkCList *clist, gint round) {
+  gchar name[48];
+  gint i;
+
+  for(i=0;i<N_CHURN;i++) {
+    sprintf(name, "changed entry %d in round %d", i, round);
+    gtk_clist_set_text(clist, 1 + i % (N_ROWS-1), 0, name);
+  }
+}
+
+static void check_texts(GtkCList *clist) {
+  gchar *texts[N_COLUMNS];
+  gchar name[32];
+  gint wrong=0;
+  gint row, col;
+
+  for(row=0;row<N_ROWS;row+=97) {
+    row_texts(row, name, texts);
+    for(col=1;col<N_COLUMNS;col++) {
+      if(!cell_is(clist, row, col, texts[col])) {
+        wrong++;
+      }
+    }
+  }
+  if(!cell_is(clist, 0, 0, "entry number 0")) {
+    wrong++;
+  }
+
+  if(wrong) {
+    printf("  %d wrong texts after thaw\n", wrong);
+    bad++;
+  }
+}
+
+int main(int argc, char *argv[]) {
+  GtkWidget *window;
+  GtkWidget *scrolled;
+  GtkCList *clist;
+  GTimer *timer;
+  gchar *held;
+  gchar *now;
+  gdouble t_fill, t_clear, t_baseline;
+  gint i;
+
+  gtk_init(&argc, &argv);
+
+  window=gtk_window_new(GTK_WINDOW_TOPLEVEL);
+  gtk_window_set_title(GTK_WINDOW(window), "CList benchmark");
+  scrolled=gtk_scrolled_window_new(NULL, NULL);
+  gtk_container_add(GTK_CONTAINER(window), scrolled);
+  clist=GTK_CLIST(gtk_clist_new(N_COLUMNS));
+  gtk_container_add(GTK_CONTAINER(scrolled), GTK_WIDGET(clist));
+  for(i=1;i<N_COLUMNS;i++) {
+    gtk_clist_set_column_intern_text(clist, i, TRUE);
+  }
+
+  timer=g_timer_new();
+  fill(clist);
+  t_fill=g_timer_elapsed(timer, NULL);
+
+  /* unfrozen: nothing may move */
+  held=NULL;
+  gtk_clist_get_text(clist, 0, 0, &held);
+  for(i=0;i<5;i++) {
+    churn(clist, i);
+  }
+  now=NULL;
+  gtk_clist_get_text(clist, 0, 0, &now);
+  if(now != held || !held || strcmp(held, "entry number 0")) {
+    printf("  text of an untouched cell moved\n");
+    bad++;
+  }
+
+  /* the last thaw may compact, the texts have to survive it */
+  gtk_clist_freeze(clist);
+  churn(clist, 5);
+  gtk_clist_thaw(clist);
+  check_texts(clist);
+
+  printf("%d rows, %d columns:\n", N_ROWS, N_COLUMNS);
+  printf("  bytes saved      %8lu\n", (gulong) gtk_clist_get_text_bytes_saved(clist));
+
+  g_timer_start(timer);
+  gtk_clist_clear(clist);
+  t_clear=g_timer_elapsed(timer, NULL);
+
+  if(clist->rows != 0) {
+    printf("  %d rows left after clear\n", clist->rows);
+    bad++;
+  }
+
+  fill(clist);
+  check_texts(clist);
+  gtk_clist_clear(clist);
+
+  g_timer_destroy(timer);
+  t_baseline=strdup_baseline();
+
+  printf("  fill             %8.3fs\n", t_fill);
+  printf("  clear            %8.3fs\n", t_clear);
+  printf("  g_free per cell  %8.3fs\n", t_baseline);
+
+  gtk_widget_destroy(window);
+
+  printf("%s\n", bad ? "FAILED" : "PASSED");
+  return bad ? EXIT_FAILURE : EXIT_SUCCESS;
+}
@@ -0,0 +1,147 @@
+/*
+ * GTK-MUI double buffering benchmark
+ *
+ * Redraws a waveform FRAMES times in a drawing area, three ways:
+ *  - directly into the window (gtk_widget_set_double_buffered FALSE),
+ *    clearing first, which flickers
+ *  - double buffered by the Custom class backing store (the default)
+ *  - the classic GTK 2 way: the application draws into its own
+ *    GdkPixmap and expose_event only blits it with gdk_draw_drawable
+ * and prints the time per frame of each. Every queued draw has to
+ * end in exactly one expose.
+ *
+ * $Id: dbuf_bench.c,v 1.1 2026/10/19 22:00:00 o1i Exp $
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+#include <gtk/gtk.h>
+
+#define WIDTH   400
+#define HEIGHT  200
+#define FRAMES  100
+#define POINTS  WIDTH
+
+enum {
+  MODE_DIRECT,
+  MODE_DOUBLE_BUFFERED,
+  MODE_PIXMAP
+};
+
+static const char *mode_names[]={
+  "direct",
+  "double buffered",
+  "application pixmap"
+};
+
+static gint mode;
+static gint frame;
+static gint exposes;
+static GdkPixmap *pixmap;
+static gint bad=0;
+
+static void draw_wave(GdkDrawable *drawable, GtkWidget *area) {
+  GdkPoint points[POINTS];
+  gint i;
+
+  gdk_draw_rectangle(drawable, area->style->white_gc, TRUE, 0, 0, WIDTH, HEIGHT);
+  for(i=0;i<POINTS;i++) {
+    points[i].x=i;
+    points[i].y=HEIGHT/2 + (gint) ((HEIGHT/2-2) * sin((i+frame*4) * G_PI / 50));
+  }
+  gdk_draw_lines(drawable, area->style->black_gc, points, POINTS);
+}
+
+static gboolean expose_event(GtkWidget *area, GdkEventExpose *event, gpointer data) {
+
+  exposes++;
+
+  if(mode == MODE_PIXMAP && pixmap) {
+    gdk_draw_drawable(area->window, area->style->black_gc, pixmap,
+                      event->area.x, event->area.y, event->area.x, event->area.y,
+                      event->area.width, event->area.height);
+  }
+  else {
+    draw_wave(area->window, area);
+  }
+
+  return TRUE;
+}
+
+static gdouble bench(GtkWidget *area, gint m) {
+  GTimer *timer;
+  gdouble t;
+
+  mode=m;
+  gtk_widget_set_double_buffered(area, m == MODE_DOUBLE_BUFFERED);
+  if(m == MODE_PIXMAP) {
+    pixmap=gdk_pixmap_new(area->window, WIDTH, HEIGHT, -1);
+  }
+
+  exposes=0;
+  timer=g_timer_new();
+  for(frame=0;frame<FRAMES;frame++) {
+    if(pixmap) {
+      draw_wave(pixmap, area);
+    }
+    /* redraws at once, see mgtk_widget_queue_draw */
+    gtk_widget_queue_draw(area);
+  }
+  t=g_timer_elapsed(timer, NULL)/FRAMES;
+  g_timer_destroy(timer);
+
+  if(exposes != FRAMES) {
+    printf("  %s: %d exposes for %d frames\n", mode_names[m], exposes, FRAMES);
+    bad++;
+  }
+
+  if(pixmap) {
+    g_object_unref(pixmap);
+    pixmap=NULL;
+  }
+
+  return t;
+}
+
+static gboolean run(gpointer data) {
+  GtkWidget *area=(GtkWidget *) data;
+  gdouble t[3];
+  gint m;
+
+  for(m=MODE_DIRECT;m<=MODE_PIXMAP;m++) {
+    t[m]=bench(area, m);
+  }
+
+  printf("%dx%d waveform, %d frames:\n", WIDTH, HEIGHT, FRAMES);
+  for(m=MODE_DIRECT;m<=MODE_PIXMAP;m++) {
+    printf("  %-20s %8.2fms per frame\n", mode_names[m], t[m]*1000);
+  }
+  printf("%s\n", bad ? "FAILED" : "PASSED");
+
+  gtk_main_quit();
+  return FALSE;
+}
+
+int main(int argc, char *argv[]) {
+  GtkWidget *window;
+  GtkWidget *area;
+
+  gtk_init(&argc, &argv);
+
+  window=gtk_window_new(GTK_WINDOW_TOPLEVEL);
+  gtk_window_set_title(GTK_WINDOW(window), "Double buffering benchmark");
+  g_signal_connect(G_OBJECT(window), "destroy", G_CALLBACK(gtk_main_quit), NULL);
+
+  area=gtk_drawing_area_new();
+  gtk_widget_set_size_request(area, WIDTH, HEIGHT);
+  g_signal_connect(G_OBJECT(area), "expose_event", G_CALLBACK(expose_event), NULL);
+  gtk_container_add(GTK_CONTAINER(window), area);
+
+  gtk_widget_show_all(window);
+  /* once the window is open */
+  gtk_timeout_add(500, run, area);
+  gtk_main();
+
+  return bad ? EXIT_FAILURE : EXIT_SUCCESS;
+}
@@ -0,0 +1,193 @@
+/*
+ * GTK-MUI menu benchmark
+ *
+ * Builds a menu bar with 5010 items on three levels: TOP items, each
+ * with a submenu of MID items, each with a submenu of LEAF items.
+ * Every third MID item has an image and a label inside an hbox, like
+ * an image menu item.
+ *
+ * Prints the time to create the items and to build the MUI menu
+ * strips of all TOP items (MUIM_ContextMenuBuild, what a click with
+ * the right mouse button does), and checks:
+ *  - mgtk_get_accel returns the direct child of every item, the object
+ *    set_submenu attaches the context menu to
+ *  - mgtk_get_accel_text finds the label, also inside the hbox
+ *  - every TOP item builds a menu strip
+ *
+ * $Id: menu_bench.c,v 1.1 2026/10/19 22:00:00 o1i Exp $
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <gtk/gtk.h>
+#include <mui.h>
+
+#define TOP   10
+#define MID   10
+#define LEAF  49   /* 10 + 10*10 + 10*10*49 = 5010 items */
+
+#define N_ITEMS (TOP + TOP*MID + TOP*MID*LEAF)
+
+static GtkWidget *items[N_ITEMS];
+static gchar     *labels[N_ITEMS];
+static gint       n_items=0;
+static gint       bad=0;
+
+static GtkWidget *new_item(gboolean with_image) {
+  GtkWidget *item;
+  GtkWidget *hbox;
+  gchar *label;
+
+  label=g_strdup_printf("Item %d", n_items);
+
+  if(with_image) {
+    item=gtk_menu_item_new();
+    hbox=gtk_hbox_new(FALSE, 2);
+    gtk_box_pack_start(GTK_BOX(hbox), gtk_image_new(), FALSE, FALSE, 0);
+    gtk_box_pack_start(GTK_BOX(hbox), gtk_label_new(label), FALSE, FALSE, 0);
+    gtk_container_add(GTK_CONTAINER(item), hbox);
+  }
+  else {
+    item=gtk_menu_item_new_with_label(label);
+  }
+
+  items[n_items]=item;
+  labels[n_items]=label;
+  n_items++;
+
+  return item;
+}
+
+static GtkWidget *build(void) {
+  GtkWidget *bar;
+  GtkWidget *top;
+  GtkWidget *mid;
+  GtkWidget *top_menu;
+  GtkWidget *mid_menu;
+  gint t, m, l;
+
+  bar=gtk_menu_bar_new();
+
+  for(t=0;t<TOP;t++) {
+    top=new_item(FALSE);
+    top_menu=gtk_menu_new();
+
+    for(m=0;m<MID;m++) {
+      mid=new_item(m % 3 == 2);
+      mid_menu=gtk_menu_new();
+
+      for(l=0;l<LEAF;l++) {
+        gtk_menu_shell_append(GTK_MENU_SHELL(mid_menu), new_item(FALSE));
+      }
+
+      gtk_menu_item_set_submenu(GTK_MENU_ITEM(mid), mid_menu);
+      gtk_menu_shell_append(GTK_MENU_SHELL(top_menu), mid);
+    }
+
+    gtk_menu_item_set_submenu(GTK_MENU_ITEM(top), top_menu);
+    gtk_menu_shell_append(GTK_MENU_SHELL(bar), top);
+  }
+
+  return bar;
+}
+
+static void check_accels(void) {
+  GtkWidget *accel;
+  const gchar *text;
+  gint wrong_accel=0;
+  gint wrong_text=0;
+  gint i;
+
+  for(i=0;i<n_items;i++) {
+    accel=mgtk_get_accel(items[i]);
+    if(accel != GTK_BIN(items[i])->child) {
+      wrong_accel++;
+    }
+    text=mgtk_get_accel_text(accel);
+    if(!text || strcmp(text, labels[i])) {
+      wrong_text++;
+    }
+  }
+
+  if(wrong_accel) {
+    printf("  %d items: accel is not the direct child\n", wrong_accel);
+    bad++;
+  }
+  if(wrong_text) {
+    printf("  %d items: wrong accel text\n", wrong_text);
+    bad++;
+  }
+}
+
+/* TOP items are the first item of every block */
+static gint build_strips(void) {
+  GtkWidget *accel;
+  APTR strip;
+  gint missing=0;
+  gint i;
+
+  for(i=0;i<n_items;i+=1 + MID + MID*LEAF) {
+    accel=mgtk_get_accel(items[i]);
+    strip=(APTR) DoMethod(GtkObj(accel), MUIM_ContextMenuBuild, 0, 0);
+    if(!strip) {
+      missing++;
+    }
+  }
+
+  return missing;
+}
+
+static gboolean run(gpointer data) {
+  GTimer *timer;
+  gdouble t_strips;
+  gint missing;
+
+  check_accels();
+
+  timer=g_timer_new();
+  missing=build_strips();
+  t_strips=g_timer_elapsed(timer, NULL);
+  g_timer_destroy(timer);
+
+  if(missing) {
+    printf("  %d of %d top items built no menu strip\n", missing, TOP);
+    bad++;
+  }
+
+  printf("  build menu strips %8.3fs\n", t_strips);
+  printf("%s\n", bad ? "FAILED" : "PASSED");
+
+  gtk_main_quit();
+  return FALSE;
+}
+
+int main(int argc, char *argv[]) {
+  GtkWidget *window;
+  GtkWidget *bar;
+  GTimer *timer;
+  gdouble t_create;
+
+  gtk_init(&argc, &argv);
+
+  window=gtk_window_new(GTK_WINDOW_TOPLEVEL);
+  gtk_window_set_title(GTK_WINDOW(window), "Menu benchmark");
+  g_signal_connect(G_OBJECT(window), "destroy", G_CALLBACK(gtk_main_quit), NULL);
+
+  timer=g_timer_new();
+  bar=build();
+  t_create=g_timer_elapsed(timer, NULL);
+  g_timer_destroy(timer);
+
+  gtk_container_add(GTK_CONTAINER(window), bar);
+  gtk_widget_show_all(window);
+
+  printf("%d menu items:\n", n_items);
+  printf("  create            %8.3fs\n", t_create);
+
+  /* once the window is open */
+  gtk_timeout_add(500, run, NULL);
+  gtk_main();
+
+  return bad ? EXIT_FAILURE : EXIT_SUCCESS;
+}
@@ -0,0 +1,132 @@
+/*
+ * GTK-MUI rgb drawing benchmark
+ *
+ * Draws a 512x512 rgb image into a drawing area both ways: with one
+ * gdk_draw_rgb_image blit (once per dither mode) and the old way, one
+ * gdk_gc_set_rgb_fg_color/gdk_draw_point per pixel. Run it on a true
+ * colour and on a palette screen.
+ *
+ * $Id: rgb_bench.c,v 1.1 2026/10/19 21:00:00 o1i Exp $
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <gtk/gtk.h>
+
+#define SIZE    512
+#define ROUNDS  10
+
+static guchar *image;
+static gboolean done=FALSE;
+
+static void fill_image(void) {
+  guchar *p;
+  gint x, y;
+
+  image=g_malloc(SIZE*SIZE*3);
+  p=image;
+  for(y=0;y<SIZE;y++) {
+    for(x=0;x<SIZE;x++) {
+      *p++=x/2;
+      *p++=y/2;
+      *p++=(x+y)/4;
+    }
+  }
+}
+
+static gdouble bench_blit(GtkWidget *area, GdkRgbDither dith) {
+  GTimer *timer;
+  gdouble t;
+  gint i;
+
+  timer=g_timer_new();
+  for(i=0;i<ROUNDS;i++) {
+    gdk_draw_rgb_image(area->window, area->style->black_gc, 0, 0, SIZE, SIZE,
+                       dith, image, SIZE*3);
+  }
+  t=g_timer_elapsed(timer, NULL)/ROUNDS;
+  g_timer_destroy(timer);
+
+  return t;
+}
+
+static gdouble bench_points(GtkWidget *area) {
+  GdkColor color;
+  GTimer *timer;
+  GdkGC *gc;
+  guchar *p;
+  gdouble t;
+  gint x, y;
+
+  gc=gdk_gc_new(area->window);
+
+  timer=g_timer_new();
+  p=image;
+  for(y=0;y<SIZE;y++) {
+    for(x=0;x<SIZE;x++) {
+      color.red  =p[0]<<8;
+      color.green=p[1]<<8;
+      color.blue =p[2]<<8;
+      p+=3;
+      gdk_gc_set_rgb_fg_color(gc, &color);
+      gdk_draw_point(area->window, gc, x, y);
+    }
+  }
+  t=g_timer_elapsed(timer, NULL);
+  g_timer_destroy(timer);
+
+  g_object_unref(gc);
+
+  return t;
+}
+
+static gboolean expose_event(GtkWidget *area, GdkEventExpose *event, gpointer data) {
+  gdouble t_none, t_normal, t_max, t_points;
+
+  if(done) {
+    gdk_draw_rgb_image(area->window, area->style->black_gc, 0, 0, SIZE, SIZE,
+                       GDK_RGB_DITHER_NORMAL, image, SIZE*3);
+    return TRUE;
+  }
+  done=TRUE;
+
+  t_none  =bench_blit(area, GDK_RGB_DITHER_NONE);
+  t_normal=bench_blit(area, GDK_RGB_DITHER_NORMAL);
+  t_max   =bench_blit(area, GDK_RGB_DITHER_MAX);
+  t_points=bench_points(area);
+
+  printf("%dx%d rgb image:\n", SIZE, SIZE);
+  printf("  gdk_draw_rgb_image, no dither:     %8.4fs\n", t_none);
+  printf("  gdk_draw_rgb_image, normal dither: %8.4fs\n", t_normal);
+  printf("  gdk_draw_rgb_image, max dither:    %8.4fs\n", t_max);
+  printf("  gdk_draw_point per pixel:          %8.4fs\n", t_points);
+  if(t_normal > 0) {
+    printf("  blit is %.1f times faster\n", t_points/t_normal);
+  }
+
+  return TRUE;
+}
+
+int main(int argc, char *argv[]) {
+  GtkWidget *window;
+  GtkWidget *area;
+
+  gtk_init(&argc, &argv);
+  fill_image();
+
+  window=gtk_window_new(GTK_WINDOW_TOPLEVEL);
+  gtk_window_set_title(GTK_WINDOW(window), "RGB benchmark");
+  g_signal_connect(G_OBJECT(window), "destroy", G_CALLBACK(gtk_main_quit), NULL);
+
+  area=gtk_drawing_area_new();
+  gtk_widget_set_size_request(area, SIZE, SIZE);
+  g_signal_connect(G_OBJECT(area), "expose_event", G_CALLBACK(expose_event), NULL);
+  gtk_container_add(GTK_CONTAINER(window), area);
+
+  gtk_widget_show_all(window);
+  gtk_main();
+
+  g_free(image);
+
+  return 0;
+}
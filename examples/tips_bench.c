@@ -0,0 +1,141 @@
+/*
+ * GTK-MUI tooltips benchmark
+ *
+ * Registers 20000 tips on scales, buttons, labels and entries (100
+ * different texts, so they share interned copies), disables and
+ * enables them, changes every text and removes them again, and prints
+ * the time of each step.
+ *
+ * After every step MUIM_CreateShortHelp of every object has to answer
+ * with the current text (or NULL while disabled) - never with the
+ * TRUE lazy tips keep in MUIA_ShortHelp.
+ *
+ * $Id: tips_bench.c,v 1.1 2026/10/19 22:00:00 o1i Exp $
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <gtk/gtk.h>
+#include <mui.h>
+
+#define N_TIPS  20000
+#define N_TEXTS 100
+
+static GtkWidget *widgets[N_TIPS];
+static gchar     *texts[N_TEXTS];
+static gchar     *other_texts[N_TEXTS];
+static gint       bad=0;
+
+static GtkWidget *new_widget(gint i) {
+
+  switch(i % 4) {
+    case 0:  return gtk_hscale_new_with_range(0, 100, 1);
+    case 1:  return gtk_button_new_with_label("Button");
+    case 2:  return gtk_label_new("Label");
+    default: return gtk_entry_new();
+  }
+}
+
+/* what MUI would show for widget i */
+static void check(const gchar *step, gchar **expected, gboolean enabled) {
+  Object *obj;
+  STRPTR help;
+  gint wrong=0;
+  gint i;
+
+  for(i=0;i<N_TIPS;i++) {
+    obj=GtkObj(widgets[i]);
+    help=(STRPTR) DoMethod(obj, MUIM_CreateShortHelp, 0, 0);
+    if(help == (STRPTR) TRUE) {
+      wrong++;
+    }
+    else if(!expected || !enabled) {
+      wrong+=help != NULL;
+    }
+    else if(!help || strcmp(help, expected[i % N_TEXTS])) {
+      wrong++;
+    }
+    DoMethod(obj, MUIM_DeleteShortHelp, (ULONG) help);
+  }
+
+  if(wrong) {
+    printf("  %s: %d objects with a wrong short help\n", step, wrong);
+    bad++;
+  }
+}
+
+static void set_tips(GtkTooltips *tips, gchar **t) {
+  gint i;
+
+  for(i=0;i<N_TIPS;i++) {
+    gtk_tooltips_set_tip(tips, widgets[i], t ? t[i % N_TEXTS] : NULL, NULL);
+  }
+}
+
+int main(int argc, char *argv[]) {
+  GtkTooltips *tips;
+  GtkWidget *window;
+  GtkWidget *vbox;
+  GTimer *timer;
+  gdouble t_set, t_toggle, t_change, t_remove;
+  gint i;
+
+  gtk_init(&argc, &argv);
+
+  for(i=0;i<N_TEXTS;i++) {
+    texts[i]=g_strdup_printf("Tip number %d", i);
+    other_texts[i]=g_strdup_printf("Changed tip %d", i);
+  }
+
+  window=gtk_window_new(GTK_WINDOW_TOPLEVEL);
+  gtk_window_set_title(GTK_WINDOW(window), "Tooltips benchmark");
+  vbox=gtk_vbox_new(FALSE, 0);
+  gtk_container_add(GTK_CONTAINER(window), vbox);
+  for(i=0;i<N_TIPS;i++) {
+    widgets[i]=new_widget(i);
+    gtk_box_pack_start(GTK_BOX(vbox), widgets[i], FALSE, FALSE, 0);
+  }
+
+  tips=gtk_tooltips_new();
+  timer=g_timer_new();
+
+  set_tips(tips, texts);
+  t_set=g_timer_elapsed(timer, NULL);
+  check("set", texts, TRUE);
+
+  g_timer_start(timer);
+  for(i=0;i<10;i++) {
+    gtk_tooltips_disable(tips);
+    gtk_tooltips_enable(tips);
+  }
+  gtk_tooltips_disable(tips);
+  t_toggle=g_timer_elapsed(timer, NULL)/21;
+  check("disabled", texts, FALSE);
+  gtk_tooltips_enable(tips);
+  check("enabled", texts, TRUE);
+
+  g_timer_start(timer);
+  set_tips(tips, other_texts);
+  t_change=g_timer_elapsed(timer, NULL);
+  check("changed", other_texts, TRUE);
+
+  g_timer_start(timer);
+  set_tips(tips, NULL);
+  t_remove=g_timer_elapsed(timer, NULL);
+  check("removed", NULL, TRUE);
+
+  g_timer_destroy(timer);
+
+  printf("%d tips:\n", N_TIPS);
+  printf("  set            %8.3fs\n", t_set);
+  printf("  enable/disable %8.3fs\n", t_toggle);
+  printf("  change text    %8.3fs\n", t_change);
+  printf("  remove         %8.3fs\n", t_remove);
+
+  gtk_object_sink(GTK_OBJECT(tips));
+  gtk_widget_destroy(window);
+
+  printf("%s\n", bad ? "FAILED" : "PASSED");
+  return bad ? EXIT_FAILURE : EXIT_SUCCESS;
+}
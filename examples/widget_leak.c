@@ -0,0 +1,120 @@
+/*
+ * GTK-MUI widget leak check
+ *
+ * Builds rows of buttons, labels, entries and check buttons inside a
+ * shown window and destroys them again, 10000 widgets altogether.
+ * After every round all buried MUI objects are disposed and the live
+ * object count has to be back where it was, for every type checked
+ * and for all of them together.
+ *
+ * $Id: widget_leak.c,v 1.1 2026/10/19 22:00:00 o1i Exp $
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <gtk/gtk.h>
+
+#define ROUNDS 10
+#define ROWS   250   /* of four widgets */
+
+static GtkWidget *new_row(gint i) {
+  GtkWidget *hbox;
+  GtkWidget *entry;
+  gchar text[32];
+
+  hbox=gtk_hbox_new(FALSE, 2);
+
+  g_snprintf(text, sizeof(text), "Button %d", i);
+  gtk_box_pack_start(GTK_BOX(hbox), gtk_button_new_with_label(text), FALSE, FALSE, 0);
+
+  g_snprintf(text, sizeof(text), "Label %d", i);
+  gtk_box_pack_start(GTK_BOX(hbox), gtk_label_new(text), FALSE, FALSE, 0);
+
+  entry=gtk_entry_new();
+  gtk_entry_set_text(GTK_ENTRY(entry), text);
+  gtk_box_pack_start(GTK_BOX(hbox), entry, TRUE, TRUE, 0);
+
+  gtk_box_pack_start(GTK_BOX(hbox), gtk_check_button_new_with_label("Check"), FALSE, FALSE, 0);
+
+  return hbox;
+}
+
+/* live objects of a type must not grow */
+static gint check_type(GType type, guint before, gint round) {
+  guint now;
+
+  now=mgtk_live_object_count(type);
+  if(now != before) {
+    printf("round %d: %s: %d live, %d before\n", round, g_type_name(type), now, before);
+    return 1;
+  }
+  return 0;
+}
+
+int main(int argc, char *argv[]) {
+  GType types[5];
+  guint before[5];
+  guint total;
+  GtkWidget *window;
+  GtkWidget *vbox;
+  GtkWidget *rows[ROWS];
+  GTimer *timer;
+  gdouble t_create=0;
+  gdouble t_destroy=0;
+  gint round;
+  gint bad=0;
+  gint i;
+
+  gtk_init(&argc, &argv);
+
+  window=gtk_window_new(GTK_WINDOW_TOPLEVEL);
+  gtk_window_set_title(GTK_WINDOW(window), "Widget leak check");
+  vbox=gtk_vbox_new(FALSE, 2);
+  gtk_container_add(GTK_CONTAINER(window), vbox);
+  gtk_widget_show_all(window);
+
+  types[0]=GTK_TYPE_HBOX;
+  types[1]=GTK_TYPE_BUTTON;
+  types[2]=GTK_TYPE_LABEL;
+  types[3]=GTK_TYPE_ENTRY;
+  types[4]=GTK_TYPE_CHECK_BUTTON;
+  for(i=0;i<5;i++) {
+    before[i]=mgtk_live_object_count(types[i]);
+  }
+  total=mgtk_live_object_count(0);
+
+  timer=g_timer_new();
+  for(round=0;round<ROUNDS;round++) {
+    g_timer_start(timer);
+    for(i=0;i<ROWS;i++) {
+      rows[i]=new_row(round*ROWS+i);
+      gtk_box_pack_start(GTK_BOX(vbox), rows[i], FALSE, FALSE, 0);
+    }
+    gtk_widget_show_all(vbox);
+    t_create+=g_timer_elapsed(timer, NULL);
+
+    g_timer_start(timer);
+    for(i=0;i<ROWS;i++) {
+      gtk_widget_destroy(rows[i]);
+    }
+    mgtk_dispose_mui_objects();
+    t_destroy+=g_timer_elapsed(timer, NULL);
+
+    for(i=0;i<5;i++) {
+      bad+=check_type(types[i], before[i], round);
+    }
+    if(mgtk_live_object_count(0) != total) {
+      printf("round %d: %d live objects, %d before\n", round, mgtk_live_object_count(0), total);
+      bad++;
+    }
+  }
+  g_timer_destroy(timer);
+
+  printf("%d widgets: create %.3fs, destroy %.3fs\n", ROUNDS*ROWS*4, t_create, t_destroy);
+  mgtk_live_objects_dump();
+
+  gtk_widget_destroy(window);
+
+  printf("%s\n", bad ? "FAILED" : "PASSED");
+  return bad ? EXIT_FAILURE : EXIT_SUCCESS;
+}
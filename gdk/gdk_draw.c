@@ -29,89 +29,240 @@
  *****************************************************************************/
 
 #include <stdio.h>
+#include <string.h>
+#include <math.h>
 #include <proto/intuition.h>
 #include <proto/graphics.h>
 #include <proto/exec.h>
+#include <proto/cybergraphics.h>
+#include <cybergraphx/cybergraphics.h>
 #include <mui.h>
 
 #include "../debug.h"
 #include <gtk/gtk.h>
 #include "../gtk_globals.h"
+#include <gdk/gdkrgb.h>
+#include "gdkscan.h"
+#include "gdkline.h"
 
 /* pens (gc) is still TODO! */
 
-// ---- point/points
-void gdk_draw_point (GdkDrawable *drawable, GdkGC *gc, gint x, gint y)
-{
+// ---- drawing targets
+/*
+ * A window draws into the RastPort of its object, inside the inner box.
+ * While the object is exposed double buffered (see classes/custom.c),
+ * the window has a backing pixmap and its drawing goes there instead.
+ * A pixmap draws into its own RastPort, which has a layer, so it clips
+ * by itself.
+ *
+ * All primitives share the setup below: draw_begin finds the target
+ * and the pen of the gc, draw_end releases the pen again.
+ */
+
+typedef struct {
+  struct RastPort *rp;
+  struct Screen   *screen;
+  struct DrawInfo *dri;    /* NULL for pixmaps made without a window */
+  struct TextFont *font;   /* NULL: use the font of rp */
+  LONG             left;   /* position of the drawable's 0,0 in rp */
+  LONG             top;
+  LONG             width;
+  LONG             height;
+} DrawTarget;
+
+static BOOL draw_target(GdkDrawable *drawable, DrawTarget *t) {
   GtkWidget *widget;
   Object *obj;
-  LONG pen;
-  ULONG red,green,blue;
-  struct Screen *screen;
-
-  DebOut("gdk_draw_point(%lx,%lx,%d,%d)\n",drawable,gc,x,y);
+  GdkPixmap *pixmap;
 
+  /* a bad hack to ensure, that our app is not hidden 
+   * (with exchange)
+   */
   if(!global_mgtk || !xget(global_mgtk->MuiRoot,MUIA_Window_Open)) {
-    /* WarnOut("Window not open? (mgtk_ObjApp %lx)\n",global_mgtk);*/
-    return;
+    return FALSE;
   }
-  
+
   if(!drawable) {
-    DebOut("ERROR: drawable is NULL!\n");
-    printf("ERROR: gdk/gdk_draw.c:drawable is NULL!\n");
-    return;
+    ErrOut("gdk/gdk_draw.c: drawable is NULL!\n");
+    return FALSE;
+  }
+
+  pixmap=drawable;
+  t->dri=NULL;
+  t->font=NULL;
+
+  if(drawable->mgtk_widget) {
+    widget=(GtkWidget *) drawable->mgtk_widget;
+    obj=GtkObj(widget);
+    if(!obj || !muiRenderInfo(obj) || !_rp(obj) || !_screen(obj)) {
+      DebOut("  object not visible, nothing to draw\n");
+      return FALSE;
+    }
+    t->dri=_dri(obj);
+    t->font=_font(obj);
+
+    pixmap=drawable->mgtk_backing;
+    if(!pixmap) {
+      t->rp=_rp(obj);
+      t->screen=_screen(obj);
+      t->left=_mleft(obj);
+      t->top=_mtop(obj);
+      t->width=_mwidth(obj);
+      t->height=_mheight(obj);
+      return TRUE;
+    }
   }
 
+  if(!pixmap->mgtk_rastport) {
+    DebOut("  pixmap %lx has no bitmap, nothing to draw\n",pixmap);
+    return FALSE;
+  }
+
+  t->rp=(struct RastPort *) pixmap->mgtk_rastport;
+  t->screen=(struct Screen *) pixmap->mgtk_screen;
+  if(!t->dri) {
+    t->dri=(struct DrawInfo *) pixmap->mgtk_dri;
+  }
+  t->left=0;
+  t->top=0;
+  t->width=pixmap->mgtk_width;
+  t->height=pixmap->mgtk_height;
+
+  return TRUE;
+}
+
+typedef struct {
+  DrawTarget       t;
+  LONG             pen;
+  BOOL             own_pen;
+  /* pending RectFill, rows run_y1..run_y2 */
+  gint             run_x1, run_x2;
+  gint             run_y1, run_y2;
+} DrawContext;
+
+static BOOL draw_begin(GdkDrawable *drawable, GdkGC *gc, DrawContext *ctx) {
+
   if(!gc) {
-    DebOut("ERROR: gc is NULL!\n");
-    printf("ERROR: gdk/gdk_draw.c:gc is NULL!\n");
-    return;
+    ErrOut("gdk/gdk_draw.c: gc is NULL!\n");
+    return FALSE;
+  }
+
+  if(!draw_target(drawable,&ctx->t)) {
+    return FALSE;
+  }
+
+  if(gc->mgtk_color.havepen==1) {
+    ctx->pen=(LONG) gc->mgtk_color.pen;
+    ctx->own_pen=FALSE;
+  }
+  else {
+    ctx->pen=ObtainBestPenA(ctx->t.screen->ViewPort.ColorMap,
+                            gc->mgtk_color.red   << 16,
+                            gc->mgtk_color.green << 16,
+                            gc->mgtk_color.blue  << 16,
+                            NULL);
+    ctx->own_pen=TRUE;
   }
 
-  widget=(GtkWidget *) drawable->mgtk_widget;
+  SetAPen(ctx->t.rp,ctx->pen);
+  SetDrMd(ctx->t.rp,JAM1);
+  ctx->run_y1=-1;
+
+  return TRUE;
+}
 
-  if(!widget) {
-    DebOut("ERROR: drawable->mgtk_widget is NULL!\n");
+static void draw_flush_run(DrawContext *ctx) {
+
+  if(ctx->run_y1<0) {
     return;
   }
-  
-  obj=GtkObj(widget);
+  RectFill(ctx->t.rp,ctx->t.left+ctx->run_x1,ctx->t.top+ctx->run_y1,
+                     ctx->t.left+ctx->run_x2,ctx->t.top+ctx->run_y2);
+  ctx->run_y1=-1;
+}
+
+static void draw_end(DrawContext *ctx) {
+
+  draw_flush_run(ctx);
+
+  if(ctx->own_pen) {
+    ReleasePen(ctx->t.screen->ViewPort.ColorMap,ctx->pen);
+  }
+}
+
+/* MgtkSpanFunc, clipped to the drawable */
+static void draw_span(gint y, gint x1, gint x2, gpointer data) {
+  DrawContext *ctx=(DrawContext *) data;
 
-  if(!obj) {
-    DebOut("ERROR: obj is NULL!\n");
-    printf("ERROR: gdk/gdk_draw.c: obj is NULL!\n");
+  if(y<0 || y>=ctx->t.height) {
     return;
   }
-  
-  screen=_screen(obj);
-  if(!screen) {
-    ErrOut("gdk/gdk_draw.c: gdk_draw_point: could not find actual screen struct!\n");
+  x1=MAX(x1,0);
+  x2=MIN(x2,ctx->t.width-1);
+  if(x1>x2) {
     return;
   }
-  
-  if(gc->colormap->colors->havepen==1) {
-    pen=(LONG) gc->colormap->colors->pen;
-    DebOut("  found pen: %d\n",(int) pen);
-  } else {
-    red  =  gc->colormap->colors->red   << 16;
-    blue =  gc->colormap->colors->blue  << 16;
-    green=  gc->colormap->colors->green << 16;
 
-    pen = ObtainBestPenA( screen->ViewPort.ColorMap, red, green, blue, NULL ); 
-  }
-  
-/* we crash here, if the window is not visible..*/
-  if(!_rp(obj)) {
-    ErrOut("RP is NULL!?\n");
+  if(ctx->run_y1>=0 && y==ctx->run_y2+1 && x1==ctx->run_x1 && x2==ctx->run_x2) {
+    ctx->run_y2=y;
+    return;
   }
-  
-  SetAPen(_rp(obj),pen);
-  Move(_rp(obj),_mleft(obj)+x,_mtop(obj)+y);
-  WritePixel(_rp(obj),_mleft(obj)+x,_mtop(obj)+y);
-  
-  if(!gc->colormap->colors->havepen) {
-    ReleasePen(screen->ViewPort.ColorMap,pen);
+  draw_flush_run(ctx);
+  ctx->run_x1=x1;
+  ctx->run_x2=x2;
+  ctx->run_y1=y;
+  ctx->run_y2=y;
+}
+
+// ---- styled lines
+/*
+ * Lines wider than one pixel, dashed lines and GDK_CAP_NOT_LAST go
+ * through gdkline.c. Thin pieces come back as runs for Move/Draw, wide
+ * ones as spans.
+ */
+
+static BOOL line_styled(GdkGC *gc) {
+
+  return gc->line_width>1 || gc->line_style!=GDK_LINE_SOLID || gc->cap_style==GDK_CAP_NOT_LAST;
+}
+
+/* MgtkRunFunc */
+static void draw_run(gint x1, gint y1, gint x2, gint y2, gpointer data) {
+  DrawContext *ctx=(DrawContext *) data;
+
+  Move(ctx->t.rp,ctx->t.left+x1,ctx->t.top+y1);
+  Draw(ctx->t.rp,ctx->t.left+x2,ctx->t.top+y2);
+}
+
+static void draw_styled(DrawContext *ctx, GdkGC *gc, GdkPoint *points, gint npoints) {
+  MgtkLineAttr attr;
+
+  attr.width=gc->line_width;
+  attr.style=gc->line_style;
+  attr.cap=gc->cap_style;
+  attr.join=gc->join_style;
+  attr.dashes=gc->mgtk_dashes;
+  attr.n_dashes=gc->mgtk_n_dashes;
+  attr.dash_offset=gc->mgtk_dash_offset;
+
+  mgtk_line_draw(&attr,(const MgtkLinePoint *) points,npoints,draw_run,draw_span,ctx);
+  draw_flush_run(ctx);
+}
+
+// ---- point/points
+void gdk_draw_point (GdkDrawable *drawable, GdkGC *gc, gint x, gint y)
+{
+  DrawContext ctx;
+
+  DebOut("gdk_draw_point(%lx,%lx,%d,%d)\n",drawable,gc,x,y);
+
+  if(!draw_begin(drawable,gc,&ctx)) {
+    return;
   }
+
+  WritePixel(ctx.t.rp,ctx.t.left+x,ctx.t.top+y);
+
+  draw_end(&ctx);
 }
 
 void gdk_draw_points (GdkDrawable *drawable, GdkGC *gc, GdkPoint *points, gint npoints)
@@ -132,27 +283,18 @@ void gdk_draw_points (GdkDrawable *drawable, GdkGC *gc, GdkPoint *points, gint n
 
 
 // ---- line/lines
-void gdk_draw_line(GdkDrawable *drawable, GdkGC *gc, gint x1, gint y1, gint x2, gint y2) {
-  GtkWidget *widget;
-  Object *obj;
+/* the pen of the gc is taken as a DrawInfo pen here */
+static BOOL line_begin(GdkDrawable *drawable, GdkGC *gc, DrawContext *ctx) {
   LONG pen;
 
-  DebOut("gdk_draw_line(%lx,%lx,%d,%d,%d,%d)\n",drawable,gc,x1,y1,x2,y2);
-
-  if(!drawable) {
-    DebOut("ERROR: drawable is NULL!\n");
-    printf("ERROR: gdk/gdk_draw.c:drawable is NULL!\n");
-    return;
-  }
-
   if(!gc) {
     DebOut("ERROR: gc is NULL!\n");
     printf("ERROR: gdk/gdk_draw.c:gc is NULL!\n");
-    return;
+    return FALSE;
   }
 
-  if(gc->colormap->colors->havepen) {
-    pen=gc->colormap->colors->pen;
+  if(gc->mgtk_color.havepen) {
+    pen=gc->mgtk_color.pen;
     DebOut("  found pen: %d\n",pen);
   }
   else {
@@ -160,152 +302,725 @@ void gdk_draw_line(GdkDrawable *drawable, GdkGC *gc, gint x1, gint y1, gint x2,
     pen=(LONG) gc;
   }
 
-  widget=(GtkWidget *) drawable->mgtk_widget;
-
-  if(!widget) {
-    DebOut("ERROR: drawable->mgtk_widget is NULL!\n");
-    return;
+  if(!draw_target(drawable,&ctx->t)) {
+    return FALSE;
   }
-  obj=GtkObj(widget);
 
-  if(!obj) {
-    DebOut("ERROR: obj is NULL!\n");
-    printf("ERROR: gdk/gdk_draw.c: obj is NULL!\n");
+  ctx->pen=ctx->t.dri ? ctx->t.dri->dri_Pens[pen] : pen;
+  ctx->own_pen=FALSE;
+  ctx->run_y1=-1;
+  SetAPen(ctx->t.rp,ctx->pen);
+  SetDrMd(ctx->t.rp,JAM1);
+
+  return TRUE;
+}
+
+void gdk_draw_line(GdkDrawable *drawable, GdkGC *gc, gint x1, gint y1, gint x2, gint y2) {
+  DrawContext ctx;
+  GdkPoint p[2];
+
+  DebOut("gdk_draw_line(%lx,%lx,%d,%d,%d,%d)\n",drawable,gc,x1,y1,x2,y2);
+
+  if(!line_begin(drawable,gc,&ctx)) {
     return;
   }
 
-  SetAPen(_rp(obj),_dri(obj)->dri_Pens[pen]);
-  Move(_rp(obj),_mleft(obj)+x1,_mtop(obj)+y1);
-  Draw(_rp(obj),_mleft(obj)+x2,_mtop(obj)+y2);
+  if(line_styled(gc)) {
+    p[0].x=x1;
+    p[0].y=y1;
+    p[1].x=x2;
+    p[1].y=y2;
+    draw_styled(&ctx,gc,p,2);
+  }
+  else {
+    Move(ctx.t.rp,ctx.t.left+x1,ctx.t.top+y1);
+    Draw(ctx.t.rp,ctx.t.left+x2,ctx.t.top+y2);
+  }
 
+  draw_end(&ctx);
 }
 
+/* one polyline, so the dashes go on around the corners */
 void gdk_draw_lines(GdkDrawable *drawable, GdkGC *gc, GdkPoint *points, gint npoints) {
-
+  DrawContext ctx;
   gint i;
 
   DebOut("gdk_draw_lines(%lx,%lx,%lx,%d)\n",drawable,gc,points,npoints);
 
-  if(npoints<2) {
+  if(!points || npoints<2 || !line_begin(drawable,gc,&ctx)) {
     return;
   }
 
-  for (i=1; i<npoints; i++) {
-    gdk_draw_line(drawable,gc,points[i-1].x,points[i-1].y,points[i].x,points[i].y);
+  if(line_styled(gc)) {
+    draw_styled(&ctx,gc,points,npoints);
+  }
+  else {
+    Move(ctx.t.rp,ctx.t.left+points[0].x,ctx.t.top+points[0].y);
+    for(i=1;i<npoints;i++) {
+      Draw(ctx.t.rp,ctx.t.left+points[i].x,ctx.t.top+points[i].y);
+    }
   }
 
+  draw_end(&ctx);
 }
 
 // ---- rectangle
 void gdk_draw_rectangle(GdkDrawable *drawable, GdkGC *gc, gint filled, gint x, gint y, gint width, gint height) {
-  GtkWidget *widget;
-  Object *obj;
-  LONG pen;
-  struct Screen *screen;
-  int i;
-  ULONG red,green,blue;
+  DrawContext ctx;
+  struct RastPort *rp;
+  GdkPoint p[5];
+  LONG left, top;
 
   DebOut("gdk_draw_rectangle(%lx,%lx,%d,%d,%d,%d,%d)\n",drawable,gc,filled,x,y,width,height);
 
-  /* a bad hack to ensure, that our app is not hidden 
-   * (with exchange)
-   */
-  if(!global_mgtk || !xget(global_mgtk->MuiRoot,MUIA_Window_Open)) {
-    /* WarnOut("Window not open? (mgtk_ObjApp %lx)\n",global_mgtk);*/
+  if(!draw_begin(drawable,gc,&ctx)) {
     return;
   }
 
-  /* try to check everything ..*/
-  if(!drawable) {
-    ErrOut("gdk/gdk_draw.c: drawable is NULL!\n");
+  rp=ctx.t.rp;
+  left=ctx.t.left+x;
+  top=ctx.t.top+y;
+
+  if(!filled && line_styled(gc)) {
+    p[0].x=x;       p[0].y=y;
+    p[1].x=x+width; p[1].y=y;
+    p[2].x=x+width; p[2].y=y+height;
+    p[3].x=x;       p[3].y=y+height;
+    p[4]=p[0];
+    draw_styled(&ctx,gc,p,5);
+  }
+  else if(!filled) {
+    Move(rp,left,top);
+    Draw(rp,left+width,top);
+
+    Move(rp,left,top);
+    Draw(rp,left,top+height);
+    
+    Move(rp,left+width,top+height);
+    Draw(rp,left+width,top);
+    Move(rp,left+width,top+height);
+    Draw(rp,left,top+height);
+  }
+  else {
+    RectFill(rp,left,top,left+width,top+height);
+  }
+
+  draw_end(&ctx);
+
+  DebOut("  exit gdk_draw_rectangle\n");
+}
+
+// ---- polygons, arcs, segments and text
+/*
+ * Filled shapes go through the area fill of the RastPort, if it has an
+ * AreaInfo and a TmpRas big enough. MUI's RastPorts normally have none,
+ * then the shape is scan converted (gdkscan.c) and written as RectFills.
+ * Spans repeating in the next row are merged into one RectFill, so boxy
+ * shapes need only a few.
+ */
+
+static BOOL draw_area_fill(DrawContext *ctx, gint vectors) {
+
+  return ctx->t.rp->AreaInfo && ctx->t.rp->TmpRas && ctx->t.rp->AreaInfo->MaxCount >= vectors;
+}
+
+#define SCAN_ROUND(v) ((LONG) floor((v)+0.5))
+
+/* polyline through scan points, closed back to the first one, if wanted */
+static void draw_outline(DrawContext *ctx, const MgtkScanPoint *p, gint n, BOOL close) {
+  LONG left=ctx->t.left;
+  LONG top=ctx->t.top;
+  gint i;
+
+  Move(ctx->t.rp,left+SCAN_ROUND(p[0].x),top+SCAN_ROUND(p[0].y));
+  for(i=1;i<n;i++) {
+    Draw(ctx->t.rp,left+SCAN_ROUND(p[i].x),top+SCAN_ROUND(p[i].y));
+  }
+  if(close) {
+    Draw(ctx->t.rp,left+SCAN_ROUND(p[0].x),top+SCAN_ROUND(p[0].y));
+  }
+}
+
+/* AreaMove/AreaDraw, the area fill closes the shape itself */
+static void draw_area(DrawContext *ctx, const MgtkScanPoint *p, gint n) {
+  LONG left=ctx->t.left;
+  LONG top=ctx->t.top;
+  gint i;
+
+  AreaMove(ctx->t.rp,left+SCAN_ROUND(p[0].x),top+SCAN_ROUND(p[0].y));
+  for(i=1;i<n;i++) {
+    AreaDraw(ctx->t.rp,left+SCAN_ROUND(p[i].x),top+SCAN_ROUND(p[i].y));
+  }
+  AreaEnd(ctx->t.rp);
+}
+
+void gdk_draw_polygon(GdkDrawable *drawable, GdkGC *gc, gboolean filled, GdkPoint *points, gint npoints) {
+  DrawContext ctx;
+  MgtkScanPoint *p;
+  GdkPoint *closed;
+  gint i;
+
+  DebOut("gdk_draw_polygon(%lx,%lx,%d,%lx,%d)\n",drawable,gc,filled,points,npoints);
+
+  if(!points || npoints<2 || !draw_begin(drawable,gc,&ctx)) {
     return;
   }
 
-  if(!gc) {
-    ErrOut("gdk/gdk_draw.c:gc is NULL!\n");
+  p=g_new(MgtkScanPoint,npoints);
+  for(i=0;i<npoints;i++) {
+    p[i].x=points[i].x;
+    p[i].y=points[i].y;
+  }
+
+  if(!filled && line_styled(gc)) {
+    closed=g_new(GdkPoint,npoints+1);
+    memcpy(closed,points,npoints*sizeof(GdkPoint));
+    closed[npoints]=points[0];
+    draw_styled(&ctx,gc,closed,npoints+1);
+    g_free(closed);
+  }
+  else if(!filled) {
+    draw_outline(&ctx,p,npoints,TRUE);
+  }
+  else if(draw_area_fill(&ctx,npoints+1)) {
+    draw_area(&ctx,p,npoints);
+  }
+  else {
+    mgtk_scan_polygon(p,npoints,draw_span,&ctx);
+  }
+
+  g_free(p);
+  draw_end(&ctx);
+}
+
+/* filled arcs are pie slices, like GDK_ARC_PIESLICE */
+void gdk_draw_arc(GdkDrawable *drawable, GdkGC *gc, gboolean filled, gint x, gint y, gint width, gint height, gint angle1, gint angle2) {
+  DrawContext ctx;
+  MgtkScanPoint *p;
+  MgtkScanPoint *pie;
+  GdkPoint *arc;
+  gint n;
+  gint i;
+
+  DebOut("gdk_draw_arc(%lx,%lx,%d,%d,%d,%d,%d,%d,%d)\n",drawable,gc,filled,x,y,width,height,angle1,angle2);
+
+  if(width<0 || height<0 || !angle2 || !draw_begin(drawable,gc,&ctx)) {
+    return;
+  }
+
+  if(!filled) {
+    n=mgtk_scan_arc_points(x,y,width,height,angle1,angle2,&p);
+    if(line_styled(gc)) {
+      arc=g_new(GdkPoint,n);
+      for(i=0;i<n;i++) {
+        arc[i].x=SCAN_ROUND(p[i].x);
+        arc[i].y=SCAN_ROUND(p[i].y);
+      }
+      draw_styled(&ctx,gc,arc,n);
+      g_free(arc);
+    }
+    else {
+      draw_outline(&ctx,p,n,FALSE);
+    }
+    g_free(p);
+  }
+  else if(ABS(angle2) >= 360*64 && draw_area_fill(&ctx,2)) {
+    AreaEllipse(ctx.t.rp,ctx.t.left+x+width/2,ctx.t.top+y+height/2,width/2,height/2);
+    AreaEnd(ctx.t.rp);
+  }
+  else if(ABS(angle2) < 360*64 && draw_area_fill(&ctx,3)) {
+    /* centre and arc */
+    n=mgtk_scan_arc_points(x,y,width,height,angle1,angle2,&p);
+    if(draw_area_fill(&ctx,n+2)) {
+      pie=g_new(MgtkScanPoint,n+1);
+      pie[0].x=x+width/2.0;
+      pie[0].y=y+height/2.0;
+      memcpy(pie+1,p,n*sizeof(MgtkScanPoint));
+      draw_area(&ctx,pie,n+1);
+      g_free(pie);
+    }
+    else {
+      mgtk_scan_pie(x,y,width,height,angle1,angle2,draw_span,&ctx);
+    }
+    g_free(p);
+  }
+  else {
+    mgtk_scan_pie(x,y,width,height,angle1,angle2,draw_span,&ctx);
+  }
+
+  draw_end(&ctx);
+}
+
+/* every segment is a line of its own, its dashes start anew */
+void gdk_draw_segments(GdkDrawable *drawable, GdkGC *gc, GdkSegment *segs, gint nsegs) {
+  DrawContext ctx;
+  GdkPoint p[2];
+  LONG left, top;
+  gint i;
+
+  DebOut("gdk_draw_segments(%lx,%lx,%lx,%d)\n",drawable,gc,segs,nsegs);
+
+  if(!segs || nsegs<1 || !draw_begin(drawable,gc,&ctx)) {
+    return;
+  }
+
+  if(line_styled(gc)) {
+    for(i=0;i<nsegs;i++) {
+      p[0].x=segs[i].x1;
+      p[0].y=segs[i].y1;
+      p[1].x=segs[i].x2;
+      p[1].y=segs[i].y2;
+      draw_styled(&ctx,gc,p,2);
+    }
+    draw_end(&ctx);
     return;
   }
 
-  widget=(GtkWidget *) drawable->mgtk_widget;
-  DebOut("  widget=%lx\n",widget);
+  left=ctx.t.left;
+  top=ctx.t.top;
+  for(i=0;i<nsegs;i++) {
+    Move(ctx.t.rp,left+segs[i].x1,top+segs[i].y1);
+    Draw(ctx.t.rp,left+segs[i].x2,top+segs[i].y2);
+  }
+
+  draw_end(&ctx);
+}
+
+/* y is the baseline. GdkFonts are not implemented, the text uses the
+ * font of the object */
+void gdk_draw_text(GdkDrawable *drawable, GdkFont *font, GdkGC *gc, gint x, gint y, const gchar *text, gint text_length) {
+  DrawContext ctx;
+
+  DebOut("gdk_draw_text(%lx,%lx,%lx,%d,%d,%s,%d)\n",drawable,font,gc,x,y,text,text_length);
 
-  if(!widget) {
-    ErrOut("gdk/gdk_draw.c: gdk_draw_rectangle: drawable->mgtk_widget is NULL!\n");
+  if(!text || text_length<1 || !draw_begin(drawable,gc,&ctx)) {
     return;
   }
 
-  obj=GtkObj(widget);
+  if(ctx.t.font) {
+    SetFont(ctx.t.rp,ctx.t.font);
+  }
+  Move(ctx.t.rp,ctx.t.left+x,ctx.t.top+y);
+  Text(ctx.t.rp,(STRPTR) text,text_length);
+
+  draw_end(&ctx);
+}
+
+void gdk_draw_string(GdkDrawable *drawable, GdkFont *font, GdkGC *gc, gint x, gint y, const gchar *string) {
+
+  if(string) {
+    gdk_draw_text(drawable,font,gc,x,y,string,strlen(string));
+  }
+}
+
+// ---- drawables
+/* the gc is ignored, the copy is always GDK_COPY */
+void gdk_draw_drawable(GdkDrawable *drawable, GdkGC *gc, GdkDrawable *src, gint xsrc, gint ysrc, gint xdest, gint ydest, gint width, gint height) {
+  DrawTarget s;
+  DrawTarget d;
+
+  DebOut("gdk_draw_drawable(%lx,%lx,%lx,%d,%d,%d,%d,%d,%d)\n",drawable,gc,src,xsrc,ysrc,xdest,ydest,width,height);
 
-  if(!obj) {
-    ErrOut("GDK: no obj!\n");
+  if(!src || !draw_target(src,&s) || !draw_target(drawable,&d)) {
     return;
   }
 
-  screen=_screen(obj);
-  if(!screen) {
-    ErrOut("gdk/gdk_draw.c: gdk_draw_rectangle: could not find actual screen struct!\n");
+  if(width<0) {
+    width=s.width-xsrc;
+  }
+  if(height<0) {
+    height=s.height-ysrc;
+  }
+
+  /* clip to the source .. */
+  if(xsrc<0) {
+    xdest-=xsrc;
+    width+=xsrc;
+    xsrc=0;
+  }
+  if(ysrc<0) {
+    ydest-=ysrc;
+    height+=ysrc;
+    ysrc=0;
+  }
+  width =MIN(width, s.width -xsrc);
+  height=MIN(height,s.height-ysrc);
+
+  /* .. and to the destination */
+  if(xdest<0) {
+    xsrc-=xdest;
+    width+=xdest;
+    xdest=0;
+  }
+  if(ydest<0) {
+    ysrc-=ydest;
+    height+=ydest;
+    ydest=0;
+  }
+  width =MIN(width, d.width -xdest);
+  height=MIN(height,d.height-ydest);
+
+  if(width<=0 || height<=0) {
     return;
   }
-  DebOut(" screen: %lx\n",_screen(obj));
 
-  /* do we need to obtain a pen? */
-  if(gc->colormap->colors->havepen==1) {
-    pen=(LONG) gc->colormap->colors->pen;
-    DebOut("  found pen: %d\n",(int) pen);
+  ClipBlit(s.rp,s.left+xsrc,s.top+ysrc,
+           d.rp,d.left+xdest,d.top+ydest,
+           width,height,0xc0);
+}
+
+// ---- rgb/gray images and pixbufs
+/*
+ * On cybergraphics true colour screens the whole rectangle goes out with
+ * a single WritePixelArray. Only pixbufs with alpha need the destination,
+ * they are blended in bands of RGB_BAND_BYTES.
+ *
+ * On palette screens the pixels are ordered dithered into a 4x4x4 cube of
+ * shared pens and written with WriteChunkyPixels, also in bands.
+ */
+
+#define RGB_BAND_BYTES 65536
+
+#define RGB_FMT_GRAY 1
+#define RGB_FMT_RGB  3
+#define RGB_FMT_RGBA 4
+
+static BOOL            own_cybergfx;
+static BOOL            cybergfx_tried;
+static struct ColorMap *cube_cm;
+static LONG            cube_pens[64];
+static struct ColorMap *cube_failed_cm;  /* no cube there, don't try again */
+static UBYTE           dither_level[17][256]; /* row 16: no dithering */
+static BOOL            dither_ready;
+static guchar         *scratch;
+static gulong          scratch_size;
+
+#ifdef __AMIGAOS4__
+struct CyberGfxIFace *ICyberGfx;
+#endif
+
+static const UBYTE bayer[4][4] = {
+  {  0,  8,  2, 10 },
+  { 12,  4, 14,  6 },
+  {  3, 11,  1,  9 },
+  { 15,  7, 13,  5 }
+};
+
+static guchar *rgb_scratch(gulong size) {
+
+  if(size>scratch_size) {
+    g_free(scratch);
+    scratch=g_malloc(size);
+    scratch_size=size;
   }
-  else {
-    DebOut(" we have no pen up to now, so we should get one ..\n",gc);
-    DebOut("   gc->colormap->colors->red: %lx\n",gc->colormap->colors->red);
-    DebOut("   gc->colormap->colors->blue: %lx\n",gc->colormap->colors->blue);
-    DebOut("   gc->colormap->colors->green: %lx\n",gc->colormap->colors->green);
-    DebOut("   gc->colormap->colors->pixel: %d\n",gc->colormap->colors->pixel);
-    red  =  gc->colormap->colors->red   << 16;
-    blue =  gc->colormap->colors->blue  << 16;
-    green=  gc->colormap->colors->green << 16;
+  return scratch;
+}
+
+static BOOL rgb_truecolor(struct RastPort *rp) {
 
-    DebOut("   red  : %lx\n",red);
-    DebOut("   blue : %lx\n",blue);
-    DebOut("   green: %lx\n",green);
+  if(!CyberGfxBase && !cybergfx_tried) {
+    cybergfx_tried=TRUE;
+    CyberGfxBase=OpenLibrary(CYBERGFXNAME,41);
+    own_cybergfx=TRUE;
+#ifdef __AMIGAOS4__
+    if(CyberGfxBase) {
+      ICyberGfx=(struct CyberGfxIFace *) GetInterface(CyberGfxBase,"main",1,NULL);
+    }
+#endif
+  }
 
-    pen = ObtainBestPenA( screen->ViewPort.ColorMap, red, green, blue, NULL ); 
-    DebOut(" new pen=%d\n",pen);
-    /* who would release this ..? 
-    gc->colormap->colors->pen=pen;
-    gc->colormap->colors->havepen=1;
-    */
+  if(!CyberGfxBase || !rp->BitMap) {
+    return FALSE;
+  }
+  if(GetBitMapAttr(rp->BitMap,BMA_DEPTH)<=8) {
+    return FALSE;
   }
+  return GetCyberMapAttr(rp->BitMap,CYBRMATTR_ISCYBERGFX) ? TRUE : FALSE;
+}
+
+static void rgb_release_pens(void) {
+  int i;
 
-/* we crash here, if the window is not visible..*/
-  if(!_rp(obj)) {
-    ErrOut("RP is NULL!?\n");
+  if(cube_cm) {
+    for(i=0;i<64;i++) {
+      ReleasePen(cube_cm,cube_pens[i]);
+    }
+    cube_cm=NULL;
   }
+}
 
-  SetAPen(_rp(obj),pen);
+/* (re)build the pen cube, if the colormap changed */
+static BOOL rgb_palette(struct ColorMap *cm) {
+  int i,b,v;
 
-  if(!filled) {
-    Move(_rp(obj),_mleft(obj)+x,_mtop(obj)+y);
-    Draw(_rp(obj),_mleft(obj)+x+width,_mtop(obj)+y);
+  if(!dither_ready) {
+    /* level = floor(v*3/255 + (2*b+1)/32) */
+    for(b=0;b<16;b++) {
+      for(v=0;v<256;v++) {
+        dither_level[b][v]=(v*96+(2*b+1)*255)/(255*32);
+      }
+    }
+    for(v=0;v<256;v++) {
+      dither_level[16][v]=(v*3+127)/255;
+    }
+    dither_ready=TRUE;
+  }
 
-    Move(_rp(obj),_mleft(obj)+x,_mtop(obj)+y);
-    Draw(_rp(obj),_mleft(obj)+x,_mtop(obj)+y+height);
-    
-    Move(_rp(obj),_mleft(obj)+x+width,_mtop(obj)+y+height);
-    Draw(_rp(obj),_mleft(obj)+x+width,_mtop(obj)+y);
-    Move(_rp(obj),_mleft(obj)+x+width,_mtop(obj)+y+height);
-    Draw(_rp(obj),_mleft(obj)+x,_mtop(obj)+y+height);
+  if(cube_cm==cm) {
+    return TRUE;
+  }
+  if(cube_failed_cm==cm) {
+    return FALSE;
+  }
+  rgb_release_pens();
+
+  for(i=0;i<64;i++) {
+    cube_pens[i]=ObtainBestPen(cm,
+                               ((i>>4)&3)*0x55555555,
+                               ((i>>2)&3)*0x55555555,
+                               ( i    &3)*0x55555555,
+                               OBP_Precision, PRECISION_IMAGE,
+                               TAG_DONE);
+    if(cube_pens[i]<0) {
+      ErrOut("gdk/gdk_draw.c: no pen for rgb cube entry %d, no rgb drawing on this screen\n",i);
+      while(i--) {
+        ReleasePen(cm,cube_pens[i]);
+      }
+      cube_failed_cm=cm;
+      return FALSE;
+    }
+  }
+  cube_cm=cm;
+  cube_failed_cm=NULL;
+  return TRUE;
+}
+
+/* map one row to pens, dx/dy is the dither position of the first pixel */
+static void rgb_map_row(const guchar *src, gint fmt, gint width, UBYTE *dst, GdkRgbDither dith, gint dx, gint dy) {
+  const UBYTE *row;
+  const UBYTE *t;
+  gint i;
+
+  row=bayer[dy&3];
+  t=dither_level[16];
+  for(i=0;i<width;i++,src+=fmt) {
+    if(dith!=GDK_RGB_DITHER_NONE) {
+      t=dither_level[row[(dx+i)&3]];
+    }
+    if(fmt==RGB_FMT_GRAY) {
+      dst[i]=cube_pens[t[src[0]]*21];
+    }
+    else {
+      dst[i]=cube_pens[(t[src[0]]<<4)|(t[src[1]]<<2)|t[src[2]]];
+    }
+  }
+}
+
+static void rgb_draw_palette(DrawTarget *t, gint x, gint y, gint width, gint height, GdkRgbDither dith, const guchar *buf, gint rowstride, gint fmt, gint xdith, gint ydith) {
+  struct RastPort *rp;
+  UBYTE *chunky;
+  const guchar *src;
+  gint band,rows,r,i,p,start;
+
+  rp=t->rp;
+  if(!rgb_palette(t->screen->ViewPort.ColorMap)) {
+    return;
+  }
+
+  band=RGB_BAND_BYTES/width;
+  if(band<1) {
+    band=1;
+  }
+  if(band>height) {
+    band=height;
+  }
+  chunky=rgb_scratch((gulong) band*width);
+
+  for(r=0;r<height;r+=rows) {
+    rows=MIN(band,height-r);
+    for(i=0;i<rows;i++) {
+      rgb_map_row(buf+(r+i)*rowstride,fmt,width,chunky+i*width,dith,x+xdith,y+ydith+r+i);
+    }
+
+    if(fmt!=RGB_FMT_RGBA) {
+      WriteChunkyPixels(rp,t->left+x,t->top+y+r,
+                           t->left+x+width-1,t->top+y+r+rows-1,
+                           chunky,width);
+      continue;
+    }
+
+    /* no blending with pens, just leave out the transparent runs */
+    for(i=0;i<rows;i++) {
+      src=buf+(r+i)*rowstride;
+      start=-1;
+      for(p=0;p<=width;p++) {
+        if(p<width && src[p*4+3]>=128) {
+          if(start<0) {
+            start=p;
+          }
+        }
+        else if(start>=0) {
+          WriteChunkyPixels(rp,t->left+x+start,t->top+y+r+i,
+                               t->left+x+p-1,t->top+y+r+i,
+                               chunky+i*width+start,width);
+          start=-1;
+        }
+      }
+    }
+  }
+}
+
+static void rgb_draw_truecolor(DrawTarget *t, gint x, gint y, gint width, gint height, const guchar *buf, gint rowstride, gint fmt) {
+  struct RastPort *rp;
+  guchar *dst;
+  guchar *d;
+  const guchar *s;
+  gint band,rows,r,i;
+  guint a,t;
+
+  rp=t->rp;
+
+  if(fmt==RGB_FMT_RGB || fmt==RGB_FMT_GRAY) {
+    WritePixelArray((APTR) buf,0,0,rowstride,rp,t->left+x,t->top+y,width,height,
+                    fmt==RGB_FMT_RGB ? RECTFMT_RGB : RECTFMT_GREY8);
+    return;
+  }
+
+  band=RGB_BAND_BYTES/(width*3);
+  if(band<1) {
+    band=1;
+  }
+  if(band>height) {
+    band=height;
+  }
+  dst=rgb_scratch((gulong) band*width*3);
+
+  for(r=0;r<height;r+=rows) {
+    rows=MIN(band,height-r);
+    ReadPixelArray(dst,0,0,width*3,rp,t->left+x,t->top+y+r,width,rows,RECTFMT_RGB);
+    for(i=0;i<rows;i++) {
+      s=buf+(r+i)*rowstride;
+      d=dst+i*width*3;
+      for(t=0;t<(guint) width;t++,s+=4,d+=3) {
+        a=s[3];
+        if(a==255) {
+          d[0]=s[0]; d[1]=s[1]; d[2]=s[2];
+        }
+        else if(a) {
+          /* (s*a + d*(255-a)) / 255, rounded */
+#define BLEND(n) { guint v=s[n]*a+d[n]*(255-a)+128; d[n]=(v+(v>>8))>>8; }
+          BLEND(0) BLEND(1) BLEND(2)
+#undef BLEND
+        }
+      }
+    }
+    WritePixelArray(dst,0,0,width*3,rp,t->left+x,t->top+y+r,width,rows,RECTFMT_RGB);
+  }
+}
+
+static void rgb_draw(GdkDrawable *drawable, gint x, gint y, gint width, gint height, GdkRgbDither dith, const guchar *buf, gint rowstride, gint fmt, gint xdith, gint ydith) {
+  DrawTarget t;
+
+  if(!buf) {
+    ErrOut("gdk/gdk_draw.c: rgb_draw: buffer is NULL!\n");
+    return;
+  }
+
+  if(!draw_target(drawable,&t)) {
+    return;
+  }
+
+  /* clip to the drawable */
+  if(x<0) {
+    buf-=x*fmt;
+    width+=x;
+    x=0;
+  }
+  if(y<0) {
+    buf-=y*rowstride;
+    height+=y;
+    y=0;
+  }
+  width =MIN(width, t.width -x);
+  height=MIN(height,t.height-y);
+  if(width<=0 || height<=0) {
+    return;
+  }
+
+  if(rgb_truecolor(t.rp)) {
+    rgb_draw_truecolor(&t,x,y,width,height,buf,rowstride,fmt);
   }
   else {
-   /* for(i=_mleft(obj)+x;i<_mleft(obj)+x+width;i++) {
-      Move(_rp(obj),i,_mtop(obj)+y);
-      Draw(_rp(obj),i,_mtop(obj)+y+height);
-    } */
-	RectFill(_rp(obj),_mleft(obj)+x, _mtop(obj)+y,_mleft(obj)+x+width, _mtop(obj)+y+height);
+    rgb_draw_palette(&t,x,y,width,height,dith,buf,rowstride,fmt,xdith,ydith);
   }
+}
+
+void gdk_draw_rgb_image(GdkDrawable *drawable, GdkGC *gc, gint x, gint y, gint width, gint height, GdkRgbDither dith, guchar *rgb_buf, gint rowstride) {
 
-  /* if we did not store the pen, we have to release it */
-  if(!gc->colormap->colors->havepen) {
-    ReleasePen(screen->ViewPort.ColorMap,pen);
+  DebOut("gdk_draw_rgb_image(%lx,%lx,%d,%d,%d,%d)\n",drawable,gc,x,y,width,height);
+
+  rgb_draw(drawable,x,y,width,height,dith,rgb_buf,rowstride,RGB_FMT_RGB,0,0);
+}
+
+void gdk_draw_rgb_image_dithalign(GdkDrawable *drawable, GdkGC *gc, gint x, gint y, gint width, gint height, GdkRgbDither dith, guchar *rgb_buf, gint rowstride, gint xdith, gint ydith) {
+
+  DebOut("gdk_draw_rgb_image_dithalign(%lx,%lx,%d,%d,%d,%d)\n",drawable,gc,x,y,width,height);
+
+  rgb_draw(drawable,x,y,width,height,dith,rgb_buf,rowstride,RGB_FMT_RGB,xdith,ydith);
+}
+
+void gdk_draw_gray_image(GdkDrawable *drawable, GdkGC *gc, gint x, gint y, gint width, gint height, GdkRgbDither dith, guchar *buf, gint rowstride) {
+
+  DebOut("gdk_draw_gray_image(%lx,%lx,%d,%d,%d,%d)\n",drawable,gc,x,y,width,height);
+
+  rgb_draw(drawable,x,y,width,height,dith,buf,rowstride,RGB_FMT_GRAY,0,0);
+}
+
+void gdk_draw_pixbuf(GdkDrawable *drawable, GdkGC *gc, GdkPixbuf *pixbuf, gint src_x, gint src_y, gint dest_x, gint dest_y, gint width, gint height, GdkRgbDither dither, gint x_dither, gint y_dither) {
+  gint n_channels;
+
+  DebOut("gdk_draw_pixbuf(%lx,%lx,%lx,%d,%d,%d,%d,%d,%d)\n",drawable,gc,pixbuf,src_x,src_y,dest_x,dest_y,width,height);
+
+  g_return_if_fail(GDK_IS_PIXBUF(pixbuf));
+
+  if(width<0) {
+    width=gdk_pixbuf_get_width(pixbuf)-src_x;
+  }
+  if(height<0) {
+    height=gdk_pixbuf_get_height(pixbuf)-src_y;
   }
+  g_return_if_fail(src_x>=0 && src_y>=0);
+  g_return_if_fail(src_x+width<=gdk_pixbuf_get_width(pixbuf));
+  g_return_if_fail(src_y+height<=gdk_pixbuf_get_height(pixbuf));
 
-  DebOut("  exit gdk_draw_rectangle\n");
+  n_channels=gdk_pixbuf_get_n_channels(pixbuf);
+
+  rgb_draw(drawable,dest_x,dest_y,width,height,dither,
+           gdk_pixbuf_get_pixels(pixbuf)+src_y*gdk_pixbuf_get_rowstride(pixbuf)+src_x*n_channels,
+           gdk_pixbuf_get_rowstride(pixbuf),
+           gdk_pixbuf_get_has_alpha(pixbuf) ? RGB_FMT_RGBA : RGB_FMT_RGB,
+           x_dither,y_dither);
+}
+
+/* called from gtk_main, before the screen gets unlocked */
+void mgtk_rgb_cleanup(void) {
+
+  rgb_release_pens();
+
+  g_free(scratch);
+  scratch=NULL;
+  scratch_size=0;
+
+  if(own_cybergfx) {
+#ifdef __AMIGAOS4__
+    if(ICyberGfx) {
+      DropInterface((struct Interface *) ICyberGfx);
+      ICyberGfx=NULL;
+    }
+#endif
+    CloseLibrary(CyberGfxBase);
+    CyberGfxBase=NULL;
+    own_cybergfx=FALSE;
+  }
+  cybergfx_tried=FALSE;
 }
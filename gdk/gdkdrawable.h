@@ -44,6 +44,18 @@ struct _GdkDrawable
 
   /* o1i: */
   APTR *mgtk_widget;
+
+  /* GTK-MUI private, pixmaps only (see gdkpixmap.c) */
+  APTR mgtk_rastport;
+  APTR mgtk_screen;
+  APTR mgtk_dri;
+  gint mgtk_width;
+  gint mgtk_height;
+  gint mgtk_depth;
+
+  /* GTK-MUI private, windows only: while set, everything drawn into
+   * the window goes into this pixmap (double buffered expose) */
+  struct _GdkDrawable *mgtk_backing;
 };
  
 struct _GdkDrawableClass 
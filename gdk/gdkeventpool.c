@@ -0,0 +1,135 @@
+/*****************************************************************************
+ *
+ * gtk-mui - a wrapper library to wrap GTK+ calls to MUI
+ *
+ * Copyright (C) 2005 Oliver Brunner
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+ *
+ * Contact information:
+ *
+ * Oliver Brunner
+ *
+ * E-Mail: gtk-mui "at" oliver-brunner.de
+ *
+ * $Id: gdkeventpool.c,v 1.1 2026/10/19 22:00:00 o1i Exp $
+ *
+ *****************************************************************************/
+
+/* freelists of GdkEvents, see gdkeventpool.h */
+
+#include <string.h>
+
+#include "gdkeventpool.h"
+
+#define NO_CLASS MGTK_EVENT_POOL_CLASSES
+
+typedef union _EventHeader EventHeader;
+
+union _EventHeader {
+  guint        size_class;
+  EventHeader *next;            /* while on a freelist */
+  gdouble      align;
+};
+
+#define EVENT_HEADER(event) ((EventHeader *) (event) - 1)
+
+static EventHeader *free_events[MGTK_EVENT_POOL_CLASSES];
+static guint        n_free_events[MGTK_EVENT_POOL_CLASSES];
+
+/* events handed out and not freed yet */
+static GHashTable  *live_events;
+
+gpointer mgtk_event_pool_alloc(gsize size) {
+  EventHeader *header;
+  guint size_class;
+  gsize bytes;
+
+  size_class=size ? (size-1) / MGTK_EVENT_POOL_GRAIN : 0;
+  if(size_class >= MGTK_EVENT_POOL_CLASSES) {
+    size_class=NO_CLASS;
+    bytes=size;
+  }
+  else {
+    bytes=(size_class+1) * MGTK_EVENT_POOL_GRAIN;
+  }
+
+  header=size_class!=NO_CLASS ? free_events[size_class] : NULL;
+  if(header) {
+    free_events[size_class]=header->next;
+    n_free_events[size_class]--;
+  }
+  else {
+    header=g_malloc(sizeof(EventHeader) + bytes);
+  }
+
+  memset(header+1,0,bytes);
+  header->size_class=size_class;
+
+  if(!live_events) {
+    live_events=g_hash_table_new(g_direct_hash,g_direct_equal);
+  }
+  g_hash_table_insert(live_events,header+1,header+1);
+
+  return header+1;
+}
+
+gboolean mgtk_event_pool_owns(gconstpointer event) {
+
+  return live_events && g_hash_table_lookup(live_events,event)!=NULL;
+}
+
+/* FALSE, if the event does not come from the pool or was freed already */
+gboolean mgtk_event_pool_free(gpointer event) {
+  EventHeader *header;
+  guint size_class;
+
+  if(!live_events || !g_hash_table_remove(live_events,event)) {
+    return FALSE;
+  }
+
+  header=EVENT_HEADER(event);
+  size_class=header->size_class;
+
+  if(size_class==NO_CLASS || n_free_events[size_class] >= MGTK_EVENT_POOL_KEEP) {
+    g_free(header);
+    return TRUE;
+  }
+
+  header->next=free_events[size_class];
+  free_events[size_class]=header;
+  n_free_events[size_class]++;
+
+  return TRUE;
+}
+
+guint mgtk_event_pool_live(void) {
+
+  return live_events ? g_hash_table_size(live_events) : 0;
+}
+
+/* called from gtk_main on exit, events still alive stay valid */
+void mgtk_event_pool_cleanup(void) {
+  EventHeader *header;
+  guint i;
+
+  for(i=0;i<MGTK_EVENT_POOL_CLASSES;i++) {
+    while((header=free_events[i])) {
+      free_events[i]=header->next;
+      g_free(header);
+    }
+    n_free_events[i]=0;
+  }
+}
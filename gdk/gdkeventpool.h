@@ -0,0 +1,61 @@
+/*****************************************************************************
+ *
+ * gtk-mui - a wrapper library to wrap GTK+ calls to MUI
+ *
+ * Copyright (C) 2005 Oliver Brunner
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+ *
+ * Contact information:
+ *
+ * Oliver Brunner
+ *
+ * E-Mail: gtk-mui "at" oliver-brunner.de
+ *
+ * $Id: gdkeventpool.h,v 1.1 2026/10/19 22:00:00 o1i Exp $
+ *
+ *****************************************************************************/
+
+#ifndef MGTK_EVENTPOOL_H
+#define MGTK_EVENTPOOL_H
+
+/* Memory for GdkEvents, used by gdk_event_new/copy/free.
+ *
+ * Events come from freelists, one for every size class of
+ * MGTK_EVENT_POOL_GRAIN bytes, so a stream of motion or expose events
+ * never reaches the system allocator. A header in front of an event
+ * remembers its class, so it can be freed even if its type (and so its
+ * size) was changed in between.
+ *
+ * The pool keeps a registry of the events it handed out, so it can tell
+ * its own events from GdkEvents on the stack or inside other structures
+ * without looking at the memory in front of them.
+ *
+ * Only depends on glib, so it can be built and tried out on any host.
+ */
+
+#include <glib.h>
+
+#define MGTK_EVENT_POOL_GRAIN   16
+#define MGTK_EVENT_POOL_CLASSES 16     /* bigger events are not pooled */
+#define MGTK_EVENT_POOL_KEEP    32     /* free events kept per class */
+
+gpointer mgtk_event_pool_alloc  (gsize size);
+gboolean mgtk_event_pool_owns   (gconstpointer event);
+gboolean mgtk_event_pool_free   (gpointer event);
+guint    mgtk_event_pool_live   (void);
+void     mgtk_event_pool_cleanup(void);
+
+#endif
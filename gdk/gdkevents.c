@@ -35,6 +35,7 @@
 
 #include "gdk.h"
 #include "gdkevents.h"
+#include "gdkeventpool.h"
 #if 0
 #include "gdkinternals.h"
 #include "gdkalias.h"
@@ -42,6 +43,98 @@
 
 #include "debug.h"
 
+/*
+ * GTK-MUI: event allocation
+ *
+ * Events come from the freelists in gdkeventpool.c and only get
+ * the size of the member their type uses. The pool knows, which
+ * events are its own, so gdk_event_free refuses events on the
+ * stack or inside other structures (like the expose event of the
+ * Custom class) without touching the memory in front of them.
+ *
+ * GdkWindows are not GObjects here (see gdk_window_new), they
+ * belong to their widget. So windows are only referenced by an
+ * event, if they are real objects (pixmaps).
+ */
+
+static gsize
+event_size (GdkEventType type)
+{
+  switch (type)
+    {
+    case GDK_EXPOSE:            return sizeof (GdkEventExpose);
+    case GDK_NO_EXPOSE:         return sizeof (GdkEventNoExpose);
+    case GDK_VISIBILITY_NOTIFY: return sizeof (GdkEventVisibility);
+    case GDK_MOTION_NOTIFY:     return sizeof (GdkEventMotion);
+    case GDK_BUTTON_PRESS:
+    case GDK_2BUTTON_PRESS:
+    case GDK_3BUTTON_PRESS:
+    case GDK_BUTTON_RELEASE:    return sizeof (GdkEventButton);
+    case GDK_SCROLL:            return sizeof (GdkEventScroll);
+    case GDK_KEY_PRESS:
+    case GDK_KEY_RELEASE:       return sizeof (GdkEventKey);
+    case GDK_ENTER_NOTIFY:
+    case GDK_LEAVE_NOTIFY:      return sizeof (GdkEventCrossing);
+    case GDK_FOCUS_CHANGE:      return sizeof (GdkEventFocus);
+    case GDK_CONFIGURE:         return sizeof (GdkEventConfigure);
+    case GDK_PROPERTY_NOTIFY:   return sizeof (GdkEventProperty);
+    case GDK_SELECTION_CLEAR:
+    case GDK_SELECTION_REQUEST:
+    case GDK_SELECTION_NOTIFY:  return sizeof (GdkEventSelection);
+    case GDK_OWNER_CHANGE:      return sizeof (GdkEventOwnerChange);
+    case GDK_PROXIMITY_IN:
+    case GDK_PROXIMITY_OUT:     return sizeof (GdkEventProximity);
+    case GDK_CLIENT_EVENT:      return sizeof (GdkEventClient);
+    case GDK_DRAG_ENTER:
+    case GDK_DRAG_LEAVE:
+    case GDK_DRAG_MOTION:
+    case GDK_DRAG_STATUS:
+    case GDK_DROP_START:
+    case GDK_DROP_FINISHED:     return sizeof (GdkEventDND);
+    case GDK_WINDOW_STATE:      return sizeof (GdkEventWindowState);
+    case GDK_SETTING:           return sizeof (GdkEventSetting);
+    default:                    return sizeof (GdkEventAny);
+    }
+}
+
+static GdkEvent *
+event_alloc (GdkEventType type)
+{
+  return mgtk_event_pool_alloc (event_size (type));
+}
+
+static void
+event_ref_object (gpointer object)
+{
+  if (object && G_IS_OBJECT (object))
+    g_object_ref (object);
+}
+
+static void
+event_unref_object (gpointer object)
+{
+  if (object && G_IS_OBJECT (object))
+    g_object_unref (object);
+}
+
+/**
+ * gdk_event_new:
+ * @type: a #GdkEventType 
+ * 
+ * Creates a new event of the given type. All fields are set to 0.
+ * 
+ * Return value: a newly-allocated #GdkEvent. The returned #GdkEvent 
+ * should be freed with gdk_event_free().
+ **/
+GdkEvent *gdk_event_new (GdkEventType type) {
+  GdkEvent *new_event;
+
+  new_event = event_alloc (type);
+  new_event->any.type = type;
+
+  return new_event;
+}
+
 /**
  * gdk_event_copy:
  * @event: a #GdkEvent
@@ -53,34 +146,15 @@
  * gdk_event_free().
  **/
 GdkEvent *gdk_event_copy (GdkEvent *event) {
-
-#if 0
-  GdkEventPrivate *new_private;
   GdkEvent *new_event;
-#endif
-  
-  g_return_val_if_fail (event != NULL, NULL);
 
-  ErrOut("gdk_event_copy(%lx) not done yet!\n",event);
-  return event;
-#if 0
-  
-  new_event = gdk_event_new (GDK_NOTHING);
-  new_private = (GdkEventPrivate *)new_event;
+  g_return_val_if_fail (event != NULL, NULL);
 
-  *new_event = *event;
-  if (new_event->any.window)
-    g_object_ref (new_event->any.window);
+  new_event = event_alloc (event->any.type);
+  memcpy (new_event, event, event_size (event->any.type));
 
-#if 0
-  if (gdk_event_is_allocated (event))
-    {
-      GdkEventPrivate *private = (GdkEventPrivate *)event;
+  event_ref_object (new_event->any.window);
 
-      new_private->screen = private->screen;
-    }
-#endif
-  
   switch (event->any.type)
     {
     case GDK_KEY_PRESS:
@@ -90,8 +164,7 @@ GdkEvent *gdk_event_copy (GdkEvent *event) {
       
     case GDK_ENTER_NOTIFY:
     case GDK_LEAVE_NOTIFY:
-      if (event->crossing.subwindow != NULL)
-	g_object_ref (event->crossing.subwindow);
+      event_ref_object (event->crossing.subwindow);
       break;
       
     case GDK_DRAG_ENTER:
@@ -100,42 +173,35 @@ GdkEvent *gdk_event_copy (GdkEvent *event) {
     case GDK_DRAG_STATUS:
     case GDK_DROP_START:
     case GDK_DROP_FINISHED:
-      g_object_ref (event->dnd.context);
+      event_ref_object (event->dnd.context);
       break;
       
-#if 0
     case GDK_EXPOSE:
       if (event->expose.region)
 	new_event->expose.region = gdk_region_copy (event->expose.region);
       break;
-#endif
       
     case GDK_SETTING:
       new_event->setting.name = g_strdup (new_event->setting.name);
       break;
 
-#if 0
+    /* there are no devices with axes, so axes can't be sized */
     case GDK_BUTTON_PRESS:
+    case GDK_2BUTTON_PRESS:
+    case GDK_3BUTTON_PRESS:
     case GDK_BUTTON_RELEASE:
-      if (event->button.axes) 
-	new_event->button.axes = g_memdup (event->button.axes, 
-					     sizeof (gdouble) * event->button.device->num_axes);
+      new_event->button.axes = NULL;
       break;
 
     case GDK_MOTION_NOTIFY:
-      if (event->motion.axes) 
-	new_event->motion.axes = g_memdup (event->motion.axes, 
-					   sizeof (gdouble) * event->motion.device->num_axes);
-      
+      new_event->motion.axes = NULL;
       break;
-#endif
       
     default:
       break;
     }
   
   return new_event;
-#endif
 }
 
 /**
@@ -151,14 +217,13 @@ void gdk_event_free (GdkEvent *event) {
 
   g_return_if_fail (event != NULL);
 
-  ErrOut("gdk_event_free(%lx) needs to be debugged..\n",event);
+  if (!mgtk_event_pool_owns (event))
+    {
+      ErrOut ("gdk_event_free(%lx): event was not allocated by gdk\n", event);
+      return;
+    }
 
-#if 0
-  g_assert (event_chunk != NULL); /* paranoid */
-#endif
-  
-  if (event->any.window)
-    g_object_unref (event->any.window);
+  event_unref_object (event->any.window);
   
   switch (event->any.type)
     {
@@ -169,8 +234,7 @@ void gdk_event_free (GdkEvent *event) {
       
     case GDK_ENTER_NOTIFY:
     case GDK_LEAVE_NOTIFY:
-      if (event->crossing.subwindow != NULL)
-	g_object_unref (event->crossing.subwindow);
+      event_unref_object (event->crossing.subwindow);
       break;
       
     case GDK_DRAG_ENTER:
@@ -179,25 +243,23 @@ void gdk_event_free (GdkEvent *event) {
     case GDK_DRAG_STATUS:
     case GDK_DROP_START:
     case GDK_DROP_FINISHED:
-      g_object_unref (event->dnd.context);
+      event_unref_object (event->dnd.context);
       break;
 
     case GDK_BUTTON_PRESS:
+    case GDK_2BUTTON_PRESS:
+    case GDK_3BUTTON_PRESS:
     case GDK_BUTTON_RELEASE:
-      if (event->button.axes)
-	g_free (event->button.axes);
+      g_free (event->button.axes);
       break;
       
-#if 0
     case GDK_EXPOSE:
       if (event->expose.region)
 	gdk_region_destroy (event->expose.region);
       break;
-#endif
       
     case GDK_MOTION_NOTIFY:
-      if (event->motion.axes)
-	g_free (event->motion.axes);
+      g_free (event->motion.axes);
       break;
       
     case GDK_SETTING:
@@ -208,13 +270,9 @@ void gdk_event_free (GdkEvent *event) {
       break;
     }
 
-#if 0
-  g_hash_table_remove (event_hash, event);
-  g_mem_chunk_free (event_chunk, event);
-#endif
+  mgtk_event_pool_free (event);
 }
 
-
 GType gdk_event_get_type (void) {
 
   static GType our_type = 0;
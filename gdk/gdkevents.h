@@ -491,6 +491,9 @@ union _GdkEvent
 
 GType     gdk_event_get_type            (void) G_GNUC_CONST;
 
+/* GTK-MUI private: frees the event pools */
+void      mgtk_event_pool_cleanup       (void);
+
 gboolean  gdk_events_pending	 	(void);
 GdkEvent* gdk_event_get			(void);
 
@@ -27,6 +27,7 @@
 /* modified by o1i 2005 */
 
 #include <stdio.h>
+#include <string.h>
 #include <proto/intuition.h>
 #include <proto/graphics.h>
 #include <proto/exec.h>
@@ -36,6 +37,186 @@
 #include <gtk/gtk.h>
 #include "../gtk_globals.h"
 
+/*********************************
+ * gc allocation and gc pool
+ *
+ * A gc is a single block, its colour is stored
+ * inline (gc->mgtk_color). Styles share their gcs through
+ * a pool keyed by colour/pen, function and line attributes.
+ * Pooled gcs must not be changed, use gdk_gc_new for that.
+ *********************************/
+
+static GHashTable *gc_pool=NULL;
+
+static GdkGC *allocgc(void) {
+  GdkGC *ret;
+
+  ret=g_new0(GdkGC,1);
+
+  ret->function=GDK_COPY;
+  ret->line_width=0;
+  ret->line_style=GDK_LINE_SOLID;
+  ret->cap_style=GDK_CAP_BUTT;
+  ret->join_style=GDK_JOIN_MITER;
+  ret->mgtk_ref_count=1;
+
+  return ret;
+}
+
+GdkGC *gdk_gc_new(GdkDrawable *drawable) {
+
+  return allocgc();
+}
+
+/* a private gc, which draws with a fixed pen */
+GdkGC *mgtk_gc_new_pen(gint pen) {
+  GdkGC *ret;
+
+  ret=allocgc();
+
+  ret->mgtk_color.pen=pen;
+  ret->mgtk_color.havepen=1;
+
+  return ret;
+}
+
+static guint gc_pool_hash(gconstpointer key) {
+  const GdkGC *gc=key;
+  guint h;
+
+  if(gc->mgtk_color.havepen) {
+    h=0x10000 | gc->mgtk_color.pen;
+  }
+  else {
+    h=(gc->mgtk_color.red >> 8) | (gc->mgtk_color.green & 0xff00) | 
+      ((gc->mgtk_color.blue & 0xff00) << 8);
+  }
+
+  h=h*31 + gc->function;
+  h=h*31 + gc->line_width;
+  h=h*31 + (gc->line_style << 4 | gc->cap_style << 2 | gc->join_style);
+
+  return h;
+}
+
+static gboolean gc_pool_equal(gconstpointer a, gconstpointer b) {
+  const GdkGC *gc1=a;
+  const GdkGC *gc2=b;
+
+  if(gc1->mgtk_color.havepen != gc2->mgtk_color.havepen) {
+    return FALSE;
+  }
+
+  if(gc1->mgtk_color.havepen) {
+    if(gc1->mgtk_color.pen != gc2->mgtk_color.pen) {
+      return FALSE;
+    }
+  }
+  else if(gc1->mgtk_color.red   != gc2->mgtk_color.red   ||
+          gc1->mgtk_color.green != gc2->mgtk_color.green ||
+          gc1->mgtk_color.blue  != gc2->mgtk_color.blue) {
+    return FALSE;
+  }
+
+  return gc1->function   == gc2->function   &&
+         gc1->line_width == gc2->line_width &&
+         gc1->line_style == gc2->line_style &&
+         gc1->cap_style  == gc2->cap_style  &&
+         gc1->join_style == gc2->join_style;
+}
+
+/* returns a shared gc with one more reference, 
+ * release it with mgtk_gc_release
+ */
+GdkGC *mgtk_gc_get(const GdkColor *color, GdkFunction function, gint line_width,
+                   GdkLineStyle line_style, GdkCapStyle cap_style, GdkJoinStyle join_style) {
+  GdkGC key;
+  GdkGC *ret;
+
+  if(!gc_pool) {
+    gc_pool=g_hash_table_new(gc_pool_hash, gc_pool_equal);
+  }
+
+  memset(&key, 0, sizeof(GdkGC));
+  if(color) {
+    key.mgtk_color=*color;
+  }
+  key.function=function;
+  key.line_width=line_width;
+  key.line_style=line_style;
+  key.cap_style=cap_style;
+  key.join_style=join_style;
+
+  ret=g_hash_table_lookup(gc_pool, &key);
+  if(ret) {
+    ret->mgtk_ref_count++;
+    return ret;
+  }
+
+  ret=allocgc();
+  ret->mgtk_color=key.mgtk_color;
+  ret->function=function;
+  ret->line_width=line_width;
+  ret->line_style=line_style;
+  ret->cap_style=cap_style;
+  ret->join_style=join_style;
+  ret->mgtk_shared=1;
+
+  g_hash_table_insert(gc_pool, ret, ret);
+
+  DebOut("mgtk_gc_get: new shared gc %lx (%d gcs in pool)\n",ret,g_hash_table_size(gc_pool));
+
+  return ret;
+}
+
+void mgtk_gc_release(GdkGC *gc) {
+
+  if(!gc) {
+    return;
+  }
+
+  if(gc->mgtk_ref_count > 1) {
+    gc->mgtk_ref_count--;
+    return;
+  }
+
+  if(gc->mgtk_shared) {
+    g_hash_table_remove(gc_pool, gc);
+  }
+
+  g_free(gc->mgtk_dashes);
+  g_free(gc);
+}
+
+GdkGC *gdk_gc_ref(GdkGC *gc) {
+
+  gc->mgtk_ref_count++;
+
+  return gc;
+}
+
+void gdk_gc_unref(GdkGC *gc) {
+
+  mgtk_gc_release(gc);
+}
+
+void gdk_gc_set_rgb_fg_color(GdkGC *gc, const GdkColor *color) {
+
+  DebOut("gdk_gc_set_rgb_fg_color(%lx,%lx)",gc,color);
+
+  if(gc->mgtk_shared) {
+    ErrOut("gdk_gc_set_rgb_fg_color: gc %lx is shared and must not be changed!\n",gc);
+    return;
+  }
+
+  gc->mgtk_color.red=color->red;
+  gc->mgtk_color.green=color->green;
+  gc->mgtk_color.blue=color->blue;
+  gc->mgtk_color.havepen=0;
+
+  /* TODO: ObtainPen..? */
+}
+
 /**
  * gdk_gc_set_dashes:
  * @gc: a #GdkGC.
@@ -60,13 +241,26 @@ gdk_gc_set_dashes (GdkGC *gc,
 		   gint8  dash_list[],
 		   gint   n)
 {
-  g_return_if_fail (GDK_IS_GC (gc));
+  gint i;
+
+  g_return_if_fail (gc != NULL);
   g_return_if_fail (dash_list != NULL);
 
-  DebOut("WARNING: gdk_gc_set_dashes: TODO\n");
-#warning gdk_gc_set_dashes: TODO
+  DebOut("gdk_gc_set_dashes(%lx,%d,%lx,%d)\n",gc,dash_offset,dash_list,n);
 
-/*  GDK_GC_GET_CLASS (gc)->set_dashes (gc, dash_offset, dash_list, n);*/
+  if(gc->mgtk_shared) {
+    ErrOut("gdk_gc_set_dashes: gc %lx is shared and must not be changed!\n",gc);
+    return;
+  }
+
+  for(i=0;i<n;i++) {
+    g_return_if_fail (dash_list[i] > 0);
+  }
+
+  g_free(gc->mgtk_dashes);
+  gc->mgtk_dashes=n>0 ? g_memdup(dash_list, n) : NULL;
+  gc->mgtk_n_dashes=n;
+  gc->mgtk_dash_offset=dash_offset;
 }
 
 /**
@@ -88,23 +282,18 @@ gdk_gc_set_line_attributes (GdkGC	*gc,
 			    GdkCapStyle	 cap_style,
 			    GdkJoinStyle join_style)
 {
+  g_return_if_fail (gc != NULL);
 
-#warning gdk_gc_set_line_attributes: TODO
-  DebOut("WARNING: gdk_gc_set_line_attributes: TODO\n");
-
-#if 0
-  GdkGCValues values;
+  DebOut("gdk_gc_set_line_attributes(%lx,%d,%d,%d,%d)\n",gc,line_width,line_style,cap_style,join_style);
 
-  values.line_width = line_width;
-  values.line_style = line_style;
-  values.cap_style = cap_style;
-  values.join_style = join_style;
+  if(gc->mgtk_shared) {
+    ErrOut("gdk_gc_set_line_attributes: gc %lx is shared and must not be changed!\n",gc);
+    return;
+  }
 
-  gdk_gc_set_values (gc, &values,
-		     GDK_GC_LINE_WIDTH |
-		     GDK_GC_LINE_STYLE |
-		     GDK_GC_CAP_STYLE |
-		     GDK_GC_JOIN_STYLE);
-#endif
+  gc->line_width=MAX(line_width,0);
+  gc->line_style=line_style;
+  gc->cap_style=cap_style;
+  gc->join_style=join_style;
 }
 
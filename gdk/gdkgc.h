@@ -168,6 +168,19 @@ struct _GdkGC
   gint ts_y_origin;
 
   GdkColormap *colormap;
+
+  /* GTK-MUI private */
+  GdkColor     mgtk_color;     /* foreground colour/pen, stored inline */
+  GdkFunction  function;
+  gint         line_width;
+  GdkLineStyle line_style;
+  GdkCapStyle  cap_style;
+  GdkJoinStyle join_style;
+  gint8       *mgtk_dashes;    /* NULL: 4 on, 4 off */
+  gint         mgtk_n_dashes;
+  gint         mgtk_dash_offset;
+  guint        mgtk_ref_count;
+  guint        mgtk_shared : 1; /* owned by the gc pool, don't modify */
 };
 
 struct _GdkGCClass 
@@ -265,6 +278,16 @@ void         gdk_gc_set_rgb_bg_color (GdkGC          *gc,
 				      const GdkColor *color);
 GdkScreen *  gdk_gc_get_screen	     (GdkGC          *gc);
 
+/* GTK-MUI private: gcs shared by colour, function and line attributes */
+GdkGC *mgtk_gc_new_pen  (gint            pen);
+GdkGC *mgtk_gc_get      (const GdkColor *color,
+			 GdkFunction     function,
+			 gint            line_width,
+			 GdkLineStyle    line_style,
+			 GdkCapStyle     cap_style,
+			 GdkJoinStyle    join_style);
+void   mgtk_gc_release  (GdkGC          *gc);
+
 #ifndef GDK_DISABLE_DEPRECATED
 #define gdk_gc_destroy                 gdk_gc_unref
 #endif /* GDK_DISABLE_DEPRECATED */
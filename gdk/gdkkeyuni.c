@@ -0,0 +1,131 @@
+/*****************************************************************************
+ *
+ * gtk-mui - a wrapper library to wrap GTK+ calls to MUI
+ *
+ * Copyright (C) 2005 Oliver Brunner
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+ *
+ * Contact information:
+ *
+ * Oliver Brunner
+ *
+ * E-Mail: gtk-mui "at" oliver-brunner.de
+ *
+ * $Id: gdkkeyuni.c,v 1.1 2026/10/19 14:00:00 o1i Exp $
+ *
+ *****************************************************************************/
+
+
+/* Keyval case conversion and the keyval <-> unicode mapping.
+ *
+ * All three are lookups in two-level tables, generated by gen-keytab.py
+ * into gdkkeytab.h: the high bits of the key select a block in the index,
+ * the low bits the entry in the block. Empty blocks are all shared, so
+ * the tables stay small and every lookup costs two array accesses.
+ *
+ * Directly encoded unicode keyvals (0x01000000 | ucs) need no table,
+ * their case comes from glib.
+ */
+
+#include <glib.h>
+
+#include "gdkkeys.h"
+#include "gdkkeytab.h"
+
+#define LOOKUP(table,TABLE,key) \
+  ((key) < TABLE##_LIMIT ? table##_blocks[table##_index[(key) >> TABLE##_SHIFT]][(key) & TABLE##_MASK] : 0)
+
+#define IS_UCS_KEYVAL(k) (((k) & 0xff000000) == 0x01000000)
+
+/**
+ * gdk_keyval_to_unicode:
+ * @keyval: a GDK key symbol
+ *
+ * Convert from a GDK key symbol to the corresponding ISO10646 (Unicode)
+ * character.
+ *
+ * Return value: the corresponding unicode character, or 0 if there
+ *               is no corresponding character.
+ **/
+guint32 gdk_keyval_to_unicode(guint keyval) {
+  if(IS_UCS_KEYVAL(keyval)) {
+    return keyval & 0x00ffffff;
+  }
+
+  return LOOKUP(keyval_ucs,KEYVAL_UCS,keyval);
+}
+
+/**
+ * gdk_unicode_to_keyval:
+ * @wc: a ISO10646 encoded character
+ *
+ * Convert from a ISO10646 character to a key symbol.
+ *
+ * Return value: the corresponding GDK key symbol, if one exists.
+ *               or, if there is no corresponding symbol,
+ *               wc | 0x01000000
+ **/
+guint gdk_unicode_to_keyval(guint32 wc) {
+  guint keyval;
+
+  /* Latin-1 maps 1:1 */
+  if((wc >= 0x0020 && wc <= 0x007e) || (wc >= 0x00a0 && wc <= 0x00ff)) {
+    return wc;
+  }
+
+  keyval=LOOKUP(ucs_keyval,UCS_KEYVAL,wc);
+  if(keyval) {
+    return keyval;
+  }
+
+  return wc | 0x01000000;
+}
+
+/**
+ * gdk_keyval_convert_case:
+ * @symbol: a keyval
+ * @lower: return location for lowercase version of @symbol
+ * @upper: return location for uppercase version of @symbol
+ *
+ * Obtains the upper- and lower-case versions of the keyval @symbol.
+ * Examples of keyvals are #GDK_a, #GDK_Enter, #GDK_F1, etc.
+ **/
+void gdk_keyval_convert_case(guint symbol, guint *lower, guint *upper) {
+  guint xlower=symbol;
+  guint xupper=symbol;
+  guint other;
+
+  if(IS_UCS_KEYVAL(symbol)) {
+    xlower=gdk_unicode_to_keyval(g_unichar_tolower(symbol & 0x00ffffff));
+    xupper=gdk_unicode_to_keyval(g_unichar_toupper(symbol & 0x00ffffff));
+  }
+  else {
+    other=LOOKUP(keyval_case,KEYVAL_CASE,symbol);
+    if(other & KEYVAL_CASE_UPPER) {
+      xlower=other & ~KEYVAL_CASE_UPPER;
+    }
+    else if(other) {
+      xupper=other;
+    }
+  }
+
+  if(lower) {
+    *lower=xlower;
+  }
+  if(upper) {
+    *upper=xupper;
+  }
+}
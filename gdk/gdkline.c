@@ -0,0 +1,484 @@
+/*****************************************************************************
+ *
+ * gtk-mui - a wrapper library to wrap GTK+ calls to MUI
+ *
+ * Copyright (C) 2005 Oliver Brunner
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+ *
+ * Contact information:
+ *
+ * Oliver Brunner
+ *
+ * E-Mail: gtk-mui "at" oliver-brunner.de
+ *
+ * $Id: gdkline.c,v 1.1 2026/10/19 17:00:00 o1i Exp $
+ *
+ *****************************************************************************/
+
+/* wide and dashed lines, see gdkline.h */
+
+#include <math.h>
+#include <string.h>
+
+#include "gdkline.h"
+
+/* arcs of round caps and joins get one segment per SEGMENT_PIXELS */
+#define SEGMENT_PIXELS 2.0
+#define MAX_SEGMENTS   64
+
+/* X11 miters up to an angle of 11 degrees between the lines, below
+ * that the join is a bevel. 1+cos(180-11 degrees) */
+#define MITER_LIMIT 0.01838
+
+static const gint8 default_dashes[2] = { 4, 4 };
+
+/* position in the dash pattern */
+typedef struct {
+  const gint8 *list;
+  gint         n_list;
+  gint         n;      /* period, an odd list is used twice */
+  gint         index;  /* even: on */
+  gdouble      left;   /* of the current dash */
+} Dash;
+
+#define DASH_LEN(d,i) MAX(1,(d)->list[(i) % (d)->n_list])
+#define DASH_ON(d)    (!((d)->index & 1))
+
+typedef struct {
+  const MgtkLineAttr *attr;
+  Dash               *dash;   /* NULL: solid */
+  gdouble             half;   /* of the width */
+  MgtkRunFunc         run;
+  MgtkSpanFunc        span;
+  gpointer            data;
+} Line;
+
+static void dash_next(Dash *d) {
+
+  d->index=(d->index+1) % d->n;
+  d->left=DASH_LEN(d,d->index);
+}
+
+static void dash_init(Dash *d, const MgtkLineAttr *attr) {
+  gint period;
+  gint offset;
+  gint i;
+
+  if(attr->dashes && attr->n_dashes>0) {
+    d->list=attr->dashes;
+    d->n_list=attr->n_dashes;
+  }
+  else {
+    d->list=default_dashes;
+    d->n_list=2;
+  }
+  d->n=(d->n_list & 1) ? 2*d->n_list : d->n_list;
+
+  period=0;
+  for(i=0;i<d->n;i++) {
+    period+=DASH_LEN(d,i);
+  }
+  offset=attr->dash_offset % period;
+  if(offset<0) {
+    offset+=period;
+  }
+
+  d->index=0;
+  d->left=DASH_LEN(d,0);
+  while(offset>=d->left) {
+    offset-=(gint) d->left;
+    dash_next(d);
+  }
+  d->left-=offset;
+}
+
+/* advance by one thin pixel, TRUE if it is on */
+static gboolean dash_pixel(Dash *d) {
+  gboolean on;
+
+  on=DASH_ON(d);
+  d->left-=1;
+  if(d->left<=0) {
+    dash_next(d);
+  }
+  return on;
+}
+
+/*********************************
+ * thin lines
+ *********************************/
+
+/* Bresenham from x0,y0 to x1,y1, dashed or without one of the ends */
+static void thin_segment(Line *l, gint x0, gint y0, gint x1, gint y1, gboolean skip_first, gboolean skip_last) {
+  gint dx, dy, sx, sy, err, e2;
+  gint steps, i;
+  gint x, y;
+  gint rx=0, ry=0, lx=0, ly=0;
+  gboolean in_run;
+  gboolean on;
+
+  if(!l->dash && !skip_last) {
+    l->run(x0,y0,x1,y1,l->data);
+    return;
+  }
+
+  dx=ABS(x1-x0);
+  dy=ABS(y1-y0);
+  sx=x0<x1 ? 1 : -1;
+  sy=y0<y1 ? 1 : -1;
+  err=dx-dy;
+  steps=MAX(dx,dy);
+
+  x=x0;
+  y=y0;
+  in_run=FALSE;
+  for(i=0;i<=steps;i++) {
+    if((i>0 || !skip_first) && (i<steps || !skip_last)) {
+      on=l->dash ? dash_pixel(l->dash) : TRUE;
+      if(on) {
+        if(!in_run) {
+          rx=x;
+          ry=y;
+          in_run=TRUE;
+        }
+        lx=x;
+        ly=y;
+      }
+      else if(in_run) {
+        l->run(rx,ry,lx,ly,l->data);
+        in_run=FALSE;
+      }
+    }
+
+    e2=2*err;
+    if(e2 > -dy) {
+      err-=dy;
+      x+=sx;
+    }
+    if(e2 < dx) {
+      err+=dx;
+      y+=sy;
+    }
+  }
+
+  if(in_run) {
+    l->run(rx,ry,lx,ly,l->data);
+  }
+}
+
+/* every pixel once, so the dashes don't stutter at the vertices */
+static void thin_polyline(Line *l, const MgtkLinePoint *p, gint n, gboolean closed) {
+  gboolean not_last;
+  gint i;
+
+  if(n==1) {
+    thin_segment(l,p[0].x,p[0].y,p[0].x,p[0].y,FALSE,FALSE);
+    return;
+  }
+
+  not_last=closed || l->attr->cap==MGTK_CAP_NOT_LAST;
+  for(i=0;i<n-1;i++) {
+    thin_segment(l,p[i].x,p[i].y,p[i+1].x,p[i+1].y,i>0,not_last && i==n-2);
+  }
+}
+
+/*********************************
+ * wide lines
+ *********************************/
+
+/* half circle around c, from c+h*a through c+h*b to c-h*a */
+static gint half_circle(MgtkScanPoint *out, MgtkScanPoint c, MgtkScanPoint a, MgtkScanPoint b, gdouble h) {
+  gint segments;
+  gint i;
+  gdouble t;
+
+  segments=CLAMP((gint) ceil(G_PI*h/SEGMENT_PIXELS),2,MAX_SEGMENTS);
+  for(i=0;i<=segments;i++) {
+    t=G_PI*i/segments;
+    out[i].x=c.x + h*(a.x*cos(t) + b.x*sin(t));
+    out[i].y=c.y + h*(a.y*cos(t) + b.y*sin(t));
+  }
+  return segments+1;
+}
+
+static void wide_dot(Line *l, MgtkScanPoint c) {
+  MgtkScanPoint poly[2*(MAX_SEGMENTS+1)];
+  MgtkScanPoint a={1,0};
+  MgtkScanPoint b={0,1};
+  MgtkScanPoint na={-1,0};
+  MgtkScanPoint nb={0,-1};
+  gdouble h=l->half;
+  gint n;
+
+  switch(l->attr->cap) {
+    case MGTK_CAP_ROUND:
+      n=half_circle(poly,c,a,b,h);
+      n+=half_circle(poly+n,c,na,nb,h);
+      break;
+    case MGTK_CAP_PROJECTING:
+      poly[0].x=c.x-h; poly[0].y=c.y-h;
+      poly[1].x=c.x+h; poly[1].y=c.y-h;
+      poly[2].x=c.x+h; poly[2].y=c.y+h;
+      poly[3].x=c.x-h; poly[3].y=c.y+h;
+      n=4;
+      break;
+    default:
+      return;
+  }
+  mgtk_scan_polygon(poly,n,l->span,l->data);
+}
+
+/* the part p0..p1 of a line with direction u and normal nv */
+static void wide_piece(Line *l, MgtkScanPoint p0, MgtkScanPoint p1, MgtkScanPoint u, MgtkScanPoint nv,
+                       gboolean start_cap, gboolean end_cap) {
+  MgtkScanPoint poly[2*(MAX_SEGMENTS+1)+4];
+  MgtkScanPoint nu;
+  MgtkScanPoint nn;
+  gdouble h=l->half;
+  gint n;
+
+  if(l->attr->cap==MGTK_CAP_PROJECTING) {
+    if(start_cap) {
+      p0.x-=u.x*h;
+      p0.y-=u.y*h;
+    }
+    if(end_cap) {
+      p1.x+=u.x*h;
+      p1.y+=u.y*h;
+    }
+  }
+
+  if(l->attr->cap!=MGTK_CAP_ROUND) {
+    start_cap=FALSE;
+    end_cap=FALSE;
+  }
+
+  nu.x=-u.x;
+  nu.y=-u.y;
+  nn.x=-nv.x;
+  nn.y=-nv.y;
+
+  n=0;
+  poly[n].x=p0.x+nv.x*h;
+  poly[n].y=p0.y+nv.y*h;
+  n++;
+  if(end_cap) {
+    n+=half_circle(poly+n,p1,nv,u,h);
+  }
+  else {
+    poly[n].x=p1.x+nv.x*h;
+    poly[n].y=p1.y+nv.y*h;
+    n++;
+    poly[n].x=p1.x-nv.x*h;
+    poly[n].y=p1.y-nv.y*h;
+    n++;
+  }
+  if(start_cap) {
+    n+=half_circle(poly+n,p0,nn,nu,h);
+  }
+  else {
+    poly[n].x=p0.x-nv.x*h;
+    poly[n].y=p0.y-nv.y*h;
+    n++;
+  }
+
+  mgtk_scan_polygon(poly,n,l->span,l->data);
+}
+
+/* fills the gap at vertex v between a line with direction u1 and the
+ * next one with direction u2 */
+static void wide_join(Line *l, MgtkScanPoint v, MgtkScanPoint u1, MgtkScanPoint u2) {
+  MgtkScanPoint poly[2*(MAX_SEGMENTS+1)];
+  MgtkScanPoint n1={-u1.y,u1.x};
+  MgtkScanPoint n2={-u2.y,u2.x};
+  MgtkScanPoint a={1,0};
+  MgtkScanPoint b={0,1};
+  MgtkScanPoint na={-1,0};
+  MgtkScanPoint nb={0,-1};
+  gdouble h=l->half;
+  gdouble cross;
+  gdouble dot;
+  gdouble s;
+  gint n;
+
+  cross=u1.x*u2.y - u1.y*u2.x;
+  dot=u1.x*u2.x + u1.y*u2.y;
+  if(fabs(cross)<1e-9 && dot>0) {
+    return;    /* straight on */
+  }
+
+  if(l->attr->join==MGTK_JOIN_ROUND) {
+    n=half_circle(poly,v,a,b,h);
+    n+=half_circle(poly+n,v,na,nb,h);
+    mgtk_scan_polygon(poly,n,l->span,l->data);
+    return;
+  }
+
+  /* the gap is on the outer side of the turn */
+  s=cross>0 ? -h : h;
+
+  n=0;
+  poly[n++]=v;
+  poly[n].x=v.x+s*n1.x;
+  poly[n].y=v.y+s*n1.y;
+  n++;
+  if(l->attr->join==MGTK_JOIN_MITER && 1.0+dot >= MITER_LIMIT) {
+    poly[n].x=v.x+s*(n1.x+n2.x)/(1.0+dot);
+    poly[n].y=v.y+s*(n1.y+n2.y)/(1.0+dot);
+    n++;
+  }
+  poly[n].x=v.x+s*n2.x;
+  poly[n].y=v.y+s*n2.y;
+  n++;
+
+  mgtk_scan_polygon(poly,n,l->span,l->data);
+}
+
+/* p has no repeated points, n>=2 */
+static void wide_polyline(Line *l, const MgtkLinePoint *p, gint n, gboolean closed) {
+  MgtkScanPoint a, b, u, nv, first_u, prev_u;
+  MgtkScanPoint p0, p1;
+  gdouble len, t, step;
+  gboolean joined;    /* the previous segment reached this vertex on */
+  gboolean on, start_cap, end_cap;
+  gint i;
+
+  /* solid closed lines are joined at the first point, too */
+  joined=closed && !l->dash;
+  first_u.x=first_u.y=0;
+  prev_u=first_u;
+
+  for(i=0;i<n-1;i++) {
+    /* pixel centres */
+    a.x=p[i].x+0.5;
+    a.y=p[i].y+0.5;
+    b.x=p[i+1].x+0.5;
+    b.y=p[i+1].y+0.5;
+    len=sqrt((b.x-a.x)*(b.x-a.x) + (b.y-a.y)*(b.y-a.y));
+    u.x=(b.x-a.x)/len;
+    u.y=(b.y-a.y)/len;
+    nv.x=-u.y;
+    nv.y=u.x;
+
+    if(i==0) {
+      first_u=u;
+    }
+    else if(joined) {
+      wide_join(l,a,prev_u,u);
+    }
+
+    for(t=0;t<len;t+=step) {
+      if(l->dash) {
+        step=MIN(l->dash->left,len-t);
+        on=DASH_ON(l->dash);
+      }
+      else {
+        step=len-t;
+        on=TRUE;
+      }
+
+      if(on) {
+        start_cap=t>0 || !joined;
+        if(t+step<len) {
+          end_cap=TRUE;                       /* the dash ends here */
+        }
+        else if(l->dash && l->dash->left-step<=1e-9) {
+          end_cap=TRUE;                       /* .. exactly at the vertex */
+        }
+        else {
+          end_cap=(i==n-2 && !closed);        /* end of the line */
+        }
+
+        p0.x=a.x+u.x*t;
+        p0.y=a.y+u.y*t;
+        p1.x=a.x+u.x*(t+step);
+        p1.y=a.y+u.y*(t+step);
+        wide_piece(l,p0,p1,u,nv,start_cap,end_cap);
+        joined=!end_cap;
+      }
+      else {
+        joined=FALSE;
+      }
+
+      if(l->dash) {
+        l->dash->left-=step;
+        if(l->dash->left<=1e-9) {
+          dash_next(l->dash);
+        }
+      }
+    }
+    prev_u=u;
+  }
+
+  if(closed && joined) {
+    wide_join(l,b,prev_u,first_u);
+  }
+}
+
+/*********************************
+ * polylines
+ *********************************/
+
+void mgtk_line_draw(const MgtkLineAttr *attr, const MgtkLinePoint *points, gint npoints,
+                    MgtkRunFunc run, MgtkSpanFunc span, gpointer data) {
+  MgtkLinePoint *p;
+  MgtkScanPoint c;
+  Dash dash;
+  Line l;
+  gboolean closed;
+  gint n;
+  gint i;
+
+  if(!points || npoints<1) {
+    return;
+  }
+
+  l.attr=attr;
+  l.dash=NULL;
+  if(attr->style!=MGTK_LINE_SOLID) {
+    dash_init(&dash,attr);
+    l.dash=&dash;
+  }
+  l.half=attr->width/2.0;
+  l.run=run;
+  l.span=span;
+  l.data=data;
+
+  /* repeated points would be segments without a direction */
+  p=g_new(MgtkLinePoint,npoints);
+  p[0]=points[0];
+  n=1;
+  for(i=1;i<npoints;i++) {
+    if(points[i].x!=p[n-1].x || points[i].y!=p[n-1].y) {
+      p[n++]=points[i];
+    }
+  }
+  closed=n>2 && p[0].x==p[n-1].x && p[0].y==p[n-1].y;
+
+  if(attr->width<=1) {
+    thin_polyline(&l,p,n,closed);
+  }
+  else if(n==1) {
+    c.x=p[0].x+0.5;
+    c.y=p[0].y+0.5;
+    wide_dot(&l,c);
+  }
+  else {
+    wide_polyline(&l,p,n,closed);
+  }
+
+  g_free(p);
+}
@@ -0,0 +1,80 @@
+/*****************************************************************************
+ *
+ * gtk-mui - a wrapper library to wrap GTK+ calls to MUI
+ *
+ * Copyright (C) 2005 Oliver Brunner
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+ *
+ * Contact information:
+ *
+ * Oliver Brunner
+ *
+ * E-Mail: gtk-mui "at" oliver-brunner.de
+ *
+ * $Id: gdkline.h,v 1.1 2026/10/19 17:00:00 o1i Exp $
+ *
+ *****************************************************************************/
+
+#ifndef MGTK_LINE_H
+#define MGTK_LINE_H
+
+/* Wide and dashed lines for gdk_draw_line and friends.
+ *
+ * Thin lines (width 0 or 1) are handed out as runs of pixels along the
+ * line, which the caller draws with Move/Draw. Wide lines become filled
+ * polygons (gdkscan.c) and are handed out as spans. The dash pattern
+ * continues across the segments of a polyline, like in X11. Thin dashes
+ * are measured in pixels along the major axis, wide ones in length.
+ *
+ * Only depends on glib, so it can be built and tried out on any host.
+ */
+
+#include <glib.h>
+
+#include "gdkscan.h"
+
+/* same values as GdkLineStyle, GdkCapStyle and GdkJoinStyle */
+enum { MGTK_LINE_SOLID, MGTK_LINE_ON_OFF_DASH, MGTK_LINE_DOUBLE_DASH };
+enum { MGTK_CAP_NOT_LAST, MGTK_CAP_BUTT, MGTK_CAP_ROUND, MGTK_CAP_PROJECTING };
+enum { MGTK_JOIN_MITER, MGTK_JOIN_ROUND, MGTK_JOIN_BEVEL };
+
+typedef struct {
+  gint         width;
+  gint         style;
+  gint         cap;
+  gint         join;
+  const gint8 *dashes;       /* NULL: 4 on, 4 off */
+  gint         n_dashes;
+  gint         dash_offset;
+} MgtkLineAttr;
+
+/* laid out like GdkPoint */
+typedef struct {
+  gint x;
+  gint y;
+} MgtkLinePoint;
+
+/* pixels x1,y1 .. x2,y2 (inclusive) of a thin line */
+typedef void (*MgtkRunFunc) (gint x1, gint y1, gint x2, gint y2, gpointer data);
+
+/* a polyline, closed if the last point is the first one. Off dashes of
+ * MGTK_LINE_DOUBLE_DASH are left out, there is no background colour.
+ */
+void mgtk_line_draw (const MgtkLineAttr *attr,
+                     const MgtkLinePoint *points, gint npoints,
+                     MgtkRunFunc run, MgtkSpanFunc span, gpointer data);
+
+#endif
@@ -0,0 +1,254 @@
+/*****************************************************************************
+ *
+ * gtk-mui - a wrapper library to wrap GTK+ calls to MUI
+ *
+ * Copyright (C) 2005 Oliver Brunner
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+ *
+ * Contact information:
+ *
+ * Oliver Brunner
+ *
+ * E-Mail: gtk-mui "at" oliver-brunner.de
+ *
+ * $Id: gdkmonitor.c,v 1.1 2026/10/19 19:00:00 o1i Exp $
+ *
+ *****************************************************************************/
+
+
+/* monitor layout of a screen, see gdkmonitor.h */
+
+#include <string.h>
+
+#include "gdkmonitor.h"
+
+static void normalize(MgtkDisplayDesc *out, const MgtkDisplayDesc *in) {
+  gint i;
+
+  memset(out,0,sizeof(MgtkDisplayDesc));
+  out->width=MAX(in->width,0);
+  out->height=MAX(in->height,0);
+  out->width_mm=MAX(in->width_mm,0);
+  out->height_mm=MAX(in->height_mm,0);
+  out->n_monitors=CLAMP(in->n_monitors,0,MGTK_MAX_MONITORS);
+
+  for(i=0;i<out->n_monitors;i++) {
+    out->monitors[i].x=in->monitors[i].x;
+    out->monitors[i].y=in->monitors[i].y;
+    out->monitors[i].width=MAX(in->monitors[i].width,0);
+    out->monitors[i].height=MAX(in->monitors[i].height,0);
+  }
+
+  if(!out->n_monitors) {
+    out->n_monitors=1;
+    out->monitors[0].width=out->width;
+    out->monitors[0].height=out->height;
+  }
+}
+
+/* sorted, without duplicates */
+static void add_edge(gint *edges, gint *n, gint v) {
+  gint i=0;
+  gint j;
+
+  while(i<*n && edges[i]<v) {
+    i++;
+  }
+  if(i<*n && edges[i]==v) {
+    return;
+  }
+  for(j=*n;j>i;j--) {
+    edges[j]=edges[j-1];
+  }
+  edges[i]=v;
+  (*n)++;
+}
+
+/* number of edges <= v, 0 is left of/above all monitors */
+static gint edge_index(const gint *edges, gint n, gint v) {
+  gint lo=0;
+  gint hi=n;
+  gint mid;
+
+  while(lo<hi) {
+    mid=(lo+hi)/2;
+    if(edges[mid] <= v) {
+      lo=mid+1;
+    }
+    else {
+      hi=mid;
+    }
+  }
+  return lo;
+}
+
+static gboolean contains(const MgtkMonitorRect *m, gint x, gint y) {
+  return x >= m->x && x < m->x + m->width && y >= m->y && y < m->y + m->height;
+}
+
+void mgtk_monitor_layout_build(MgtkMonitorLayout *layout, const MgtkDisplayDesc *desc) {
+  const MgtkMonitorRect *m;
+  gint row, col;
+  gint x, y;
+  gint i;
+
+  normalize(&layout->desc,desc);
+
+  layout->nx=0;
+  layout->ny=0;
+  for(i=0;i<layout->desc.n_monitors;i++) {
+    m=&layout->desc.monitors[i];
+    add_edge(layout->xs,&layout->nx,m->x);
+    add_edge(layout->xs,&layout->nx,m->x + m->width);
+    add_edge(layout->ys,&layout->ny,m->y);
+    add_edge(layout->ys,&layout->ny,m->y + m->height);
+  }
+
+  /* monitor edges are cell edges, so the top left corner of a cell
+   * is covered by the same monitors as all of the cell
+   */
+  for(row=0;row<=layout->ny;row++) {
+    for(col=0;col<=layout->nx;col++) {
+      layout->cells[row*(layout->nx+1)+col]=-1;
+      if(!row || !col || row==layout->ny || col==layout->nx) {
+        continue;         /* outside of all monitors */
+      }
+      x=layout->xs[col-1];
+      y=layout->ys[row-1];
+      for(i=0;i<layout->desc.n_monitors;i++) {
+        if(contains(&layout->desc.monitors[i],x,y)) {
+          layout->cells[row*(layout->nx+1)+col]=i;
+          break;
+        }
+      }
+    }
+  }
+}
+
+gboolean mgtk_monitor_layout_differs(const MgtkMonitorLayout *layout, const MgtkDisplayDesc *desc) {
+  MgtkDisplayDesc d;
+
+  normalize(&d,desc);
+
+  return memcmp(&d,&layout->desc,sizeof(MgtkDisplayDesc)) != 0;
+}
+
+/* fallback, if no monitor contains x,y. Same distance as GTK+ uses. */
+static gint nearest(const MgtkMonitorLayout *layout, gint x, gint y) {
+  const MgtkMonitorRect *m;
+  gint dist_x, dist_y;
+  gint dist;
+  gint best_dist=G_MAXINT;
+  gint best=0;
+  gint i;
+
+  for(i=0;i<layout->desc.n_monitors;i++) {
+    m=&layout->desc.monitors[i];
+
+    if(x < m->x) {
+      dist_x=m->x - x;
+    }
+    else if(x >= m->x + m->width) {
+      dist_x=x - (m->x + m->width) + 1;
+    }
+    else {
+      dist_x=0;
+    }
+
+    if(y < m->y) {
+      dist_y=m->y - y;
+    }
+    else if(y >= m->y + m->height) {
+      dist_y=y - (m->y + m->height) + 1;
+    }
+    else {
+      dist_y=0;
+    }
+
+    dist=MIN(dist_x,dist_y);
+    if(dist < best_dist) {
+      best_dist=dist;
+      best=i;
+    }
+  }
+
+  return best;
+}
+
+static gint cell_monitor(const MgtkMonitorLayout *layout, gint x, gint y) {
+  gint col;
+  gint row;
+
+  col=edge_index(layout->xs,layout->nx,x);
+  row=edge_index(layout->ys,layout->ny,y);
+
+  return layout->cells[row*(layout->nx+1)+col];
+}
+
+gint mgtk_monitor_at_point(const MgtkMonitorLayout *layout, gint x, gint y) {
+  gint m;
+
+  m=cell_monitor(layout,x,y);
+  if(m >= 0) {
+    return m;
+  }
+
+  return nearest(layout,x,y);
+}
+
+gint mgtk_monitor_at_rect(const MgtkMonitorLayout *layout, const MgtkMonitorRect *rect) {
+  const MgtkMonitorRect *m;
+  gint area;
+  gint best_area=0;
+  gint best=-1;
+  gint w, h;
+  gint i;
+
+  if(rect->width > 0 && rect->height > 0) {
+    /* usual case: all of rect is on the first monitor of its corner.
+     * Every monitor containing all of rect contains the corner too,
+     * so no monitor before this one can have as much of rect.
+     */
+    i=cell_monitor(layout,rect->x,rect->y);
+    if(i >= 0) {
+      m=&layout->desc.monitors[i];
+      if(rect->x + rect->width <= m->x + m->width &&
+         rect->y + rect->height <= m->y + m->height) {
+        return i;
+      }
+    }
+
+    for(i=0;i<layout->desc.n_monitors;i++) {
+      m=&layout->desc.monitors[i];
+      w=MIN(rect->x + rect->width, m->x + m->width) - MAX(rect->x, m->x);
+      h=MIN(rect->y + rect->height, m->y + m->height) - MAX(rect->y, m->y);
+      if(w <= 0 || h <= 0) {
+        continue;
+      }
+      area=w*h;
+      if(area > best_area) {
+        best_area=area;
+        best=i;
+      }
+    }
+  }
+
+  if(best >= 0) {
+    return best;
+  }
+
+  return nearest(layout, rect->x + rect->width/2, rect->y + rect->height/2);
+}
@@ -0,0 +1,102 @@
+/*****************************************************************************
+ *
+ * gtk-mui - a wrapper library to wrap GTK+ calls to MUI
+ *
+ * Copyright (C) 2005 Oliver Brunner
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+ *
+ * Contact information:
+ *
+ * Oliver Brunner
+ *
+ * E-Mail: gtk-mui "at" oliver-brunner.de
+ *
+ * $Id: gdkmonitor.h,v 1.1 2026/10/19 19:00:00 o1i Exp $
+ *
+ *****************************************************************************/
+
+
+#ifndef MGTK_MONITOR_H
+#define MGTK_MONITOR_H
+
+/* Monitor layout of a screen, used by gdkscreen.c.
+ *
+ * The platform side describes the screen once in a MgtkDisplayDesc, which
+ * is turned into a grid: the edges of all monitors cut the plane into
+ * cells, and every cell knows the first monitor covering it. So finding
+ * the monitor at a point is two searches over at most
+ * 2*MGTK_MAX_MONITORS edges and one table access, however often it is
+ * asked. The layout is only rebuilt, when the description changes.
+ *
+ * Only depends on glib, so it can be built and tried out on any host,
+ * with a made up display description.
+ */
+
+#include <glib.h>
+
+#define MGTK_MAX_MONITORS 8
+
+/* laid out like GdkRectangle */
+typedef struct {
+  gint x;
+  gint y;
+  gint width;
+  gint height;
+} MgtkMonitorRect;
+
+typedef struct {
+  gint            width;        /* of the whole screen, in pixels */
+  gint            height;
+  gint            width_mm;
+  gint            height_mm;
+  gint            n_monitors;   /* 1..MGTK_MAX_MONITORS */
+  MgtkMonitorRect monitors[MGTK_MAX_MONITORS];
+} MgtkDisplayDesc;
+
+#define MGTK_MONITOR_EDGES (2*MGTK_MAX_MONITORS)
+
+typedef struct {
+  MgtkDisplayDesc desc;
+  gint            nx;           /* number of distinct x/y edges */
+  gint            ny;
+  gint            xs[MGTK_MONITOR_EDGES];
+  gint            ys[MGTK_MONITOR_EDGES];
+  /* (nx+1)*(ny+1) cells, column 0 is left of xs[0]. -1: no monitor */
+  gint8           cells[(MGTK_MONITOR_EDGES+1)*(MGTK_MONITOR_EDGES+1)];
+} MgtkMonitorLayout;
+
+/* desc is copied, monitors beyond MGTK_MAX_MONITORS are ignored and a
+ * description without monitors gets one covering the whole screen.
+ */
+void mgtk_monitor_layout_build (MgtkMonitorLayout *layout,
+                                const MgtkDisplayDesc *desc);
+
+/* TRUE, if desc would build a different layout */
+gboolean mgtk_monitor_layout_differs (const MgtkMonitorLayout *layout,
+                                      const MgtkDisplayDesc *desc);
+
+/* like gdk_screen_get_monitor_at_point: the first monitor containing
+ * x,y or else the nearest one.
+ */
+gint mgtk_monitor_at_point (const MgtkMonitorLayout *layout, gint x, gint y);
+
+/* like gdk_screen_get_monitor_at_window: the first monitor with the
+ * largest part of rect or else the one nearest to its centre.
+ */
+gint mgtk_monitor_at_rect  (const MgtkMonitorLayout *layout,
+                            const MgtkMonitorRect *rect);
+
+#endif
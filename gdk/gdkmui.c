@@ -40,8 +40,8 @@
 
 void gdkmui_set_color(struct RastPort *rp, GdkGC *gc)
 {
-  if(gc->colormap->colors->havepen==1) {
-    pen=(LONG) gc->colormap->colors->pen;
+  if(gc->mgtk_color.havepen==1) {
+    pen=(LONG) gc->mgtk_color.pen;
     DebOut("  found pen: %d\n",(int) pen);
   }
   else {
@@ -58,9 +58,9 @@ void gdkmui_set_color(struct RastPort *rp, GdkGC *gc)
 {
   ULONG	r, g, b;
 
-  r = gc->colormap->colors->red >> 8;
-  g = gc->colormap->colors->green >> 8;
-  b = gc->colormap->colors->blue >> 8;
+  r = gc->mgtk_color.red >> 8;
+  g = gc->mgtk_color.green >> 8;
+  b = gc->mgtk_color.blue >> 8;
 
   #ifdef __AMIGAOS4__
   SetRPAttrs(rp, RPTAG_APenColor, (r << 16) | (g << 8) | (b << 0), TAG_DONE);
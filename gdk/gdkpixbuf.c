@@ -0,0 +1,751 @@
+/* GDK - The GIMP Drawing Kit
+ * Copyright (C) 1995-1997 Peter Mattis, Spencer Kimball and Josh MacDonald
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the
+ * Free Software Foundation, Inc., 59 Temple Place - Suite 330,
+ * Boston, MA 02111-1307, USA.
+ */
+
+/*
+ * Modified by the GTK-MUI Team 2006
+ *
+ * $Id: gdkpixbuf.c,v 1.1 2026/10/19 10:00:00 o1i Exp $
+ */
+
+#include <string.h>
+#include <math.h>
+#include <glib-object.h>
+
+#include "gdkpixbuf.h"
+
+/* The scalers sample every destination row into a RGBA row buffer
+ * first, which is then stored or composited into the destination.
+ * Source positions are computed once per column and row, as byte
+ * offsets into the source, so the inner loops only add and shift.
+ * Bilinear weights are 8 bit fixed point.
+ */
+
+static gpointer parent_class = NULL;
+
+static void
+gdk_pixbuf_finalize (GObject *object)
+{
+  GdkPixbuf *pixbuf = GDK_PIXBUF (object);
+
+  if (pixbuf->destroy_fn)
+    (* pixbuf->destroy_fn) (pixbuf->pixels, pixbuf->destroy_fn_data);
+
+  G_OBJECT_CLASS (parent_class)->finalize (object);
+}
+
+static void
+gdk_pixbuf_class_init (GdkPixbufClass *klass)
+{
+  GObjectClass *object_class = G_OBJECT_CLASS (klass);
+
+  parent_class = g_type_class_peek_parent (klass);
+
+  object_class->finalize = gdk_pixbuf_finalize;
+}
+
+GType
+gdk_pixbuf_get_type (void)
+{
+  static GType pixbuf_type = 0;
+
+  if (!pixbuf_type)
+    {
+      static const GTypeInfo pixbuf_info =
+      {
+        sizeof (GdkPixbufClass),
+        (GBaseInitFunc) NULL,
+        (GBaseFinalizeFunc) NULL,
+        (GClassInitFunc) gdk_pixbuf_class_init,
+        NULL,           /* class_finalize */
+        NULL,           /* class_data */
+        sizeof (GdkPixbuf),
+        0,              /* n_preallocs */
+        (GInstanceInitFunc) NULL,
+      };
+
+      pixbuf_type = g_type_register_static (G_TYPE_OBJECT, "GdkPixbuf", &pixbuf_info, 0);
+    }
+
+  return pixbuf_type;
+}
+
+GdkPixbuf *
+gdk_pixbuf_ref (GdkPixbuf *pixbuf)
+{
+  return (GdkPixbuf *) g_object_ref (pixbuf);
+}
+
+void
+gdk_pixbuf_unref (GdkPixbuf *pixbuf)
+{
+  g_object_unref (pixbuf);
+}
+
+/*************** accessors ***************************************************/
+
+GdkColorspace
+gdk_pixbuf_get_colorspace (const GdkPixbuf *pixbuf)
+{
+  g_return_val_if_fail (pixbuf != NULL, GDK_COLORSPACE_RGB);
+
+  return pixbuf->colorspace;
+}
+
+int
+gdk_pixbuf_get_n_channels (const GdkPixbuf *pixbuf)
+{
+  g_return_val_if_fail (pixbuf != NULL, -1);
+
+  return pixbuf->n_channels;
+}
+
+gboolean
+gdk_pixbuf_get_has_alpha (const GdkPixbuf *pixbuf)
+{
+  g_return_val_if_fail (pixbuf != NULL, FALSE);
+
+  return pixbuf->has_alpha;
+}
+
+int
+gdk_pixbuf_get_bits_per_sample (const GdkPixbuf *pixbuf)
+{
+  g_return_val_if_fail (pixbuf != NULL, -1);
+
+  return pixbuf->bits_per_sample;
+}
+
+guchar *
+gdk_pixbuf_get_pixels (const GdkPixbuf *pixbuf)
+{
+  g_return_val_if_fail (pixbuf != NULL, NULL);
+
+  return pixbuf->pixels;
+}
+
+int
+gdk_pixbuf_get_width (const GdkPixbuf *pixbuf)
+{
+  g_return_val_if_fail (pixbuf != NULL, -1);
+
+  return pixbuf->width;
+}
+
+int
+gdk_pixbuf_get_height (const GdkPixbuf *pixbuf)
+{
+  g_return_val_if_fail (pixbuf != NULL, -1);
+
+  return pixbuf->height;
+}
+
+int
+gdk_pixbuf_get_rowstride (const GdkPixbuf *pixbuf)
+{
+  g_return_val_if_fail (pixbuf != NULL, -1);
+
+  return pixbuf->rowstride;
+}
+
+/*************** creation ****************************************************/
+
+static void
+free_buffer (guchar *pixels, gpointer data)
+{
+  g_free (pixels);
+}
+
+static void
+unref_parent (guchar *pixels, gpointer data)
+{
+  g_object_unref (data);
+}
+
+/* bytes really used by the pixels, the last row may be short */
+static gsize
+pixbuf_size (const GdkPixbuf *pixbuf)
+{
+  return (gsize) (pixbuf->height - 1) * pixbuf->rowstride +
+         (gsize) pixbuf->width * pixbuf->n_channels;
+}
+
+GdkPixbuf *
+gdk_pixbuf_new_from_data (const guchar *data,
+                          GdkColorspace colorspace,
+                          gboolean      has_alpha,
+                          int           bits_per_sample,
+                          int           width,
+                          int           height,
+                          int           rowstride,
+                          GdkPixbufDestroyNotify destroy_fn,
+                          gpointer      destroy_fn_data)
+{
+  GdkPixbuf *pixbuf;
+
+  g_return_val_if_fail (data != NULL, NULL);
+  g_return_val_if_fail (colorspace == GDK_COLORSPACE_RGB, NULL);
+  g_return_val_if_fail (bits_per_sample == 8, NULL);
+  g_return_val_if_fail (width > 0, NULL);
+  g_return_val_if_fail (height > 0, NULL);
+  g_return_val_if_fail (rowstride >= width * (has_alpha ? 4 : 3), NULL);
+
+  pixbuf = g_object_new (GDK_TYPE_PIXBUF, NULL);
+
+  pixbuf->colorspace = colorspace;
+  pixbuf->n_channels = has_alpha ? 4 : 3;
+  pixbuf->bits_per_sample = bits_per_sample;
+  pixbuf->has_alpha = has_alpha ? TRUE : FALSE;
+  pixbuf->width = width;
+  pixbuf->height = height;
+  pixbuf->rowstride = rowstride;
+  pixbuf->pixels = (guchar *) data;
+  pixbuf->destroy_fn = destroy_fn;
+  pixbuf->destroy_fn_data = destroy_fn_data;
+
+  return pixbuf;
+}
+
+GdkPixbuf *
+gdk_pixbuf_new (GdkColorspace colorspace,
+                gboolean      has_alpha,
+                int           bits_per_sample,
+                int           width,
+                int           height)
+{
+  guchar *pixels;
+  gint channels;
+  gint rowstride;
+
+  g_return_val_if_fail (colorspace == GDK_COLORSPACE_RGB, NULL);
+  g_return_val_if_fail (bits_per_sample == 8, NULL);
+  g_return_val_if_fail (width > 0, NULL);
+  g_return_val_if_fail (height > 0, NULL);
+
+  channels = has_alpha ? 4 : 3;
+
+  /* rows are 32 bit aligned */
+  if (width > (G_MAXINT - 3) / channels)
+    return NULL;
+  rowstride = (width * channels + 3) & ~3;
+  if (height > G_MAXINT / rowstride)
+    return NULL;
+
+  pixels = g_try_malloc ((gsize) height * rowstride);
+  if (!pixels)
+    return NULL;
+
+  return gdk_pixbuf_new_from_data (pixels, colorspace, has_alpha, bits_per_sample,
+                                   width, height, rowstride, free_buffer, NULL);
+}
+
+GdkPixbuf *
+gdk_pixbuf_copy (const GdkPixbuf *pixbuf)
+{
+  guchar *pixels;
+  gsize size;
+
+  g_return_val_if_fail (GDK_IS_PIXBUF (pixbuf), NULL);
+
+  size = pixbuf_size (pixbuf);
+  pixels = g_try_malloc (size);
+  if (!pixels)
+    return NULL;
+
+  memcpy (pixels, pixbuf->pixels, size);
+
+  return gdk_pixbuf_new_from_data (pixels, pixbuf->colorspace, pixbuf->has_alpha,
+                                   pixbuf->bits_per_sample, pixbuf->width, pixbuf->height,
+                                   pixbuf->rowstride, free_buffer, NULL);
+}
+
+GdkPixbuf *
+gdk_pixbuf_new_subpixbuf (GdkPixbuf *src_pixbuf,
+                          int        src_x,
+                          int        src_y,
+                          int        width,
+                          int        height)
+{
+  guchar *pixels;
+
+  g_return_val_if_fail (GDK_IS_PIXBUF (src_pixbuf), NULL);
+  g_return_val_if_fail (src_x >= 0 && src_x + width <= src_pixbuf->width, NULL);
+  g_return_val_if_fail (src_y >= 0 && src_y + height <= src_pixbuf->height, NULL);
+  g_return_val_if_fail (width > 0 && height > 0, NULL);
+
+  pixels = src_pixbuf->pixels + src_y * src_pixbuf->rowstride +
+           src_x * src_pixbuf->n_channels;
+
+  g_object_ref (src_pixbuf);
+
+  return gdk_pixbuf_new_from_data (pixels, src_pixbuf->colorspace, src_pixbuf->has_alpha,
+                                   src_pixbuf->bits_per_sample, width, height,
+                                   src_pixbuf->rowstride, unref_parent, src_pixbuf);
+}
+
+/**
+ * gdk_pixbuf_fill:
+ * @pixbuf: a #GdkPixbuf
+ * @pixel: RGBA pixel to clear to (0xffffffff is opaque white)
+ *
+ * Clears a pixbuf to the given RGBA value. The alpha part is ignored,
+ * if @pixbuf has no alpha channel.
+ **/
+void
+gdk_pixbuf_fill (GdkPixbuf *pixbuf,
+                 guint32    pixel)
+{
+  guchar *row;
+  guchar *p;
+  gint n_channels;
+  gint x, y;
+
+  g_return_if_fail (GDK_IS_PIXBUF (pixbuf));
+
+  n_channels = pixbuf->n_channels;
+  row = pixbuf->pixels;
+
+  p = row;
+  for (x = 0; x < pixbuf->width; x++)
+    {
+      p[0] = (pixel >> 24) & 0xff;
+      p[1] = (pixel >> 16) & 0xff;
+      p[2] = (pixel >> 8) & 0xff;
+      if (n_channels == 4)
+        p[3] = pixel & 0xff;
+      p += n_channels;
+    }
+
+  for (y = 1; y < pixbuf->height; y++)
+    memcpy (row + y * pixbuf->rowstride, row, pixbuf->width * n_channels);
+}
+
+/*************** scaling and compositing *************************************/
+
+/* source position of one destination column or row */
+typedef struct
+{
+  gint  o0;   /* byte offset of the first sample */
+  gint  o1;   /* byte offset of the second sample, bilinear only */
+  guint w;    /* weight of the second sample, 0..255 */
+} PixbufSample;
+
+static PixbufSample *
+make_samples (gint          dest_start,
+              gint          n,
+              double        offset,
+              double        scale,
+              gint          src_size,
+              gint          stride,
+              GdkInterpType interp_type)
+{
+  PixbufSample *samples;
+  double s;
+  gint i, p, w;
+
+  samples = g_new (PixbufSample, n);
+
+  for (i = 0; i < n; i++)
+    {
+      /* centre of the destination pixel in source coordinates */
+      s = (dest_start + i + 0.5 - offset) / scale;
+
+      if (interp_type == GDK_INTERP_NEAREST)
+        {
+          p = (gint) floor (s);
+          p = CLAMP (p, 0, src_size - 1);
+          samples[i].o0 = samples[i].o1 = p * stride;
+          samples[i].w = 0;
+          continue;
+        }
+
+      s -= 0.5;
+      p = (gint) floor (s);
+      w = (gint) ((s - p) * 256.0 + 0.5);
+      if (w >= 256)
+        {
+          p++;
+          w = 0;
+        }
+
+      if (p < 0)
+        {
+          samples[i].o0 = samples[i].o1 = 0;
+          samples[i].w = 0;
+        }
+      else if (p >= src_size - 1)
+        {
+          samples[i].o0 = samples[i].o1 = (src_size - 1) * stride;
+          samples[i].w = 0;
+        }
+      else
+        {
+          samples[i].o0 = p * stride;
+          samples[i].o1 = (p + 1) * stride;
+          samples[i].w = w;
+        }
+    }
+
+  return samples;
+}
+
+/* nearest neighbour, straight into a destination with the same layout */
+static void
+copy_row_nearest (const guchar       *src,
+                  const PixbufSample *xs,
+                  gint                n,
+                  gint                n_channels,
+                  guchar             *dest)
+{
+  const guchar *p;
+  gint i;
+
+  if (n_channels == 4)
+    {
+      for (i = 0; i < n; i++)
+        {
+          p = src + xs[i].o0;
+          dest[0] = p[0];
+          dest[1] = p[1];
+          dest[2] = p[2];
+          dest[3] = p[3];
+          dest += 4;
+        }
+    }
+  else
+    {
+      for (i = 0; i < n; i++)
+        {
+          p = src + xs[i].o0;
+          dest[0] = p[0];
+          dest[1] = p[1];
+          dest[2] = p[2];
+          dest += 3;
+        }
+    }
+}
+
+static void
+sample_row_nearest (const guchar       *src,
+                    const PixbufSample *xs,
+                    gint                n,
+                    gint                n_channels,
+                    guchar             *out)
+{
+  const guchar *p;
+  gint i;
+
+  if (n_channels == 4)
+    {
+      copy_row_nearest (src, xs, n, 4, out);
+      return;
+    }
+
+  for (i = 0; i < n; i++)
+    {
+      p = src + xs[i].o0;
+      out[0] = p[0];
+      out[1] = p[1];
+      out[2] = p[2];
+      out[3] = 0xff;
+      out += 4;
+    }
+}
+
+static void
+sample_row_bilinear (const guchar       *row0,
+                     const guchar       *row1,
+                     guint               wy,
+                     const PixbufSample *xs,
+                     gint                n,
+                     gint                n_channels,
+                     guchar             *out)
+{
+  const guchar *a, *b, *c, *d;
+  guint w00, w01, w10, w11;
+  guint wx, alpha;
+  gint i, k;
+
+  if (n_channels == 3)
+    {
+      if (!wy)
+        {
+          /* on a source row, horizontal only */
+          for (i = 0; i < n; i++)
+            {
+              a = row0 + xs[i].o0;
+              b = row0 + xs[i].o1;
+              wx = xs[i].w;
+              out[0] = (a[0] * (256 - wx) + b[0] * wx + 128) >> 8;
+              out[1] = (a[1] * (256 - wx) + b[1] * wx + 128) >> 8;
+              out[2] = (a[2] * (256 - wx) + b[2] * wx + 128) >> 8;
+              out[3] = 0xff;
+              out += 4;
+            }
+          return;
+        }
+
+      for (i = 0; i < n; i++)
+        {
+          a = row0 + xs[i].o0;
+          b = row0 + xs[i].o1;
+          c = row1 + xs[i].o0;
+          d = row1 + xs[i].o1;
+          wx = xs[i].w;
+          w00 = (256 - wx) * (256 - wy);
+          w01 = wx * (256 - wy);
+          w10 = (256 - wx) * wy;
+          w11 = wx * wy;
+          for (k = 0; k < 3; k++)
+            out[k] = (a[k] * w00 + b[k] * w01 + c[k] * w10 + d[k] * w11 + 32768) >> 16;
+          out[3] = 0xff;
+          out += 4;
+        }
+      return;
+    }
+
+  /* RGBA: interpolate premultiplied, so transparent pixels do not bleed */
+  for (i = 0; i < n; i++)
+    {
+      a = row0 + xs[i].o0;
+      b = row0 + xs[i].o1;
+      c = row1 + xs[i].o0;
+      d = row1 + xs[i].o1;
+      wx = xs[i].w;
+      w00 = (256 - wx) * (256 - wy) * a[3];
+      w01 = wx * (256 - wy) * b[3];
+      w10 = (256 - wx) * wy * c[3];
+      w11 = wx * wy * d[3];
+      alpha = w00 + w01 + w10 + w11;
+      if (!alpha)
+        {
+          out[0] = out[1] = out[2] = out[3] = 0;
+        }
+      else
+        {
+          /* every sum is at most 65536 * 255 * 255, which fits 32 bits */
+          for (k = 0; k < 3; k++)
+            out[k] = (a[k] * w00 + b[k] * w01 + c[k] * w10 + d[k] * w11 + alpha / 2) / alpha;
+          out[3] = (alpha + 32768) >> 16;
+        }
+      out += 4;
+    }
+}
+
+static void
+store_row (const guchar *in,
+           gint          n,
+           gint          n_channels,
+           guchar       *dest)
+{
+  gint i;
+
+  if (n_channels == 4)
+    {
+      memcpy (dest, in, n * 4);
+      return;
+    }
+
+  for (i = 0; i < n; i++)
+    {
+      dest[0] = in[0];
+      dest[1] = in[1];
+      dest[2] = in[2];
+      in += 4;
+      dest += 3;
+    }
+}
+
+static void
+composite_row (const guchar *in,
+               gint          n,
+               gint          n_channels,
+               gint          overall_alpha,
+               guchar       *dest)
+{
+  guint a, w0, w1, w;
+  gint i;
+
+  for (i = 0; i < n; i++, in += 4, dest += n_channels)
+    {
+      a = (in[3] * overall_alpha + 127) / 255;
+      if (!a)
+        continue;
+
+      if (n_channels == 3)
+        {
+          dest[0] = (in[0] * a + dest[0] * (255 - a) + 127) / 255;
+          dest[1] = (in[1] * a + dest[1] * (255 - a) + 127) / 255;
+          dest[2] = (in[2] * a + dest[2] * (255 - a) + 127) / 255;
+          continue;
+        }
+
+      /* source over destination, both with alpha */
+      w0 = a * 255;
+      w1 = (255 - a) * dest[3];
+      w = w0 + w1;
+      dest[0] = (in[0] * w0 + dest[0] * w1 + w / 2) / w;
+      dest[1] = (in[1] * w0 + dest[1] * w1 + w / 2) / w;
+      dest[2] = (in[2] * w0 + dest[2] * w1 + w / 2) / w;
+      dest[3] = (w + 127) / 255;
+    }
+}
+
+static void
+pixbuf_scale_real (const GdkPixbuf *src,
+                   GdkPixbuf       *dest,
+                   int              dest_x,
+                   int              dest_y,
+                   int              dest_width,
+                   int              dest_height,
+                   double           offset_x,
+                   double           offset_y,
+                   double           scale_x,
+                   double           scale_y,
+                   GdkInterpType    interp_type,
+                   int              overall_alpha,
+                   gboolean         composite)
+{
+  PixbufSample *xs;
+  PixbufSample *ys;
+  guchar *row;
+  guchar *drow;
+  gboolean nearest;
+  gint j;
+
+  g_return_if_fail (GDK_IS_PIXBUF (src));
+  g_return_if_fail (GDK_IS_PIXBUF (dest));
+  g_return_if_fail (dest_x >= 0 && dest_x + dest_width <= dest->width);
+  g_return_if_fail (dest_y >= 0 && dest_y + dest_height <= dest->height);
+  g_return_if_fail (scale_x > 0.0 && scale_y > 0.0);
+
+  if (dest_width <= 0 || dest_height <= 0 || (composite && overall_alpha <= 0))
+    return;
+
+  overall_alpha = MIN (overall_alpha, 255);
+
+  nearest = (interp_type == GDK_INTERP_NEAREST);
+
+  xs = make_samples (dest_x, dest_width, offset_x, scale_x, src->width,
+                     src->n_channels, interp_type);
+  ys = make_samples (dest_y, dest_height, offset_y, scale_y, src->height,
+                     src->rowstride, interp_type);
+
+  row = g_malloc (dest_width * 4);
+
+  drow = dest->pixels + dest_y * dest->rowstride + dest_x * dest->n_channels;
+
+  for (j = 0; j < dest_height; j++, drow += dest->rowstride)
+    {
+      if (nearest && !composite && src->n_channels == dest->n_channels)
+        {
+          copy_row_nearest (src->pixels + ys[j].o0, xs, dest_width,
+                            src->n_channels, drow);
+          continue;
+        }
+
+      if (nearest)
+        sample_row_nearest (src->pixels + ys[j].o0, xs, dest_width,
+                            src->n_channels, row);
+      else
+        sample_row_bilinear (src->pixels + ys[j].o0, src->pixels + ys[j].o1, ys[j].w,
+                             xs, dest_width, src->n_channels, row);
+
+      if (composite)
+        composite_row (row, dest_width, dest->n_channels, overall_alpha, drow);
+      else
+        store_row (row, dest_width, dest->n_channels, drow);
+    }
+
+  g_free (row);
+  g_free (ys);
+  g_free (xs);
+}
+
+/**
+ * gdk_pixbuf_scale:
+ *
+ * Renders the rectangle (@dest_x, @dest_y, @dest_width, @dest_height)
+ * of @dest with @src scaled by @scale_x and @scale_y and moved by
+ * @offset_x and @offset_y, replacing the old contents.
+ **/
+void
+gdk_pixbuf_scale (const GdkPixbuf *src,
+                  GdkPixbuf       *dest,
+                  int              dest_x,
+                  int              dest_y,
+                  int              dest_width,
+                  int              dest_height,
+                  double           offset_x,
+                  double           offset_y,
+                  double           scale_x,
+                  double           scale_y,
+                  GdkInterpType    interp_type)
+{
+  pixbuf_scale_real (src, dest, dest_x, dest_y, dest_width, dest_height,
+                     offset_x, offset_y, scale_x, scale_y, interp_type, 255, FALSE);
+}
+
+/**
+ * gdk_pixbuf_composite:
+ *
+ * Like gdk_pixbuf_scale(), but the scaled @src is composited over
+ * @dest, with its alpha multiplied by @overall_alpha (0..255).
+ **/
+void
+gdk_pixbuf_composite (const GdkPixbuf *src,
+                      GdkPixbuf       *dest,
+                      int              dest_x,
+                      int              dest_y,
+                      int              dest_width,
+                      int              dest_height,
+                      double           offset_x,
+                      double           offset_y,
+                      double           scale_x,
+                      double           scale_y,
+                      GdkInterpType    interp_type,
+                      int              overall_alpha)
+{
+  pixbuf_scale_real (src, dest, dest_x, dest_y, dest_width, dest_height,
+                     offset_x, offset_y, scale_x, scale_y, interp_type,
+                     overall_alpha, TRUE);
+}
+
+GdkPixbuf *
+gdk_pixbuf_scale_simple (const GdkPixbuf *src,
+                         int              dest_width,
+                         int              dest_height,
+                         GdkInterpType    interp_type)
+{
+  GdkPixbuf *dest;
+
+  g_return_val_if_fail (GDK_IS_PIXBUF (src), NULL);
+  g_return_val_if_fail (dest_width > 0, NULL);
+  g_return_val_if_fail (dest_height > 0, NULL);
+
+  dest = gdk_pixbuf_new (GDK_COLORSPACE_RGB, src->has_alpha, 8, dest_width, dest_height);
+  if (!dest)
+    return NULL;
+
+  gdk_pixbuf_scale (src, dest, 0, 0, dest_width, dest_height, 0, 0,
+                    (double) dest_width / src->width,
+                    (double) dest_height / src->height,
+                    interp_type);
+
+  return dest;
+}
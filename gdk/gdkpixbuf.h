@@ -0,0 +1,155 @@
+/* GDK - The GIMP Drawing Kit
+ * Copyright (C) 1995-1997 Peter Mattis, Spencer Kimball and Josh MacDonald
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the
+ * Free Software Foundation, Inc., 59 Temple Place - Suite 330,
+ * Boston, MA 02111-1307, USA.
+ */
+
+/*
+ * Modified by the GTK-MUI Team 2006
+ *
+ * $Id: gdkpixbuf.h,v 1.1 2026/10/19 10:00:00 o1i Exp $
+ */
+
+#ifndef __GDK_PIXBUF_H__
+#define __GDK_PIXBUF_H__
+
+#include <glib.h>
+#include <glib-object.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif /* __cplusplus */
+
+/* GTK-MUI: in memory pixbufs, 8 bit RGB or RGBA only. Loading from files
+ * and animations are not supported. GDK_INTERP_TILES and
+ * GDK_INTERP_HYPER are done as GDK_INTERP_BILINEAR.
+ */
+
+typedef struct _GdkPixbuf      GdkPixbuf;
+typedef struct _GdkPixbufClass GdkPixbufClass;
+
+typedef enum
+{
+  GDK_COLORSPACE_RGB
+} GdkColorspace;
+
+typedef enum
+{
+  GDK_INTERP_NEAREST,
+  GDK_INTERP_TILES,
+  GDK_INTERP_BILINEAR,
+  GDK_INTERP_HYPER
+} GdkInterpType;
+
+typedef void (* GdkPixbufDestroyNotify) (guchar *pixels, gpointer data);
+
+#define GDK_TYPE_PIXBUF              (gdk_pixbuf_get_type ())
+#define GDK_PIXBUF(object)           (G_TYPE_CHECK_INSTANCE_CAST ((object), GDK_TYPE_PIXBUF, GdkPixbuf))
+#define GDK_IS_PIXBUF(object)        (G_TYPE_CHECK_INSTANCE_TYPE ((object), GDK_TYPE_PIXBUF))
+
+struct _GdkPixbuf
+{
+  GObject parent_instance;
+
+  GdkColorspace colorspace;
+  gint          n_channels;
+  gint          bits_per_sample;
+  gint          width;
+  gint          height;
+  gint          rowstride;
+  guchar       *pixels;
+
+  GdkPixbufDestroyNotify destroy_fn;
+  gpointer               destroy_fn_data;
+
+  guint has_alpha : 1;
+};
+
+struct _GdkPixbufClass
+{
+  GObjectClass parent_class;
+};
+
+GType         gdk_pixbuf_get_type            (void) G_GNUC_CONST;
+
+GdkPixbuf    *gdk_pixbuf_ref                 (GdkPixbuf *pixbuf);
+void          gdk_pixbuf_unref               (GdkPixbuf *pixbuf);
+
+GdkColorspace gdk_pixbuf_get_colorspace      (const GdkPixbuf *pixbuf);
+int           gdk_pixbuf_get_n_channels      (const GdkPixbuf *pixbuf);
+gboolean      gdk_pixbuf_get_has_alpha       (const GdkPixbuf *pixbuf);
+int           gdk_pixbuf_get_bits_per_sample (const GdkPixbuf *pixbuf);
+guchar       *gdk_pixbuf_get_pixels          (const GdkPixbuf *pixbuf);
+int           gdk_pixbuf_get_width           (const GdkPixbuf *pixbuf);
+int           gdk_pixbuf_get_height          (const GdkPixbuf *pixbuf);
+int           gdk_pixbuf_get_rowstride       (const GdkPixbuf *pixbuf);
+
+GdkPixbuf    *gdk_pixbuf_new                 (GdkColorspace colorspace,
+                                              gboolean      has_alpha,
+                                              int           bits_per_sample,
+                                              int           width,
+                                              int           height);
+GdkPixbuf    *gdk_pixbuf_new_from_data       (const guchar *data,
+                                              GdkColorspace colorspace,
+                                              gboolean      has_alpha,
+                                              int           bits_per_sample,
+                                              int           width,
+                                              int           height,
+                                              int           rowstride,
+                                              GdkPixbufDestroyNotify destroy_fn,
+                                              gpointer      destroy_fn_data);
+GdkPixbuf    *gdk_pixbuf_copy                (const GdkPixbuf *pixbuf);
+GdkPixbuf    *gdk_pixbuf_new_subpixbuf       (GdkPixbuf    *src_pixbuf,
+                                              int           src_x,
+                                              int           src_y,
+                                              int           width,
+                                              int           height);
+void          gdk_pixbuf_fill                (GdkPixbuf    *pixbuf,
+                                              guint32       pixel);
+
+void          gdk_pixbuf_scale               (const GdkPixbuf *src,
+                                              GdkPixbuf    *dest,
+                                              int           dest_x,
+                                              int           dest_y,
+                                              int           dest_width,
+                                              int           dest_height,
+                                              double        offset_x,
+                                              double        offset_y,
+                                              double        scale_x,
+                                              double        scale_y,
+                                              GdkInterpType interp_type);
+void          gdk_pixbuf_composite           (const GdkPixbuf *src,
+                                              GdkPixbuf    *dest,
+                                              int           dest_x,
+                                              int           dest_y,
+                                              int           dest_width,
+                                              int           dest_height,
+                                              double        offset_x,
+                                              double        offset_y,
+                                              double        scale_x,
+                                              double        scale_y,
+                                              GdkInterpType interp_type,
+                                              int           overall_alpha);
+GdkPixbuf    *gdk_pixbuf_scale_simple        (const GdkPixbuf *src,
+                                              int           dest_width,
+                                              int           dest_height,
+                                              GdkInterpType interp_type);
+
+#ifdef __cplusplus
+}
+#endif /* __cplusplus */
+
+#endif /* __GDK_PIXBUF_H__ */
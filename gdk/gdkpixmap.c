@@ -0,0 +1,236 @@
+/*****************************************************************************
+ * 
+ * mui-gtk - a wrapper library to wrap GTK+ calls to MUI
+ *
+ * Copyright (C) 2005 Oliver Brunner
+ * 
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ * 
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ * 
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+ * 
+ * Contact information:
+ *
+ * Oliver Brunner
+ *
+ * E-Mail: mui-gtk "at" oliver-brunner.de
+ *
+ * $Id: gdkpixmap.c,v 1.1 2026/10/19 16:00:00 o1i Exp $
+ *
+ *****************************************************************************/
+
+#include <stdio.h>
+#include <proto/intuition.h>
+#include <proto/graphics.h>
+#include <proto/layers.h>
+#include <proto/exec.h>
+#include <mui.h>
+
+#include "../debug.h"
+#include <gtk/gtk.h>
+#include "../gtk_globals.h"
+
+/* Pixmaps are the only real GObjects among the drawables, windows are
+ * still plain structs (see gdk_window_new). A pixmap gets a layer of
+ * its own, so the graphics.library clips everything drawn into it and
+ * gdk_draw.c can treat it like the RastPort of a window.
+ */
+
+static gpointer parent_class = NULL;
+
+static void gdk_pixmap_finalize(GObject *object) {
+  GdkPixmap *pixmap=(GdkPixmap *) object;
+  struct RastPort *rp;
+  struct Layer_Info *li;
+  struct BitMap *bm;
+
+  DebOut("gdk_pixmap_finalize(%lx)\n",pixmap);
+
+  rp=(struct RastPort *) pixmap->mgtk_rastport;
+  if(rp) {
+    bm=rp->BitMap;
+    li=rp->Layer->LayerInfo;
+    DeleteLayer(0,rp->Layer);
+    DisposeLayerInfo(li);
+    FreeBitMap(bm);
+    pixmap->mgtk_rastport=NULL;
+  }
+
+  G_OBJECT_CLASS(parent_class)->finalize(object);
+}
+
+static void gdk_pixmap_class_init(GObjectClass *klass) {
+
+  parent_class=g_type_class_peek_parent(klass);
+
+  klass->finalize=gdk_pixmap_finalize;
+}
+
+GType gdk_pixmap_get_type(void) {
+  static GType pixmap_type=0;
+
+  if(!pixmap_type) {
+    static const GTypeInfo pixmap_info = {
+      sizeof(GObjectClass),
+      (GBaseInitFunc) NULL,
+      (GBaseFinalizeFunc) NULL,
+      (GClassInitFunc) gdk_pixmap_class_init,
+      NULL,           /* class_finalize */
+      NULL,           /* class_data */
+      sizeof(GdkPixmap),
+      0,              /* n_preallocs */
+      (GInstanceInitFunc) NULL,
+    };
+
+    pixmap_type=g_type_register_static(G_TYPE_OBJECT,"GdkPixmap",&pixmap_info,0);
+  }
+
+  return pixmap_type;
+}
+
+/* screen and draw info a new pixmap is compatible with */
+static BOOL pixmap_screen(GdkDrawable *drawable, struct Screen **screen, struct DrawInfo **dri) {
+  GtkWidget *widget;
+  Object *obj;
+
+  *screen=NULL;
+  *dri=NULL;
+
+  if(drawable && drawable->mgtk_rastport) {
+    *screen=(struct Screen *) drawable->mgtk_screen;
+    *dri=(struct DrawInfo *) drawable->mgtk_dri;
+  }
+  else if(drawable && drawable->mgtk_widget) {
+    widget=(GtkWidget *) drawable->mgtk_widget;
+    obj=GtkObj(widget);
+    if(obj && muiRenderInfo(obj)) {
+      *screen=_screen(obj);
+      *dri=_dri(obj);
+    }
+  }
+
+  /* no drawable or not shown (yet), take the screen of the main window */
+  if(!*screen && global_mgtk && xget(global_mgtk->MuiRoot,MUIA_Window_Open)) {
+    *screen=(struct Screen *) xget(global_mgtk->MuiRoot,MUIA_Window_Screen);
+  }
+
+  return *screen != NULL;
+}
+
+GdkPixmap *gdk_pixmap_new(GdkDrawable *drawable, gint width, gint height, gint depth) {
+  GdkPixmap *pixmap;
+  struct Screen *screen;
+  struct DrawInfo *dri;
+  struct BitMap *friend;
+  struct BitMap *bm;
+  struct Layer_Info *li;
+  struct Layer *layer;
+  gint screen_depth;
+
+  DebOut("gdk_pixmap_new(%lx,%d,%d,%d)\n",drawable,width,height,depth);
+
+  g_return_val_if_fail(width>0 && height>0, NULL);
+  g_return_val_if_fail(drawable!=NULL || depth>0, NULL);
+
+  pixmap=(GdkPixmap *) g_object_new(GDK_TYPE_PIXMAP,NULL);
+  pixmap->mgtk_width=width;
+  pixmap->mgtk_height=height;
+
+  if(!pixmap_screen(drawable,&screen,&dri)) {
+    ErrOut("gdk_pixmap_new: no screen, pixmap %lx stays empty\n",pixmap);
+    pixmap->mgtk_depth=depth>0 ? depth : 1;
+    return pixmap;
+  }
+
+  friend=screen->RastPort.BitMap;
+  screen_depth=GetBitMapAttr(friend,BMA_DEPTH);
+  if(depth<=0) {
+    depth=screen_depth;
+  }
+  pixmap->mgtk_depth=depth;
+
+  /* only a bitmap of the screen depth can be a friend */
+  bm=AllocBitMap(width,height,depth,BMF_CLEAR,depth==screen_depth ? friend : NULL);
+  if(!bm) {
+    ErrOut("gdk_pixmap_new: no memory for a %dx%dx%d bitmap\n",width,height,depth);
+    return pixmap;
+  }
+
+  li=NewLayerInfo();
+  layer=li ? CreateUpfrontLayer(li,bm,0,0,width-1,height-1,LAYERSIMPLE,NULL) : NULL;
+  if(!layer) {
+    ErrOut("gdk_pixmap_new: could not create layer\n");
+    if(li) {
+      DisposeLayerInfo(li);
+    }
+    FreeBitMap(bm);
+    return pixmap;
+  }
+
+  pixmap->mgtk_rastport=layer->rp;
+  pixmap->mgtk_screen=screen;
+  pixmap->mgtk_dri=dri;
+
+  DebOut("  pixmap=%lx rp=%lx\n",pixmap,layer->rp);
+
+  return pixmap;
+}
+
+void gdk_drawable_get_size(GdkDrawable *drawable, gint *width, gint *height) {
+  GtkWidget *widget;
+  Object *obj;
+  gint w=0;
+  gint h=0;
+
+  if(drawable && GDK_IS_PIXMAP(drawable)) {
+    w=drawable->mgtk_width;
+    h=drawable->mgtk_height;
+  }
+  else if(drawable && drawable->mgtk_widget) {
+    widget=(GtkWidget *) drawable->mgtk_widget;
+    obj=GtkObj(widget);
+    if(obj && muiRenderInfo(obj)) {
+      w=_mwidth(obj);
+      h=_mheight(obj);
+    }
+    else {
+      w=widget->allocation.width;
+      h=widget->allocation.height;
+    }
+  }
+
+  if(width) {
+    *width=w;
+  }
+  if(height) {
+    *height=h;
+  }
+}
+
+gint gdk_drawable_get_depth(GdkDrawable *drawable) {
+  GtkWidget *widget;
+  Object *obj;
+
+  if(drawable && GDK_IS_PIXMAP(drawable)) {
+    return drawable->mgtk_depth;
+  }
+
+  if(drawable && drawable->mgtk_widget) {
+    widget=(GtkWidget *) drawable->mgtk_widget;
+    obj=GtkObj(widget);
+    if(obj && muiRenderInfo(obj)) {
+      return GetBitMapAttr(_screen(obj)->RastPort.BitMap,BMA_DEPTH);
+    }
+  }
+
+  return 0;
+}
@@ -0,0 +1,51 @@
+/**************************************************
+ * taken and modified from the gtk+-2.6.9 sources,
+ * there was no "original copyright header", so 
+ * don't complain, that it is missing.
+ *
+ * o1i
+ *
+ * $Id: gdkpixmap.h,v 1.1 2026/10/19 16:00:00 o1i Exp $
+ **************************************************/
+
+#ifndef __GDK_PIXMAP_H__
+#define __GDK_PIXMAP_H__
+
+#include <gdk/gdktypes.h>
+#include <gdk/gdkdrawable.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif /* __cplusplus */
+
+/* GTK-MUI: a pixmap is an offscreen BitMap with its own layer, so
+ * everything drawn into it is clipped to its size. It is a friend
+ * bitmap of the screen, gdk_draw_drawable blits it into a window.
+ * Bitmaps (depth 1) are pixmaps, too.
+ */
+
+#define GDK_TYPE_PIXMAP              (gdk_pixmap_get_type ())
+#define GDK_PIXMAP(object)           (G_TYPE_CHECK_INSTANCE_CAST ((object), GDK_TYPE_PIXMAP, GdkPixmap))
+#define GDK_IS_PIXMAP(object)        (G_TYPE_CHECK_INSTANCE_TYPE ((object), GDK_TYPE_PIXMAP))
+
+GType      gdk_pixmap_get_type (void) G_GNUC_CONST;
+
+/* Pixmaps
+ */
+GdkPixmap* gdk_pixmap_new      (GdkDrawable *drawable,
+				gint	     width,
+				gint	     height,
+				gint	     depth);
+
+#ifndef GDK_DISABLE_DEPRECATED
+#define gdk_pixmap_ref                 g_object_ref
+#define gdk_pixmap_unref               g_object_unref
+#define gdk_bitmap_ref                 g_object_ref
+#define gdk_bitmap_unref               g_object_unref
+#endif /* GDK_DISABLE_DEPRECATED */
+
+#ifdef __cplusplus
+}
+#endif /* __cplusplus */
+
+#endif /* __GDK_PIXMAP_H__ */
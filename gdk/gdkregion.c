@@ -0,0 +1,291 @@
+/* GDK - The GIMP Drawing Kit
+ * Copyright (C) 1995-1997 Peter Mattis, Spencer Kimball and Josh MacDonald
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the
+ * Free Software Foundation, Inc., 59 Temple Place - Suite 330,
+ * Boston, MA 02111-1307, USA.
+ */
+
+/*
+ * Modified by the GTK-MUI Team 2006
+ *
+ * $Id: gdkregion.c,v 1.1 2026/10/19 10:00:00 o1i Exp $
+ */
+
+#include <string.h>
+#include <glib-object.h>
+
+#include "gdkregion.h"
+
+/**
+ * gdk_rectangle_intersect:
+ * @src1: a #GdkRectangle
+ * @src2: a #GdkRectangle
+ * @dest: return location for the intersection of @src1 and @src2
+ *
+ * Calculates the intersection of two rectangles. If the rectangles
+ * do not intersect, @dest's width and height are set to 0.
+ *
+ * Return value: %TRUE if the rectangles intersect.
+ **/
+gboolean
+gdk_rectangle_intersect (GdkRectangle *src1,
+			 GdkRectangle *src2,
+			 GdkRectangle *dest)
+{
+  gint dest_x, dest_y;
+  gint dest_x2, dest_y2;
+
+  g_return_val_if_fail (src1 != NULL, FALSE);
+  g_return_val_if_fail (src2 != NULL, FALSE);
+  g_return_val_if_fail (dest != NULL, FALSE);
+
+  dest_x = MAX (src1->x, src2->x);
+  dest_y = MAX (src1->y, src2->y);
+  dest_x2 = MIN (src1->x + src1->width, src2->x + src2->width);
+  dest_y2 = MIN (src1->y + src1->height, src2->y + src2->height);
+
+  if (dest_x2 > dest_x && dest_y2 > dest_y)
+    {
+      dest->x = dest_x;
+      dest->y = dest_y;
+      dest->width = dest_x2 - dest_x;
+      dest->height = dest_y2 - dest_y;
+      return TRUE;
+    }
+
+  dest->width = 0;
+  dest->height = 0;
+
+  return FALSE;
+}
+
+/**
+ * gdk_rectangle_union:
+ * @src1: a #GdkRectangle
+ * @src2: a #GdkRectangle
+ * @dest: return location for the union of @src1 and @src2
+ *
+ * Calculates the smallest rectangle containing both @src1 and @src2.
+ **/
+void
+gdk_rectangle_union (GdkRectangle *src1,
+		     GdkRectangle *src2,
+		     GdkRectangle *dest)
+{
+  gint dest_x, dest_y;
+
+  g_return_if_fail (src1 != NULL);
+  g_return_if_fail (src2 != NULL);
+  g_return_if_fail (dest != NULL);
+
+  dest_x = MIN (src1->x, src2->x);
+  dest_y = MIN (src1->y, src2->y);
+  dest->width = MAX (src1->x + src1->width, src2->x + src2->width) - dest_x;
+  dest->height = MAX (src1->y + src1->height, src2->y + src2->height) - dest_y;
+  dest->x = dest_x;
+  dest->y = dest_y;
+}
+
+static void
+region_grow (GdkRegion *region,
+	     gint       n)
+{
+  if (region->size >= n)
+    return;
+
+  if (region->size * 2 > n)
+    n = region->size * 2;
+
+  region->rects = g_renew (GdkRectangle, region->rects, n);
+  region->size = n;
+}
+
+GdkRegion *
+gdk_region_new (void)
+{
+  GdkRegion *region;
+
+  region = g_new0 (GdkRegion, 1);
+
+  return region;
+}
+
+GdkRegion *
+gdk_region_rectangle (GdkRectangle *rectangle)
+{
+  GdkRegion *region;
+
+  g_return_val_if_fail (rectangle != NULL, NULL);
+
+  region = gdk_region_new ();
+  mgtk_region_set_rectangle (region, rectangle);
+
+  return region;
+}
+
+GdkRegion *
+gdk_region_copy (GdkRegion *region)
+{
+  GdkRegion *ret;
+
+  g_return_val_if_fail (region != NULL, NULL);
+
+  ret = gdk_region_new ();
+  if (region->n_rects)
+    {
+      region_grow (ret, region->n_rects);
+      memcpy (ret->rects, region->rects, region->n_rects * sizeof (GdkRectangle));
+    }
+  ret->n_rects = region->n_rects;
+  ret->extents = region->extents;
+
+  return ret;
+}
+
+void
+gdk_region_destroy (GdkRegion *region)
+{
+  g_return_if_fail (region != NULL);
+
+  g_free (region->rects);
+  g_free (region);
+}
+
+void
+mgtk_region_set_rectangle (GdkRegion    *region,
+			   GdkRectangle *rectangle)
+{
+  region->n_rects = 0;
+  region->extents.x = 0;
+  region->extents.y = 0;
+  region->extents.width = 0;
+  region->extents.height = 0;
+
+  if (rectangle->width <= 0 || rectangle->height <= 0)
+    return;
+
+  region_grow (region, 1);
+  region->rects[0] = *rectangle;
+  region->n_rects = 1;
+  region->extents = *rectangle;
+}
+
+void
+gdk_region_get_clipbox (GdkRegion    *region,
+			GdkRectangle *rectangle)
+{
+  g_return_if_fail (region != NULL);
+  g_return_if_fail (rectangle != NULL);
+
+  *rectangle = region->extents;
+}
+
+void
+gdk_region_get_rectangles (GdkRegion     *region,
+			   GdkRectangle **rectangles,
+			   gint          *n_rectangles)
+{
+  g_return_if_fail (region != NULL);
+  g_return_if_fail (rectangles != NULL);
+  g_return_if_fail (n_rectangles != NULL);
+
+  *n_rectangles = region->n_rects;
+  *rectangles = NULL;
+
+  if (region->n_rects)
+    *rectangles = g_memdup (region->rects, region->n_rects * sizeof (GdkRectangle));
+}
+
+gboolean
+gdk_region_empty (GdkRegion *region)
+{
+  g_return_val_if_fail (region != NULL, FALSE);
+
+  return region->n_rects == 0;
+}
+
+gboolean
+gdk_region_point_in (GdkRegion *region,
+		     int        x,
+		     int        y)
+{
+  gint i;
+
+  g_return_val_if_fail (region != NULL, FALSE);
+
+  for (i = 0; i < region->n_rects; i++)
+    {
+      GdkRectangle *r = &region->rects[i];
+
+      if (x >= r->x && x < r->x + r->width &&
+	  y >= r->y && y < r->y + r->height)
+	return TRUE;
+    }
+
+  return FALSE;
+}
+
+void
+gdk_region_offset (GdkRegion *region,
+		   gint       dx,
+		   gint       dy)
+{
+  gint i;
+
+  g_return_if_fail (region != NULL);
+
+  for (i = 0; i < region->n_rects; i++)
+    {
+      region->rects[i].x += dx;
+      region->rects[i].y += dy;
+    }
+
+  region->extents.x += dx;
+  region->extents.y += dy;
+}
+
+void
+gdk_region_union_with_rect (GdkRegion    *region,
+			    GdkRectangle *rect)
+{
+  gint i;
+
+  g_return_if_fail (region != NULL);
+  g_return_if_fail (rect != NULL);
+
+  if (rect->width <= 0 || rect->height <= 0)
+    return;
+
+  if (!region->n_rects)
+    {
+      mgtk_region_set_rectangle (region, rect);
+      return;
+    }
+
+  /* already covered by one of our rectangles? */
+  for (i = 0; i < region->n_rects; i++)
+    {
+      GdkRectangle *r = &region->rects[i];
+
+      if (rect->x >= r->x && rect->x + rect->width <= r->x + r->width &&
+	  rect->y >= r->y && rect->y + rect->height <= r->y + r->height)
+	return;
+    }
+
+  region_grow (region, region->n_rects + 1);
+  region->rects[region->n_rects++] = *rect;
+
+  gdk_rectangle_union (&region->extents, rect, &region->extents);
+}
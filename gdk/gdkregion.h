@@ -0,0 +1,81 @@
+/* GDK - The GIMP Drawing Kit
+ * Copyright (C) 1995-1997 Peter Mattis, Spencer Kimball and Josh MacDonald
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the
+ * Free Software Foundation, Inc., 59 Temple Place - Suite 330,
+ * Boston, MA 02111-1307, USA.
+ */
+
+/*
+ * Modified by the GTK-MUI Team 2006
+ *
+ * $Id: gdkregion.h,v 1.1 2026/10/19 10:00:00 o1i Exp $
+ */
+
+#ifndef __GDK_REGION_H__
+#define __GDK_REGION_H__
+
+#include <gdk/gdktypes.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif /* __cplusplus */
+
+/* GTK-MUI: a region is just a list of rectangles. Unions are
+ * appended, so the rectangles may overlap. This is enough for
+ * expose areas and clipping, but not for real region arithmetic.
+ */
+struct _GdkRegion
+{
+  gint          size;      /* allocated rects */
+  gint          n_rects;
+  GdkRectangle *rects;
+  GdkRectangle  extents;   /* bounding box of all rects */
+};
+
+GdkRegion *gdk_region_new             (void);
+GdkRegion *gdk_region_rectangle       (GdkRectangle *rectangle);
+GdkRegion *gdk_region_copy            (GdkRegion    *region);
+void       gdk_region_destroy         (GdkRegion    *region);
+void       gdk_region_get_clipbox     (GdkRegion    *region,
+				       GdkRectangle *rectangle);
+void       gdk_region_get_rectangles  (GdkRegion    *region,
+				       GdkRectangle **rectangles,
+				       gint          *n_rectangles);
+gboolean   gdk_region_empty           (GdkRegion    *region);
+gboolean   gdk_region_point_in        (GdkRegion    *region,
+				       int           x,
+				       int           y);
+void       gdk_region_offset          (GdkRegion    *region,
+				       gint          dx,
+				       gint          dy);
+void       gdk_region_union_with_rect (GdkRegion    *region,
+				       GdkRectangle *rect);
+
+gboolean   gdk_rectangle_intersect    (GdkRectangle *src1,
+				       GdkRectangle *src2,
+				       GdkRectangle *dest);
+void       gdk_rectangle_union        (GdkRectangle *src1,
+				       GdkRectangle *src2,
+				       GdkRectangle *dest);
+
+/* GTK-MUI private: reset region to a single rectangle, keeps its storage */
+void       mgtk_region_set_rectangle  (GdkRegion    *region,
+				       GdkRectangle *rectangle);
+
+#ifdef __cplusplus
+}
+#endif /* __cplusplus */
+
+#endif /* __GDK_REGION_H__ */
@@ -0,0 +1,94 @@
+/* GDK - The GIMP Drawing Kit
+ * Copyright (C) 1995-1997 Peter Mattis, Spencer Kimball and Josh MacDonald
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the
+ * Free Software Foundation, Inc., 59 Temple Place - Suite 330,
+ * Boston, MA 02111-1307, USA.
+ */
+
+/*
+ * Modified by the GTK-MUI Team 2006
+ *
+ * $Id: gdkrgb.h,v 1.1 2026/10/19 10:00:00 o1i Exp $
+ */
+
+#ifndef __GDK_RGB_H__
+#define __GDK_RGB_H__
+
+#include <gdk/gdktypes.h>
+#include <gdk/gdkpixbuf.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif /* __cplusplus */
+
+typedef enum
+{
+  GDK_RGB_DITHER_NONE,
+  GDK_RGB_DITHER_NORMAL,
+  GDK_RGB_DITHER_MAX
+} GdkRgbDither;
+
+void gdk_draw_rgb_image  (GdkDrawable  *drawable,
+			  GdkGC        *gc,
+			  gint          x,
+			  gint          y,
+			  gint          width,
+			  gint          height,
+			  GdkRgbDither  dith,
+			  guchar       *rgb_buf,
+			  gint          rowstride);
+void gdk_draw_rgb_image_dithalign (GdkDrawable  *drawable,
+			  GdkGC        *gc,
+			  gint          x,
+			  gint          y,
+			  gint          width,
+			  gint          height,
+			  GdkRgbDither  dith,
+			  guchar       *rgb_buf,
+			  gint          rowstride,
+			  gint          xdith,
+			  gint          ydith);
+void gdk_draw_gray_image (GdkDrawable  *drawable,
+			  GdkGC        *gc,
+			  gint          x,
+			  gint          y,
+			  gint          width,
+			  gint          height,
+			  GdkRgbDither  dith,
+			  guchar       *buf,
+			  gint          rowstride);
+
+/* GTK-MUI: gdk_draw_pixbuf lives here, gdkdrawable.h has it disabled */
+void gdk_draw_pixbuf     (GdkDrawable  *drawable,
+			  GdkGC        *gc,
+			  GdkPixbuf    *pixbuf,
+			  gint          src_x,
+			  gint          src_y,
+			  gint          dest_x,
+			  gint          dest_y,
+			  gint          width,
+			  gint          height,
+			  GdkRgbDither  dither,
+			  gint          x_dither,
+			  gint          y_dither);
+
+/* GTK-MUI private: releases the dither pens and cybergraphics.library */
+void mgtk_rgb_cleanup    (void);
+
+#ifdef __cplusplus
+}
+#endif /* __cplusplus */
+
+#endif /* __GDK_RGB_H__ */
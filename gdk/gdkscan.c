@@ -0,0 +1,282 @@
+/*****************************************************************************
+ *
+ * gtk-mui - a wrapper library to wrap GTK+ calls to MUI
+ *
+ * Copyright (C) 2005 Oliver Brunner
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+ *
+ * Contact information:
+ *
+ * Oliver Brunner
+ *
+ * E-Mail: gtk-mui "at" oliver-brunner.de
+ *
+ * $Id: gdkscan.c,v 1.1 2026/10/19 14:00:00 o1i Exp $
+ *
+ *****************************************************************************/
+
+/* scan conversion of polygons, ellipses and pie slices, see gdkscan.h */
+
+#include <math.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "gdkscan.h"
+
+#define FULL_CIRCLE (360*64)
+
+/* arcs get one segment per SEGMENT_PIXELS of their length */
+#define SEGMENT_PIXELS 2.0
+#define MAX_SEGMENTS   1024
+
+typedef struct {
+  gdouble ytop;   /* ytop < ybottom */
+  gdouble ybottom;
+  gdouble x;      /* at ytop */
+  gdouble dxdy;
+  gint    dir;    /* +1 downwards, -1 upwards, for the winding rule */
+} Edge;
+
+static gint edge_compare(gconstpointer a, gconstpointer b) {
+  const Edge *ea=(const Edge *) a;
+  const Edge *eb=(const Edge *) b;
+
+  if(ea->ytop < eb->ytop) {
+    return -1;
+  }
+  return ea->ytop > eb->ytop;
+}
+
+/* first pixel with its centre at or right of x */
+#define PIXEL_FROM(x) ((gint) ceil((x)-0.5))
+
+void mgtk_scan_polygon(const MgtkScanPoint *points, gint npoints, MgtkSpanFunc span, gpointer data) {
+
+  mgtk_scan_polygon_rule(points,npoints,FALSE,span,data);
+}
+
+void mgtk_scan_polygon_rule(const MgtkScanPoint *points, gint npoints, gboolean winding,
+                            MgtkSpanFunc span, gpointer data) {
+  Edge *edges;
+  Edge **active;
+  gdouble *cross;
+  gint *dirs;
+  const MgtkScanPoint *p0;
+  const MgtkScanPoint *p1;
+  gint nedges;
+  gint nactive;
+  gint next;
+  gint i, j;
+  gint y, ylast;
+  gdouble yc, ymax;
+  gdouble x;
+  gint x1, x2;
+  gint w;
+
+  if(npoints<3) {
+    return;
+  }
+
+  edges=g_new(Edge,npoints);
+  active=g_new(Edge *,npoints);
+  cross=g_new(gdouble,npoints);
+  dirs=g_new(gint,npoints);
+
+  nedges=0;
+  ymax=points[0].y;
+  for(i=0;i<npoints;i++) {
+    p0=&points[i];
+    p1=&points[(i+1) % npoints];
+    if(p0->y == p1->y) {
+      continue;         /* horizontal edges cross no row centre */
+    }
+    edges[nedges].dir=1;
+    if(p0->y > p1->y) {
+      p0=p1;
+      p1=&points[i];
+      edges[nedges].dir=-1;
+    }
+    edges[nedges].ytop=p0->y;
+    edges[nedges].ybottom=p1->y;
+    edges[nedges].x=p0->x;
+    edges[nedges].dxdy=(p1->x - p0->x) / (p1->y - p0->y);
+    if(p1->y > ymax) {
+      ymax=p1->y;
+    }
+    nedges++;
+  }
+
+  if(!nedges) {
+    goto done;
+  }
+
+  qsort(edges,nedges,sizeof(Edge),edge_compare);
+
+  y=PIXEL_FROM(edges[0].ytop);
+  ylast=PIXEL_FROM(ymax)-1;
+  nactive=0;
+  next=0;
+
+  for(;y<=ylast;y++) {
+    yc=y+0.5;
+
+    /* edges starting above this row centre */
+    while(next<nedges && edges[next].ytop <= yc) {
+      active[nactive++]=&edges[next++];
+    }
+
+    /* crossings of the edges still alive, sorted by x */
+    j=0;
+    for(i=0;i<nactive;i++) {
+      if(active[i]->ybottom <= yc) {
+        continue;
+      }
+      active[j++]=active[i];
+    }
+    nactive=j;
+
+    for(i=0;i<nactive;i++) {
+      x=active[i]->x + (yc - active[i]->ytop) * active[i]->dxdy;
+      for(j=i;j>0 && cross[j-1] > x;j--) {
+        cross[j]=cross[j-1];
+        dirs[j]=dirs[j-1];
+      }
+      cross[j]=x;
+      dirs[j]=active[i]->dir;
+    }
+
+    if(!winding) {
+      for(i=0;i+1<nactive;i+=2) {
+        x1=PIXEL_FROM(cross[i]);
+        x2=PIXEL_FROM(cross[i+1])-1;
+        if(x1<=x2) {
+          span(y,x1,x2,data);
+        }
+      }
+      continue;
+    }
+
+    /* non-zero: from where the winding number leaves 0 until it is back */
+    w=0;
+    j=0;
+    for(i=0;i<nactive;i++) {
+      if(!w) {
+        j=i;
+      }
+      w+=dirs[i];
+      if(!w) {
+        x1=PIXEL_FROM(cross[j]);
+        x2=PIXEL_FROM(cross[i])-1;
+        if(x1<=x2) {
+          span(y,x1,x2,data);
+        }
+      }
+    }
+  }
+
+done:
+  g_free(dirs);
+  g_free(cross);
+  g_free(active);
+  g_free(edges);
+}
+
+void mgtk_scan_ellipse(gint x, gint y, gint width, gint height, MgtkSpanFunc span, gpointer data) {
+  gdouble cx, cy, rx, ry;
+  gdouble t, dx;
+  gint row;
+  gint x1, x2;
+
+  if(width<=0 || height<=0) {
+    return;
+  }
+
+  rx=width/2.0;
+  ry=height/2.0;
+  cx=x+rx;
+  cy=y+ry;
+
+  for(row=y;row<y+height;row++) {
+    t=(row+0.5-cy)/ry;
+    if(t <= -1.0 || t >= 1.0) {
+      continue;
+    }
+    dx=rx*sqrt(1.0-t*t);
+    x1=PIXEL_FROM(cx-dx);
+    x2=PIXEL_FROM(cx+dx)-1;
+    if(x1<=x2) {
+      span(row,x1,x2,data);
+    }
+  }
+}
+
+gint mgtk_scan_arc_points(gint x, gint y, gint width, gint height, gint angle1, gint angle2, MgtkScanPoint **points) {
+  MgtkScanPoint *p;
+  gdouble cx, cy, rx, ry;
+  gdouble length;
+  gdouble a;
+  gint segments;
+  gint i;
+
+  angle2=CLAMP(angle2,-FULL_CIRCLE,FULL_CIRCLE);
+
+  rx=width/2.0;
+  ry=height/2.0;
+  cx=x+rx;
+  cy=y+ry;
+
+  /* good enough estimate of the ellipse circumference */
+  length=G_PI*(rx+ry) * ABS(angle2) / FULL_CIRCLE;
+  segments=CLAMP((gint) ceil(length/SEGMENT_PIXELS),2,MAX_SEGMENTS);
+
+  p=g_new(MgtkScanPoint,segments+1);
+  for(i=0;i<=segments;i++) {
+    a=(angle1 + (gdouble) angle2*i/segments) * G_PI / (180.0*64);
+    p[i].x=cx + rx*cos(a);
+    p[i].y=cy - ry*sin(a);
+  }
+
+  *points=p;
+  return segments+1;
+}
+
+void mgtk_scan_pie(gint x, gint y, gint width, gint height, gint angle1, gint angle2, MgtkSpanFunc span, gpointer data) {
+  MgtkScanPoint *arc;
+  MgtkScanPoint *pie;
+  gint n;
+
+  if(width<=0 || height<=0 || !angle2) {
+    return;
+  }
+
+  if(ABS(angle2) >= FULL_CIRCLE) {
+    mgtk_scan_ellipse(x,y,width,height,span,data);
+    return;
+  }
+
+  n=mgtk_scan_arc_points(x,y,width,height,angle1,angle2,&arc);
+
+  /* centre first, the closing edge goes back to it */
+  pie=g_new(MgtkScanPoint,n+1);
+  pie[0].x=x+width/2.0;
+  pie[0].y=y+height/2.0;
+  memcpy(pie+1,arc,n*sizeof(MgtkScanPoint));
+
+  mgtk_scan_polygon(pie,n+1,span,data);
+
+  g_free(pie);
+  g_free(arc);
+}
@@ -0,0 +1,74 @@
+/*****************************************************************************
+ *
+ * gtk-mui - a wrapper library to wrap GTK+ calls to MUI
+ *
+ * Copyright (C) 2005 Oliver Brunner
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+ *
+ * Contact information:
+ *
+ * Oliver Brunner
+ *
+ * E-Mail: gtk-mui "at" oliver-brunner.de
+ *
+ * $Id: gdkscan.h,v 1.1 2026/10/19 14:00:00 o1i Exp $
+ *
+ *****************************************************************************/
+
+#ifndef MGTK_SCAN_H
+#define MGTK_SCAN_H
+
+/* Scan conversion of filled shapes into horizontal spans, used by
+ * gdk_draw_polygon and gdk_draw_arc.
+ *
+ * Like X11, a pixel belongs to a shape, if its centre is inside. Edges
+ * are half open, so shapes sharing an edge never share a pixel. Polygons
+ * use the even-odd rule, which is also what the Amiga area fill does,
+ * mgtk_scan_polygon_rule can do the non-zero winding rule, too.
+ *
+ * Angles are GDK angles: 1/64 degree, counter-clockwise from 3 o'clock.
+ *
+ * Only depends on glib, so it can be built and tried out on any host.
+ */
+
+#include <glib.h>
+
+/* one row of pixels x1..x2 (inclusive) in row y */
+typedef void (*MgtkSpanFunc) (gint y, gint x1, gint x2, gpointer data);
+
+typedef struct {
+  gdouble x;
+  gdouble y;
+} MgtkScanPoint;
+
+void  mgtk_scan_polygon    (const MgtkScanPoint *points, gint npoints,
+                            MgtkSpanFunc span, gpointer data);
+void  mgtk_scan_polygon_rule(const MgtkScanPoint *points, gint npoints,
+                            gboolean winding, MgtkSpanFunc span, gpointer data);
+void  mgtk_scan_ellipse    (gint x, gint y, gint width, gint height,
+                            MgtkSpanFunc span, gpointer data);
+void  mgtk_scan_pie        (gint x, gint y, gint width, gint height,
+                            gint angle1, gint angle2,
+                            MgtkSpanFunc span, gpointer data);
+
+/* points on the arc, the ellipse goes through x..x+width, y..y+height.
+ * Returns the number of points, free *points with g_free.
+ */
+gint  mgtk_scan_arc_points (gint x, gint y, gint width, gint height,
+                            gint angle1, gint angle2,
+                            MgtkScanPoint **points);
+
+#endif
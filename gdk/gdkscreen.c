@@ -22,10 +22,15 @@
  */
 
 #include <config.h>
-#include "gdk.h"		/* For gdk_rectangle_intersect() */
-#include "gdkcolor.h"
-#include "gdkwindow.h"
+#include <string.h>
+#include <proto/intuition.h>
+#include <mui.h>
+
+#include "../debug.h"
+#include <gtk/gtk.h>
+#include "../gtk_globals.h"
 #include "gdkscreen.h"
+#include "gdkmonitor.h"
 #if 0
 #include "gdkalias.h"
 #endif
@@ -43,6 +48,16 @@ static guint signals[LAST_SIGNAL] = { 0 };
 
 static gpointer parent_class = NULL;
 
+/* GTK-MUI: there is only one GdkScreen, the public screen the main
+ * window is on. Its monitor layout is cached and rebuilt, when the
+ * application moves to a screen of another size or the screen changes
+ * its resolution, see screen_layout (). Nothing tells us about such a
+ * change, it is only noticed by the next gdk_screen_* call.
+ */
+static GdkScreen         *default_screen = NULL;
+static MgtkMonitorLayout  layout;
+static gboolean           layout_valid = FALSE;
+
 GType
 gdk_screen_get_type (void)
 {
@@ -129,51 +144,161 @@ _gdk_screen_close (GdkScreen *screen)
     }
 }
 
-/* Fallback used when the monitor "at" a point or window
- * doesn't exist.
+/* GTK-MUI private: the screen of the main window, if it is open, or
+ * the public screen locked in gtk_init.
  */
-static gint
-get_nearest_monitor (GdkScreen *screen,
-		     gint       x,
-		     gint       y)
+static struct Screen *
+current_screen (void)
 {
-  gint num_monitors, i;
-  gint nearest_dist = G_MAXINT;
-  gint nearest_monitor = 0;
-  
-  g_return_val_if_fail (GDK_IS_SCREEN (screen), -1);
+  struct Screen *screen = NULL;
 
-  num_monitors = gdk_screen_get_n_monitors (screen);
-  
-  for (i = 0; i < num_monitors; i++)
+  if (!global_mgtk)
+    return NULL;
+
+  if (global_mgtk->MuiRoot && xget (global_mgtk->MuiRoot, MUIA_Window_Open))
+    screen = (struct Screen *) xget (global_mgtk->MuiRoot, MUIA_Window_Screen);
+
+  if (!screen)
+    screen = global_mgtk->screen;
+
+  return screen;
+}
+
+/* GTK-MUI private: the monitor layout of the current screen.
+ *
+ * An Amiga screen is shown on one monitor, so the description has a
+ * single monitor covering all of it. Intuition does not know the size
+ * of the display in millimeters, 72 dpi are assumed.
+ *
+ * There is no notification for screen changes: the cache is checked by
+ * polling, every getter describes the screen again and compares. That
+ * is a few assignments, the layout is only rebuilt, if the description
+ * differs from the cached one.
+ *
+ * So "size_changed" is not emitted when the screen changes, but from
+ * inside the first getter called afterwards, before it returns. The
+ * layout is already rebuilt then, so handlers may call the getters
+ * again, but they run in the middle of whatever code asked for the
+ * screen size.
+ */
+static const MgtkMonitorLayout *
+screen_layout (GdkScreen *screen)
+{
+  struct Screen *s;
+  MgtkDisplayDesc desc;
+  gboolean resized;
+
+  s = current_screen ();
+
+  memset (&desc, 0, sizeof (desc));
+  if (s)
     {
-      GdkRectangle monitor;
-      gint dist_x, dist_y;
-      
-      gdk_screen_get_monitor_geometry (screen, i, &monitor);
-
-      if (x < monitor.x)
-	dist_x = monitor.x - x;
-      else if (x >= monitor.x + monitor.width)
-	dist_x = x - (monitor.x + monitor.width) + 1;
-      else
-	dist_x = 0;
-
-      if (y < monitor.y)
-	dist_y = monitor.y - y;
-      else if (y >= monitor.y + monitor.height)
-	dist_y = y - (monitor.y + monitor.height) + 1;
-      else
-	dist_y = 0;
-
-      if (MIN (dist_x, dist_y) < nearest_dist)
-	{
-	  nearest_dist = MIN (dist_x, dist_y);
-	  nearest_monitor = i;
-	}
+      desc.width = s->Width;
+      desc.height = s->Height;
     }
+  desc.width_mm = desc.width * 127 / 360;
+  desc.height_mm = desc.height * 127 / 360;
+  desc.n_monitors = 1;
+  desc.monitors[0].width = desc.width;
+  desc.monitors[0].height = desc.height;
+
+  if (layout_valid && !mgtk_monitor_layout_differs (&layout, &desc))
+    return &layout;
+
+  resized = layout_valid &&
+            (layout.desc.width != desc.width || layout.desc.height != desc.height);
+
+  DebOut ("screen_layout: screen %lx is %dx%d\n", s, desc.width, desc.height);
+  mgtk_monitor_layout_build (&layout, &desc);
+  layout_valid = TRUE;
+
+  if (resized && screen)
+    g_signal_emit (screen, signals[SIZE_CHANGED], 0);
+
+  return &layout;
+}
+
+/**
+ * gdk_screen_get_default:
+ *
+ * Gets the default screen.
+ *
+ * Returns: the screen of the main window.
+ **/
+GdkScreen *
+gdk_screen_get_default (void)
+{
+  if (!default_screen)
+    default_screen = g_object_new (GDK_TYPE_SCREEN, NULL);
+
+  return default_screen;
+}
+
+gint
+gdk_screen_get_number (GdkScreen *screen)
+{
+  g_return_val_if_fail (GDK_IS_SCREEN (screen), 0);
+
+  return 0;
+}
+
+gint
+gdk_screen_get_width (GdkScreen *screen)
+{
+  g_return_val_if_fail (GDK_IS_SCREEN (screen), 0);
 
-  return nearest_monitor;
+  return screen_layout (screen)->desc.width;
+}
+
+gint
+gdk_screen_get_height (GdkScreen *screen)
+{
+  g_return_val_if_fail (GDK_IS_SCREEN (screen), 0);
+
+  return screen_layout (screen)->desc.height;
+}
+
+gint
+gdk_screen_get_width_mm (GdkScreen *screen)
+{
+  g_return_val_if_fail (GDK_IS_SCREEN (screen), 0);
+
+  return screen_layout (screen)->desc.width_mm;
+}
+
+gint
+gdk_screen_get_height_mm (GdkScreen *screen)
+{
+  g_return_val_if_fail (GDK_IS_SCREEN (screen), 0);
+
+  return screen_layout (screen)->desc.height_mm;
+}
+
+gint
+gdk_screen_get_n_monitors (GdkScreen *screen)
+{
+  g_return_val_if_fail (GDK_IS_SCREEN (screen), 0);
+
+  return screen_layout (screen)->desc.n_monitors;
+}
+
+void
+gdk_screen_get_monitor_geometry (GdkScreen    *screen,
+				 gint          monitor_num,
+				 GdkRectangle *dest)
+{
+  const MgtkMonitorLayout *l;
+
+  g_return_if_fail (GDK_IS_SCREEN (screen));
+  g_return_if_fail (dest != NULL);
+
+  l = screen_layout (screen);
+  g_return_if_fail (monitor_num >= 0 && monitor_num < l->desc.n_monitors);
+
+  dest->x = l->desc.monitors[monitor_num].x;
+  dest->y = l->desc.monitors[monitor_num].y;
+  dest->width = l->desc.monitors[monitor_num].width;
+  dest->height = l->desc.monitors[monitor_num].height;
 }
 
 /**
@@ -194,26 +319,9 @@ gdk_screen_get_monitor_at_point (GdkScreen *screen,
 				 gint       x,
 				 gint       y)
 {
-  gint num_monitors, i;
-  
   g_return_val_if_fail (GDK_IS_SCREEN (screen), -1);
 
-  num_monitors = gdk_screen_get_n_monitors (screen);
-  
-  for (i=0;i<num_monitors;i++)
-    {
-      GdkRectangle monitor;
-      
-      gdk_screen_get_monitor_geometry (screen, i, &monitor);
-
-      if (x >= monitor.x &&
-          x < monitor.x + monitor.width &&
-          y >= monitor.y &&
-          y < (monitor.y + monitor.height))
-        return i;
-    }
-
-  return get_nearest_monitor (screen, x, y);
+  return mgtk_monitor_at_point (screen_layout (screen), x, y);
 }
 
 /**
@@ -233,34 +341,24 @@ gint
 gdk_screen_get_monitor_at_window (GdkScreen      *screen,
 				  GdkWindow	 *window)
 {
-  gint num_monitors, i, area = 0, screen_num = -1;
-  GdkRectangle win_rect;
+  MgtkMonitorRect win_rect = { 0, 0, 0, 0 };
+  Object *obj = NULL;
+
   g_return_val_if_fail (GDK_IS_SCREEN (screen), -1);
-  
-  gdk_window_get_geometry (window, &win_rect.x, &win_rect.y, &win_rect.width,
-			   &win_rect.height, NULL);
-  gdk_window_get_origin (window, &win_rect.x, &win_rect.y);
-  num_monitors = gdk_screen_get_n_monitors (screen);
-  
-  for (i=0;i<num_monitors;i++)
+
+  /* the MUI object of the window, in screen coordinates */
+  if (window && window->mgtk_widget)
+    obj = GtkObj ((GtkWidget *) window->mgtk_widget);
+
+  if (obj && muiRenderInfo (obj) && _window (obj))
     {
-      GdkRectangle tmp_monitor, intersect;
-      
-      gdk_screen_get_monitor_geometry (screen, i, &tmp_monitor);
-      gdk_rectangle_intersect (&win_rect, &tmp_monitor, &intersect);
-      
-      if (intersect.width * intersect.height > area)
-	{ 
-	  area = intersect.width * intersect.height;
-	  screen_num = i;
-	}
+      win_rect.x = _window (obj)->LeftEdge + _mleft (obj);
+      win_rect.y = _window (obj)->TopEdge + _mtop (obj);
+      win_rect.width = _mwidth (obj);
+      win_rect.height = _mheight (obj);
     }
-  if (screen_num >= 0)
-    return screen_num;
-  else
-    return get_nearest_monitor (screen,
-				win_rect.x + win_rect.width / 2,
-				win_rect.y + win_rect.height / 2);
+
+  return mgtk_monitor_at_rect (screen_layout (screen), &win_rect);
 }
 
 /**
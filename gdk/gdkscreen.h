@@ -99,6 +99,14 @@ gboolean   gdk_screen_get_setting (GdkScreen   *screen,
 				   const gchar *name,
 				   GValue      *value);
 
+/* of the default screen */
+gint gdk_screen_width     (void);
+gint gdk_screen_height    (void);
+gint gdk_screen_width_mm  (void);
+gint gdk_screen_height_mm (void);
+
+void _gdk_screen_close (GdkScreen *screen);
+
 G_END_DECLS
 
 #endif				/* __GDK_SCREEN_H__ */
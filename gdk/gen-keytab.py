@@ -0,0 +1,208 @@
+#!/usr/bin/env python3
+#
+# Generates the keyval lookup tables for gdk/gdkkeyuni.c from the X11
+# keysymdef.h:
+#
+#   gdk/gen-keytab.py /usr/include/X11/keysymdef.h > gdk/gdkkeytab.h
+#
+# With --pairs it prints every keysym -> unicode pair it read instead,
+# for the exhaustive check in test/test-keyuni.c:
+#
+#   gdk/gen-keytab.py --pairs /usr/include/X11/keysymdef.h > test/keysympairs.h
+#
+
+import re
+import sys
+
+# keysyms without a U+ comment, which still type a character
+SPECIALS = {
+    0xff08: 0x0008,  # BackSpace
+    0xff09: 0x0009,  # Tab
+    0xff0a: 0x000a,  # Linefeed
+    0xff0d: 0x000d,  # Return
+    0xff1b: 0x001b,  # Escape
+    0xff80: 0x0020,  # KP_Space
+    0xff89: 0x0009,  # KP_Tab
+    0xff8d: 0x000d,  # KP_Enter
+    0xffaa: 0x002a,  # KP_Multiply
+    0xffab: 0x002b,  # KP_Add
+    0xffac: 0x002c,  # KP_Separator
+    0xffad: 0x002d,  # KP_Subtract
+    0xffae: 0x002e,  # KP_Decimal
+    0xffaf: 0x002f,  # KP_Divide
+    0xffbd: 0x003d,  # KP_Equal
+    0xffff: 0x007f,  # Delete
+}
+for i in range(10):
+    SPECIALS[0xffb0 + i] = 0x0030 + i  # KP_0 .. KP_9
+
+LIMIT = 0x10000
+
+
+def parse(path):
+    forward = {}
+    exact = {}
+    define = re.compile(r'^#define XK_(\w+)\s+0x([0-9a-fA-F]+)\s*/\*\s*(\(?)U\+([0-9a-fA-F]+)')
+    for line in open(path):
+        m = define.match(line)
+        if not m:
+            continue
+        keysym = int(m.group(2), 16)
+        ucs = int(m.group(4), 16)
+        if keysym >= LIMIT:
+            continue                    # directly encoded, 0x01000000 | ucs
+        if keysym in forward and forward[keysym] != ucs:
+            sys.exit('keysym 0x%04x maps to U+%04X and U+%04X' % (keysym, forward[keysym], ucs))
+        forward[keysym] = ucs
+        exact[keysym] = exact.get(keysym, False) or not m.group(3)
+    for keysym, ucs in SPECIALS.items():
+        forward[keysym] = ucs
+    return forward, exact
+
+
+def case_of(s):
+    """The keysym case rules of X11 XConvertCase."""
+    lower = upper = s
+    page = s >> 8
+    if page == 0:                               # Latin 1
+        if 0x41 <= s <= 0x5a: lower += 0x20
+        elif 0x61 <= s <= 0x7a: upper -= 0x20
+        elif 0xc0 <= s <= 0xd6: lower += 0x20
+        elif 0xe0 <= s <= 0xf6: upper -= 0x20
+        elif 0xd8 <= s <= 0xde: lower += 0x20
+        elif 0xf8 <= s <= 0xfe: upper -= 0x20
+    elif page == 1:                             # Latin 2
+        if s == 0x1a1: lower = 0x1b1
+        elif 0x1a3 <= s <= 0x1a6: lower += 0x10
+        elif 0x1a9 <= s <= 0x1ac: lower += 0x10
+        elif 0x1ae <= s <= 0x1af: lower += 0x10
+        elif s == 0x1b1: upper = 0x1a1
+        elif 0x1b3 <= s <= 0x1b6: upper -= 0x10
+        elif 0x1b9 <= s <= 0x1bc: upper -= 0x10
+        elif 0x1be <= s <= 0x1bf: upper -= 0x10
+        elif 0x1c0 <= s <= 0x1de: lower += 0x20
+        elif 0x1e0 <= s <= 0x1fe: upper -= 0x20
+    elif page == 2:                             # Latin 3
+        if 0x2a1 <= s <= 0x2a6: lower += 0x10
+        elif 0x2ab <= s <= 0x2ac: lower += 0x10
+        elif 0x2b1 <= s <= 0x2b6: upper -= 0x10
+        elif 0x2bb <= s <= 0x2bc: upper -= 0x10
+        elif 0x2c5 <= s <= 0x2de: lower += 0x20
+        elif 0x2e5 <= s <= 0x2fe: upper -= 0x20
+    elif page == 3:                             # Latin 4
+        if 0x3a3 <= s <= 0x3ac: lower += 0x10
+        elif 0x3b3 <= s <= 0x3bc: upper -= 0x10
+        elif s == 0x3bd: lower = 0x3bf
+        elif s == 0x3bf: upper = 0x3bd
+        elif 0x3c0 <= s <= 0x3de: lower += 0x20
+        elif 0x3e0 <= s <= 0x3fe: upper -= 0x20
+    elif page == 6:                             # Cyrillic
+        if 0x6b1 <= s <= 0x6bf: lower -= 0x10
+        elif 0x6a1 <= s <= 0x6af: upper += 0x10
+        elif 0x6e0 <= s <= 0x6ff: lower -= 0x20
+        elif 0x6c0 <= s <= 0x6df: upper += 0x20
+    elif page == 7:                             # Greek
+        if 0x7a1 <= s <= 0x7ab: lower += 0x10
+        elif 0x7b1 <= s <= 0x7bb and s not in (0x7b6, 0x7ba): upper -= 0x10
+        elif 0x7c1 <= s <= 0x7d9: lower += 0x20
+        elif 0x7e1 <= s <= 0x7f9 and s != 0x7f3: upper -= 0x20
+    elif page == 0x13:                          # Latin 9
+        if s == 0x13bc: lower = 0x13bd
+        elif s == 0x13bd: upper = 0x13bc
+        elif s == 0x13be: lower = 0xff
+    return lower, upper
+
+
+def two_level(values, limit):
+    """Smallest split of 0..limit-1 into an index and shared blocks."""
+    best = None
+    for shift in range(3, 9):
+        size = 1 << shift
+        blocks = [[0] * size]
+        index = []
+        for base in range(0, limit, size):
+            block = [values.get(base + i, 0) for i in range(size)]
+            if block in blocks:
+                index.append(blocks.index(block))
+            else:
+                index.append(len(blocks))
+                blocks.append(block)
+        while index and index[-1] == 0:
+            index.pop()
+        cost = len(index) + len(blocks) * size * 2
+        if len(blocks) < 256 and (best is None or cost < best[0]):
+            best = (cost, shift, index, blocks)
+    return best[1:]
+
+
+def emit(name, values, limit, comment):
+    shift, index, blocks = two_level(values, limit)
+    size = 1 << shift
+    upper = name.upper()
+    print('/* %s */' % comment)
+    print('#define %s_SHIFT %d' % (upper, shift))
+    print('#define %s_MASK  0x%02x' % (upper, size - 1))
+    print('#define %s_LIMIT 0x%05x' % (upper, len(index) << shift))
+    print()
+    print('static const guint8 %s_index[%d] = {' % (name, len(index)))
+    for i in range(0, len(index), 16):
+        print('  ' + ' '.join('%3d,' % v for v in index[i:i + 16]))
+    print('};')
+    print()
+    print('static const guint16 %s_blocks[%d][%d] = {' % (name, len(blocks), size))
+    for b in blocks:
+        print('  {')
+        for i in range(0, size, 8):
+            print('    ' + ' '.join('0x%04x,' % v for v in b[i:i + 8]))
+        print('  },')
+    print('};')
+    print()
+
+
+def pairs(forward, exact):
+    print('/* generated by gen-keytab.py --pairs from keysymdef.h, do not edit.')
+    print(' * { keysym, unicode, exact }')
+    print(' */')
+    for keysym in sorted(forward):
+        print('{ 0x%04x, 0x%04x, %d },' % (keysym, forward[keysym], exact.get(keysym, True)))
+
+
+def main():
+    if sys.argv[1] == '--pairs':
+        pairs(*parse(sys.argv[2]))
+        return
+
+    forward, exact = parse(sys.argv[1])
+
+    # unicode -> keysym, only for the character pages. Exact mappings win
+    # over approximate ones, then the lower keysym.
+    reverse = {}
+    for keysym in sorted(forward):
+        ucs = forward[keysym]
+        if keysym < 0x100 or keysym >= 0xfe00:
+            continue
+        if ucs in reverse and (exact[reverse[ucs]] or not exact[keysym]):
+            continue
+        reverse[ucs] = keysym
+
+    # case: the other case of a keysym, 0x8000 set for uppercase keysyms
+    case = {}
+    for s in range(LIMIT):
+        lower, upper = case_of(s)
+        if lower != s:
+            case[s] = lower | 0x8000
+        elif upper != s:
+            case[s] = upper
+        assert lower == s or upper == s
+
+    print('/* generated by gen-keytab.py from keysymdef.h, do not edit.')
+    print(' * Only included by gdkkeyuni.c.')
+    print(' */')
+    print()
+    emit('keyval_ucs', forward, LIMIT, 'keyval -> unicode, 0 for no character')
+    emit('ucs_keyval', reverse, LIMIT, 'unicode -> legacy keyval, 0 for none')
+    emit('keyval_case', case, LIMIT, 'the other case of a keyval, with KEYVAL_CASE_UPPER for uppercase keyvals')
+    print('#define KEYVAL_CASE_UPPER 0x8000')
+
+
+main()
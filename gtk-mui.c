@@ -29,6 +29,8 @@
  *****************************************************************************/
 
 #include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
 #include <proto/intuition.h>
 #include <proto/graphics.h>
 #include <proto/exec.h>
@@ -48,6 +50,7 @@
 #endif
 
 #include "classes.h"
+#include "imagecache.h"
 #include "debug.h"
 #include <gtk/gtk.h>
 #include <gtk/gtkwindow.h>
@@ -78,6 +81,10 @@ static guint mui_signals[LAST_SIGNAL] = { 0 };
 
 static GtkMuiClass *parent_class = NULL;
 
+static void mgtk_live_object_add(GObject *object);
+static void mgtk_live_object_remove(GObject *object);
+static void mgtk_mui_object_bury(GtkMui *mui);
+
 static void gtk_mui_init (GtkMui *mui) {
 
   DebOut("gtk_mui_init(%lx)\n",mui);
@@ -119,14 +126,49 @@ GType gtk_mui_get_type (void) {
   return mui_type;
 }
 
+/* instance init only sees the class of GtkMui, the constructor the real type */
+static GObject *gtk_mui_constructor(GType type, guint n_construct_properties, GObjectConstructParam *construct_params) {
+  GObject *object;
+
+  object=G_OBJECT_CLASS(parent_class)->constructor(type,n_construct_properties,construct_params);
+  mgtk_live_object_add(object);
+
+  return object;
+}
+
+static void gtk_mui_dispose(GObject *object) {
+
+  mgtk_mui_object_bury(GTK_MUI(object));
+
+  G_OBJECT_CLASS(parent_class)->dispose(object);
+}
+
+static void gtk_mui_finalize(GObject *object) {
+
+  DebOut("gtk_mui_finalize(%lx)\n",object);
+
+  g_slist_free(GTK_MUI(object)->remember);
+  GTK_MUI(object)->remember=NULL;
+
+  mgtk_live_object_remove(object);
+
+  G_OBJECT_CLASS(parent_class)->finalize(object);
+}
+
 static void gtk_mui_class_init (GtkMuiClass *class) {
+  GObjectClass *gobject_class;
   GtkWidgetClass *widget_class;
 
   DebOut("gtk_mui_class_init(%lx)\n",class);
 
+  gobject_class = (GObjectClass*) class;
   widget_class = (GtkWidgetClass*) class;
   parent_class = g_type_class_peek_parent (class);
 
+  gobject_class->constructor = gtk_mui_constructor;
+  gobject_class->dispose = gtk_mui_dispose;
+  gobject_class->finalize = gtk_mui_finalize;
+
 
   mui_signals[COMMODITY_SHOW] =
     gtk_signal_new ("commodity-show",
@@ -146,6 +188,250 @@ static void gtk_mui_class_init (GtkMuiClass *class) {
 }
 
 
+/**********************************************************************
+ * MUI objects of destroyed widgets
+ *
+ * A widget may be destroyed from within a hook of its own MUI object
+ * (or one of its children), so the MUI object can neither be removed
+ * from its group nor disposed right away. It is buried here and
+ * mgtk_dispose_mui_objects() removes and disposes it later, from the
+ * main loop.
+ *
+ * Until then the object is hidden, so it gets no more input, and it
+ * holds a reference on its widget, so its hooks and dispatchers
+ * (which find the widget through MA_Widget or their instance data)
+ * never see a finalized one.
+ *
+ * Windows are left alone (see gtk_widget_destroy), as are menus,
+ * which are no members of a group.
+ **********************************************************************/
+static GHashTable *buried_objects;  /* MUI object -> widget */
+
+static void mgtk_mui_object_bury(GtkMui *mui) {
+
+  if(!mui->MuiObject || !GTK_IS_WIDGET(mui) || mui->mainclass==CL_WINDOW) {
+    return;
+  }
+  if(GTK_IS_WINDOW(mui) || GTK_IS_MENU_SHELL(mui) || GTK_IS_MENU_ITEM(mui)) {
+    return;
+  }
+
+  DebOut("mgtk_mui_object_bury(%lx): %lx\n",mui,mui->MuiObject);
+
+  if(!buried_objects) {
+    buried_objects=g_hash_table_new(g_direct_hash,g_direct_equal);
+  }
+
+  set(mui->MuiObject,MUIA_ShowMe,FALSE);
+  g_hash_table_insert(buried_objects,mui->MuiObject,g_object_ref(mui));
+  mui->MuiObject=NULL;
+}
+
+typedef struct {
+  GHashTable *buried;
+  GHashTable *parents;  /* parent -> GSList of buried children to remove */
+  GSList     *topmost;
+} MgtkBuryWalk;
+
+/* MUI_DisposeObject of a buried ancestor takes the others with it */
+static void mgtk_buried_find_topmost(gpointer key, gpointer value, gpointer user_data) {
+  MgtkBuryWalk *walk=(MgtkBuryWalk *) user_data;
+  Object *obj=(Object *) key;
+  Object *parent;
+  Object *o;
+
+  parent=(Object *) xget(obj,MUIA_Parent);
+  for(o=parent;o;o=(Object *) xget(o,MUIA_Parent)) {
+    if(g_hash_table_lookup(walk->buried,o)) {
+      return;
+    }
+  }
+
+  walk->topmost=g_slist_prepend(walk->topmost,obj);
+  if(parent) {
+    g_hash_table_insert(walk->parents,parent,
+                        g_slist_prepend(g_hash_table_lookup(walk->parents,parent),obj));
+  }
+}
+
+/* one InitChange/ExitChange per group */
+static void mgtk_buried_remove_children(gpointer key, gpointer value, gpointer user_data) {
+  Object *parent=(Object *) key;
+  GSList *children=(GSList *) value;
+  GSList *l;
+
+  DoMethod(parent,MUIM_Group_InitChange);
+  for(l=children;l;l=l->next) {
+    DoMethod(parent,OM_REMMEMBER,(ULONG) l->data);
+  }
+  DoMethod(parent,MUIM_Group_ExitChange);
+  g_slist_free(children);
+}
+
+static void mgtk_buried_release_widget(gpointer key, gpointer value, gpointer user_data) {
+
+  g_object_unref(G_OBJECT(value));
+}
+
+void mgtk_dispose_mui_objects(void) {
+  MgtkBuryWalk walk;
+  GSList *l;
+
+  if(!buried_objects || !g_hash_table_size(buried_objects)) {
+    return;
+  }
+
+  /* unrefs below may bury more, that goes to the next call */
+  walk.buried=buried_objects;
+  walk.parents=g_hash_table_new(g_direct_hash,g_direct_equal);
+  walk.topmost=NULL;
+  buried_objects=NULL;
+
+  g_hash_table_foreach(walk.buried,mgtk_buried_find_topmost,&walk);
+  g_hash_table_foreach(walk.parents,mgtk_buried_remove_children,NULL);
+  g_hash_table_destroy(walk.parents);
+
+  for(l=walk.topmost;l;l=l->next) {
+    DebOut("mgtk_dispose_mui_objects: %lx\n",l->data);
+    MUI_DisposeObject((Object *) l->data);
+  }
+  g_slist_free(walk.topmost);
+
+  g_hash_table_foreach(walk.buried,mgtk_buried_release_widget,NULL);
+  g_hash_table_destroy(walk.buried);
+}
+
+/**********************************************************************
+ * live object accounting
+ *
+ * Every GtkMui object is counted per type from construction to
+ * finalization, so leaks of rebuilt dialogs show up in
+ * mgtk_live_objects_dump() and can be checked with
+ * mgtk_live_object_count(). Set the environment variable GTKMUI_LEAKS
+ * to get the dump at the end of gtk_main.
+ **********************************************************************/
+typedef struct {
+  GType  type;
+  guint  size;    /* instance size */
+  guint  live;
+  guint  peak;
+  guint  created;
+} MgtkLiveType;
+
+static GHashTable *live_types;
+static guint       live_objects;
+static gulong      live_bytes;
+
+static MgtkLiveType *mgtk_live_type(GType type) {
+  MgtkLiveType *t;
+  GTypeQuery query;
+
+  if(!live_types) {
+    live_types=g_hash_table_new_full(g_direct_hash,g_direct_equal,NULL,g_free);
+  }
+
+  t=g_hash_table_lookup(live_types,GSIZE_TO_POINTER(type));
+  if(!t) {
+    g_type_query(type,&query);
+    t=g_new0(MgtkLiveType,1);
+    t->type=type;
+    t->size=query.instance_size;
+    g_hash_table_insert(live_types,GSIZE_TO_POINTER(type),t);
+  }
+  return t;
+}
+
+static void mgtk_live_object_add(GObject *object) {
+  MgtkLiveType *t;
+
+  t=mgtk_live_type(G_OBJECT_TYPE(object));
+  t->created++;
+  if(++t->live > t->peak) {
+    t->peak=t->live;
+  }
+  live_objects++;
+  live_bytes+=t->size;
+}
+
+static void mgtk_live_object_remove(GObject *object) {
+  MgtkLiveType *t;
+
+  t=mgtk_live_type(G_OBJECT_TYPE(object));
+  if(!t->live) {
+    /* not created through g_object_new */
+    return;
+  }
+  t->live--;
+  live_objects--;
+  live_bytes-=t->size;
+}
+
+/* live objects of exactly this type, or of all types for 0 */
+guint mgtk_live_object_count(GType type) {
+  MgtkLiveType *t;
+
+  if(!type) {
+    return live_objects;
+  }
+  if(!live_types) {
+    return 0;
+  }
+  t=g_hash_table_lookup(live_types,GSIZE_TO_POINTER(type));
+
+  return t ? t->live : 0;
+}
+
+static void mgtk_live_type_collect(gpointer key, gpointer value, gpointer user_data) {
+  GPtrArray *types=(GPtrArray *) user_data;
+
+  g_ptr_array_add(types,value);
+}
+
+static gint mgtk_live_type_compare(gconstpointer a, gconstpointer b) {
+  const MgtkLiveType *ta=*(const MgtkLiveType **) a;
+  const MgtkLiveType *tb=*(const MgtkLiveType **) b;
+
+  if(ta->size != tb->size) {
+    return ta->size < tb->size ? 1 : -1;
+  }
+  return strcmp(g_type_name(ta->type),g_type_name(tb->type));
+}
+
+/* by allocation size, with a subtotal for every size.
+ * Meant for release builds, too, so no DebOut here.
+ */
+void mgtk_live_objects_dump(void) {
+  GPtrArray *types;
+  MgtkLiveType *t;
+  guint i;
+  guint size_live;
+
+  printf("live objects: %u (%lu bytes)\n",live_objects,live_bytes);
+  if(!live_types) {
+    return;
+  }
+
+  types=g_ptr_array_new();
+  g_hash_table_foreach(live_types,mgtk_live_type_collect,types);
+  g_ptr_array_sort(types,mgtk_live_type_compare);
+
+  size_live=0;
+  for(i=0;i<types->len;i++) {
+    t=(MgtkLiveType *) g_ptr_array_index(types,i);
+    if(t->live) {
+      printf("  %-24s %5u bytes: %5u live, %5u peak, %6u created\n",g_type_name(t->type),t->size,t->live,t->peak,t->created);
+    }
+    size_live+=t->live;
+    if(i+1==types->len || ((MgtkLiveType *) g_ptr_array_index(types,i+1))->size != t->size) {
+      if(size_live) {
+        printf("  = %5u bytes: %5u live\n",t->size,size_live);
+      }
+      size_live=0;
+    }
+  }
+  g_ptr_array_free(types,TRUE);
+}
+
 /**********************************************************************
  * tmp helper
  **********************************************************************/
@@ -174,58 +460,137 @@ Object *mgtk_get_mui_object(GtkWidget *w) {
 }
 /**********************************************************************
   mgtk_allocvec, mgtk_freevec, mgtk_allocmem, mgtk_freemem
+
+  All those are served from one exec memory pool. Small blocks are
+  rounded up to a size class and recycled through a free list per
+  class, so the typical short lived allocations (list nodes, texts,
+  rastports..) never reach the system allocator again once the pool
+  is warm. Bigger blocks go straight to AllocPooled/FreePooled.
+
+  Only MEMF_CLEAR of the requirements is honoured, gtk-mui never needs
+  anything but MEMF_ANY memory. The pool is not protected by a
+  semaphore, gtk-mui is single tasked anyways.
 **********************************************************************/
 
-APTR mgtk_allocvec(ULONG size, ULONG req)
+#define MGTK_POOL_PUDDLE     8192
+#define MGTK_POOL_THRESH     2048
+#define MGTK_POOL_GRAIN      16
+#define MGTK_POOL_CLASSES    32   /* up to 512 bytes */
+#define MGTK_POOL_MAX_SMALL  (MGTK_POOL_GRAIN * MGTK_POOL_CLASSES)
+
+/* mgtk_allocvec remembers the size in front of the block, keep the
+ * block itself aligned like AllocVec would do */
+#define MGTK_VEC_HEADER      8
+
+struct mgtk_free_chunk {
+  struct mgtk_free_chunk *next;
+};
+
+static APTR                    mgtk_pool = NULL;
+static struct mgtk_free_chunk *mgtk_free_chunks[MGTK_POOL_CLASSES];
+
+static inline ULONG mgtk_pool_class(ULONG size) {
+  return (size + MGTK_POOL_GRAIN - 1) / MGTK_POOL_GRAIN - 1;
+}
+
+APTR mgtk_allocmem(ULONG size, ULONG req)
 {
   APTR ptr;
-#ifdef __MORPHOS__
-  ptr = AllocVecTaskPooled(size);
+  ULONG c;
+
+  if(!size) {
+    return NULL;
+  }
+
+  if(!mgtk_pool) {
+    mgtk_pool=CreatePool(MEMF_ANY, MGTK_POOL_PUDDLE, MGTK_POOL_THRESH);
+    if(!mgtk_pool) {
+      ErrOut("mgtk_allocmem: unable to create memory pool!\n");
+      return NULL;
+    }
+  }
+
+  if(size <= MGTK_POOL_MAX_SMALL) {
+    c=mgtk_pool_class(size);
+    size=(c+1) * MGTK_POOL_GRAIN;
+
+    if(mgtk_free_chunks[c]) {
+      ptr=mgtk_free_chunks[c];
+      mgtk_free_chunks[c]=mgtk_free_chunks[c]->next;
+    }
+    else {
+      ptr=AllocPooled(mgtk_pool, size);
+    }
+  }
+  else {
+    ptr=AllocPooled(mgtk_pool, size);
+  }
 
   if (ptr && (req & MEMF_CLEAR))
   {
     memset(ptr, 0, size);
   }
-#else
-  ptr = AllocVec(size, req);
-#endif
 
-	return ptr;
+  return ptr;
 }
 
-VOID mgtk_freevec(APTR ptr)
+VOID mgtk_freemem(APTR ptr, ULONG size)
 {
-#ifdef __MORPHOS__
-  FreeVecTaskPooled(ptr);
-#else
-  FreeVec(ptr);
-#endif
+  struct mgtk_free_chunk *chunk;
+  ULONG c;
+
+  if(!ptr || !size) {
+    return;
+  }
+
+  if(size <= MGTK_POOL_MAX_SMALL) {
+    c=mgtk_pool_class(size);
+    chunk=(struct mgtk_free_chunk *) ptr;
+    chunk->next=mgtk_free_chunks[c];
+    mgtk_free_chunks[c]=chunk;
+  }
+  else {
+    FreePooled(mgtk_pool, ptr, size);
+  }
 }
 
-APTR mgtk_allocmem(ULONG size, ULONG req)
+APTR mgtk_allocvec(ULONG size, ULONG req)
 {
-  APTR ptr;
-#ifdef __MORPHOS__
-  ptr = AllocTaskPooled(size);
+  UBYTE *ptr;
 
-  if (ptr && (req & MEMF_CLEAR))
-  {
-    memset(ptr, 0, size);
+  ptr=mgtk_allocmem(size + MGTK_VEC_HEADER, req);
+  if(!ptr) {
+    return NULL;
   }
-#else
-  ptr = AllocMem(size, req);
-#endif
 
-	return ptr;
+  *((ULONG *) ptr)=size + MGTK_VEC_HEADER;
+
+  return (APTR) (ptr + MGTK_VEC_HEADER);
 }
 
-VOID mgtk_freemem(APTR ptr, ULONG size)
+VOID mgtk_freevec(APTR ptr)
 {
-#ifdef __MORPHOS__
-  FreeTaskPooled(ptr, size);
-#else
-  FreeMem(ptr, size);
-#endif
+  UBYTE *block;
+
+  if(!ptr) {
+    return;
+  }
+
+  block=((UBYTE *) ptr) - MGTK_VEC_HEADER;
+  mgtk_freemem(block, *((ULONG *) block));
+}
+
+/* frees everything ever allocated with mgtk_allocmem/mgtk_allocvec */
+static void mgtk_pool_cleanup(void) {
+  ULONG c;
+
+  if(mgtk_pool) {
+    DeletePool(mgtk_pool);
+    mgtk_pool=NULL;
+  }
+  for(c=0; c < MGTK_POOL_CLASSES; c++) {
+    mgtk_free_chunks[c]=NULL;
+  }
 }
 
 /*********************************
@@ -650,6 +1015,51 @@ void mgtk_add(GtkMui *parent, GtkMui *son) {
 
   return;
 }
+
+/******************************************
+ * mgtk_remove(parent, son)
+ *
+ * Counterpart of mgtk_add for a child
+ * removed from its container without being
+ * destroyed (see gtk_widget_unparent).
+ *
+ * OM_REMMEMBER goes to the object of the
+ * GTK parent like OM_ADDMEMBER did, so
+ * classes, which put their children into
+ * an inner group, can take them out of it
+ * again. InitChange/ExitChange go to the
+ * group really holding the object.
+ *
+ * Windows, menus and notebook pages are
+ * left alone, they are not added with
+ * OM_ADDMEMBER.
+ ******************************************/
+void mgtk_remove(GtkMui *parent, GtkMui *son) {
+  Object *group;
+  Object *o;
+
+  DebOut("mgtk_remove(%lx,%lx)\n",parent,son);
+
+  if(!GtkObj(parent) || !GtkObj(son)) {
+    return;
+  }
+  if(GTK_IS_WINDOW(son) || GTK_IS_MENU_SHELL(son) || GTK_IS_MENU_ITEM(son) || GTK_IS_NOTEBOOK(parent)) {
+    return;
+  }
+
+  group=(Object *) xget(GtkObj(son),MUIA_Parent);
+
+  /* only, if it really is inside the object of parent */
+  for(o=group;o && o!=GtkObj(parent);o=(Object *) xget(o,MUIA_Parent));
+  if(!o) {
+    DebOut("  %lx is no member of %lx\n",GtkObj(son),GtkObj(parent));
+    return;
+  }
+
+  DoMethod(group,MUIM_Group_InitChange);
+  DoMethod(GtkObj(parent),OM_REMMEMBER,(ULONG) GtkObj(son));
+  DoMethod(group,MUIM_Group_ExitChange);
+}
 /******************************************
  * mgtk_check_windows()
  *
@@ -722,8 +1132,17 @@ void gtk_main(void) {
       break;
     }
 
+    /* pictures decoded by the image loader */
+    mgtk_image_cache_dispatch();
+
+    /* value_changed of dragged sliders and spin buttons */
+    mgtk_adjustment_flush_value_changed();
+
+    /* MUI objects of widgets destroyed by the hooks above */
+    mgtk_dispose_mui_objects();
+
     if (sigs) {
-      sigs = Wait(sigs | SIGBREAKF_CTRL_C | SIGBREAKF_CTRL_F);
+      sigs = Wait(sigs | SIGBREAKF_CTRL_C | SIGBREAKF_CTRL_F | mgtk_image_cache_signals());
       if (sigs & SIGBREAKF_CTRL_C) {
         break;
       }
@@ -784,6 +1203,11 @@ void gtk_main(void) {
   ReleasePen(ViewAddress()->ViewPort->ColorMap,mgtk->white_pen);
   */
 
+  mgtk_dispose_mui_objects();
+  if(getenv("GTKMUI_LEAKS")) {
+    mgtk_live_objects_dump();
+  }
+
   DebOut("  MUI_DisposeObject(mgtk->MuiApp)\n");
   MUI_DisposeObject(global_mgtk->MuiApp);
 
@@ -792,6 +1216,13 @@ void gtk_main(void) {
     FreeDiskObject(global_mgtk->icon);
   }
 
+  mgtk_image_cache_cleanup();
+
+  /* disposing the objects above may still draw or send events */
+  mgtk_rgb_cleanup();
+  mgtk_event_pool_cleanup();
+  mgtk_pool_cleanup();
+
 #ifndef __MORPHOS__
   DebOut("  FreeRemember & CloseLibs\n");
   FreeRemember(&rememberKey,TRUE);
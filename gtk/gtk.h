@@ -128,6 +128,9 @@ typedef struct {
 #include <gdk/gdktypes.h>
 #include <gdk/gdkvisual.h>
 #include <gdk/gdkgc.h>
+#include <gdk/gdkregion.h>
+#include <gdk/gdkpixbuf.h>
+#include <gdk/gdkrgb.h>
 #include <gdk/gdkdevice.h>
 
 
@@ -149,6 +152,8 @@ typedef struct _GtkWidget GtkWidget;
 #include <gtk/gtkwidget.h>
 #include <gdk/gdkevents.h>
 #include <gdk/gdkwindow.h>
+#include <gdk/gdkpixmap.h>
+#include <gdk/gdkscreen.h>
 
 
 typedef struct {
@@ -197,7 +202,6 @@ struct mgtk_ObjApp {
 
 #include <gtk/gtkprogressbar.h>
 
-typedef GtkWidget GdkPixbuf;
 typedef GtkWidget GtkTextBuffer;
 typedef GtkWidget GtkOptionMenu;
 typedef GtkWidget GtkHandleBox;
@@ -253,8 +257,24 @@ void      *mgtk_malloc(int size);
 void       mgtk_radio_button_muify(GtkWidget *button);
 Object    *mgtk_get_mui_action_object(GtkWidget *widget);
 void       mgtk_call_destroy_hooks(GtkWidget *widget);
+void       mgtk_dispose_mui_objects(void);
+guint      mgtk_live_object_count(GType type);
+void       mgtk_live_objects_dump(void);
 GType      mgtk_g_type_register_fundamental(GType type_id, const gchar *type_name, GtkWidget  *(*newobject) (void));
 mgtk_Fundamental *mgtk_g_type_get_fundamental(GType type_id);
+typedef enum {
+  MGTK_VIEW_RANGE,
+  MGTK_VIEW_SPIN_BUTTON
+} MgtkViewType;
+void       mgtk_adjustment_bind(GtkAdjustment *adjustment, GtkWidget *widget, MgtkViewType type);
+void       mgtk_adjustment_unbind(GtkAdjustment *adjustment, GtkWidget *widget);
+void       mgtk_adjustment_update_view(GtkAdjustment *adjustment, GtkWidget *widget);
+gboolean   mgtk_adjustment_pushing(GtkAdjustment *adjustment);
+void       mgtk_adjustment_queue_value_changed(GtkAdjustment *adjustment, GtkWidget *widget, gboolean emit);
+void       mgtk_adjustment_cancel_value_changed(GtkAdjustment *adjustment);
+void       mgtk_adjustment_flush_value_changed(void);
+void       mgtk_scale_format_value(GtkScale *scale, gdouble value, gchar *buf, gsize size);
+gboolean   mgtk_tooltips_short_help(Object *obj, STRPTR *help);
 
 /* gtk functions */
 void       gtk_init(int *argc, char ***argv);
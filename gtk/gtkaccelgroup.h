@@ -81,6 +81,10 @@ struct _GtkAccelGroup
   GSList             *acceleratables;
   guint		      n_accels;
   GtkAccelGroupEntry *priv_accels;
+
+  /* GTK-MUI private */
+  guint               mgtk_n_alloced;  /* size of priv_accels */
+  GHashTable         *mgtk_key_index;  /* (key, mods) -> number of entries */
 };
 
 struct _GtkAccelGroupClass
@@ -120,6 +124,10 @@ void	       gtk_accel_group_connect		  (GtkAccelGroup  *accel_group,
 void           gtk_accel_group_connect_by_path    (GtkAccelGroup  *accel_group,
 						   const gchar	  *accel_path,
 						   GClosure	  *closure);
+void           gtk_accel_group_connect_many	  (GtkAccelGroup  *accel_group,
+						   guint           n_accels,
+						   const GtkAccelKey *keys,
+						   GClosure      **closures);
 gboolean       gtk_accel_group_disconnect	  (GtkAccelGroup  *accel_group,
 						   GClosure	  *closure);
 gboolean       gtk_accel_group_disconnect_key	  (GtkAccelGroup  *accel_group,
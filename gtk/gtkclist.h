@@ -163,6 +163,14 @@ struct _GtkCList
   GMemChunk *row_mem_chunk;
   GMemChunk *cell_mem_chunk;
 
+  /* GTK-MUI: arena for cell texts, released in bulk by gtk_clist_clear */
+  GStringChunk *text_chunk;
+  GHashTable *text_intern;
+  gsize text_bytes;
+  gsize text_bytes_saved;
+  gsize text_live;        /* bytes of text in cells */
+  gsize text_dead;        /* bytes of replaced texts, see cell_text_compact */
+
   guint freeze_count;
   
   /* allocation rectangle after the conatiner_border_width
@@ -349,6 +357,7 @@ struct _GtkCListColumn
   guint resizeable     : 1;
   guint auto_resize    : 1;
   guint button_passive : 1;
+  guint intern_text    : 1;
 };
 
 struct _GtkCListRow
@@ -546,6 +555,16 @@ void gtk_clist_set_column_auto_resize (GtkCList *clist,
 
 gint gtk_clist_columns_autosize (GtkCList *clist);
 
+/* GTK-MUI extension: share identical cell texts of a column, useful for
+ * columns with only a few distinct values (status, type, host..)
+ */
+void gtk_clist_set_column_intern_text (GtkCList *clist,
+				       gint      column,
+				       gboolean  intern_text);
+
+/* GTK-MUI extension: bytes of cell text not copied thanks to interning */
+gsize gtk_clist_get_text_bytes_saved (GtkCList *clist);
+
 /* return the optimal column width, i.e. maximum of all cell widths */
 gint gtk_clist_optimal_column_width (GtkCList *clist,
 				     gint      column);
@@ -600,6 +619,8 @@ void gtk_clist_set_text (GtkCList    *clist,
 
 /* for the "get" functions, any of the return pointer can be
  * NULL if you are not interested
+ * GTK-MUI: the text of gtk_clist_get_text stays valid until its cell
+ * changes, the list is cleared or the last gtk_clist_thaw
  */
 gint gtk_clist_get_text (GtkCList  *clist,
 			 gint       row,
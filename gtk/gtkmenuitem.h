@@ -97,7 +97,8 @@ struct _GtkMenuItemClass
 };
 
 /* GTK-MUI private */
-GtkWidget* mgtk_get_accel(GtkWidget *w);
+GtkWidget*   mgtk_get_accel(GtkWidget *w);
+const gchar* mgtk_get_accel_text(GtkWidget *accel);
 
 
 GType	   gtk_menu_item_get_type	      (void) G_GNUC_CONST;
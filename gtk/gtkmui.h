@@ -104,6 +104,7 @@ gint      gtk_mui_application_icon(char *iconname);
 GType     gtk_mui_get_type  (void) G_GNUC_CONST;
 
 void mgtk_add(GtkMui *parent, GtkMui *son);
+void mgtk_remove(GtkMui *parent, GtkMui *son);
 
 G_END_DECLS
 
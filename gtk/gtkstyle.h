@@ -126,6 +126,13 @@ struct _GtkStyle
   GSList	 *styles;	  /* of type GtkStyle* */
   GArray	 *property_cache;
   GSList         *icon_factories; /* of type GtkIconFactory* */
+
+  /* GTK-MUI private: shaded gcs, created on first use by gtk_paint.c */
+  GdkGC *mgtk_aa_gc[5];
+  GdkGC *mgtk_darkened_gc[5][3];
+
+  /* GTK-MUI private: the fields this style is cached with, gtk_style.c */
+  gpointer mgtk_cache_key;
 };
 
 struct _GtkStyleClass
@@ -884,6 +891,11 @@ const GValue* _gtk_style_peek_property_value (GtkStyle           *style,
 void _gtk_style_init_for_settings (GtkStyle    *style,
 				   GtkSettings *settings);
 
+/* GTK-MUI: integer shading with a small result cache, see gtk_paint.c */
+void _gtk_style_shade (GdkColor *a,
+		       GdkColor *b,
+		       gdouble   k);
+
 /* deprecated */
 #ifndef GTK_DISABLE_DEPRECATED
 #define gtk_style_apply_default_pixmap(s,gw,st,a,x,y,w,h) gtk_style_apply_default_background (s,gw,1,st,a,x,y,w,h)
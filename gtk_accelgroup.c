@@ -174,13 +174,15 @@ gtk_accel_group_finalize (GObject *object)
 
       if (entry->accel_path_quark)
 	{
-	  const gchar *accel_path = g_quark_to_string (entry[i].accel_path_quark);
+	  const gchar *accel_path = g_quark_to_string (entry->accel_path_quark);
 
 	  _gtk_accel_map_remove_group (accel_path, accel_group);
 	}
     }
 
   g_free (accel_group->priv_accels);
+  if (accel_group->mgtk_key_index)
+    g_hash_table_destroy (accel_group->mgtk_key_index);
 
   G_OBJECT_CLASS (parent_class)->finalize (object);
 }
@@ -193,6 +195,8 @@ gtk_accel_group_init (GtkAccelGroup *accel_group)
   accel_group->acceleratables = NULL;
   accel_group->n_accels = 0;
   accel_group->priv_accels = NULL;
+  accel_group->mgtk_n_alloced = 0;
+  accel_group->mgtk_key_index = NULL;
 }
 
 /**
@@ -384,6 +388,190 @@ bsearch_compare_accels (const void *d1,
     return entry1->key.accel_key < entry2->key.accel_key ? -1 : 1;
 }
 
+/* GTK-MUI: (accel_key, accel_mods) keyed hash entries. Used for the
+ * per group key index (value is the number of entries with that key)
+ * and for the global accelerator name quark cache (value is the quark).
+ */
+typedef struct {
+  guint           accel_key;
+  GdkModifierType accel_mods;
+  guint           value;
+} AccelKeyEntry;
+
+static GHashTable *accel_quark_cache = NULL;
+
+static guint
+accel_key_hash (gconstpointer v)
+{
+  const AccelKeyEntry *e = v;
+
+  return e->accel_key ^ (e->accel_mods * 2654435761U);
+}
+
+static gboolean
+accel_key_equal (gconstpointer v1,
+		 gconstpointer v2)
+{
+  const AccelKeyEntry *e1 = v1;
+  const AccelKeyEntry *e2 = v2;
+
+  return e1->accel_key == e2->accel_key && e1->accel_mods == e2->accel_mods;
+}
+
+/* same as g_quark_from_string (gtk_accelerator_name (key, mods)), but
+ * the name is only built once per key/mods pair.
+ */
+static GQuark
+accel_quark_get (guint           accel_key,
+		 GdkModifierType accel_mods)
+{
+  AccelKeyEntry lookup, *entry;
+  gchar *accel_name;
+
+  if (!accel_quark_cache)
+    accel_quark_cache = g_hash_table_new (accel_key_hash, accel_key_equal);
+
+  lookup.accel_key = accel_key;
+  lookup.accel_mods = accel_mods;
+  entry = g_hash_table_lookup (accel_quark_cache, &lookup);
+  if (entry)
+    return entry->value;
+
+  accel_name = gtk_accelerator_name (accel_key, accel_mods);
+  entry = g_new (AccelKeyEntry, 1);
+  entry->accel_key = accel_key;
+  entry->accel_mods = accel_mods;
+  entry->value = g_quark_from_string (accel_name);
+  g_free (accel_name);
+
+  g_hash_table_insert (accel_quark_cache, entry, entry);
+
+  return entry->value;
+}
+
+static void
+key_index_add (GtkAccelGroup  *accel_group,
+	       guint           accel_key,
+	       GdkModifierType accel_mods)
+{
+  AccelKeyEntry lookup, *entry;
+
+  if (!accel_group->mgtk_key_index)
+    accel_group->mgtk_key_index = g_hash_table_new_full (accel_key_hash, accel_key_equal,
+							 NULL, g_free);
+
+  lookup.accel_key = accel_key;
+  lookup.accel_mods = accel_mods;
+  entry = g_hash_table_lookup (accel_group->mgtk_key_index, &lookup);
+  if (!entry)
+    {
+      entry = g_new (AccelKeyEntry, 1);
+      entry->accel_key = accel_key;
+      entry->accel_mods = accel_mods;
+      entry->value = 0;
+      g_hash_table_insert (accel_group->mgtk_key_index, entry, entry);
+    }
+  entry->value++;
+}
+
+static void
+key_index_remove (GtkAccelGroup  *accel_group,
+		  guint           accel_key,
+		  GdkModifierType accel_mods)
+{
+  AccelKeyEntry lookup, *entry;
+
+  lookup.accel_key = accel_key;
+  lookup.accel_mods = accel_mods;
+  entry = g_hash_table_lookup (accel_group->mgtk_key_index, &lookup);
+  g_return_if_fail (entry != NULL);
+
+  if (!--entry->value)
+    g_hash_table_remove (accel_group->mgtk_key_index, entry);
+}
+
+static guint
+key_index_count (GtkAccelGroup  *accel_group,
+		 guint           accel_key,
+		 GdkModifierType accel_mods)
+{
+  AccelKeyEntry lookup, *entry;
+
+  if (!accel_group->mgtk_key_index)
+    return 0;
+
+  lookup.accel_key = accel_key;
+  lookup.accel_mods = accel_mods;
+  entry = g_hash_table_lookup (accel_group->mgtk_key_index, &lookup);
+
+  return entry ? entry->value : 0;
+}
+
+static void
+accels_reserve (GtkAccelGroup *accel_group,
+		guint          n_accels)
+{
+  guint n = accel_group->mgtk_n_alloced;
+
+  if (n >= n_accels)
+    return;
+
+  n = MAX (n * 2, 8);
+  if (n < n_accels)
+    n = n_accels;
+
+  accel_group->priv_accels = g_renew (GtkAccelGroupEntry, accel_group->priv_accels, n);
+  accel_group->mgtk_n_alloced = n;
+}
+
+/* first position, at which the entry would sort after all equal keys */
+static guint
+accels_upper_bound (GtkAccelGroup      *accel_group,
+		    GtkAccelGroupEntry *key)
+{
+  guint lo = 0, hi = accel_group->n_accels;
+
+  while (lo < hi)
+    {
+      guint mid = (lo + hi) / 2;
+
+      if (bsearch_compare_accels (key, accel_group->priv_accels + mid) < 0)
+	hi = mid;
+      else
+	lo = mid + 1;
+    }
+
+  return lo;
+}
+
+/* everything quick_accel_add needs to do for an entry, which is
+ * already in priv_accels, besides the changed notification
+ */
+static void
+quick_accel_setup (GtkAccelGroup      *accel_group,
+		   GtkAccelGroupEntry *entry)
+{
+  GClosure *closure = entry->closure;
+
+  g_closure_ref (closure);
+  g_closure_sink (closure);
+
+  key_index_add (accel_group, entry->key.accel_key, entry->key.accel_mods);
+
+  /* handle closure invalidation and reverse lookups */
+  g_closure_add_invalidate_notifier (closure, accel_group, accel_closure_invalidate);
+
+  /* get accel path notification */
+  if (entry->accel_path_quark)
+    _gtk_accel_map_add_group (g_quark_to_string (entry->accel_path_quark), accel_group);
+
+  /* setup handler */
+  if (entry->key.accel_key)
+    g_signal_connect_closure_by_id (accel_group, signal_accel_activate,
+				    accel_quark_get (entry->key.accel_key, entry->key.accel_mods),
+				    closure, FALSE);
+}
+
 static void
 quick_accel_add (GtkAccelGroup  *accel_group,
 		 guint           accel_key,
@@ -392,48 +580,31 @@ quick_accel_add (GtkAccelGroup  *accel_group,
 		 GClosure       *closure,
 		 GQuark          path_quark)
 {
-  guint pos, i = accel_group->n_accels++;
+  guint pos, i = accel_group->n_accels;
   GtkAccelGroupEntry key;
 
   /* find position */
   key.key.accel_key = accel_key;
   key.key.accel_mods = accel_mods;
-  for (pos = 0; pos < i; pos++)
-    if (bsearch_compare_accels (&key, accel_group->priv_accels + pos) < 0)
-      break;
+  pos = accels_upper_bound (accel_group, &key);
 
-  /* insert at position, ref closure */
-  accel_group->priv_accels = g_renew (GtkAccelGroupEntry, accel_group->priv_accels, accel_group->n_accels);
+  /* insert at position */
+  accels_reserve (accel_group, i + 1);
+  accel_group->n_accels++;
   g_memmove (accel_group->priv_accels + pos + 1, accel_group->priv_accels + pos,
 	     (i - pos) * sizeof (accel_group->priv_accels[0]));
   accel_group->priv_accels[pos].key.accel_key = accel_key;
   accel_group->priv_accels[pos].key.accel_mods = accel_mods;
   accel_group->priv_accels[pos].key.accel_flags = accel_flags;
-  accel_group->priv_accels[pos].closure = g_closure_ref (closure);
+  accel_group->priv_accels[pos].closure = closure;
   accel_group->priv_accels[pos].accel_path_quark = path_quark;
-  g_closure_sink (closure);
-  
-  /* handle closure invalidation and reverse lookups */
-  g_closure_add_invalidate_notifier (closure, accel_group, accel_closure_invalidate);
 
-  /* get accel path notification */
-  if (path_quark)
-    _gtk_accel_map_add_group (g_quark_to_string (path_quark), accel_group);
+  quick_accel_setup (accel_group, accel_group->priv_accels + pos);
 
-  /* connect and notify changed */
+  /* notify changed */
   if (accel_key)
-    {
-      gchar *accel_name = gtk_accelerator_name (accel_key, accel_mods);
-      GQuark accel_quark = g_quark_from_string (accel_name);
-
-      g_free (accel_name);
-      
-      /* setup handler */
-      g_signal_connect_closure_by_id (accel_group, signal_accel_activate, accel_quark, closure, FALSE);
-      
-      /* and notify */
-      g_signal_emit (accel_group, signal_accel_changed, accel_quark, accel_key, accel_mods, closure);
-    }
+    g_signal_emit (accel_group, signal_accel_changed, accel_quark_get (accel_key, accel_mods),
+		   accel_key, accel_mods, closure);
 }
 
 static void
@@ -448,12 +619,7 @@ quick_accel_remove (GtkAccelGroup      *accel_group,
 
   /* quark for notification */
   if (accel_key)
-    {
-      gchar *accel_name = gtk_accelerator_name (accel_key, accel_mods);
-
-      accel_quark = g_quark_from_string (accel_name);
-      g_free (accel_name);
-    }
+    accel_quark = accel_quark_get (accel_key, accel_mods);
 
   /* clean up closure invalidate notification and disconnect */
   g_closure_remove_invalidate_notifier (entry->closure, accel_group, accel_closure_invalidate);
@@ -467,6 +633,7 @@ quick_accel_remove (GtkAccelGroup      *accel_group,
     _gtk_accel_map_remove_group (g_quark_to_string (entry->accel_path_quark), accel_group);
 
   /* physically remove */
+  key_index_remove (accel_group, accel_key, accel_mods);
   accel_group->n_accels -= 1;
   g_memmove (entry, entry + 1,
 	     (accel_group->n_accels - pos) * sizeof (accel_group->priv_accels[0]));
@@ -487,30 +654,21 @@ quick_accel_find (GtkAccelGroup  *accel_group,
 {
   GtkAccelGroupEntry *entry;
   GtkAccelGroupEntry key;
+  guint count;
 
   *count_p = 0;
 
-  if (!accel_group->n_accels)
+  /* most lookups are misses, the index answers those without a search */
+  count = key_index_count (accel_group, accel_key, accel_mods);
+  if (!count)
     return NULL;
 
+  /* equal keys are stored consecutively, in front of the upper bound */
   key.key.accel_key = accel_key;
   key.key.accel_mods = accel_mods;
-  entry = bsearch (&key, accel_group->priv_accels, accel_group->n_accels,
-		   sizeof (accel_group->priv_accels[0]), bsearch_compare_accels);
-  
-  if (!entry)
-    return NULL;
+  entry = accel_group->priv_accels + accels_upper_bound (accel_group, &key) - count;
 
-  /* step back to the first member */
-  for (; entry > accel_group->priv_accels; entry--)
-    if (entry[-1].key.accel_key != accel_key ||
-	entry[-1].key.accel_mods != accel_mods)
-      break;
-  /* count equal members */
-  for (; entry + *count_p < accel_group->priv_accels + accel_group->n_accels; (*count_p)++)
-    if (entry[*count_p].key.accel_key != accel_key ||
-	entry[*count_p].key.accel_mods != accel_mods)
-      break;
+  *count_p = count;
   return entry;
 }
 
@@ -597,6 +755,117 @@ gtk_accel_group_connect_by_path (GtkAccelGroup	*accel_group,
   g_object_unref (accel_group);
 }
 
+typedef struct {
+  GtkAccelGroupEntry entry;
+  guint              seq;
+} AccelBatchEntry;
+
+static int
+batch_compare_accels (const void *d1,
+		      const void *d2)
+{
+  const AccelBatchEntry *b1 = d1;
+  const AccelBatchEntry *b2 = d2;
+  int cmp = bsearch_compare_accels (&b1->entry, &b2->entry);
+
+  if (cmp)
+    return cmp;
+
+  return b1->seq < b2->seq ? -1 : b1->seq > b2->seq;
+}
+
+/**
+ * gtk_accel_group_connect_many:
+ * @accel_group: the accelerator group to install the accelerators in
+ * @n_accels:    number of accelerators
+ * @keys:        @n_accels key values, modifiers and flags
+ * @closures:    @n_accels closures, one for every entry in @keys
+ *
+ * Installs several accelerators at once. This does the same as calling
+ * gtk_accel_group_connect() for every entry of @keys, in order, but
+ * sorts the new accelerators into the group only once, which is a lot
+ * faster for big menus. Every closure may only be given once.
+ *
+ * GTK-MUI extension.
+ */
+void
+gtk_accel_group_connect_many (GtkAccelGroup     *accel_group,
+			      guint              n_accels,
+			      const GtkAccelKey *keys,
+			      GClosure         **closures)
+{
+  AccelBatchEntry *batch;
+  GtkAccelGroupEntry *merged, *added;
+  guint i, n, old, a, b;
+
+  g_return_if_fail (GTK_IS_ACCEL_GROUP (accel_group));
+  g_return_if_fail (n_accels == 0 || (keys != NULL && closures != NULL));
+
+  if (!n_accels)
+    return;
+
+  g_object_ref (accel_group);
+
+  batch = g_new (AccelBatchEntry, n_accels);
+  for (i = 0, n = 0; i < n_accels; i++)
+    {
+      GClosure *closure = closures[i];
+
+      if (closure == NULL ||
+	  keys[i].accel_key == 0 ||
+	  closure->is_invalid ||
+	  gtk_accel_group_from_accel_closure (closure) != NULL)
+	{
+	  WarnOut("gtk_accel_group_connect_many: skipping invalid accelerator %d\n", i);
+	  continue;
+	}
+
+      batch[n].entry.key.accel_key = gdk_keyval_to_lower (keys[i].accel_key);
+      batch[n].entry.key.accel_mods = keys[i].accel_mods;
+      batch[n].entry.key.accel_flags = keys[i].accel_flags;
+      batch[n].entry.closure = closure;
+      batch[n].entry.accel_path_quark = 0;
+      batch[n].seq = n;
+      n++;
+    }
+
+  /* remember the callers order for the notifications */
+  added = g_new (GtkAccelGroupEntry, MAX (n, 1));
+  for (i = 0; i < n; i++)
+    added[i] = batch[i].entry;
+
+  qsort (batch, n, sizeof (batch[0]), batch_compare_accels);
+
+  /* merge the sorted batch behind equal old entries */
+  old = accel_group->n_accels;
+  merged = g_new (GtkAccelGroupEntry, MAX (old + n, accel_group->mgtk_n_alloced));
+  for (i = 0, a = 0, b = 0; a < old || b < n; i++)
+    {
+      if (b >= n ||
+	  (a < old && bsearch_compare_accels (accel_group->priv_accels + a, &batch[b].entry) <= 0))
+	merged[i] = accel_group->priv_accels[a++];
+      else
+	{
+	  merged[i] = batch[b++].entry;
+	  quick_accel_setup (accel_group, merged + i);
+	}
+    }
+  g_free (accel_group->priv_accels);
+  accel_group->priv_accels = merged;
+  accel_group->mgtk_n_alloced = MAX (old + n, accel_group->mgtk_n_alloced);
+  accel_group->n_accels = old + n;
+
+  /* notify in the order, the caller gave us */
+  for (i = 0; i < n; i++)
+    g_signal_emit (accel_group, signal_accel_changed,
+		   accel_quark_get (added[i].key.accel_key, added[i].key.accel_mods),
+		   added[i].key.accel_key, added[i].key.accel_mods, added[i].closure);
+
+  g_free (added);
+  g_free (batch);
+  g_object_unref (accel_group);
+}
+
 /**
  * gtk_accel_group_disconnect:
  * @accel_group: the accelerator group to remove an accelerator from
@@ -806,13 +1075,10 @@ gtk_accel_groups_activate (GObject	  *object,
   
   if (gtk_accelerator_valid (accel_key, accel_mods))
     {
-      gchar *accel_name;
       GQuark accel_quark;
       GSList *slist;
 
-      accel_name = gtk_accelerator_name (accel_key, (accel_mods & gtk_accelerator_get_default_mod_mask ()));
-      accel_quark = g_quark_from_string (accel_name);
-      g_free (accel_name);
+      accel_quark = accel_quark_get (accel_key, (accel_mods & gtk_accelerator_get_default_mod_mask ()));
       
       for (slist = gtk_accel_groups_from_object (object); slist; slist = slist->next)
 	if (gtk_accel_group_activate (slist->data, accel_quark, object, accel_key, accel_mods))
@@ -37,6 +37,7 @@
 
 #include <glib/gstdio.h>
 
+#include <sys/stat.h>
 #include <string.h>
 #include <errno.h>
 #include <fcntl.h>
@@ -68,6 +69,7 @@ typedef struct {
   guint	       std_accel_key;
   guint	       std_accel_mods;
   guint        changed : 1;
+  guint        notify_pending : 1;
   guint        lock_count;
   GSList      *groups;
 } AccelEntry;
@@ -85,8 +87,25 @@ static GSList      *accel_filters = NULL;
 static gulong	    accel_map_signals[LAST_SIGNAL] = { 0, };
 static GtkAccelMap *accel_map;
 
+/* GTK-MUI: while loading a map, change notifications are collected
+ * and emitted once per entry after the whole map has been applied.
+ */
+static guint        accel_map_notify_freeze = 0;
+static GSList      *accel_map_notify_pending = NULL;
+
+/* GTK-MUI: entries parsed by the text loader, if a cache is to be written */
+typedef struct {
+  gchar          *accel_path;
+  guint           accel_key;
+  GdkModifierType accel_mods;
+} AccelRecord;
+
+static GArray      *accel_map_record = NULL;
+
 /* --- prototypes --- */
 static void do_accel_map_changed (AccelEntry *entry);
+static void accel_map_freeze_notify (void);
+static void accel_map_thaw_notify (void);
 
 /* --- functions --- */
 static guint
@@ -492,7 +511,18 @@ accel_map_parse_accel_path (GScanner *scanner)
   gtk_accel_map_change_entry (path, accel_key, accel_mods, TRUE);
 
   g_free (accel);
-  g_free (path);
+
+  if (accel_map_record)
+    {
+      AccelRecord record;
+
+      record.accel_path = path;
+      record.accel_key = accel_key;
+      record.accel_mods = accel_mods;
+      g_array_append_val (accel_map_record, record);
+    }
+  else
+    g_free (path);
 
   /* check correct statement end */
   g_scanner_get_next_token (scanner);
@@ -573,6 +603,7 @@ gtk_accel_map_load_scanner (GScanner *scanner)
 
   /* outer parsing loop
    */
+  accel_map_freeze_notify ();
   g_scanner_peek_next_token (scanner);
   while (scanner->next_token == '(')
     {
@@ -582,6 +613,7 @@ gtk_accel_map_load_scanner (GScanner *scanner)
 
       g_scanner_peek_next_token (scanner);
     }
+  accel_map_thaw_notify ();
 
   /* restore config */
   scanner->config->skip_comment_single = skip_comment_single;
@@ -616,6 +648,188 @@ gtk_accel_map_load_fd (gint fd)
   g_scanner_destroy (scanner);
 }
 
+static gboolean
+write_all (gint   fd,
+	   gchar *buf,
+	   gsize  to_write)
+{
+  while (to_write > 0)
+    {
+      gssize count = write (fd, buf, to_write);
+      if (count < 0)
+	{
+	  if (errno != EINTR)
+	    return FALSE;
+	}
+      else
+	{
+	  to_write -= count;
+	  buf += count;
+	}
+    }
+
+  return TRUE;
+}
+
+/* GTK-MUI: binary accel map cache
+ *
+ * gtk_accel_map_load() stores the parsed result of a map file in
+ * "<file_name>.cache" and uses it instead of the text file as long as
+ * the size and modification time of the text file did not change.
+ *
+ * Layout (host byte order, all fields guint32):
+ *   header:  magic, version, source mtime, source size,
+ *            number of entries, size of the string block
+ *   entries: path offset, accel_key, accel_mods
+ *   strings: the NUL terminated accelerator paths
+ */
+#define ACCEL_CACHE_MAGIC   0x47414d43  /* GAMC */
+#define ACCEL_CACHE_VERSION 1
+#define ACCEL_CACHE_SUFFIX  ".cache"
+
+typedef struct {
+  guint32 magic;
+  guint32 version;
+  guint32 mtime;
+  guint32 size;
+  guint32 n_entries;
+  guint32 strings_size;
+} AccelCacheHeader;
+
+typedef struct {
+  guint32 path_offset;
+  guint32 accel_key;
+  guint32 accel_mods;
+} AccelCacheEntry;
+
+static gboolean
+accel_map_load_cache (const gchar *cache_name,
+		      struct stat *source)
+{
+  AccelCacheHeader *header;
+  AccelCacheEntry *entries;
+  const gchar *strings;
+  struct stat st;
+  gchar *buffer;
+  gsize n;
+  gint fd;
+  guint i;
+
+  fd = g_open (cache_name, O_RDONLY, 0);
+  if (fd < 0)
+    return FALSE;
+
+  if (fstat (fd, &st) < 0 || st.st_size < (off_t) sizeof (AccelCacheHeader))
+    {
+      close (fd);
+      return FALSE;
+    }
+
+  /* one read for the whole cache */
+  n = st.st_size;
+  buffer = g_malloc (n);
+  if (read (fd, buffer, n) != (gssize) n)
+    {
+      close (fd);
+      g_free (buffer);
+      return FALSE;
+    }
+  close (fd);
+
+  header = (AccelCacheHeader *) buffer;
+  if (header->magic != ACCEL_CACHE_MAGIC ||
+      header->version != ACCEL_CACHE_VERSION ||
+      header->mtime != (guint32) source->st_mtime ||
+      header->size != (guint32) source->st_size ||
+      n != sizeof (AccelCacheHeader) + header->n_entries * sizeof (AccelCacheEntry) + header->strings_size ||
+      (header->strings_size && buffer[n - 1] != '\0'))
+    {
+      DebOut("accel map cache %s is stale\n", cache_name);
+      g_free (buffer);
+      return FALSE;
+    }
+
+  entries = (AccelCacheEntry *) (buffer + sizeof (AccelCacheHeader));
+  strings = (const gchar *) (entries + header->n_entries);
+
+  for (i = 0; i < header->n_entries; i++)
+    if (entries[i].path_offset >= header->strings_size)
+      {
+	g_free (buffer);
+	return FALSE;
+      }
+
+  DebOut("accel map cache %s: %d entries\n", cache_name, header->n_entries);
+
+  accel_map_freeze_notify ();
+  for (i = 0; i < header->n_entries; i++)
+    {
+      const gchar *path = strings + entries[i].path_offset;
+
+      if (!_gtk_accel_path_is_valid (path))
+	continue;
+
+      gtk_accel_map_add_entry (path, 0, 0);
+      gtk_accel_map_change_entry (path, entries[i].accel_key, entries[i].accel_mods, TRUE);
+    }
+  accel_map_thaw_notify ();
+
+  g_free (buffer);
+
+  return TRUE;
+}
+
+static void
+accel_map_save_cache (const gchar *cache_name,
+		      struct stat *source,
+		      GArray      *records)
+{
+  AccelCacheHeader header;
+  AccelCacheEntry *entries;
+  GString *strings;
+  gint fd;
+  guint i;
+  gboolean ok;
+
+  entries = g_new (AccelCacheEntry, MAX (records->len, 1));
+  strings = g_string_new (NULL);
+
+  for (i = 0; i < records->len; i++)
+    {
+      AccelRecord *record = &g_array_index (records, AccelRecord, i);
+
+      entries[i].path_offset = strings->len;
+      entries[i].accel_key = record->accel_key;
+      entries[i].accel_mods = record->accel_mods;
+      g_string_append_len (strings, record->accel_path, strlen (record->accel_path) + 1);
+    }
+
+  header.magic = ACCEL_CACHE_MAGIC;
+  header.version = ACCEL_CACHE_VERSION;
+  header.mtime = (guint32) source->st_mtime;
+  header.size = (guint32) source->st_size;
+  header.n_entries = records->len;
+  header.strings_size = strings->len;
+
+  fd = g_open (cache_name, O_CREAT | O_TRUNC | O_WRONLY, 0644);
+  if (fd >= 0)
+    {
+      ok = write_all (fd, (gchar *) &header, sizeof (header)) &&
+	   write_all (fd, (gchar *) entries, records->len * sizeof (AccelCacheEntry)) &&
+	   write_all (fd, strings->str, strings->len);
+      close (fd);
+
+      if (!ok)
+	{
+	  DebOut("unable to write accel map cache %s\n", cache_name);
+	  g_unlink (cache_name);
+	}
+    }
+
+  g_string_free (strings, TRUE);
+  g_free (entries);
+}
+
 /**
  * gtk_accel_map_load:
  * @file_name: a file containing accelerator specifications,
@@ -627,6 +841,9 @@ gtk_accel_map_load_fd (gint fd)
 void
 gtk_accel_map_load (const gchar *file_name)
 {
+  struct stat st;
+  gchar *cache_name;
+  guint i;
   gint fd;
 
   g_return_if_fail (file_name != NULL);
@@ -634,36 +851,39 @@ gtk_accel_map_load (const gchar *file_name)
   if (!g_file_test (file_name, G_FILE_TEST_IS_REGULAR))
     return;
 
+  if (g_stat (file_name, &st) < 0)
+    return;
+
+  cache_name = g_strconcat (file_name, ACCEL_CACHE_SUFFIX, NULL);
+
+  if (accel_map_load_cache (cache_name, &st))
+    {
+      g_free (cache_name);
+      return;
+    }
+
   fd = g_open (file_name, O_RDONLY, 0);
   if (fd < 0)
-    return;
+    {
+      g_free (cache_name);
+      return;
+    }
+
+  /* parse the text file and remember, what we got for the cache */
+  accel_map_record = g_array_new (FALSE, FALSE, sizeof (AccelRecord));
 
   gtk_accel_map_load_fd (fd);
 
   close (fd);
-}
 
-static gboolean
-write_all (gint   fd,
-	   gchar *buf,
-	   gsize  to_write)
-{
-  while (to_write > 0)
-    {
-      gssize count = write (fd, buf, to_write);
-      if (count < 0)
-	{
-	  if (errno != EINTR)
-	    return FALSE;
-	}
-      else
-	{
-	  to_write -= count;
-	  buf += count;
-	}
-    }
+  accel_map_save_cache (cache_name, &st, accel_map_record);
 
-  return TRUE;
+  for (i = 0; i < accel_map_record->len; i++)
+    g_free (g_array_index (accel_map_record, AccelRecord, i).accel_path);
+  g_array_free (accel_map_record, TRUE);
+  accel_map_record = NULL;
+
+  g_free (cache_name);
 }
 
 static void
@@ -1002,9 +1222,49 @@ gtk_accel_map_get (void)
   return accel_map;
 }
 
+static void
+accel_map_freeze_notify (void)
+{
+  accel_map_notify_freeze++;
+}
+
+static void
+accel_map_thaw_notify (void)
+{
+  GSList *slist, *pending;
+
+  g_return_if_fail (accel_map_notify_freeze > 0);
+
+  if (--accel_map_notify_freeze)
+    return;
+
+  pending = g_slist_reverse (accel_map_notify_pending);
+  accel_map_notify_pending = NULL;
+
+  for (slist = pending; slist; slist = slist->next)
+    {
+      AccelEntry *entry = slist->data;
+
+      entry->notify_pending = FALSE;
+      do_accel_map_changed (entry);
+    }
+  g_slist_free (pending);
+}
+
 static void
 do_accel_map_changed (AccelEntry *entry)
 {
+  if (accel_map_notify_freeze)
+    {
+      /* one notification per entry, with its final values */
+      if (!entry->notify_pending)
+	{
+	  entry->notify_pending = TRUE;
+	  accel_map_notify_pending = g_slist_prepend (accel_map_notify_pending, entry);
+	}
+      return;
+    }
+
   if (accel_map)
     g_signal_emit (accel_map,
 		   accel_map_signals[CHANGED],
@@ -31,6 +31,7 @@
  */
 
 #include <config.h>
+#include <math.h>
 
 #include "gtk/gtkadjustment.h"
 /*
@@ -43,6 +44,9 @@
 */
 #include "mui.h"
 #include "debug.h"
+#include "classes/classes.h"
+#include "classes/numericmap.h"
+#include "classes/adjbinding.h"
 
 enum
 {
@@ -76,6 +80,9 @@ static void gtk_adjustment_set_property (GObject      *object,
 
 static guint adjustment_signals[LAST_SIGNAL] = { 0 };
 
+static void push_views (GtkAdjustment *adjustment, GtkWidget *source);
+static void invalidate_views (GtkAdjustment *adjustment);
+
 
 GType gtk_adjustment_get_type (void) {
 
@@ -397,57 +404,25 @@ gtk_adjustment_changed (GtkAdjustment        *adjustment) {
   DebOut("gtk_adjustment_changed(%lx)\n",adjustment);
 
   g_signal_emit (adjustment, adjustment_signals[CHANGED], 0);
+
+  /* bounds or step changed, scales need a new MUI range */
+  invalidate_views(adjustment);
 }
 
 void gtk_adjustment_value_changed (GtkAdjustment        *adjustment) {
-  GSList *g;
-  GtkWidget *w;
-  ULONG v;
 
   DebOut("gtk_adjustment_value_changed(%lx,..)\n",adjustment);
 
   g_return_if_fail (GTK_IS_ADJUSTMENT (adjustment));
 
-  g_signal_emit (adjustment, adjustment_signals[VALUE_CHANGED], 0);
-  g_object_notify (G_OBJECT (adjustment), "value");
-
   /* MUI stuff 
    * an adjustment is a quite abstract object, it has no MuiObject..
-   * but we have all real Objects in the remember GSList 
+   * but its views have one.
    */
+  push_views(adjustment,NULL);
 
-  g=GTK_MUI(adjustment)->remember;
-  
-  DebOut("g: %lx\n", g);
-  while(g) {
-    w=g->data;
-  
-    DebOut("gtk_adjustment_value_changed is still quite unfinished..\n");
-#if 0
-    if(w->step_increment) {
-      /* slider */
-      DebOut("  set_value on slider\n");
-      v=(int) value / w->step_increment;
-    
-      /* this should call the appropiate hooks, too */
-    }
-    else {
-      /* scrollbar */
-      DebOut("  set_value on scollbar\n");
-      v=(int) value;
-      /*??*/
-    }
-    set(mgtk_get_mui_action_object(w),MUIA_Numeric_Value,v); 
-#endif
-
-    //v=(ULONG) GTK_ADJUSTMENT(w)->value;
-    v=GTK_RANGE(w)->adjustment->value / GTK_RANGE(w)->adjustment->step_increment;
-    DebOut("new value: %d\n", v);
-    set(GtkObj(w),MUIA_Numeric_Value,v);
-
-    /*    g=g_slist_next(g);*/
-    g=g->next;
-  }
+  g_signal_emit (adjustment, adjustment_signals[VALUE_CHANGED], 0);
+  g_object_notify (G_OBJECT (adjustment), "value");
 }
 
 void
@@ -479,4 +454,260 @@ gtk_adjustment_clamp_page (GtkAdjustment *adjustment,
     gtk_adjustment_value_changed (adjustment);
 }
 
+/*********************************
+ * GTK-MUI: views of an adjustment
+ *
+ * Every widget showing an adjustment is bound to it as a typed
+ * view, see classes/adjbinding.h. Here are only the view classes
+ * and the glue to the GObject world: the binding hangs at the
+ * adjustment and a weak reference drops views of dead widgets.
+ *********************************/
+
+static GQuark binding_quark(void) {
+  static GQuark q;
+
+  if(!q) {
+    q=g_quark_from_static_string("mgtk-adjustment-binding");
+  }
+  return q;
+}
+
+static MgtkBinding *get_binding(GtkAdjustment *adjustment) {
+
+  return (MgtkBinding *) g_object_get_qdata(G_OBJECT(adjustment),binding_quark());
+}
+
+/* MUIA_Numeric_Value of sliders */
+static gboolean range_position(MgtkBindingView *view, gpointer data, gdouble *pos) {
+  GtkAdjustment *adjustment=(GtkAdjustment *) data;
+  MgtkNumericMap map;
+
+  if(!GtkObj(GTK_WIDGET(view->widget))) {
+    return FALSE;
+  }
+  mgtk_numeric_map_adjustment(&map,adjustment,GTK_RANGE(view->widget)->round_digits);
+  *pos=mgtk_numeric_map_to_mui(&map,adjustment->value);
+
+  return TRUE;
+}
+
+static void range_show(MgtkBindingView *view, gpointer data, gdouble pos) {
+
+  DebOut("range_show(%lx): %ld\n",view->widget,(LONG) pos);
+  set(GtkObj(GTK_WIDGET(view->widget)),MUIA_Numeric_Value,(LONG) pos);
+}
+
+static void range_invalidate(MgtkBindingView *view, gpointer data) {
+
+  if(GTK_IS_SCALE(view->widget) && GtkObj(GTK_WIDGET(view->widget))) {
+    DoMethod(GtkObj(GTK_WIDGET(view->widget)),MM_Scale_Redraw,(ULONG) TRUE);
+  }
+}
+
+/* text of spin buttons, in units of their last digit */
+static gboolean spin_button_position(MgtkBindingView *view, gpointer data, gdouble *pos) {
+  GtkAdjustment *adjustment=(GtkAdjustment *) data;
+  gint digits;
+
+  if(!GtkObj(GTK_WIDGET(view->widget))) {
+    return FALSE;
+  }
+  digits=MIN(GTK_SPIN_BUTTON(view->widget)->digits,15);
+  *pos=floor(adjustment->value*pow(10,digits)+0.5);
+
+  return TRUE;
+}
+
+static void spin_button_show(MgtkBindingView *view, gpointer data, gdouble pos) {
+  GtkAdjustment *adjustment=(GtkAdjustment *) data;
+  gchar text[64];
+  gint digits;
+
+  DebOut("spin_button_show(%lx)\n",view->widget);
+  digits=MIN(GTK_SPIN_BUTTON(view->widget)->digits,15);
+  g_snprintf(text,sizeof(text),"%4.*f",digits,adjustment->value);
+  set(GtkObj(GTK_WIDGET(view->widget)),MA_Spin_String_Value,(ULONG) text);
+}
+
+static const MgtkBindingViewClass view_classes[] = {
+  { range_position,       range_show,       range_invalidate }, /* MGTK_VIEW_RANGE */
+  { spin_button_position, spin_button_show, NULL }              /* MGTK_VIEW_SPIN_BUTTON */
+};
+
+static void push_views(GtkAdjustment *adjustment, GtkWidget *source) {
+  MgtkBinding *binding;
+
+  binding=get_binding(adjustment);
+  if(binding) {
+    mgtk_binding_push(binding,adjustment,source);
+  }
+}
+
+static void invalidate_views(GtkAdjustment *adjustment) {
+  MgtkBinding *binding;
+
+  binding=get_binding(adjustment);
+  if(binding) {
+    mgtk_binding_invalidate(binding,adjustment);
+  }
+}
+
+static void view_widget_gone(gpointer data, GObject *widget) {
+
+  mgtk_binding_remove((MgtkBinding *) data,widget);
+}
+
+static void binding_free(gpointer data) {
+  MgtkBinding *binding;
+  GSList *g;
+
+  binding=(MgtkBinding *) data;
+  for(g=binding->views;g;g=g->next) {
+    g_object_weak_unref(G_OBJECT(((MgtkBindingView *) g->data)->widget),view_widget_gone,binding);
+  }
+  mgtk_binding_free(binding);
+}
+
+void mgtk_adjustment_bind(GtkAdjustment *adjustment, GtkWidget *widget, MgtkViewType type) {
+  MgtkBinding *binding;
+
+  g_return_if_fail(GTK_IS_ADJUSTMENT(adjustment));
+
+  DebOut("mgtk_adjustment_bind(%lx,%lx,%d)\n",adjustment,widget,type);
+
+  binding=get_binding(adjustment);
+  if(!binding) {
+    binding=mgtk_binding_new();
+    g_object_set_qdata_full(G_OBJECT(adjustment),binding_quark(),binding,binding_free);
+  }
+
+  if(mgtk_binding_add(binding,widget,&view_classes[type])) {
+    g_object_weak_ref(G_OBJECT(widget),view_widget_gone,binding);
+  }
+}
+
+void mgtk_adjustment_unbind(GtkAdjustment *adjustment, GtkWidget *widget) {
+  MgtkBinding *binding;
+
+  g_return_if_fail(GTK_IS_ADJUSTMENT(adjustment));
+
+  binding=get_binding(adjustment);
+  if(binding && mgtk_binding_remove(binding,widget)) {
+    g_object_weak_unref(G_OBJECT(widget),view_widget_gone,binding);
+  }
+}
+
+/* the view shows the value in another format now */
+void mgtk_adjustment_update_view(GtkAdjustment *adjustment, GtkWidget *widget) {
+  MgtkBinding *binding;
+  MgtkBindingView *view;
+
+  g_return_if_fail(GTK_IS_ADJUSTMENT(adjustment));
+
+  binding=get_binding(adjustment);
+  if(!binding) {
+    return;
+  }
+
+  view=mgtk_binding_find(binding,widget);
+  if(view) {
+    mgtk_binding_push_view(binding,view,adjustment);
+  }
+}
+
+/* TRUE, while the views get a new value from us */
+gboolean mgtk_adjustment_pushing(GtkAdjustment *adjustment) {
+  MgtkBinding *binding;
+
+  binding=get_binding(adjustment);
+
+  return mgtk_binding_pushing(binding);
+}
+
+/*********************************
+ * GTK-MUI: value_changed coalescing
+ *
+ * While a slider is dragged, MUI notifies for every single step.
+ * The classes only update adjustment->value then and queue the
+ * signal here, gtk_main delivers it once per input loop iteration,
+ * so handlers always see the last value.
+ *********************************/
+typedef struct {
+  GtkAdjustment *adjustment;
+  GtkWidget     *widget;     /* view the change came from, may be NULL */
+  gboolean       emit;       /* widget gets value_changed, too */
+} MgtkPendingValue;
+
+static GSList *pending_values;
+
+void mgtk_adjustment_queue_value_changed(GtkAdjustment *adjustment, GtkWidget *widget, gboolean emit) {
+  MgtkPendingValue *p;
+  GSList *g;
+
+  for(g=pending_values;g;g=g->next) {
+    p=(MgtkPendingValue *) g->data;
+    if(p->adjustment==adjustment && p->widget==widget) {
+      return;
+    }
+  }
+
+  p=g_new(MgtkPendingValue,1);
+  p->adjustment=g_object_ref(adjustment);
+  p->widget=widget ? g_object_ref(widget) : NULL;
+  p->emit=emit;
+  pending_values=g_slist_append(pending_values,p);
+}
+
+static void pending_value_free(MgtkPendingValue *p) {
+
+  if(p->widget) {
+    g_object_unref(p->widget);
+  }
+  g_object_unref(p->adjustment);
+  g_free(p);
+}
+
+/* drop a queued signal, the caller emits it right now */
+void mgtk_adjustment_cancel_value_changed(GtkAdjustment *adjustment) {
+  MgtkPendingValue *p;
+  GSList *g;
+  GSList *next;
+
+  for(g=pending_values;g;g=next) {
+    next=g->next;
+    p=(MgtkPendingValue *) g->data;
+    if(p->adjustment==adjustment) {
+      pending_values=g_slist_delete_link(pending_values,g);
+      pending_value_free(p);
+    }
+  }
+}
+
+void mgtk_adjustment_flush_value_changed(void) {
+  MgtkPendingValue *p;
+  GSList *list;
+  GSList *g;
+
+  if(!pending_values) {
+    return;
+  }
+
+  /* handlers may queue again, that goes to the next iteration */
+  list=pending_values;
+  pending_values=NULL;
+
+  for(g=list;g;g=g->next) {
+    p=(MgtkPendingValue *) g->data;
+    DebOut("emit value_changed for widget %lx and adj %lx\n",p->widget,p->adjustment);
+    push_views(p->adjustment,p->widget);
+    if(p->widget && p->emit) {
+      g_signal_emit_by_name(p->widget,"value_changed");
+    }
+    g_signal_emit(p->adjustment,adjustment_signals[VALUE_CHANGED],0);
+    g_object_notify(G_OBJECT(p->adjustment),"value");
+    pending_value_free(p);
+  }
+  g_slist_free(list);
+}
+
 #define __GTK_ADJUSTMENT_C__
@@ -157,10 +157,7 @@ static void gtk_bin_remove (GtkContainer *container, GtkWidget    *child) {
   widget_was_visible = GTK_WIDGET_VISIBLE (child);
 #endif
   
-#warning TODO: enable gtk_widget_unparent again
-#if 0
   gtk_widget_unparent (child);
-#endif
   bin->child = NULL;
   
   /* queue resize regardless of GTK_WIDGET_VISIBLE (container),
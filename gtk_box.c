@@ -221,7 +221,7 @@ static void gtk_box_init (GtkBox *box) {
   box->spacing = 0;
   box->homogeneous = FALSE;
 
-  GtkSetObj(GTK_WIDGET(box),NewObject(CL_Group->mcc_Class, NULL,
+  GtkSetObj(GTK_WIDGET(box),NewObject(MGTK_CLASS(CL_Group), NULL,
                                              MA_Widget,(LONG) box,
                                              TAG_DONE));
 
@@ -845,9 +845,7 @@ gtk_box_remove (GtkContainer *container,
 	  gboolean was_visible;
 
 	  was_visible = GTK_WIDGET_VISIBLE (widget);
-#if 0
 	  gtk_widget_unparent (widget);
-#endif
 
 	  box->children = g_list_remove_link (box->children, children);
 	  g_list_free (children);
@@ -650,13 +650,13 @@ GtkWidget* gtk_button_new_with_label(const char *label) {
       **
       ** If this is not desired then we must use taglist way
       */
-      button=NewObject(CL_Button->mcc_Class, NULL,MA_Widget,(ULONG) ret,MA_Button_Label,(ULONG) label,TAG_DONE);
+      button=NewObject(MGTK_CLASS(CL_Button), NULL,MA_Widget,(ULONG) ret,MA_Button_Label,(ULONG) label,TAG_DONE);
     }
   }
   else { /* no label */
     ret=g_object_new (GTK_TYPE_BUTTON, NULL);
     if(ret) {
-      button=NewObject(CL_Button->mcc_Class, NULL,MA_Widget,(ULONG) ret,TAG_DONE);
+      button=NewObject(MGTK_CLASS(CL_Button), NULL,MA_Widget,(ULONG) ret,TAG_DONE);
     }
   }
 
@@ -130,7 +130,7 @@ GtkWidget *gtk_check_button_new_with_label (const gchar *label) {
 
   ret=g_object_new (GTK_TYPE_CHECK_BUTTON, "label", label, NULL);
 
-  check = NewObject(CL_CheckButton->mcc_Class, NULL,MA_Widget,(ULONG) ret,MA_Check_Label,(ULONG) label,TAG_DONE);
+  check = NewObject(MGTK_CLASS(CL_CheckButton), NULL,MA_Widget,(ULONG) ret,MA_Check_Label,(ULONG) label,TAG_DONE);
 
   if((!ret) || (!check)) {
     ErrOut("Unable to create gtk_check_button_with_label!\n");
@@ -65,6 +65,9 @@
 /* the number rows memchunk expands at a time */
 #define CLIST_OPTIMUM_SIZE 64
 
+/* the size of one block of the cell text arena */
+#define CLIST_TEXT_CHUNK_SIZE 4096
+
 /* the width of the column resize windows */
 #define DRAG_WIDTH  6
 
@@ -446,6 +449,14 @@ static void column_title_new       (GtkCList      *clist,
 			            const gchar   *title);
 static void columns_delete         (GtkCList      *clist);
 static GtkCListRow *row_new        (GtkCList      *clist);
+static gchar *cell_text_new        (GtkCList      *clist,
+				    gint           column,
+				    const gchar   *text);
+static void cell_text_release      (GtkCList      *clist,
+				    const gchar   *text);
+static void cell_text_reset        (GtkCList      *clist);
+static void cell_text_compact      (GtkCList      *clist);
+static void clist_thaw             (GtkCList      *clist);
 static void row_delete             (GtkCList      *clist,
 			            GtkCListRow   *clist_row);
 static void set_cell_contents      (GtkCList      *clist,
@@ -1054,6 +1065,13 @@ static void gtk_clist_init (GtkCList *clist) {
   clist->row_mem_chunk = NULL;
   clist->cell_mem_chunk = NULL;
 
+  clist->text_chunk = NULL;
+  clist->text_intern = NULL;
+  clist->text_bytes = 0;
+  clist->text_bytes_saved = 0;
+  clist->text_live = 0;
+  clist->text_dead = 0;
+
   clist->freeze_count = 0;
 
   clist->rows = 0;
@@ -1145,6 +1163,9 @@ gtk_clist_constructor (GType                  type,
 					     sizeof (GtkCell) * clist->columns *
 					     CLIST_OPTIMUM_SIZE, 
 					     G_ALLOC_AND_FREE);
+
+  if (!clist->text_chunk)
+    clist->text_chunk = g_string_chunk_new (CLIST_TEXT_CHUNK_SIZE);
   
   /* allocate memory for columns */
   clist->column = columns_new (clist);
@@ -1187,7 +1208,7 @@ GtkWidget* gtk_clist_new_with_titles (gint columns, gchar *titles[]) {
 			"n_columns", columns,
 			NULL);
 
-  GtkSetObj(GTK_WIDGET(clist),NewObject(CL_CList->mcc_Class, NULL,
+  GtkSetObj(GTK_WIDGET(clist),NewObject(MGTK_CLASS(CL_CList), NULL,
                                           MA_Widget,          (ULONG) clist, 
                                           MA_CList_Columns,   (ULONG) clist->columns,
                                         TAG_DONE));
@@ -1376,6 +1397,25 @@ gtk_clist_thaw (GtkCList *clist)
 {
   g_return_if_fail (GTK_IS_CLIST (clist));
 
+  if (clist->freeze_count)
+    {
+      clist->freeze_count--;
+      /* GTK-MUI: the caller is done with its batch of changes, so
+       * texts may move now
+       */
+      if (!clist->freeze_count)
+	cell_text_compact (clist);
+      CLIST_REFRESH (clist);
+    }
+}
+
+/* GTK-MUI: thaw after a freeze inside of clist itself. Unlike
+ * gtk_clist_thaw it never compacts the cell texts, sorting or moving
+ * rows must not move texts the caller may still hold.
+ */
+static void
+clist_thaw (GtkCList *clist)
+{
   if (clist->freeze_count)
     {
       clist->freeze_count--;
@@ -1397,6 +1437,8 @@ gtk_clist_thaw (GtkCList *clist)
  *   gtk_clist_set_column_visibility
  *   gtk_clist_set_column_resizeable
  *   gtk_clist_set_column_auto_resize
+ *   gtk_clist_set_column_intern_text
+ *   gtk_clist_get_text_bytes_saved
  *   gtk_clist_optimal_column_width
  *   gtk_clist_set_column_width
  *   gtk_clist_set_column_min_width
@@ -1797,6 +1839,28 @@ gtk_clist_set_column_auto_resize (GtkCList *clist,
     size_allocate_title_buttons (clist);
 }
 
+void
+gtk_clist_set_column_intern_text (GtkCList *clist,
+				  gint      column,
+				  gboolean  intern_text)
+{
+  g_return_if_fail (GTK_IS_CLIST (clist));
+
+  if (column < 0 || column >= clist->columns)
+    return;
+
+  /* already stored texts are not affected */
+  clist->column[column].intern_text = (intern_text != FALSE);
+}
+
+gsize
+gtk_clist_get_text_bytes_saved (GtkCList *clist)
+{
+  g_return_val_if_fail (GTK_IS_CLIST (clist), 0);
+
+  return clist->text_bytes_saved;
+}
+
 gint
 gtk_clist_columns_autosize (GtkCList *clist)
 {
@@ -1815,7 +1879,7 @@ gtk_clist_columns_autosize (GtkCList *clist)
       width += clist->column[i].width;
     }
 
-  gtk_clist_thaw (clist);
+  clist_thaw (clist);
   return width;
 }
 
@@ -2609,7 +2673,7 @@ set_cell_contents (GtkCList    *clist,
     case GTK_CELL_TEXT:
       if (text) {
 	  clist_row->cell[column].type = GTK_CELL_TEXT;
-	  GTK_CELL_TEXT (clist_row->cell[column])->text = g_strdup (text);
+	  GTK_CELL_TEXT (clist_row->cell[column])->text = cell_text_new (clist, column, text);
 	}
       break;
 #if 0
@@ -2626,7 +2690,7 @@ set_cell_contents (GtkCList    *clist,
       if (text && pixmap)
 	{
 	  clist_row->cell[column].type = GTK_CELL_PIXTEXT;
-	  GTK_CELL_PIXTEXT (clist_row->cell[column])->text = g_strdup (text);
+	  GTK_CELL_PIXTEXT (clist_row->cell[column])->text = cell_text_new (clist, column, text);
 	  GTK_CELL_PIXTEXT (clist_row->cell[column])->spacing = spacing;
 	  GTK_CELL_PIXTEXT (clist_row->cell[column])->pixmap = pixmap;
 	  GTK_CELL_PIXTEXT (clist_row->cell[column])->mask = mask;
@@ -2646,8 +2710,12 @@ set_cell_contents (GtkCList    *clist,
     column_auto_resize (clist, clist_row, column, requisition.width);
 #endif
 
+  /* old_text lives in clist->text_chunk, it is only accounted as dead
+   * here. The arena is rebuilt by cell_text_compact at the last thaw or
+   * dropped by cell_text_reset.
+   */
   if (old_text)
-    g_free (old_text);
+    cell_text_release (clist, old_text);
 #if 0
   if (old_pixmap)
     gdk_pixmap_unref (old_pixmap);
@@ -3042,6 +3110,9 @@ real_clear (GtkCList *clist)
     row_delete (clist, GTK_CLIST_ROW (list));
 
   g_list_free (free_list);
+
+  /* all cell texts are gone now, drop them at once */
+  cell_text_reset (clist);
   GTK_CLIST_UNSET_FLAG (clist, CLIST_AUTO_RESIZE_BLOCKED);
   for (i = 0; i < clist->columns; i++)
     if (clist->column[i].auto_resize)
@@ -3126,7 +3197,7 @@ real_row_move (GtkCList *clist,
   else if (clist->focus_row > first)
     clist->focus_row += d;
 
-  gtk_clist_thaw (clist);
+  clist_thaw (clist);
 }
 
 /* PUBLIC ROW FUNCTIONS
@@ -3308,7 +3379,7 @@ gtk_clist_swap_rows (GtkCList *clist,
   gtk_clist_row_move (clist, last, first);
   gtk_clist_row_move (clist, first + 1, last);
   
-  gtk_clist_thaw (clist);
+  clist_thaw (clist);
 }
 
 void
@@ -4284,7 +4355,7 @@ resync_selection (GtkCList *clist,
   clist->anchor = -1;
   clist->drag_pos = -1;
 
-  gtk_clist_thaw (clist);
+  clist_thaw (clist);
 }
 
 static void
@@ -4610,6 +4681,11 @@ gtk_clist_finalize (GObject *object)
 
   columns_delete (clist);
 
+  if (clist->text_intern)
+    g_hash_table_destroy (clist->text_intern);
+  if (clist->text_chunk)
+    g_string_chunk_free (clist->text_chunk);
+
   g_mem_chunk_destroy (clist->cell_mem_chunk);
   g_mem_chunk_destroy (clist->row_mem_chunk);
 
@@ -6541,6 +6617,10 @@ hadjustment_value_changed (GtkAdjustment *adjustment,
  *   columns_delete
  *   row_new
  *   row_delete
+ *   cell_text_new
+ *   cell_text_release
+ *   cell_text_reset
+ *   cell_text_compact
  */
 static GtkCListColumn *
 columns_new (GtkCList *clist)
@@ -6567,6 +6647,7 @@ columns_new (GtkCList *clist)
       column[i].resizeable = TRUE;
       column[i].auto_resize = FALSE;
       column[i].button_passive = FALSE;
+      column[i].intern_text = FALSE;
       column[i].justification = GTK_JUSTIFY_LEFT;
     }
 
@@ -6660,6 +6741,152 @@ row_delete (GtkCList    *clist,
   g_mem_chunk_free (clist->row_mem_chunk, clist_row);
 }
 
+/* cell texts are not g_strdup'ed, but copied into a per clist
+ * string arena. Columns with intern_text set share identical
+ * strings. Nothing is freed per cell, replaced texts are only
+ * counted in text_dead. The whole arena is dropped by cell_text_reset
+ * or rebuilt by cell_text_compact.
+ * A text returned by gtk_clist_get_text stays where it is until its
+ * cell changes, the list is cleared or the last gtk_clist_thaw.
+ */
+static gchar *
+cell_text_new (GtkCList    *clist,
+	       gint         column,
+	       const gchar *text)
+{
+  gchar *ret;
+  gsize len;
+
+  len = strlen (text) + 1;
+  clist->text_live += len;
+
+  if (clist->column[column].intern_text)
+    {
+      if (!clist->text_intern)
+	clist->text_intern = g_hash_table_new (g_str_hash, g_str_equal);
+
+      ret = g_hash_table_lookup (clist->text_intern, text);
+      if (ret)
+	{
+	  clist->text_bytes_saved += len;
+	  return ret;
+	}
+
+      ret = g_string_chunk_insert (clist->text_chunk, text);
+      g_hash_table_insert (clist->text_intern, ret, ret);
+    }
+  else
+    ret = g_string_chunk_insert (clist->text_chunk, text);
+
+  clist->text_bytes += len;
+
+  return ret;
+}
+
+/* text of a cell is replaced or the cell is gone. Shared texts are
+ * counted once per cell, so text_dead may overestimate the garbage,
+ * which only makes cell_text_compact run a bit earlier.
+ */
+static void
+cell_text_release (GtkCList    *clist,
+		   const gchar *text)
+{
+  gsize len;
+
+  len = strlen (text) + 1;
+
+  clist->text_live -= MIN (len, clist->text_live);
+  clist->text_dead += len;
+}
+
+static void
+cell_text_reset (GtkCList *clist)
+{
+  DebOut("cell_text_reset(%lx): %ld bytes used, %ld bytes saved\n",clist,
+	 (long) clist->text_bytes, (long) clist->text_bytes_saved);
+
+  if (clist->text_intern)
+    {
+      g_hash_table_destroy (clist->text_intern);
+      clist->text_intern = NULL;
+    }
+
+  g_string_chunk_free (clist->text_chunk);
+  clist->text_chunk = g_string_chunk_new (CLIST_TEXT_CHUNK_SIZE);
+
+  clist->text_bytes = 0;
+  clist->text_bytes_saved = 0;
+  clist->text_live = 0;
+  clist->text_dead = 0;
+}
+
+/* copy all cell texts into a fresh arena, once more garbage than live
+ * text has piled up. So a long lived list, whose texts change all the
+ * time, keeps at most about twice its text, and each byte is copied
+ * only once for every byte replaced.
+ * This moves the text of every cell, so pointers from gtk_clist_get_text
+ * of cells nobody touched would dangle. It is only done when the last
+ * gtk_clist_thaw ends a batch of changes, lists that are never frozen
+ * keep their garbage until gtk_clist_clear.
+ */
+static void
+cell_text_compact (GtkCList *clist)
+{
+  GStringChunk *old_chunk;
+  GtkCListRow *clist_row;
+  gsize bytes_saved;
+  gchar **text;
+  GList *list;
+  gint i;
+
+  if (clist->text_dead < CLIST_TEXT_CHUNK_SIZE ||
+      clist->text_dead < clist->text_live)
+    return;
+
+  DebOut("cell_text_compact(%lx): %ld bytes live, %ld bytes dead\n",clist,
+	 (long) clist->text_live, (long) clist->text_dead);
+
+  old_chunk = clist->text_chunk;
+  bytes_saved = clist->text_bytes_saved;
+
+  if (clist->text_intern)
+    {
+      g_hash_table_destroy (clist->text_intern);
+      clist->text_intern = NULL;
+    }
+  clist->text_chunk = g_string_chunk_new (CLIST_TEXT_CHUNK_SIZE);
+  clist->text_bytes = 0;
+  clist->text_live = 0;
+  clist->text_dead = 0;
+
+  for (list = clist->row_list; list; list = list->next)
+    {
+      clist_row = list->data;
+      for (i = 0; i < clist->columns; i++)
+	{
+	  switch (clist_row->cell[i].type)
+	    {
+	    case GTK_CELL_TEXT:
+	      text = &GTK_CELL_TEXT (clist_row->cell[i])->text;
+	      break;
+	    case GTK_CELL_PIXTEXT:
+	      text = &GTK_CELL_PIXTEXT (clist_row->cell[i])->text;
+	      break;
+	    default:
+	      text = NULL;
+	      break;
+	    }
+	  if (text && *text)
+	    *text = cell_text_new (clist, i, *text);
+	}
+    }
+
+  /* interning again is no saving */
+  clist->text_bytes_saved = bytes_saved;
+
+  g_string_chunk_free (old_chunk);
+}
+
 /* FOCUS FUNCTIONS
  *   gtk_clist_focus_content_area
  *   gtk_clist_focus
@@ -7509,7 +7736,7 @@ real_sort_list (GtkCList *clist)
 	clist->row_list_end = list;
     }
 
-  gtk_clist_thaw (clist);
+  clist_thaw (clist);
 }
 
 static GList *
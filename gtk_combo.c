@@ -1095,7 +1095,7 @@ static void gtk_combo_init (GtkCombo * combo) {
 
   DebOut("  NewObject..\n");
   /* create a MUI Object */
-  GtkSetObj(GTK_WIDGET(combo),NewObject(CL_Combo->mcc_Class, NULL,MA_Widget,(ULONG) combo, TAG_DONE));
+  GtkSetObj(GTK_WIDGET(combo),NewObject(MGTK_CLASS(CL_Combo), NULL,MA_Widget,(ULONG) combo, TAG_DONE));
 
   DebOut("  gtk_combo_init done\n");
 }
@@ -865,12 +865,12 @@ gtk_container_init (GtkContainer *container)
 static void
 gtk_container_destroy (GtkObject *object)
 {
-#warning TODO: enable gtk_container_destroy again
-#if 0
   GtkContainer *container = GTK_CONTAINER (object);
   
+#if 0
   if (GTK_CONTAINER_RESIZE_PENDING (container))
     _gtk_container_dequeue_resize_handler (container);
+#endif
 
   /* do this before walking child widgets, to avoid
    * removing children from focus chain one by one.
@@ -879,7 +879,6 @@ gtk_container_destroy (GtkObject *object)
     gtk_container_unset_focus_chain (container);
   
   gtk_container_foreach (container, (GtkCallback) gtk_widget_destroy, NULL);
-#endif
   
   if (GTK_OBJECT_CLASS (parent_class)->destroy)
     (* GTK_OBJECT_CLASS (parent_class)->destroy) (object);
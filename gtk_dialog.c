@@ -269,10 +269,10 @@ static void gtk_dialog_init (GtkDialog *dialog) {
 			    GDK_WINDOW_TYPE_HINT_DIALOG);
 #endif
 
-  obj = NewObject(CL_Window->mcc_Class, NULL,
+  obj = NewObject(MGTK_CLASS(CL_Window), NULL,
                   MUIA_Window_CloseGadget, FALSE,
                   WindowContents, 
-                    root = (APTR)NewObject(CL_RootGroup->mcc_Class, NULL, TAG_DONE)
+                    root = (APTR)NewObject(MGTK_CLASS(CL_RootGroup), NULL, TAG_DONE)
                   );
 
   if(obj) {
@@ -808,7 +808,7 @@ GtkWidget *gtk_entry_new() {
 
   ret=g_object_new (GTK_TYPE_ENTRY, NULL);
 
-  entry=NewObject(CL_Entry->mcc_Class, NULL,MA_Widget,(ULONG) ret,MUIA_String_MaxLen,(ULONG) 256,TAG_DONE);
+  entry=NewObject(MGTK_CLASS(CL_Entry), NULL,MA_Widget,(ULONG) ret,MUIA_String_MaxLen,(ULONG) 256,TAG_DONE);
 
   DebOut("ret=%lx\n",ret);
   DebOut("entry=%lx\n",entry);
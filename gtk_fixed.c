@@ -170,7 +170,7 @@ static void gtk_fixed_init (GtkFixed *fixed) {
 
   DebOut("gtk_fixed_init(%lx)\n",fixed);
 
-  GtkSetObj(GTK_WIDGET(fixed),NewObject(CL_Fixed->mcc_Class, NULL,MA_Widget,(ULONG) fixed,TAG_DONE));
+  GtkSetObj(GTK_WIDGET(fixed),NewObject(MGTK_CLASS(CL_Fixed), NULL,MA_Widget,(ULONG) fixed,TAG_DONE));
  
   fixed->children = NULL;
 }
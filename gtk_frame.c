@@ -189,7 +189,7 @@ static void gtk_frame_init (GtkFrame *frame) {
   frame->title = g_strdup("");
 #endif
 
-  GtkSetObj(GTK_WIDGET(frame),NewObject(CL_Frame->mcc_Class,0L,TAG_DONE));
+  GtkSetObj(GTK_WIDGET(frame),NewObject(MGTK_CLASS(CL_Frame),0L,TAG_DONE));
   set(GtkObj(frame),MA_Widget, (ULONG) frame);
   GTK_MUI(frame)->mainclass=CL_AREA;
 
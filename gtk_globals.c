@@ -90,6 +90,7 @@ struct MUI_CustomClass *CL_Combo;
 struct MUI_CustomClass *CL_Scale;
 struct MUI_CustomClass *CL_Frame;
 struct MUI_CustomClass *CL_Scrolledwindow;
+struct MUI_CustomClass *CL_Image;
 
 int gtk_do_main_quit=0;
 int gtk_no_own_libs=0;
@@ -65,6 +65,18 @@ extern struct MUI_CustomClass *CL_Frame;
 extern struct MUI_CustomClass *CL_Dialog;
 extern struct MUI_CustomClass *CL_Window;
 extern struct MUI_CustomClass *CL_Scrolledwindow;
+extern struct MUI_CustomClass *CL_Image;
+
+/* GTK-MUI private: startup profiler, see gtk_init.c */
+#define MGTK_PROFILE_LIBS    0
+#define MGTK_PROFILE_CLASSES 1
+#define MGTK_PROFILE_TYPES   2
+#define MGTK_PROFILE_STYLE   3
+#define MGTK_PROFILE_LAST    4
+
+gdouble mgtk_profile_start(void);
+void    mgtk_profile_stop(int phase, gdouble start);
+void    mgtk_profile_report(const char *when);
 
 extern int gtk_do_main_quit;
 extern int gtk_no_own_libs;
@@ -107,7 +107,7 @@ GtkWidget* gtk_hbox_new (gboolean homogeneous, gint spacing) {
   GTK_BOX (hbox)->spacing = spacing;
   GTK_BOX (hbox)->homogeneous = homogeneous ? TRUE : FALSE;
 
-  GtkSetObj(GTK_WIDGET(hbox), NewObject(CL_HBox->mcc_Class, NULL,
+  GtkSetObj(GTK_WIDGET(hbox), NewObject(MGTK_CLASS(CL_HBox), NULL,
                                               MA_Widget,(LONG) hbox,
                                               MUIA_Group_Horiz,TRUE,
                                               TAG_DONE));
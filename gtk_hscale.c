@@ -39,6 +39,7 @@
 
 #include "gtk_globals.h"
 #include "classes/classes.h"
+#include "classes/numericmap.h"
 #include "debug.h"
 #if 0
 #include "gtk/gtkintl.h"
@@ -118,7 +119,7 @@ static void gtk_hscale_init (GtkHScale *hscale) {
   range->orientation = GTK_ORIENTATION_HORIZONTAL;
   range->flippable = TRUE;
 
-  GtkSetObj(GTK_WIDGET(hscale),NewObject(CL_Scale->mcc_Class, NULL,
+  GtkSetObj(GTK_WIDGET(hscale),NewObject(MGTK_CLASS(CL_Scale), NULL,
                                        MA_Widget,(ULONG) hscale, 
                                        MUIA_Slider_Horiz, TRUE,
                                        MUIA_Numeric_Min,0,
@@ -140,22 +141,20 @@ static void gtk_hscale_init (GtkHScale *hscale) {
 GtkWidget* gtk_hscale_new (GtkAdjustment *adjustment) {
 
   GtkWidget *w;
+  MgtkNumericMap map;
 
   DebOut("gtk_hscale_new(%lx)\n",adjustment);
 
   w=g_object_new (GTK_TYPE_HSCALE, "adjustment", adjustment, NULL);
 
-  if(!GTK_RANGE(w)->adjustment->step_increment) {
-    ErrOut("gtk_vscale.c: step_increment is zero (Division by zero error avoided)!");
-    GTK_RANGE(w)->adjustment->step_increment=1;
-  }
+  mgtk_numeric_map_adjustment(&map,GTK_RANGE(w)->adjustment,GTK_RANGE(w)->round_digits);
 
-  GtkSetObj(w, NewObject(CL_Scale->mcc_Class, NULL,
+  GtkSetObj(w, NewObject(MGTK_CLASS(CL_Scale), NULL,
                                        MA_Widget,(ULONG) w, 
                                        MUIA_Slider_Horiz, TRUE,
-                                       MUIA_Numeric_Min,GTK_RANGE(w)->adjustment->lower / GTK_RANGE(w)->adjustment->step_increment,
-                                       MUIA_Numeric_Max,GTK_RANGE(w)->adjustment->upper / GTK_RANGE(w)->adjustment->step_increment,
-                                       MUIA_Numeric_Value,GTK_RANGE(w)->adjustment->value / GTK_RANGE(w)->adjustment->step_increment,
+                                       MUIA_Numeric_Min,0,
+                                       MUIA_Numeric_Max,map.max,
+                                       MUIA_Numeric_Value,mgtk_numeric_map_to_mui(&map,GTK_RANGE(w)->adjustment->value),
                                        TAG_DONE));
 
 
@@ -164,7 +163,6 @@ GtkWidget* gtk_hscale_new (GtkAdjustment *adjustment) {
   }
   else {
     DoMethod(GTK_MUI(w)->MuiObject,MM_Scale_Pos,GTK_POS_TOP);
-    GTK_MUI(adjustment)->remember=g_slist_append(GTK_MUI(adjustment)->remember, w);
   }
 
   DoMethod(GtkObj(w),MM_Scale_Redraw,(ULONG) TRUE);
@@ -44,6 +44,7 @@
 #include "mui.h"
 #include "gtk_globals.h"
 #include "classes/classes.h"
+#include "classes/imagecache.h"
 #include "debug.h"
 #if 0
 #include "gtkiconfactory.h"
@@ -920,11 +921,8 @@ void gtk_image_set_from_file   (GtkImage    *image, const gchar *filename) {
 #endif
 
   Object *pic;
-#if defined(__AROS__) || defined(__MORPHOS__)
-  BPTR lock;
-#else
-  APTR lock;
-#endif
+  Object *old;
+  MgtkImageEntry *entry;
 
   g_return_if_fail (GTK_IS_IMAGE (image));
 
@@ -973,12 +971,19 @@ void gtk_image_set_from_file   (GtkImage    *image, const gchar *filename) {
 
   DebOut("Loading %s..\n",filename);
 
-  lock=NULL;
+  /* decoded pictures are shared, the loader decodes new ones in the background */
   pic=NULL;
-  if ((lock = Lock(filename, ACCESS_READ)) != NULL) {
-    pic=(APTR) MUI_NewObject("Dtpic.mui",MUIA_Dtpic_Name,(ULONG) filename,TAG_DONE);
-    UnLock(lock);
-    DebOut("Loaded %s successfully\n",filename);
+  entry=mgtk_image_cache_get(filename);
+  if(entry) {
+    old=GtkObj(image);
+    if(old && CL_Image && OCLASS(old) == CL_Image->mcc_Class) {
+      set(old,MA_Image_Entry,(ULONG) entry);
+      mgtk_image_cache_unref(entry);
+      g_object_thaw_notify (G_OBJECT (image));
+      return;
+    }
+    pic=NewObject(MGTK_CLASS(CL_Image),NULL,MA_Image_Entry,(ULONG) entry,TAG_DONE);
+    mgtk_image_cache_unref(entry);
   }
   
   if(!pic) {
@@ -103,42 +103,200 @@ BOOL open_own_libs() {
   return TRUE;
 }
 
+/*********************************
+ * custom classes
+ *
+ * Every class is listed after its parent class. Only the
+ * classes with eager set are created in Open_Libs, all others are
+ * created by mgtk_need_class, when the first such widget is built.
+ * Set the environment variable GTKMUI_EAGER_CLASSES to create all of
+ * them in Open_Libs, so GTKMUI_PROFILE can compare both ways.
+ * Close_Libs deletes them in reverse order, so subclasses go first.
+ *********************************/
+struct mgtk_class_def {
+  struct MUI_CustomClass **cl;
+  struct MUI_CustomClass **parent;
+  int  (*create)(void);
+  void (*delete)(void);
+  int   eager;
+};
+
+static const struct mgtk_class_def mgtk_classes[] = {
+  { &CL_Application,    NULL,       mgtk_create_application_class,    mgtk_delete_application_class,    1 },
+  { &CL_Window,         NULL,       mgtk_create_window_class,         mgtk_delete_window_class,         0 },
+  { &CL_RootGroup,      NULL,       mgtk_create_rootgroup_class,      mgtk_delete_rootgroup_class,      0 },
+  { &CL_Group,          NULL,       mgtk_create_group_class,          mgtk_delete_group_class,          0 },
+  { &CL_HBox,           NULL,       mgtk_create_hbox_class,           mgtk_delete_hbox_class,           0 },
+  { &CL_VBox,           NULL,       mgtk_create_vbox_class,           mgtk_delete_vbox_class,           0 },
+  { &CL_SpinButton,     NULL,       mgtk_create_spinbutton_class,     mgtk_delete_spinbutton_class,     0 },
+  { &CL_Fixed,          NULL,       mgtk_create_fixed_class,          mgtk_delete_fixed_class,          0 },
+  { &CL_Menu,           NULL,       mgtk_create_menu_class,           mgtk_delete_menu_class,           0 },
+  { &CL_Entry,          NULL,       mgtk_create_entry_class,          mgtk_delete_entry_class,          0 },
+  { &CL_Toolbar,        NULL,       mgtk_create_toolbar_class,        mgtk_delete_toolbar_class,        0 },
+  { &CL_Scale,          NULL,       mgtk_create_scale_class,          mgtk_delete_scale_class,          0 },
+  { &CL_Custom,         NULL,       mgtk_create_custom_class,         mgtk_delete_custom_class,         0 },
+  { &CL_Image,          NULL,       mgtk_create_image_class,          mgtk_delete_image_class,          0 },
+  { &CL_Dialog,         &CL_Window, mgtk_create_dialog_class,         mgtk_delete_dialog_class,         0 },
+  { &CL_Table,          &CL_Group,  mgtk_create_table_class,          mgtk_delete_table_class,          0 },
+  { &CL_NoteBook,       &CL_Group,  mgtk_create_notebook_class,       mgtk_delete_notebook_class,       0 },
+  { &CL_ProgressBar,    &CL_Group,  mgtk_create_progressbar_class,    mgtk_delete_progressbar_class,    0 },
+  { &CL_CheckButton,    &CL_Group,  mgtk_create_checkbutton_class,    mgtk_delete_checkbutton_class,    0 },
+  { &CL_ToggleButton,   &CL_Group,  mgtk_create_togglebutton_class,   mgtk_delete_togglebutton_class,   0 },
+  { &CL_RadioButton,    &CL_Group,  mgtk_create_radiobutton_class,    mgtk_delete_radiobutton_class,    0 },
+  { &CL_Button,         &CL_Group,  mgtk_create_button_class,         mgtk_delete_button_class,         0 },
+  { &CL_List,           &CL_Group,  mgtk_create_list_class,           mgtk_delete_list_class,           0 },
+  { &CL_CList,          &CL_Group,  mgtk_create_clist_class,          mgtk_delete_clist_class,          0 },
+  { &CL_Combo,          &CL_Group,  mgtk_create_combo_class,          mgtk_delete_combo_class,          0 },
+  { &CL_Frame,          &CL_Group,  mgtk_create_frame_class,          mgtk_delete_frame_class,          0 },
+  { &CL_Label,          &CL_Group,  mgtk_create_label_class,          mgtk_delete_label_class,          0 },
+  { &CL_Scrolledwindow, &CL_Group,  mgtk_create_scrolledwindow_class, mgtk_delete_scrolledwindow_class, 0 },
+  { NULL, NULL, NULL, NULL, 0 }
+};
+
+static const struct mgtk_class_def *mgtk_find_class(struct MUI_CustomClass **cl) {
+  const struct mgtk_class_def *def;
+
+  for(def=mgtk_classes; def->cl; def++) {
+    if(def->cl == cl) {
+      return def;
+    }
+  }
+  return NULL;
+}
+
+static int mgtk_create_class(const struct mgtk_class_def *def) {
+  gdouble start;
+  int     ret;
+
+  if(*def->cl) {
+    return 1;
+  }
+
+  if(def->parent && !*def->parent) {
+    if(!mgtk_create_class(mgtk_find_class(def->parent))) {
+      return 0;
+    }
+  }
+
+  start=mgtk_profile_start();
+  ret=def->create();
+  mgtk_profile_stop(MGTK_PROFILE_CLASSES, start);
+
+  return ret;
+}
+
+struct IClass *mgtk_need_class(struct MUI_CustomClass **cl) {
+  const struct mgtk_class_def *def;
+
+  def=mgtk_find_class(cl);
+  if(!def) {
+    ErrOut("mgtk_need_class: unknown class %lx\n",cl);
+    return NULL;
+  }
+
+  if(!mgtk_create_class(def)) {
+    ErrOut("mgtk_need_class: unable to create custom class\n");
+    return NULL;
+  }
+
+  return (*cl)->mcc_Class;
+}
+
+gboolean mgtk_is_custom_object(Object *obj) {
+  const struct mgtk_class_def *def;
+  struct IClass *cl;
+
+  if(!obj) {
+    return FALSE;
+  }
+
+  cl=OCLASS(obj);
+  for(def=mgtk_classes; def->cl; def++) {
+    if(*def->cl && (*def->cl)->mcc_Class == cl) {
+      return TRUE;
+    }
+  }
+  return FALSE;
+}
+
+/*********************************
+ * startup profiler
+ *
+ * Set the environment variable GTKMUI_PROFILE to get the time spent
+ * opening libraries, creating classes, registering types and creating
+ * the default style printed after gtk_init and again at exit.
+ *********************************/
+static int     mgtk_profile_on=-1;
+static gdouble mgtk_profile_time[MGTK_PROFILE_LAST];
+static guint   mgtk_profile_calls[MGTK_PROFILE_LAST];
+
+static const char *mgtk_profile_names[MGTK_PROFILE_LAST] = {
+  "libraries",
+  "classes",
+  "types",
+  "style"
+};
+
+gdouble mgtk_profile_start(void) {
+  GTimeVal now;
+
+  if(mgtk_profile_on<0) {
+    mgtk_profile_on=getenv("GTKMUI_PROFILE") ? 1 : 0;
+  }
+  if(!mgtk_profile_on) {
+    return 0;
+  }
+
+  g_get_current_time(&now);
+  return (gdouble) now.tv_sec + (gdouble) now.tv_usec / 1000000.0;
+}
+
+void mgtk_profile_stop(int phase, gdouble start) {
+
+  if(!mgtk_profile_on) {
+    return;
+  }
+
+  mgtk_profile_time[phase]+=mgtk_profile_start() - start;
+  mgtk_profile_calls[phase]++;
+}
+
+void mgtk_profile_report(const char *when) {
+  int i;
+
+  if(mgtk_profile_on<=0) {
+    return;
+  }
+
+  printf("GTK-MUI profile (%s):\n",when);
+  for(i=0; i<MGTK_PROFILE_LAST; i++) {
+    printf("  %-10s %8.2f ms (%u calls)\n",mgtk_profile_names[i],
+           mgtk_profile_time[i] * 1000.0,mgtk_profile_calls[i]);
+  }
+}
+
 BOOL Open_Libs(void ) {
+  const struct mgtk_class_def *def;
+  gdouble start;
+  BOOL    ok;
+  int     all;
 
-  if (open_own_libs()) 
-  if (mgtk_create_application_class())
-  if (mgtk_create_rootgroup_class())
-  if (mgtk_create_group_class())
-  if (mgtk_create_hbox_class())
-  if (mgtk_create_vbox_class())
-  if (mgtk_create_window_class())
-  if (mgtk_create_table_class())
-  if (mgtk_create_spinbutton_class()) 
-  if (mgtk_create_notebook_class()) 
-  if (mgtk_create_progressbar_class()) 
-//  if (mgtk_create_timer_class()) 
-  if (mgtk_create_fixed_class()) 
-  if (mgtk_create_checkbutton_class()) 
-  if (mgtk_create_togglebutton_class()) 
-  if (mgtk_create_radiobutton_class()) 
-  if (mgtk_create_button_class()) 
-  if (mgtk_create_menu_class()) 
-  if (mgtk_create_entry_class()) 
-  if (mgtk_create_toolbar_class()) 
-  if (mgtk_create_list_class()) 
-  if (mgtk_create_clist_class())
-  if (mgtk_create_combo_class()) 
-  if (mgtk_create_scale_class()) 
-  if (mgtk_create_frame_class()) 
-  if (mgtk_create_custom_class()) 
-  if (mgtk_create_dialog_class())
-//  if (mgtk_create_messagedialog_class())
-//  if (mgtk_create_box_class())
-  if (mgtk_create_label_class())
-  if (mgtk_create_scrolledwindow_class())
-  {
-    DebOut("  Open_Libs was successfull\n");
-    return (1);
+  start=mgtk_profile_start();
+  ok=open_own_libs();
+  mgtk_profile_stop(MGTK_PROFILE_LIBS, start);
+
+  all=getenv("GTKMUI_EAGER_CLASSES") ? 1 : 0;
+
+  if(ok) {
+    for(def=mgtk_classes; def->cl; def++) {
+      if((def->eager || all) && !mgtk_create_class(def)) {
+        break;
+      }
+    }
+    if(!def->cl) {
+      DebOut("  Open_Libs was successfull\n");
+      return (1);
+    }
   }
 
   Close_Libs();
@@ -147,41 +305,17 @@ BOOL Open_Libs(void ) {
 
 void Close_Libs(void)
 {
+  const struct mgtk_class_def *def;
 
   DebOut("Close_Libs()\n");
 
-  mgtk_delete_scrolledwindow_class();
-  mgtk_delete_table_class();
-  mgtk_delete_spinbutton_class();
-  mgtk_delete_notebook_class();
-  mgtk_delete_progressbar_class();
-//  mgtk_delete_timer_class();
-//  mgtk_delete_box_class();
-  mgtk_delete_fixed_class();
-  mgtk_delete_dialog_class();
-//  mgtk_delete_messagedialog_class();
-  mgtk_delete_checkbutton_class();
-  mgtk_delete_togglebutton_class();
-  mgtk_delete_radiobutton_class();
-  mgtk_delete_button_class();
-  mgtk_delete_menu_class();
-  mgtk_delete_entry_class();
-  mgtk_delete_toolbar_class();
-  mgtk_delete_clist_class();
-  mgtk_delete_list_class();
-  mgtk_delete_custom_class();
-  DebOut("Close_Libs combo start()\n");
-  mgtk_delete_combo_class();
-  DebOut("Close_Libs combo end()\n");
-  mgtk_delete_scale_class();
-  mgtk_delete_label_class();
-  mgtk_delete_frame_class();
-  mgtk_delete_hbox_class();
-  mgtk_delete_vbox_class();
-  mgtk_delete_group_class();
-  mgtk_delete_rootgroup_class();
-  mgtk_delete_window_class();
-  mgtk_delete_application_class();
+  mgtk_profile_report("exit");
+
+  def=mgtk_classes + G_N_ELEMENTS(mgtk_classes) - 1;
+  while(def != mgtk_classes) {
+    def--;
+    def->delete();
+  }
 
 #ifndef __AMIGAOS4__
   if(!gtk_no_own_libs) {
@@ -248,14 +382,17 @@ if(!gtk_no_own_libs) {
  * init_fundamentals
  *********************************/
 void init_fundamentals() {
+  gdouble start;
 
   DebOut("init_fundamentals()\n");
 
   /* some applications require a valid HOME variable */
   setenv("HOME","PROGDIR:",0); /* should not overwrite, if existing already*/
 
+  start=mgtk_profile_start();
   g_type_init();
   g_signal_init();
+  mgtk_profile_stop(MGTK_PROFILE_TYPES, start);
 }
 
 /*********************************
@@ -372,7 +509,7 @@ gboolean  gtk_init_check(int *argc, char ***argv) {
 
   mgtk_broker_hook.h_Entry = (HOOKFUNC)AROS_ASMSYMNAME(mgtk_broker_func);
 
-  global_mgtk->MuiApp = (APTR) NewObject(CL_Application->mcc_Class, NULL,
+  global_mgtk->MuiApp = (APTR) NewObject(MGTK_CLASS(CL_Application), NULL,
     MA_GtkApplication_Title,     (ULONG) name,
     MUIA_Application_Version ,   (ULONG) name2,
     MUIA_Application_Copyright , (ULONG) "GTK-MUI: LGPL",
@@ -442,6 +579,8 @@ gboolean  gtk_init_check(int *argc, char ***argv) {
     global_mgtk->black_pen=MGTK_PEN_BLACK; /* naja.. */
   }
 
+  mgtk_profile_report("gtk_init");
+
   DebOut("  gtk_init was successfull\n");
 
   return(TRUE);
@@ -886,7 +886,7 @@ static void gtk_label_init (GtkLabel *label) {
   label->mnemonic_widget = NULL;
   label->mnemonic_window = NULL;
   
-  GtkSetObj(GTK_WIDGET(label), NewObject(CL_Label->mcc_Class,NULL,TAG_DONE));
+  GtkSetObj(GTK_WIDGET(label), NewObject(MGTK_CLASS(CL_Label),NULL,TAG_DONE));
   set(GtkObj(label),MA_Widget,(ULONG) label);
 
   DebOut("  new object: %lx\n",GtkObj(label));
@@ -933,9 +933,10 @@ void gtk_label_set_text(GtkLabel *label, const char *str) {
 
   DebOut("gtk_label_set_text(%x,%s)\n",(int) label,str);
 
-  if(str && label->text && !strcmp(str,label->text) && !strcmp(str,(char *) xget(GtkObj(label),MUIA_Text_Contents))) {
+  if(!label->use_markup && str && label->text && !strcmp(str,label->text) && !strcmp(str,(char *) xget(GtkObj(label),MUIA_Text_Contents))) {
     return;
   }
+  label->use_markup=FALSE;
 
   DebOut("1..\n");
 
@@ -963,6 +964,76 @@ void gtk_label_set_text(GtkLabel *label, const char *str) {
   DebOut("gtk_label_set_text: %s\n",GTK_LABEL(label)->text);
 }
 
+/**
+ * gtk_label_set_markup:
+ * @label: a #GtkLabel
+ * @str: a markup string (see <link linkend="PangoMarkupFormat">Pango markup format</link>)
+ *
+ * Parses @str which is marked up with the Pango text markup language,
+ * setting the label's text and attribute list based on the parse results.
+ *
+ * The markup is parsed only once, the label class keeps the styled runs.
+ **/
+void gtk_label_set_markup(GtkLabel *label, const gchar *str) {
+  gchar *markup;
+
+  DebOut("gtk_label_set_markup(%lx,%s)\n",label,str);
+
+  g_return_if_fail (GTK_IS_LABEL (label));
+
+  /* str may be label->label itself */
+  markup=g_strdup(str ? str : "");
+  g_free(label->label);
+  label->label=markup;
+  label->use_markup=TRUE;
+
+  set(GtkObj(label),MA_GtkLabel_PangoText,label->label);
+
+  /* the label class returns the text without markup */
+  g_free(label->text);
+  label->text=g_strdup((gchar *) xget(GtkObj(label),MUIA_Text_Contents));
+}
+
+/**
+ * gtk_label_set_use_markup:
+ * @label: a #GtkLabel
+ * @setting: %TRUE if the label's text should be parsed for markup.
+ *
+ * Sets whether the text of the label contains markup in Pango's text markup
+ * language. See gtk_label_set_markup().
+ **/
+void gtk_label_set_use_markup(GtkLabel *label, gboolean setting) {
+  gchar *str;
+
+  g_return_if_fail (GTK_IS_LABEL (label));
+
+  setting=setting ? TRUE : FALSE;
+  if(label->use_markup == setting) {
+    return;
+  }
+
+  if(setting) {
+    str=g_strdup(label->text);
+    gtk_label_set_markup(label, str);
+    g_free(str);
+  }
+  else {
+    label->use_markup=FALSE;
+    if(label->label) {
+      str=label->label;
+      label->label=NULL;
+      gtk_label_set_text(label, str);
+      g_free(str);
+    }
+  }
+}
+
+gboolean gtk_label_get_use_markup(GtkLabel *label) {
+  g_return_val_if_fail (GTK_IS_LABEL (label), FALSE);
+
+  return label->use_markup;
+}
+
 #if 0
 void gtk_label_set_ellipsize(GtkLabel *label, PangoEllipsizeMode mode) {
 
@@ -355,7 +355,7 @@ static void gtk_list_init (GtkList *list) {
   list->drag_selection = FALSE;
   list->add_mode = FALSE;
 
-  GtkSetObj(GTK_WIDGET(list), NewObject(CL_List->mcc_Class, NULL,MA_Widget,(ULONG) list, TAG_DONE));
+  GtkSetObj(GTK_WIDGET(list), NewObject(MGTK_CLASS(CL_List), NULL,MA_Widget,(ULONG) list, TAG_DONE));
   GTK_MUI(list)->mainclass=CL_AREA; /* ? */
   DebOut("  gtk_list_init done\n");
 }
@@ -324,7 +324,7 @@ gtk_menu_item_new_with_label (const gchar *label)
   DebOut("gtk_accel_label_get_accel_widget: %lx\n",gtk_accel_label_get_accel_widget(GTK_ACCEL_LABEL(accel_label)));
 
 #if 0
-  GTK_MUI(menu_item)->MuiMenu =(APTR) NewObject(CL_Menu->mcc_Class, NULL,
+  GTK_MUI(menu_item)->MuiMenu =(APTR) NewObject(MGTK_CLASS(CL_Menu), NULL,
                                                   MA_Widget,(ULONG) accel_label,
                                                   MUIA_Menuitem_Title,(ULONG) gtk_label_get_text(GTK_LABEL(accel_label)),
                                                   TAG_DONE);
@@ -425,18 +425,21 @@ gtk_menu_item_detacher (GtkWidget     *widget,
  * +----------+
  ******************************************/
 
-GtkWidget* mgtk_get_accel(GtkWidget *w) {
-  GList *i=NULL;
-  struct List *list;
-  struct Node *state;
-  Object *o;
-  GtkWidget *accel;
+/******************************************
+ * mgtk_get_accel returns the accel widget
+ * of a menu item: its direct child. This is
+ * the object set_submenu attaches the
+ * context menu to, and the one
+ * mgtk_get_accel_parent (classes/group.c)
+ * expects right below the menu item.
+ *
+ * GtkBin already keeps the child pointer up
+ * to date on add and remove, so there is no
+ * need to walk the MUI child list.
+ ******************************************/
 
-   /* seems not to work..
-  i=gtk_container_get_children(GTK_CONTAINER(menu_item));
-    *
-    * try the mui way ;) :
-    */
+GtkWidget* mgtk_get_accel(GtkWidget *w) {
+  GtkWidget *child;
 
   DebOut("mgtk_get_accel(%lx)\n",w);
 
@@ -444,25 +447,57 @@ GtkWidget* mgtk_get_accel(GtkWidget *w) {
     return w;
   }
 
-  list=(struct List *) xget(GtkObj(w),MUIA_Group_ChildList);
-  state = list->lh_Head;
-  while ( (o = NextObject( &state )) ) {
-    DebOut(" child: %lx\n",o);
-    i=g_list_append(i,(GtkWidget *) xget(o,MA_Widget));
+  if(!GTK_IS_BIN(w)) {
+    ErrOut("mgtk_get_accel: %lx is no menu item !?\n",w);
+    return NULL;
   }
 
-  if(!i) {
+  child=GTK_BIN(w)->child;
+  if(!child) {
     ErrOut("GTK_CONTAINER(menu_item) has no children !?\n");
     return NULL;
   }
-  if(g_list_length(i)>1) {
-    ErrOut("GTK_CONTAINER(menu_item) has too many children (%d)!?\n",g_list_length(i));
+
+  return child;
+}
+
+/******************************************
+ * mgtk_get_accel_text returns the text of
+ * an accel widget: its own, if it is a
+ * label, else the one of the first label
+ * inside it (items with an image and a
+ * label, for example).
+ ******************************************/
+
+const gchar *mgtk_get_accel_text(GtkWidget *accel) {
+  GList *children;
+  GList *i;
+  const gchar *text;
+
+  if(!accel) {
+    return NULL;
+  }
+
+  if(GTK_IS_LABEL(accel)) {
+    return gtk_label_get_text(GTK_LABEL(accel));
+  }
+
+  if(!GTK_IS_CONTAINER(accel)) {
+    ErrOut("mgtk_get_accel_text: accel widget %lx has no label !?\n",accel);
+    return NULL;
   }
 
-  accel=(GtkWidget *) i->data;
-  g_list_free(i);
+  text=NULL;
+  children=gtk_container_get_children(GTK_CONTAINER(accel));
+  for(i=children;i;i=i->next) {
+    if(GTK_IS_LABEL(i->data)) {
+      text=gtk_label_get_text(GTK_LABEL(i->data));
+      break;
+    }
+  }
+  g_list_free(children);
 
-  return accel;
+  return text;
 }
 
 void gtk_menu_item_set_submenu (GtkMenuItem *menu_item, GtkWidget   *submenu) {
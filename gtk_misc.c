@@ -158,7 +158,7 @@ static void gtk_misc_init (GtkMisc *misc) {
   misc->xpad = 0;
   misc->ypad = 0;
 
-  GtkSetObj(GTK_WIDGET(misc), NewObject(CL_Custom->mcc_Class, NULL,MA_Widget,(ULONG) misc,TAG_DONE));
+  GtkSetObj(GTK_WIDGET(misc), NewObject(MGTK_CLASS(CL_Custom), NULL,MA_Widget,(ULONG) misc,TAG_DONE));
 
   DebOut("  misc obj: %lx\n",GtkObj(misc));
 
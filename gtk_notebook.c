@@ -693,7 +693,7 @@ GtkWidget* gtk_notebook_new(void) {
 
   ret=g_object_new (GTK_TYPE_NOTEBOOK, NULL);
 
-  note = (APTR) NewObject(CL_NoteBook->mcc_Class, NULL,MA_Widget,(ULONG) ret,TAG_DONE);
+  note = (APTR) NewObject(MGTK_CLASS(CL_NoteBook), NULL,MA_Widget,(ULONG) ret,TAG_DONE);
 
   if((!ret)||(!note)) {
     ErrOut("gtk_notebook_new: unable to create new notebook\n");
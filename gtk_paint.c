@@ -84,15 +84,14 @@ void        gdk_gc_set_clip_rectangle       (GdkGC *gc,
 static GdkGC *create_aa_gc (GdkWindow *window, GtkStyle *style, GtkStateType state_type) {
 
   GdkColor aa_color;
-  GdkGC *gc = gdk_gc_new (window);
 
   aa_color.red = (style->fg[state_type].red + style->bg[state_type].red) / 2;
   aa_color.green = (style->fg[state_type].green + style->bg[state_type].green) / 2;
   aa_color.blue = (style->fg[state_type].blue + style->bg[state_type].blue) / 2;
-  
-  gdk_gc_set_rgb_fg_color (gc, &aa_color);
+  aa_color.havepen = 0;
+  aa_color.pen = 0;
 
-  return gc;
+  return mgtk_gc_get (&aa_color, GDK_COPY, 0, GDK_LINE_SOLID, GDK_CAP_BUTT, GDK_JOIN_MITER);
 }
 
 
@@ -358,211 +357,177 @@ calculate_arrow_geometry (GtkArrowType  arrow_type,
   *width = w;
 }
 
-static void
-rgb_to_hls (gdouble *r,
-            gdouble *g,
-            gdouble *b)
-{
-  gdouble min;
-  gdouble max;
-  gdouble red;
-  gdouble green;
-  gdouble blue;
-  gdouble h, l, s;
-  gdouble delta;
-  
-  red = *r;
-  green = *g;
-  blue = *b;
-  
-  if (red > green)
-    {
-      if (red > blue)
-        max = red;
-      else
-        max = blue;
-      
-      if (green < blue)
-        min = green;
-      else
-        min = blue;
-    }
-  else
-    {
-      if (green > blue)
-        max = green;
-      else
-        max = blue;
-      
-      if (red < blue)
-        min = red;
-      else
-        min = blue;
-    }
-  
-  l = (max + min) / 2;
-  s = 0;
-  h = 0;
-  
-  if (max != min)
-    {
-      if (l <= 0.5)
-        s = (max - min) / (max + min);
-      else
-        s = (max - min) / (2 - max - min);
-      
-      delta = max -min;
-      if (red == max)
-        h = (green - blue) / delta;
-      else if (green == max)
-        h = 2 + (blue - red) / delta;
-      else if (blue == max)
-        h = 4 + (red - green) / delta;
-      
-      h *= 60;
-      if (h < 0.0)
-        h += 360;
-    }
-  
-  *r = h;
-  *g = l;
-  *b = s;
+/* gtk_style_shade
+ *
+ * Scales lightness and saturation of a colour by k. This used to be a 
+ * RGB->HLS->RGB round trip in doubles. As shading keeps the hue, the
+ * channel, which was the maximum, becomes m2, the minimum becomes m1 and
+ * the middle one keeps its relative position in between. So we do not
+ * need the hue at all and can stay in 64 bit fixed point (2^30 == 1.0).
+ * The result differs by at most one LSB from the old double version.
+ *
+ * Results are remembered in a small direct mapped cache, as the same
+ * few colours are shaded over and over again.
+ */
+
+#define SHADE_ONE         ((gint64) 1 << 30)
+#define SHADE_K_SHIFT     24
+#define SHADE_CACHE_SIZE  64
+
+typedef struct {
+  guint16 red, green, blue;
+  guint32 k;
+  GdkColor shaded;
+  gboolean valid;
+} ShadeCacheEntry;
+
+static ShadeCacheEntry shade_cache[SHADE_CACHE_SIZE];
+
+static guint16 shade_channel (gint64 c, gint64 min, gint64 max, gint64 m1, gint64 m2) {
+
+  if (max == min)
+    return (guint16) ((m1 * 65535) >> 30);
+  if (c == max)
+    return (guint16) ((m2 * 65535) >> 30);
+  if (c == min)
+    return (guint16) ((m1 * 65535) >> 30);
+
+  return (guint16) (((m1 + (m2 - m1) * (c - min) / (max - min)) * 65535) >> 30);
 }
 
-static void
-hls_to_rgb (gdouble *h,
-            gdouble *l,
-            gdouble *s)
-{
-  gdouble hue;
-  gdouble lightness;
-  gdouble saturation;
-  gdouble m1, m2;
-  gdouble r, g, b;
-  
-  lightness = *l;
-  saturation = *s;
-  
-  if (lightness <= 0.5)
-    m2 = lightness * (1 + saturation);
+static void shade_color (const GdkColor *a, GdkColor *b, guint32 k) {
+  gint64 max, min, sum, delta;
+  gint64 l, s, m1, m2;
+
+  max = a->red;
+  if (a->green > max)
+    max = a->green;
+  if (a->blue > max)
+    max = a->blue;
+
+  min = a->red;
+  if (a->green < min)
+    min = a->green;
+  if (a->blue < min)
+    min = a->blue;
+
+  sum = max + min;
+  delta = max - min;
+
+  l = sum * SHADE_ONE / (2 * 65535);
+  if (delta == 0)
+    s = 0;
+  else if (sum <= 65535)
+    s = delta * SHADE_ONE / sum;
   else
-    m2 = lightness + saturation - lightness * saturation;
-  m1 = 2 * lightness - m2;
-  
-  if (saturation == 0)
-    {
-      *h = lightness;
-      *l = lightness;
-      *s = lightness;
-    }
+    s = delta * SHADE_ONE / (2 * 65535 - sum);
+
+  l = (l * k) >> SHADE_K_SHIFT;
+  if (l > SHADE_ONE)
+    l = SHADE_ONE;
+
+  s = (s * k) >> SHADE_K_SHIFT;
+  if (s > SHADE_ONE)
+    s = SHADE_ONE;
+
+  if (l <= SHADE_ONE / 2)
+    m2 = l + ((l * s) >> 30);
   else
+    m2 = l + s - ((l * s) >> 30);
+  m1 = 2 * l - m2;
+
+  b->red   = shade_channel (a->red,   min, max, m1, m2);
+  b->green = shade_channel (a->green, min, max, m1, m2);
+  b->blue  = shade_channel (a->blue,  min, max, m1, m2);
+}
+
+void
+_gtk_style_shade (GdkColor *a,
+                  GdkColor *b,
+                  gdouble   k)
+{
+  ShadeCacheEntry *entry;
+  guint32 kfix;
+  guint slot;
+
+  if (k < 0.0)
+    k = 0.0;
+  kfix = (guint32) (k * (1 << SHADE_K_SHIFT) + 0.5);
+
+  slot = ((a->red >> 8) * 31 + (a->green >> 8) * 17 + (a->blue >> 8) + kfix) % SHADE_CACHE_SIZE;
+  entry = &shade_cache[slot];
+
+  if (!entry->valid ||
+      entry->k != kfix ||
+      entry->red != a->red || entry->green != a->green || entry->blue != a->blue)
     {
-      hue = *h + 120;
-      while (hue > 360)
-        hue -= 360;
-      while (hue < 0)
-        hue += 360;
-      
-      if (hue < 60)
-        r = m1 + (m2 - m1) * hue / 60;
-      else if (hue < 180)
-        r = m2;
-      else if (hue < 240)
-        r = m1 + (m2 - m1) * (240 - hue) / 60;
-      else
-        r = m1;
-      
-      hue = *h;
-      while (hue > 360)
-        hue -= 360;
-      while (hue < 0)
-        hue += 360;
-      
-      if (hue < 60)
-        g = m1 + (m2 - m1) * hue / 60;
-      else if (hue < 180)
-        g = m2;
-      else if (hue < 240)
-        g = m1 + (m2 - m1) * (240 - hue) / 60;
-      else
-        g = m1;
-      
-      hue = *h - 120;
-      while (hue > 360)
-        hue -= 360;
-      while (hue < 0)
-        hue += 360;
-      
-      if (hue < 60)
-        b = m1 + (m2 - m1) * hue / 60;
-      else if (hue < 180)
-        b = m2;
-      else if (hue < 240)
-        b = m1 + (m2 - m1) * (240 - hue) / 60;
-      else
-        b = m1;
-      
-      *h = r;
-      *l = g;
-      *s = b;
+      entry->red = a->red;
+      entry->green = a->green;
+      entry->blue = a->blue;
+      entry->k = kfix;
+      shade_color (a, &entry->shaded, kfix);
+      entry->valid = TRUE;
     }
+
+  b->red = entry->shaded.red;
+  b->green = entry->shaded.green;
+  b->blue = entry->shaded.blue;
 }
+
 static void
-gtk_style_shade (GdkColor *a,
-                 GdkColor *b,
-                 gdouble   k)
+shade_darken (GdkColor *color, GdkColor *shaded, gint darken_count)
 {
-  gdouble red;
-  gdouble green;
-  gdouble blue;
-  
-  red = (gdouble) a->red / 65535.0;
-  green = (gdouble) a->green / 65535.0;
-  blue = (gdouble) a->blue / 65535.0;
-  
-  rgb_to_hls (&red, &green, &blue);
-  
-  green *= k;
-  if (green > 1.0)
-    green = 1.0;
-  else if (green < 0.0)
-    green = 0.0;
-  
-  blue *= k;
-  if (blue > 1.0)
-    blue = 1.0;
-  else if (blue < 0.0)
-    blue = 0.0;
-  
-  hls_to_rgb (&red, &green, &blue);
-  
-  b->red = red * 65535.0;
-  b->green = green * 65535.0;
-  b->blue = blue * 65535.0;
-}
+  GdkColor src = *color;
 
+  *shaded = *color;
+  while (darken_count)
+    {
+      _gtk_style_shade (&src, shaded, 0.93);
+      src = *shaded;
+      --darken_count;
+    }
+}
 
+/* shaded gcs of a colour come from the gc pool and must be
+ * released with mgtk_gc_release
+ */
 static GdkGC*
 get_darkened_gc (GdkWindow *window,
                  GdkColor  *color,
                  gint       darken_count)
 {
-  GdkColor src = *color;
-  GdkColor shaded = *color;
-  GdkGC *gc;
-  
-  gc = gdk_gc_new (window);
+  GdkColor shaded;
 
-  while (darken_count)
-    {
-      gtk_style_shade (&src, &shaded, 0.93);
-      src = shaded;
-      --darken_count;
-    }
-   
-  gdk_gc_set_rgb_fg_color (gc, &shaded);
+  shade_darken (color, &shaded, darken_count);
+  shaded.havepen = 0;
+
+  return mgtk_gc_get (&shaded, GDK_COPY, 0, GDK_LINE_SOLID, GDK_CAP_BUTT, GDK_JOIN_MITER);
+}
+
+/* the darkened base gcs and the aa gcs only depend on the style,
+ * so they are created once and kept until the style goes away
+ * (see style_release_gcs in gtk_style.c)
+ */
+static GdkGC*
+get_style_darkened_gc (GtkStyle     *style,
+                       GtkStateType  state_type,
+                       gint          darken_count)
+{
+  if (!style->mgtk_darkened_gc[state_type][darken_count])
+    style->mgtk_darkened_gc[state_type][darken_count] =
+      get_darkened_gc (NULL, &style->base[state_type], darken_count);
+
+  return style->mgtk_darkened_gc[state_type][darken_count];
+}
+
+static GdkGC*
+get_style_aa_gc (GtkStyle     *style,
+                 GtkStateType  state_type)
+{
+  if (!style->mgtk_aa_gc[state_type])
+    style->mgtk_aa_gc[state_type] = create_aa_gc (NULL, style, state_type);
 
-  return gc;
+  return style->mgtk_aa_gc[state_type];
 }
 
 static void gtk_default_draw_arrow (GtkStyle      *style,
@@ -1562,8 +1527,6 @@ gtk_default_draw_check (GtkStyle      *style,
     }
   }
   else {
-    GdkGC *free_me = NULL;
-      
     GdkGC *base_gc;
     GdkGC *text_gc;
     GdkGC *aa_gc;
@@ -1574,14 +1537,13 @@ gtk_default_draw_check (GtkStyle      *style,
     if (detail && strcmp (detail, "check") == 0) { /* Menu item */
       text_gc = style->fg_gc[state_type];
       base_gc = style->bg_gc[state_type];
-      aa_gc = free_me = create_aa_gc (window, style, state_type);
+      aa_gc = get_style_aa_gc (style, state_type);
     }
     else {
       if (state_type == GTK_STATE_ACTIVE) {
         text_gc = style->fg_gc[state_type];
         base_gc = style->bg_gc[state_type];
-        aa_gc=create_aa_gc (window, style, state_type);
-        free_me=aa_gc;
+        aa_gc = get_style_aa_gc (style, state_type);
       }
       else {
         text_gc = style->text_gc[state_type];
@@ -1601,10 +1563,6 @@ gtk_default_draw_check (GtkStyle      *style,
     else if (shadow_type == GTK_SHADOW_ETCHED_IN) { /* inconsistent */
       draw_part (window, text_gc, area, x, y, CHECK_INCONSISTENT_TEXT);
     }
-
-    if (free_me) {
-      g_object_unref ((GObject *) free_me);
-    }
   }
 }
 
@@ -1948,12 +1906,11 @@ gtk_default_draw_flat_box (GtkStyle      *style,
 
           if (color) {
             freeme = get_darkened_gc (window, color, 1);
+            gc1 = freeme;
             gdk_color_free (color);
           }
           else
-            freeme = get_darkened_gc (window, &style->base[state_type], 1);
-
-          gc1 = freeme;
+            gc1 = get_style_darkened_gc (style, state_type, 1);
         }
       }
       else if (!strcmp ("cell_even_sorted", detail) ||
@@ -1973,8 +1930,7 @@ gtk_default_draw_flat_box (GtkStyle      *style,
           gdk_color_free (color);
         }
         else {
-          freeme = get_darkened_gc (window, &style->base[state_type], 1);
-          gc1 = freeme;
+          gc1 = get_style_darkened_gc (style, state_type, 1);
         }
       }
       else if (!strcmp ("cell_odd_ruled_sorted", detail)) {
@@ -1993,12 +1949,11 @@ gtk_default_draw_flat_box (GtkStyle      *style,
 
           if (color) {
             freeme = get_darkened_gc (window, color, 2);
+            gc1 = freeme;
             gdk_color_free (color);
           }
           else
-            freeme = get_darkened_gc (window, &style->base[state_type], 2);
-
-          gc1 = freeme;
+            gc1 = get_style_darkened_gc (style, state_type, 2);
         }
       }
       else
@@ -2011,9 +1966,9 @@ gtk_default_draw_flat_box (GtkStyle      *style,
   }
 
   DebOut(" gc1=%lx:\n",gc1);
-  DebOut("  colormap->colors->red=%lx\n",gc1->colormap->colors->red);
-  DebOut("  colormap->colors->blue=%lx\n",gc1->colormap->colors->blue);
-  DebOut("  colormap->colors->green=%lx\n",gc1->colormap->colors->green);
+  DebOut("  mgtk_color.red=%lx\n",gc1->mgtk_color.red);
+  DebOut("  mgtk_color.blue=%lx\n",gc1->mgtk_color.blue);
+  DebOut("  mgtk_color.green=%lx\n",gc1->mgtk_color.green);
 
 
   if (!style->bg_pixmap[state_type] || gc1 != style->bg_gc[state_type] || TRUE /*|| GDK_IS_PIXMAP (window)*/) {
@@ -2042,7 +1997,7 @@ gtk_default_draw_flat_box (GtkStyle      *style,
   DebOut(" running..\n");
 
   if (freeme) {
-    g_object_unref ((GObject *) freeme);
+    mgtk_gc_release (freeme);
   }
 }
 /**
@@ -2313,8 +2268,6 @@ gtk_default_draw_option (GtkStyle      *style,
 #endif
     }
   else {
-    GdkGC *free_me = NULL;
-      
     GdkGC *base_gc;
     GdkGC *text_gc;
     GdkGC *aa_gc;
@@ -2325,13 +2278,13 @@ gtk_default_draw_option (GtkStyle      *style,
     if (detail && strcmp (detail, "option") == 0)	{ /* Menu item */
       text_gc = style->fg_gc[state_type];
       base_gc = style->bg_gc[state_type];
-      aa_gc = free_me = create_aa_gc (window, style, state_type);
+      aa_gc = get_style_aa_gc (style, state_type);
     }
     else {
       if (state_type == GTK_STATE_ACTIVE) {
         text_gc = style->fg_gc[state_type];
         base_gc = style->bg_gc[state_type];
-        aa_gc = free_me = create_aa_gc (window, style, state_type);
+        aa_gc = get_style_aa_gc (style, state_type);
       }
       else {
         text_gc = style->text_gc[state_type];
@@ -2358,10 +2311,6 @@ gtk_default_draw_option (GtkStyle      *style,
         draw_part (window, aa_gc, area, x, y, RADIO_INCONSISTENT_AA);
       }
     }
-
-    if (free_me) {
-      g_object_unref ((GObject *) free_me);
-    }
   }
 }
 
@@ -290,7 +290,7 @@ static void gtk_progress_bar_init (GtkProgressBar *pbar) {
 #endif
   pbar->ellipsize = 0;
 
-  GtkSetObj(GTK_WIDGET(pbar), NewObject(CL_ProgressBar->mcc_Class, NULL,MA_Widget,(ULONG) pbar,TAG_DONE));
+  GtkSetObj(GTK_WIDGET(pbar), NewObject(MGTK_CLASS(CL_ProgressBar), NULL,MA_Widget,(ULONG) pbar,TAG_DONE));
 
 }
 
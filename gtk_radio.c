@@ -218,7 +218,7 @@ GtkWidget *gtk_radio_button_new_with_label( GSList *group, const gchar  *label )
   GTK_BUTTON(ret)->label_text=g_strdup(label);
 
 
-  radio=NewObject(CL_RadioButton->mcc_Class, NULL,MA_Widget,(ULONG) ret,MA_Radio_Label,(ULONG) label,TAG_DONE);
+  radio=NewObject(MGTK_CLASS(CL_RadioButton), NULL,MA_Widget,(ULONG) ret,MA_Radio_Label,(ULONG) label,TAG_DONE);
       
   GtkSetObj(GTK_WIDGET(ret), radio);
 
@@ -610,12 +610,14 @@ gtk_range_set_adjustment (GtkRange      *range, GtkAdjustment *adjustment) {
       g_signal_handlers_disconnect_by_func (range->adjustment,
 						gtk_range_adjustment_value_changed,
 						range);
+      mgtk_adjustment_unbind (range->adjustment, GTK_WIDGET (range));
       g_object_unref (range->adjustment);
     }
 
     range->adjustment = adjustment;
     g_object_ref (adjustment);
     gtk_object_sink (GTK_OBJECT (adjustment));
+    mgtk_adjustment_bind (adjustment, GTK_WIDGET (range), MGTK_VIEW_RANGE);
     
     g_signal_connect (adjustment, "changed",
       G_CALLBACK (gtk_range_adjustment_changed),
@@ -684,6 +684,34 @@ _gtk_scale_format_value (GtkScale *scale,
                             value);
 }
 
+/* GTK-MUI private: like _gtk_scale_format_value, but into a buffer of
+ * the caller, so classes/scale.c does not allocate for every step
+ */
+void
+mgtk_scale_format_value (GtkScale *scale,
+                         gdouble   value,
+                         gchar    *buf,
+                         gsize     size)
+{
+  gchar *fmt = NULL;
+
+  if (GTK_SCALE_GET_CLASS (scale)->format_value ||
+      g_signal_has_handler_pending (scale, signals[FORMAT_VALUE], 0, FALSE))
+    g_signal_emit (scale,
+                   signals[FORMAT_VALUE],
+                   0,
+                   value,
+                   &fmt);
+
+  if (fmt)
+    {
+      g_strlcpy (buf, fmt, size);
+      g_free (fmt);
+    }
+  else
+    g_snprintf (buf, size, "%0.*f", scale->digits, value);
+}
+
 static void
 gtk_scale_finalize (GObject *object)
 {
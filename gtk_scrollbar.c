@@ -350,8 +350,12 @@ GtkWidget *mgtk_scale_new(GtkAdjustment *adjustment, gint vert) {
   }
 #endif
 
-  /* remember all scales created with this adjustment */
-  g_slist_append(GTK_MUI(adjustment)->remember,ret);
+  /* Not bound to the adjustment as a view (see mgtk_adjustment_bind):
+   * these old style scales keep their value in the GtkWidget fields and
+   * their MuiObject is the group around the slider, so the range view
+   * can't push into them. The old remember append threw its result away,
+   * so they never got updates from the adjustment anyway.
+   */
 
   return ret;
 }
@@ -405,8 +409,9 @@ GtkWidget *mgtk_scroll_new(GtkAdjustment *adjustment, gint vert) {
     }
   }
 
-  /* remember all scrollbars created with this adjustment */
-  g_slist_append(GTK_MUI(adjustment)->remember,ret);
+  /* not bound to the adjustment, a MUI scrollbar has no
+   * MUIA_Numeric_Value for the range view (see mgtk_scale_new)
+   */
 
   return ret;
 }
@@ -487,11 +492,13 @@ void gtk_range_set_adjustment(GtkRange *range, GtkAdjustment *adjustment) {
 
   if(range->adjustment) {
     DebOut("  range had already an adjustment\n");
+    mgtk_adjustment_unbind(range->adjustment,GTK_WIDGET(range));
     g_object_unref(G_OBJECT(range->adjustment));
   }
 
   range->adjustment=adjustment;
   g_object_ref(G_OBJECT(adjustment));
+  mgtk_adjustment_bind(adjustment,GTK_WIDGET(range),MGTK_VIEW_RANGE);
   /* hmm..
   range->round_digits=adjustment->digits;
   */
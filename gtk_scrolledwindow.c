@@ -369,7 +369,7 @@ gtk_scrolled_window_init (GtkScrolledWindow *scrolled_window)
   scrolled_window->focus_out = FALSE;
   scrolled_window->window_placement = GTK_CORNER_TOP_LEFT;
 
-  GtkSetObj(GTK_WIDGET(scrolled_window), NewObject(CL_Scrolledwindow->mcc_Class, NULL,
+  GtkSetObj(GTK_WIDGET(scrolled_window), NewObject(MGTK_CLASS(CL_Scrolledwindow), NULL,
                                                         MA_Widget, (ULONG) scrolled_window,
                                                         TAG_DONE));
 
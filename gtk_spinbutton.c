@@ -526,16 +526,12 @@ static void gtk_spin_button_init (GtkSpinButton *spin_button) {
   gtk_spin_button_set_adjustment (spin_button,
 	  (GtkAdjustment*) gtk_adjustment_new (0, 0, 0, 0, 0, 0));
 
-  GtkSetObj(GTK_WIDGET(spin_button), NewObject(CL_SpinButton->mcc_Class, NULL,MA_Widget,(ULONG) spin_button,TAG_DONE));
+  GtkSetObj(GTK_WIDGET(spin_button), NewObject(MGTK_CLASS(CL_SpinButton), NULL,MA_Widget,(ULONG) spin_button,TAG_DONE));
 
   value=g_strdup_printf("%f",GTK_SPIN_BUTTON(spin_button)->adjustment->value);
   set(GtkObj(spin_button),MA_Spin_Value,(ULONG) value);
   g_free(value);
 
-  /* add this Widget to the adjustment */
-  GTK_MUI(spin_button->adjustment)->remember=g_slist_append(GTK_MUI(spin_button->adjustment)->remember,spin_button);
-
-
 }
 
 static void
@@ -1302,15 +1298,14 @@ gtk_spin_button_value_changed (GtkAdjustment *adjustment,
 			       GtkSpinButton *spin_button)
 {
   gboolean return_val;
-  char *value;
 
   g_return_if_fail (GTK_IS_ADJUSTMENT (adjustment));
 
-  DebOut("gtk_spin_button_value_changed(%lx,%lx)\n");
+  DebOut("gtk_spin_button_value_changed(%lx,%lx)\n",adjustment,spin_button);
 
-  value=g_strdup_printf("%f",spin_button->adjustment->value);
-  set(GtkObj(spin_button),MA_Spin_Value,(ULONG) value);
-  g_free(value);
+  /* the MUI object got the new text already, the adjustment pushes
+   * it to all of its views (see mgtk_adjustment_bind)
+   */
 
   return_val = FALSE;
   g_signal_emit (spin_button, spinbutton_signals[OUTPUT], 0, &return_val);
@@ -1774,6 +1769,7 @@ gtk_spin_button_set_adjustment (GtkSpinButton *spin_button,
 	  g_signal_handlers_disconnect_by_func (spin_button->adjustment,
 						adjustment_changed_cb,
 						spin_button);
+	  mgtk_adjustment_unbind (spin_button->adjustment, GTK_WIDGET (spin_button));
 	  g_object_unref (spin_button->adjustment);
         }
       spin_button->adjustment = adjustment;
@@ -1781,6 +1777,7 @@ gtk_spin_button_set_adjustment (GtkSpinButton *spin_button,
         {
 	  g_object_ref (adjustment);
 	  gtk_object_sink (GTK_OBJECT (adjustment));
+	  mgtk_adjustment_bind (adjustment, GTK_WIDGET (spin_button), MGTK_VIEW_SPIN_BUTTON);
 	  g_signal_connect (adjustment, "value_changed",
 			    G_CALLBACK (gtk_spin_button_value_changed),
 			    spin_button);
@@ -1832,6 +1829,7 @@ gtk_spin_button_set_digits (GtkSpinButton *spin_button,
   if (spin_button->digits != digits)
     {
       spin_button->digits = digits;
+      mgtk_adjustment_update_view (spin_button->adjustment, GTK_WIDGET (spin_button));
       gtk_spin_button_value_changed (spin_button->adjustment, spin_button);
       g_object_notify (G_OBJECT (spin_button), "digits");
       
@@ -43,6 +43,11 @@
 
 /* WARNING: Styles are not "full real" Gtk Objects..*/
 
+static void gtk_style_class_init(GtkStyleClass *klass);
+static void gtk_style_finalize(GObject *object);
+
+static GObjectClass *parent_class = NULL;
+
 GType gtk_style_get_type (void) {
 
   static GType style_type = 0;
@@ -56,8 +61,7 @@ GType gtk_style_get_type (void) {
         sizeof (GtkStyleClass),
         (GBaseInitFunc) NULL,
         (GBaseFinalizeFunc) NULL,
-        /*(GClassInitFunc) gtk_style_class_init,*/
-        (GClassInitFunc) NULL,
+        (GClassInitFunc) gtk_style_class_init,
         NULL,           /* class_finalize */
         NULL,           /* class_data */
         sizeof (GtkStyle),
@@ -72,78 +76,330 @@ GType gtk_style_get_type (void) {
   return style_type;
 }
 
-/*************** OLD ***********************************************************/
-/* TODO: move gdk functions to gdk/ */
+static void gtk_style_class_init(GtkStyleClass *klass) {
+  GObjectClass *object_class = G_OBJECT_CLASS (klass);
 
-static GdkGC *allocgc() {
-  GdkGC *ret;
+  parent_class = g_type_class_peek_parent (klass);
 
-  ret=g_new0(GdkGC,1);
+  object_class->finalize = gtk_style_finalize;
+}
 
-  ret->colormap=g_new0(GdkColormap,1);
+/*************** style gcs ***************************************************/
 
-  ret->colormap->colors=g_new0(GdkColor,1);
+#define LIGHTNESS_MULT  1.3
+#define DARKNESS_MULT   0.7
 
-  ret->colormap->colors->havepen=0;
+/* all gcs of a style come from the shared gc pool (gdk/gdkgc.c), 
+ * so styles with the same colours use the very same gcs
+ */
+static GdkGC *style_gc(GdkColor *color) {
 
-  return ret;
+  return mgtk_gc_get(color, GDK_COPY, 0, GDK_LINE_SOLID, GDK_CAP_BUTT, GDK_JOIN_MITER);
 }
 
-static GdkGC *newgc(gint defaultpen) {
-  GdkGC *ret;
+static void style_release_gcs(GtkStyle *style) {
+  int i;
+  int j;
+
+  for(i=0;i<5;i++) {
+    mgtk_gc_release(style->fg_gc[i]);
+    mgtk_gc_release(style->bg_gc[i]);
+    mgtk_gc_release(style->light_gc[i]);
+    mgtk_gc_release(style->dark_gc[i]);
+    mgtk_gc_release(style->mid_gc[i]);
+    mgtk_gc_release(style->text_gc[i]);
+    mgtk_gc_release(style->base_gc[i]);
+    mgtk_gc_release(style->text_aa_gc[i]);
+    style->fg_gc[i]=NULL;
+    style->bg_gc[i]=NULL;
+    style->light_gc[i]=NULL;
+    style->dark_gc[i]=NULL;
+    style->mid_gc[i]=NULL;
+    style->text_gc[i]=NULL;
+    style->base_gc[i]=NULL;
+    style->text_aa_gc[i]=NULL;
+  }
+  mgtk_gc_release(style->white_gc);
+  mgtk_gc_release(style->black_gc);
+  style->white_gc=NULL;
+  style->black_gc=NULL;
+
+  for(i=0;i<5;i++) {
+    mgtk_gc_release(style->mgtk_aa_gc[i]);
+    style->mgtk_aa_gc[i]=NULL;
+    for(j=0;j<3;j++) {
+      mgtk_gc_release(style->mgtk_darkened_gc[i][j]);
+      style->mgtk_darkened_gc[i][j]=NULL;
+    }
+  }
+}
 
-  ret=allocgc();
+/* like gtk_style_real_realize: light, dark and mid follow bg.
+ * Pen based colours (the default style) are left alone.
+ */
+static void style_realize_colors(GtkStyle *style) {
+  int i;
 
-  ret->colormap->colors->pen=defaultpen;
-  ret->colormap->colors->havepen=1;
+  for(i=0;i<5;i++) {
+    if(style->bg[i].havepen) {
+      continue;
+    }
 
-  return ret;
+    _gtk_style_shade(&style->bg[i], &style->light[i], LIGHTNESS_MULT);
+    _gtk_style_shade(&style->bg[i], &style->dark[i], DARKNESS_MULT);
+    style->light[i].havepen=0;
+    style->dark[i].havepen=0;
+
+    style->mid[i].red=(style->light[i].red + style->dark[i].red) / 2;
+    style->mid[i].green=(style->light[i].green + style->dark[i].green) / 2;
+    style->mid[i].blue=(style->light[i].blue + style->dark[i].blue) / 2;
+    style->mid[i].havepen=0;
+  }
 }
 
-GdkGC *gdk_gc_new(GdkWindow *window) {
-  GdkGC *ret;
+/* (re)create the gcs of a style according to its colours */
+static void style_realize_gcs(GtkStyle *style) {
+  int i;
+
+  style_release_gcs(style);
+
+  for(i=0;i<5;i++) {
+    style->fg_gc[i]=style_gc(&style->fg[i]);
+    style->bg_gc[i]=style_gc(&style->bg[i]);
+    style->light_gc[i]=style_gc(&style->light[i]);
+    style->dark_gc[i]=style_gc(&style->dark[i]);
+    style->mid_gc[i]=style_gc(&style->mid[i]);
+    style->text_gc[i]=style_gc(&style->text[i]);
+    style->base_gc[i]=style_gc(&style->base[i]);
+    style->text_aa_gc[i]=style_gc(&style->text_aa[i]);
+  }
+  style->white_gc=style_gc(&style->white);
+  style->black_gc=style_gc(&style->black);
+}
 
-  ret=allocgc();
-  ret->colormap->colors->havepen=0;
+/*************** style cache *************************************************/
 
-  return ret;
+/* Attached styles are shared: gtk_style_attach returns an already 
+ * attached style with the same colours, font and thickness, if there 
+ * is one. Shared styles must not be modified, use gtk_style_copy.
+ * The cache does not hold a reference, styles remove themselves 
+ * in gtk_style_finalize.
+ *
+ * The cache is keyed by a copy of the fields taken at attach time
+ * (style->mgtk_cache_key), not by the style itself. So a style changed
+ * behind our back still finds and removes its own entry, and
+ * gtk_style_attach notices the change and copies the style, see
+ * style_unshare.
+ */
+static GHashTable *style_cache=NULL;
+
+typedef struct {
+  GdkColor fg[5];
+  GdkColor bg[5];
+  GdkColor light[5];
+  GdkColor dark[5];
+  GdkColor mid[5];
+  GdkColor text[5];
+  GdkColor base[5];
+  GdkColor text_aa[5];
+  GdkColor black;
+  GdkColor white;
+  PangoFontDescription *font_desc;
+  gint xthickness;
+  gint ythickness;
+} StyleKey;
+
+static guint color_hash(const GdkColor *color) {
+
+  if(color->havepen) {
+    return 0x10000 | color->pen;
+  }
+  return (color->red >> 8) | (color->green & 0xff00) | ((color->blue & 0xff00) << 8);
+}
+
+static gboolean color_equal(const GdkColor *a, const GdkColor *b) {
+
+  if(a->havepen != b->havepen) {
+    return FALSE;
+  }
+  if(a->havepen) {
+    return a->pen == b->pen;
+  }
+  return a->red == b->red && a->green == b->green && a->blue == b->blue;
+}
+
+static void style_key_fill(StyleKey *key, const GtkStyle *style) {
+  int i;
+
+  for(i=0;i<5;i++) {
+    key->fg[i]=style->fg[i];
+    key->bg[i]=style->bg[i];
+    key->light[i]=style->light[i];
+    key->dark[i]=style->dark[i];
+    key->mid[i]=style->mid[i];
+    key->text[i]=style->text[i];
+    key->base[i]=style->base[i];
+    key->text_aa[i]=style->text_aa[i];
+  }
+  key->black=style->black;
+  key->white=style->white;
+  key->font_desc=style->font_desc;
+  key->xthickness=style->xthickness;
+  key->ythickness=style->ythickness;
+}
+
+/* put back the fields a style was attached with */
+static void style_key_restore(GtkStyle *style, const StyleKey *key) {
+  int i;
+
+  for(i=0;i<5;i++) {
+    style->fg[i]=key->fg[i];
+    style->bg[i]=key->bg[i];
+    style->light[i]=key->light[i];
+    style->dark[i]=key->dark[i];
+    style->mid[i]=key->mid[i];
+    style->text[i]=key->text[i];
+    style->base[i]=key->base[i];
+    style->text_aa[i]=key->text_aa[i];
+  }
+  style->black=key->black;
+  style->white=key->white;
+  style->font_desc=key->font_desc;
+  style->xthickness=key->xthickness;
+  style->ythickness=key->ythickness;
+}
+
+static guint style_hash(gconstpointer k) {
+  const StyleKey *key=k;
+  guint h;
+  int i;
+
+  h=GPOINTER_TO_UINT(key->font_desc);
+  h=h*31 + key->xthickness;
+  h=h*31 + key->ythickness;
+
+  for(i=0;i<5;i++) {
+    h=h*31 + color_hash(&key->fg[i]);
+    h=h*31 + color_hash(&key->bg[i]);
+    h=h*31 + color_hash(&key->text[i]);
+    h=h*31 + color_hash(&key->base[i]);
+  }
+
+  return h;
+}
+
+static gboolean style_equal(gconstpointer a, gconstpointer b) {
+  const StyleKey *s1=a;
+  const StyleKey *s2=b;
+  int i;
+
+  if(s1->font_desc  != s2->font_desc  ||
+     s1->xthickness != s2->xthickness ||
+     s1->ythickness != s2->ythickness) {
+    return FALSE;
+  }
+
+  for(i=0;i<5;i++) {
+    if(!color_equal(&s1->fg[i],      &s2->fg[i])      ||
+       !color_equal(&s1->bg[i],      &s2->bg[i])      ||
+       !color_equal(&s1->light[i],   &s2->light[i])   ||
+       !color_equal(&s1->dark[i],    &s2->dark[i])    ||
+       !color_equal(&s1->mid[i],     &s2->mid[i])     ||
+       !color_equal(&s1->text[i],    &s2->text[i])    ||
+       !color_equal(&s1->base[i],    &s2->base[i])    ||
+       !color_equal(&s1->text_aa[i], &s2->text_aa[i])) {
+      return FALSE;
+    }
+  }
+
+  return color_equal(&s1->black, &s2->black) && color_equal(&s1->white, &s2->white);
+}
+
+/* remove the cache entry of style, through the key it was stored with */
+static void style_uncache(GtkStyle *style) {
+  StyleKey *key=style->mgtk_cache_key;
+
+  if(!key) {
+    return;
+  }
+
+  if(style_cache && g_hash_table_lookup(style_cache, key) == style) {
+    g_hash_table_remove(style_cache, key); /* frees key */
+  }
+  else {
+    g_free(key);
+  }
+  style->mgtk_cache_key=NULL;
+}
+
+/* style was changed after it was attached (key holds its new fields).
+ * If nobody else holds it, it just leaves the cache. Otherwise the
+ * caller gets a copy with the changes and the others keep the style
+ * as it was attached. Takes over the reference of the caller.
+ */
+static GtkStyle *style_unshare(GtkStyle *style, const StyleKey *key) {
+  GtkStyle *copy;
+
+  if(!style->mgtk_cache_key || style_equal(style->mgtk_cache_key, key)) {
+    return style;
+  }
+
+  if(G_OBJECT(style)->ref_count == 1) {
+    DebOut("  style %lx changed, uncache it\n",style);
+    style_uncache(style);
+    return style;
+  }
+
+  DebOut("  shared style %lx changed, copy it\n",style);
+  copy=gtk_style_copy(style);
+  style_key_restore(style, style->mgtk_cache_key);
+  g_object_unref(style);
+
+  return copy;
+}
+
+static void gtk_style_finalize(GObject *object) {
+  GtkStyle *style=GTK_STYLE(object);
+
+  DebOut("gtk_style_finalize(%lx)\n",style);
+
+  style_uncache(style);
+  style_release_gcs(style);
+
+  parent_class->finalize(object);
+}
+
+/*************** OLD ***********************************************************/
+
+/* one colormap for all styles, there is no real colormap support anyway */
+static GdkColormap *style_colormap(void) {
+  static GdkColormap *colormap=NULL;
+
+  if(!colormap) {
+    colormap=g_new0(GdkColormap,1);
+    colormap->colors=g_new0(GdkColor,1);
+    colormap->colors->havepen=0;
+  }
+
+  return colormap;
 }
 
 GtkStyle *gtk_style_new() {
 
   GtkStyle *ret;
-  int i;
 
   DebOut("gtk_style_new()\n");
 
-/*
-  ret=g_new0(GtkStyle,1);
-  */
   ret=g_object_new (GTK_TYPE_STYLE, NULL);
   DebOut("  ret=%lx\n",ret);
-  i=0;
-  while(i<6) {
-    ret->fg_gc[i]=allocgc();
-    ret->bg_gc[i]=allocgc();
-    ret->light_gc[i]=allocgc();
-    ret->dark_gc[i]=allocgc();
-    ret->mid_gc[i]=allocgc();
-    ret->text_gc[i]=allocgc();
-    ret->base_gc[i]=allocgc();
-    ret->text_aa_gc[i]=allocgc();
-    ret->bg_pixmap[i]=g_new0(GdkPixmap,1);
-
-    i++;
-  }
-  ret->white_gc=allocgc();
-  ret->black_gc=allocgc();
+
+  /* bg_pixmap[] stay NULL, we have no pixmaps */
+  style_realize_gcs(ret);
 
   ret->xthickness=2;
   ret->ythickness=2;
 
-  ret->colormap=g_new0(GdkColormap,1);
-  ret->colormap->colors=g_new0(GdkColor,1);
-  ret->colormap->colors->havepen=0;
+  ret->colormap=style_colormap();
 
   ret->attach_count=0;
 
@@ -200,11 +456,19 @@ void gtk_style_apply_default_background (GtkStyle *style, GdkWindow *window, gbo
 
 #define INTUI_PENS 1
 
+static void style_set_pen(GdkColor *color, gint pen) {
+
+  color->pen=pen;
+  color->havepen=1;
+}
+
 GtkStyle *mgtk_get_default_style(Object *obj) {
   unsigned int i;
 #ifndef INTUI_PENS
   struct MUI_RenderInfo *mri;
 #endif
+  GtkStyle *style;
+  gdouble start;
   GETGLOBAL
 
   DebOut("mgtk_get_default_style(%lx)\n");
@@ -222,44 +486,42 @@ GtkStyle *mgtk_get_default_style(Object *obj) {
       }
     }
 
-    mgtk->default_style=gtk_style_new();
+    start=mgtk_profile_start();
+    style=gtk_style_new();
     i=0;
-    while(i<6) {
+    while(i<5) {
 #if INTUI_PENS
-      mgtk->default_style->fg_gc[i]=newgc(MGTK_PEN_FG);  
-      mgtk->default_style->bg_gc[i]=newgc(MGTK_PEN_BG);
-      mgtk->default_style->light_gc[i]=newgc(MGTK_PEN_LIGHT);
-      mgtk->default_style->dark_gc[i]=newgc(MGTK_PEN_DARK);
-      mgtk->default_style->mid_gc[i]=newgc(MGTK_PEN_MID); /* hmm..*/
-      mgtk->default_style->text_gc[i]=newgc(MGTK_PEN_TEXT);
-      mgtk->default_style->base_gc[i]=newgc(MGTK_PEN_BASE);
-      mgtk->default_style->text_aa_gc[i]=newgc(MGTK_PEN_TEXT_AA); /* hmm..*/
+      style_set_pen(&style->fg[i],MGTK_PEN_FG);  
+      style_set_pen(&style->bg[i],MGTK_PEN_BG);
+      style_set_pen(&style->light[i],MGTK_PEN_LIGHT);
+      style_set_pen(&style->dark[i],MGTK_PEN_DARK);
+      style_set_pen(&style->mid[i],MGTK_PEN_MID); /* hmm..*/
+      style_set_pen(&style->text[i],MGTK_PEN_TEXT);
+      style_set_pen(&style->base[i],MGTK_PEN_BASE);
+      style_set_pen(&style->text_aa[i],MGTK_PEN_TEXT_AA); /* hmm..*/
 #else
-      mgtk->default_style->fg_gc[i]=newgc(MUIPEN(mri->mri_Pens[MPEN_TEXT]));  
-      mgtk->default_style->bg_gc[i]=newgc(MUIPEN(mri->mri_Pens[MPEN_BACKGROUND]));
-      mgtk->default_style->light_gc[i]=newgc(MUIPEN(mri->mri_Pens[MPEN_SHINE]));
-      mgtk->default_style->mid_gc[i]=newgc(MUIPEN(mri->mri_Pens[MPEN_HALFSHADOW])); 
-      mgtk->default_style->dark_gc[i]=newgc(MUIPEN(mri->mri_Pens[MPEN_SHADOW]));
-      mgtk->default_style->text_gc[i]=newgc(MUIPEN(mri->mri_Pens[MPEN_TEXT]));
-      mgtk->default_style->base_gc[i]=newgc(MUIPEN(mri->mri_Pens[MPEN_BACKGROUND]));
-      mgtk->default_style->text_aa_gc[i]=newgc(MUIPEN(mri->mri_Pens[MPEN_TEXT])); 
+      style_set_pen(&style->fg[i],MUIPEN(mri->mri_Pens[MPEN_TEXT]));  
+      style_set_pen(&style->bg[i],MUIPEN(mri->mri_Pens[MPEN_BACKGROUND]));
+      style_set_pen(&style->light[i],MUIPEN(mri->mri_Pens[MPEN_SHINE]));
+      style_set_pen(&style->mid[i],MUIPEN(mri->mri_Pens[MPEN_HALFSHADOW])); 
+      style_set_pen(&style->dark[i],MUIPEN(mri->mri_Pens[MPEN_SHADOW]));
+      style_set_pen(&style->text[i],MUIPEN(mri->mri_Pens[MPEN_TEXT]));
+      style_set_pen(&style->base[i],MUIPEN(mri->mri_Pens[MPEN_BACKGROUND]));
+      style_set_pen(&style->text_aa[i],MUIPEN(mri->mri_Pens[MPEN_TEXT])); 
 #endif
+      i++;
+    }
+    style_set_pen(&style->white,mgtk->white_pen); 
+    style_set_pen(&style->black,mgtk->black_pen); 
 
-      DebOut("mgtk->default_style->fg_gc[i]=%d\n",mgtk->default_style->fg_gc[i]->colormap->colors->pen);
-      DebOut("mgtk->default_style->bg_gc[i]=%d\n",mgtk->default_style->bg_gc[i]->colormap->colors->pen);
-      DebOut("mgtk->default_style->light_gc[i]=%d\n",mgtk->default_style->light_gc[i]->colormap->colors->pen);
-      DebOut("mgtk->default_style->mid_gc[i]=%d\n",mgtk->default_style->mid_gc[i]->colormap->colors->pen);
-      DebOut("mgtk->default_style->dark_gc[i]=%d\n",mgtk->default_style->dark_gc[i]->colormap->colors->pen);
-      DebOut("mgtk->default_style->text_gc[i]=%d\n",mgtk->default_style->text_gc[i]->colormap->colors->pen);
-      DebOut("mgtk->default_style->base_gc[i]=%d\n",mgtk->default_style->base_gc[i]->colormap->colors->pen);
-      DebOut("mgtk->default_style->text_aa_gc[i]=%d\n",mgtk->default_style->text_aa_gc[i]->colormap->colors->pen);
+    style_realize_gcs(style);
 
-      mgtk->default_style->bg_pixmap[i]=g_new0(GdkPixmap,1);
+    DebOut("  fg pen %d, bg pen %d, light pen %d, dark pen %d\n",
+           style->fg_gc[0]->mgtk_color.pen,style->bg_gc[0]->mgtk_color.pen,
+           style->light_gc[0]->mgtk_color.pen,style->dark_gc[0]->mgtk_color.pen);
 
-      i++;
-    }
-    mgtk->default_style->white_gc=newgc(mgtk->white_pen); 
-    mgtk->default_style->black_gc=newgc(mgtk->black_pen); 
+    mgtk->default_style=style;
+    mgtk_profile_stop(MGTK_PROFILE_STYLE, start);
   }
   else {
     DebOut("  just return mgtk->default_style (%lx)\n",mgtk->default_style);
@@ -276,10 +538,16 @@ GtkStyle *mgtk_get_default_style(Object *obj) {
  * The process may involve the creation of a new style if 
  * the style has already been attached to a window with a 
  * different style and colormap.
+ *
+ * GTK-MUI: if an identical style is already attached somewhere,
+ * style is unref'ed and the shared one is returned (with a
+ * reference for the caller).
  */
 
 GtkStyle *gtk_style_attach(GtkStyle *style, GdkWindow *window) {
   GtkWidget *widget;
+  GtkStyle *shared;
+  StyleKey key;
 
   DebOut("gtk_style_attach(%lx,%lx)\n",style,window);
 
@@ -288,39 +556,51 @@ GtkStyle *gtk_style_attach(GtkStyle *style, GdkWindow *window) {
     return NULL;
   }
 
-  if(style) {
-    window->style=style;
-  }
-  else {
+  if(!style) {
     widget=(GtkWidget *) window->mgtk_widget;
 #warning Someone should check that GDK stuff.
     window->style=mgtk_get_default_style(GtkObj(widget));
+    return window->style;
   }
 
-  /* o1i: after this function, bg_gc must be filled, according to bg ..*/
-  /* this might be totally wrong...? */
-  style->bg_gc[GTK_STATE_NORMAL]->colormap->colors->red=style->bg[GTK_STATE_NORMAL].red;
-  style->bg_gc[GTK_STATE_NORMAL]->colormap->colors->blue=style->bg[GTK_STATE_NORMAL].blue;
-  style->bg_gc[GTK_STATE_NORMAL]->colormap->colors->green=style->bg[GTK_STATE_NORMAL].green;
-
-  return window->style;
-}
+  if(!style_cache) {
+    style_cache=g_hash_table_new_full(style_hash, style_equal, g_free, NULL);
+  }
 
-void gdk_gc_set_rgb_fg_color(GdkGC *gc, const GdkColor *color) {
+  style_realize_colors(style);
+  style_key_fill(&key, style);
+  style=style_unshare(style, &key);
 
-  DebOut("gdk_gc_set_rgb_fg_color(%lx,%lx)",gc,color);
+  shared=g_hash_table_lookup(style_cache, &key);
 
-  if(!gc->colormap) {
-    ErrOut("gdk_gc_set_rgb_fg_color: gc has no colormap!\n");
-    return;
+  if(shared && shared != style) {
+    DebOut("  share style %lx instead of %lx\n",shared,style);
+    g_object_ref(shared);
+    g_object_unref(style);
+    style=shared;
+  }
+  else if(!shared) {
+    /* o1i: after this function, bg_gc must be filled, according to bg ..*/
+    style_realize_gcs(style);
+    style->mgtk_cache_key=g_memdup(&key, sizeof(StyleKey));
+    g_hash_table_insert(style_cache, style->mgtk_cache_key, style);
   }
 
-  gc->colormap->colors->red=color->red;
-  gc->colormap->colors->green=color->green;
-  gc->colormap->colors->blue=color->blue;
-  gc->colormap->colors->havepen=0;
+  style->attach_count++;
+  window->style=style;
 
-  /* TODO: ObtainPen..? */
+  return style;
+}
+
+void gtk_style_detach(GtkStyle *style) {
+
+  DebOut("gtk_style_detach(%lx)\n",style);
+
+  g_return_if_fail (GTK_IS_STYLE (style));
+
+  if(style->attach_count > 0) {
+    style->attach_count--;
+  }
 }
 
 /* A style created by matching with the supplied paths, or NULL 
@@ -335,13 +615,38 @@ GtkStyle* gtk_rc_get_style_by_paths(GtkSettings *settings, const char *widget_pa
   return NULL;
 }
 
+/* the copy is not shared, so it may be modified until it gets attached */
 GtkStyle *gtk_style_copy (GtkStyle *style) {
+  GtkStyle *ret;
+  int i;
 
   DebOut("gtk_style_copy(%lx)\n",style);
 
-  DebOut("  TODO: this just calls gtk_style_new..\n");
+  ret=gtk_style_new();
+
+  if(!style) {
+    return ret;
+  }
 
-  return gtk_style_new();
+  for(i=0;i<5;i++) {
+    ret->fg[i]=style->fg[i];
+    ret->bg[i]=style->bg[i];
+    ret->light[i]=style->light[i];
+    ret->dark[i]=style->dark[i];
+    ret->mid[i]=style->mid[i];
+    ret->text[i]=style->text[i];
+    ret->base[i]=style->base[i];
+    ret->text_aa[i]=style->text_aa[i];
+  }
+  ret->black=style->black;
+  ret->white=style->white;
+  ret->font_desc=style->font_desc;
+  ret->xthickness=style->xthickness;
+  ret->ythickness=style->ythickness;
+
+  style_realize_gcs(ret);
+
+  return ret;
 }
 
 
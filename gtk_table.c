@@ -518,7 +518,7 @@ static void gtk_table_init (GtkTable *table) {
 
   GTK_MUI(table)->mainclass=CL_AREA;
 
-  GtkSetObj(GTK_WIDGET(table), NewObject(CL_Table->mcc_Class, NULL,
+  GtkSetObj(GTK_WIDGET(table), NewObject(MGTK_CLASS(CL_Table), NULL,
                                         MA_Widget,(ULONG) table,
 #if 0
                                         MA_Table_Homogeneous,table->homogeneous,
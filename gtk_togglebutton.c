@@ -188,7 +188,7 @@ static void gtk_toggle_button_init (GtkToggleButton *toggle_button) {
   toggle_button->draw_indicator = FALSE;
   GTK_BUTTON (toggle_button)->depress_on_activate = TRUE;
 
-  GtkSetObj(GTK_WIDGET(toggle_button), NewObject(CL_ToggleButton->mcc_Class, NULL,
+  GtkSetObj(GTK_WIDGET(toggle_button), NewObject(MGTK_CLASS(CL_ToggleButton), NULL,
                                                   MA_Widget,(ULONG) toggle_button,
                                                   TAG_DONE
                                                 ));
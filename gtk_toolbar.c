@@ -52,7 +52,7 @@ GtkWidget *gtk_toolbar_new(void) {
 
   ret=mgtk_widget_new(IS_TOOLBAR);
 
-  tb = (APTR) NewObject(CL_Toolbar->mcc_Class, NULL,MA_Widget,ret,MUIA_Group_Horiz,TRUE,MUIA_Group_Spacing,0,TAG_DONE);
+  tb = (APTR) NewObject(MGTK_CLASS(CL_Toolbar), NULL,MA_Widget,ret,MUIA_Group_Horiz,TRUE,MUIA_Group_Spacing,0,TAG_DONE);
 
   DebOut(" NewObject=%lx\n",tb);
 
@@ -52,6 +52,7 @@
 
 #include "debug.h"
 #include "mui.h"
+#include "classes.h"
 
 
 #define DEFAULT_DELAY 500           /* Default delay in ms */
@@ -90,6 +91,149 @@ static GtkObjectClass *parent_class;
 static const gchar  tooltips_data_key[] = "_GtkTooltipsData";
 static const gchar  tooltips_info_key[] = "_GtkTooltipsInfo";
 
+/* GTK-MUI private: what we need to know about a tip on top of the public
+ * GtkTooltipsData, which has to stay the first member.
+ *
+ * Objects of our own classes only get MUIA_ShortHelp set to TRUE, which
+ * tells MUI there is help. The text is handed out in MUIM_CreateShortHelp
+ * (see mgtk_super_method), when the bubble is about to appear. Objects of
+ * plain MUI classes still get the text itself, and so do objects of our
+ * classes, whose dispatcher does not end in ENDMTABLE (see tips_lazy_class).
+ */
+typedef struct {
+  GtkTooltipsData  data;
+  GList           *link;        /* in tooltips->tips_data_list */
+  Object          *obj;         /* MUI object of data.widget */
+  gboolean         lazy;
+} MgtkTipsData;
+
+#define MGTK_TIPS(d) ((MgtkTipsData *) (d))
+
+static GHashTable *tips_by_object;  /* lazy Object -> MgtkTipsData */
+static GHashTable *lazy_classes;    /* IClass -> LAZY_CLASS_YES/NO */
+
+#define LAZY_CLASS_YES 1
+#define LAZY_CLASS_NO  2
+static GHashTable *tip_texts;       /* interned text -> reference count */
+
+/* Tip texts are interned, widgets with the same tip share one copy.
+ * Never g_free tip_text/tip_private, use tip_text_unref.
+ */
+static gchar *tip_text_ref (const gchar *text) {
+
+  gpointer key;
+  gpointer count;
+
+  if (!text) {
+    return NULL;
+  }
+
+  if (!tip_texts) {
+    tip_texts = g_hash_table_new (g_str_hash, g_str_equal);
+  }
+
+  if (g_hash_table_lookup_extended (tip_texts, text, &key, &count)) {
+    g_hash_table_insert (tip_texts, key, GUINT_TO_POINTER (GPOINTER_TO_UINT (count) + 1));
+    return key;
+  }
+
+  key = g_strdup (text);
+  g_hash_table_insert (tip_texts, key, GUINT_TO_POINTER (1));
+
+  return key;
+}
+
+static void tip_text_unref (gchar *text) {
+
+  guint count;
+
+  if (!text) {
+    return;
+  }
+
+  count = GPOINTER_TO_UINT (g_hash_table_lookup (tip_texts, text));
+  if (count > 1) {
+    g_hash_table_insert (tip_texts, text, GUINT_TO_POINTER (count - 1));
+    return;
+  }
+
+  g_hash_table_remove (tip_texts, text);
+  g_free (text);
+}
+
+/* plain MUI objects need the text (or NULL, if disabled) in MUIA_ShortHelp */
+static void tips_bind (MgtkTipsData *tips) {
+
+  if (tips->lazy || !tips->obj || GtkObj (tips->data.widget) != tips->obj) {
+    return;
+  }
+
+  set (tips->obj, MUIA_ShortHelp,
+       (ULONG) (tips->data.tooltips->enabled ? tips->data.tip_text : NULL));
+}
+
+/* GTK-MUI private: called for MUIM_CreateShortHelp of our own classes.
+ * Returns FALSE, if obj has no tip, else the text to show in *help
+ * (NULL, if tips are disabled).
+ */
+gboolean mgtk_tooltips_short_help (Object *obj, STRPTR *help) {
+
+  MgtkTipsData *tips;
+
+  if (!tips_by_object) {
+    return FALSE;
+  }
+
+  tips = g_hash_table_lookup (tips_by_object, obj);
+  if (!tips) {
+    return FALSE;
+  }
+
+  *help = tips->data.tooltips->enabled ? (STRPTR) tips->data.tip_text : NULL;
+
+  return TRUE;
+}
+
+/* TRUE, if MUIM_CreateShortHelp of the class of tips->obj really reaches
+ * mgtk_super_method. A dispatcher, which passes unknown methods on with
+ * DoSuperMethodA itself, lets MUI answer with MUIA_ShortHelp, which is
+ * only TRUE for lazy tips - and MUI would show (STRPTR) 1.
+ *
+ * Asked once per class: tips->obj must already be registered and have
+ * MUIA_ShortHelp TRUE, then only a class answering through ENDMTABLE
+ * hands out the text of the tip.
+ */
+static gboolean tips_lazy_class (MgtkTipsData *tips) {
+
+  struct IClass *cl;
+  STRPTR         expected;
+  STRPTR         help;
+  gint           known;
+
+  if (!lazy_classes) {
+    lazy_classes = g_hash_table_new (g_direct_hash, g_direct_equal);
+  }
+
+  cl = OCLASS (tips->obj);
+  known = GPOINTER_TO_INT (g_hash_table_lookup (lazy_classes, cl));
+  if (known) {
+    return known == LAZY_CLASS_YES;
+  }
+
+  mgtk_tooltips_short_help (tips->obj, &expected);
+  help = (STRPTR) DoMethod (tips->obj, MUIM_CreateShortHelp, 0, 0);
+  DoMethod (tips->obj, MUIM_DeleteShortHelp, (ULONG) help);
+
+  if (help != expected) {
+    WarnOut ("gtk_tooltips: class %lx does not answer MUIM_CreateShortHelp, tips of its objects are not lazy\n", cl);
+    g_hash_table_insert (lazy_classes, cl, GINT_TO_POINTER (LAZY_CLASS_NO));
+    return FALSE;
+  }
+
+  g_hash_table_insert (lazy_classes, cl, GINT_TO_POINTER (LAZY_CLASS_YES));
+  return TRUE;
+}
+
 GType gtk_tooltips_get_type (void) {
 
   static GType tooltips_type = 0;
@@ -150,10 +294,20 @@ GtkTooltips *gtk_tooltips_new (void) {
 
 static void gtk_tooltips_destroy_data (GtkTooltipsData *tooltipsdata) {
 
+  MgtkTipsData *tips = MGTK_TIPS (tooltipsdata);
+
   DebOut("gtk_tooltips_destroy_data(%lx)\n",tooltipsdata);
 
-  g_free (tooltipsdata->tip_text);
-  g_free (tooltipsdata->tip_private);
+  /* MUI must not show the text anymore, objects are disposed later */
+  if (tips->lazy) {
+    g_hash_table_remove (tips_by_object, tips->obj);
+  }
+  if (tips->obj && GtkObj (tooltipsdata->widget) == tips->obj) {
+    set (tips->obj, MUIA_ShortHelp, NULL);
+  }
+
+  tip_text_unref (tooltipsdata->tip_text);
+  tip_text_unref (tooltipsdata->tip_private);
 
   g_signal_handlers_disconnect_by_func (tooltipsdata->widget,
 					gtk_tooltips_event_handler,
@@ -167,7 +321,7 @@ static void gtk_tooltips_destroy_data (GtkTooltipsData *tooltipsdata) {
 
   g_object_set_data (G_OBJECT (tooltipsdata->widget), tooltips_data_key, NULL);
   g_object_unref (tooltipsdata->widget);
-  g_free (tooltipsdata);
+  g_free (tips);
 }
 
 #if 0
@@ -312,7 +466,7 @@ void gtk_tooltips_enable (GtkTooltips *tooltips) {
   while(list!=NULL) {
     tips_data=(GtkTooltipsData *) list->data;
     DebOut("  enable: widget %lx object %lx\n",tips_data->widget,GtkObj(tips_data->widget));
-    set(GtkObj(tips_data->widget),MUIA_ShortHelp,tips_data->tip_text);
+    tips_bind(MGTK_TIPS(tips_data));
     list=list->next;
   }
 
@@ -323,6 +477,8 @@ void gtk_tooltips_enable (GtkTooltips *tooltips) {
  * help bubbles. As I did not find any documentation
  * on how to disable a ShortHelp, I do a 
  * set MUIA_ShortHelp,NULL, which seems to work.
+ * Objects of our own classes just get no text
+ * in MUIM_CreateShortHelp.
  */
 
 void gtk_tooltips_disable (GtkTooltips *tooltips) {
@@ -343,7 +499,7 @@ void gtk_tooltips_disable (GtkTooltips *tooltips) {
   while(list!=NULL) {
     tips_data=(GtkTooltipsData *) list->data;
     DebOut("  disable: widget %lx object %lx\n",tips_data->widget,GtkObj(tips_data->widget));
-    set(GtkObj(tips_data->widget),MUIA_ShortHelp,NULL);
+    tips_bind(MGTK_TIPS(tips_data));
     list=list->next;
   }
 }
@@ -380,6 +536,9 @@ gtk_tooltips_data_get (GtkWidget       *widget)
 void gtk_tooltips_set_tip (GtkTooltips *tooltips, GtkWidget *widget, const gchar *tip_text, const gchar *tip_private) { 
   
   GtkTooltipsData *tooltipsdata;
+  MgtkTipsData *tips;
+  gchar *old_text;
+  gchar *old_private;
 
   g_return_if_fail (GTK_IS_TOOLTIPS (tooltips));
   g_return_if_fail (widget != NULL);
@@ -394,65 +553,88 @@ void gtk_tooltips_set_tip (GtkTooltips *tooltips, GtkWidget *widget, const gchar
     }
     return;
   }
-  
-  if (tooltips->active_tips_data 
-      && tooltips->active_tips_data->widget == widget
-      && GTK_WIDGET_DRAWABLE (tooltips->active_tips_data->widget)) {
 
+  if (tooltipsdata && tooltipsdata->tooltips == tooltips) {
 
-    DebOut("gtk_tooltips_set_tip: we already have active_tips_data..\n");
+    DebOut("gtk_tooltips_set_tip: new text for known widget\n");
 
-    g_free (tooltipsdata->tip_text);
-    g_free (tooltipsdata->tip_private);
+    old_text = tooltipsdata->tip_text;
+    old_private = tooltipsdata->tip_private;
 
-    tooltipsdata->tip_text = g_strdup (tip_text);
-    tooltipsdata->tip_private = g_strdup (tip_private);
-      
-    gtk_tooltips_draw_tips (tooltips);
+    tooltipsdata->tip_text = tip_text_ref (tip_text);
+    tooltipsdata->tip_private = tip_text_ref (tip_private);
+
+    tip_text_unref (old_text);
+    tip_text_unref (old_private);
+
+    tips_bind (MGTK_TIPS (tooltipsdata));
+
+    if (tooltips->active_tips_data == tooltipsdata
+        && GTK_WIDGET_DRAWABLE (widget)) {
+      gtk_tooltips_draw_tips (tooltips);
+    }
+    return;
   }
-  else {
-    g_object_ref (widget);
-    
-    DebOut("gtk_tooltips_set_tip: we have no active_tips_data..\n");
 
-    if (tooltipsdata)
-      gtk_tooltips_widget_remove (tooltipsdata->widget, tooltipsdata);
-    
-    tooltipsdata = g_new0 (GtkTooltipsData, 1);
-    
-    tooltipsdata->tooltips = tooltips;
-    tooltipsdata->widget = widget;
+  if (tooltipsdata) {
+    gtk_tooltips_widget_remove (tooltipsdata->widget, tooltipsdata);
+  }
+
+  g_object_ref (widget);
 
-    tooltipsdata->tip_text = g_strdup (tip_text);
-    tooltipsdata->tip_private = g_strdup (tip_private);
+  tips = g_new0 (MgtkTipsData, 1);
+  tooltipsdata = &tips->data;
 
-    tooltips->tips_data_list = g_list_append (tooltips->tips_data_list,
-                                              tooltipsdata);
+  tooltipsdata->tooltips = tooltips;
+  tooltipsdata->widget = widget;
+
+  tooltipsdata->tip_text = tip_text_ref (tip_text);
+  tooltipsdata->tip_private = tip_text_ref (tip_private);
+
+  /* order does not matter, prepend is O(1) and the link makes removal O(1) */
+  tooltips->tips_data_list = g_list_prepend (tooltips->tips_data_list,
+                                             tooltipsdata);
+  tips->link = tooltips->tips_data_list;
 #if 0
-    g_signal_connect_after (widget, "event-after",
-                            G_CALLBACK (gtk_tooltips_event_handler),
-          tooltipsdata);
+  g_signal_connect_after (widget, "event-after",
+                          G_CALLBACK (gtk_tooltips_event_handler),
+        tooltipsdata);
 #endif
 
-    g_object_set_data (G_OBJECT (widget), tooltips_data_key,
-                       tooltipsdata);
+  g_object_set_data (G_OBJECT (widget), tooltips_data_key,
+                     tooltipsdata);
 
 #if 0
-    g_signal_connect (widget, "unmap",
-    G_CALLBACK (gtk_tooltips_widget_unmap),
-    tooltipsdata);
+  g_signal_connect (widget, "unmap",
+  G_CALLBACK (gtk_tooltips_widget_unmap),
+  tooltipsdata);
 
-    g_signal_connect (widget, "unrealize",
-    G_CALLBACK (gtk_tooltips_widget_unmap),
-    tooltipsdata);
+  g_signal_connect (widget, "unrealize",
+  G_CALLBACK (gtk_tooltips_widget_unmap),
+  tooltipsdata);
 #endif
 
-    set(GtkObj(widget),MUIA_ShortHelp,(ULONG) tooltipsdata->tip_text);
+  tips->obj = GtkObj (widget);
+  tips->lazy = mgtk_is_custom_object (tips->obj);
+
+  if (tips->lazy) {
+    if (!tips_by_object) {
+      tips_by_object = g_hash_table_new (g_direct_hash, g_direct_equal);
+    }
+    g_hash_table_insert (tips_by_object, tips->obj, tips);
+    set (tips->obj, MUIA_ShortHelp, (ULONG) TRUE);
 
-    g_signal_connect (widget, "destroy",
-                      G_CALLBACK (gtk_tooltips_widget_remove),
-                      tooltipsdata);
+    if (!tips_lazy_class (tips)) {
+      g_hash_table_remove (tips_by_object, tips->obj);
+      tips->lazy = FALSE;
+    }
   }
+
+  tips_bind (tips);
+
+  g_signal_connect (widget, "destroy",
+                    G_CALLBACK (gtk_tooltips_widget_remove),
+                    tooltipsdata);
 }
 
 #if 0
@@ -595,21 +777,13 @@ gtk_tooltips_set_active_widget (GtkTooltips *tooltips,
   
   if (widget)
     {
-      GList *list;
-      
-      for (list = tooltips->tips_data_list; list; list = list->next)
-	{
-	  GtkTooltipsData *tooltipsdata;
-	  
-	  tooltipsdata = list->data;
-	  
-	  if (tooltipsdata->widget == widget &&
-	      GTK_WIDGET_DRAWABLE (widget))
-	    {
-	      tooltips->active_tips_data = tooltipsdata;
-	      break;
-	    }
-	}
+      GtkTooltipsData *tooltipsdata;
+
+      tooltipsdata = gtk_tooltips_data_get (widget);
+
+      if (tooltipsdata && tooltipsdata->tooltips == tooltips &&
+	  GTK_WIDGET_DRAWABLE (widget))
+	tooltips->active_tips_data = tooltipsdata;
     }
   else
     {
@@ -835,8 +1009,8 @@ gtk_tooltips_widget_remove (GtkWidget *widget,
   GtkTooltips *tooltips = tooltipsdata->tooltips;
 
   gtk_tooltips_widget_unmap (widget, data);
-  tooltips->tips_data_list = g_list_remove (tooltips->tips_data_list,
-					    tooltipsdata);
+  tooltips->tips_data_list = g_list_delete_link (tooltips->tips_data_list,
+						 MGTK_TIPS (tooltipsdata)->link);
   gtk_tooltips_destroy_data (tooltipsdata);
 }
 
@@ -106,7 +106,7 @@ GtkWidget* gtk_vbox_new (gboolean homogeneous, gint spacing) {
   GTK_BOX (vbox)->spacing = spacing;
   GTK_BOX (vbox)->homogeneous = homogeneous ? TRUE : FALSE;
 
-  GtkSetObj(GTK_WIDGET(vbox), NewObject(CL_VBox->mcc_Class, NULL,
+  GtkSetObj(GTK_WIDGET(vbox), NewObject(MGTK_CLASS(CL_VBox), NULL,
                                               MA_Widget,(LONG) vbox,
                                               MUIA_Group_Horiz,FALSE,
                                               TAG_DONE));
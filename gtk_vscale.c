@@ -41,6 +41,7 @@
 #include "gtk_globals.h"
 #include "mui.h"
 #include "classes/classes.h"
+#include "classes/numericmap.h"
 #include "debug.h"
 /*
 #include "gtkintl.h"
@@ -120,7 +121,7 @@ static void gtk_vscale_init (GtkVScale *vscale) {
   
   range->orientation = GTK_ORIENTATION_VERTICAL;
 
-  GtkSetObj(GTK_WIDGET(vscale), NewObject(CL_Scale->mcc_Class, NULL,
+  GtkSetObj(GTK_WIDGET(vscale), NewObject(MGTK_CLASS(CL_Scale), NULL,
                                        MA_Widget,(ULONG) vscale, 
                                        MUIA_Slider_Horiz, FALSE,
                                        MUIA_Numeric_Min,0,
@@ -140,22 +141,20 @@ static void gtk_vscale_init (GtkVScale *vscale) {
 GtkWidget* gtk_vscale_new (GtkAdjustment *adjustment) {
 
   GtkWidget *w;
+  MgtkNumericMap map;
 
   DebOut("gtk_vscale_new(%lx)\n",adjustment);
 
   w=g_object_new (GTK_TYPE_VSCALE, "adjustment", adjustment, NULL);
 
-  if(!GTK_RANGE(w)->adjustment->step_increment) {
-    ErrOut("gtk_vscale.c: step_increment is zero (Division by zero error avoided)!");
-    GTK_RANGE(w)->adjustment->step_increment=1;
-  }
+  mgtk_numeric_map_adjustment(&map,GTK_RANGE(w)->adjustment,GTK_RANGE(w)->round_digits);
 
-  GtkSetObj(w, NewObject(CL_Scale->mcc_Class, NULL,
+  GtkSetObj(w, NewObject(MGTK_CLASS(CL_Scale), NULL,
                                        MA_Widget,(ULONG) w, 
                                        MUIA_Slider_Horiz, FALSE,
-                                       MUIA_Numeric_Min,GTK_RANGE(w)->adjustment->lower / GTK_RANGE(w)->adjustment->step_increment,
-                                       MUIA_Numeric_Max,GTK_RANGE(w)->adjustment->upper / GTK_RANGE(w)->adjustment->step_increment,
-                                       MUIA_Numeric_Value,GTK_RANGE(w)->adjustment->value / GTK_RANGE(w)->adjustment->step_increment,
+                                       MUIA_Numeric_Min,0,
+                                       MUIA_Numeric_Max,map.max,
+                                       MUIA_Numeric_Value,mgtk_numeric_map_to_mui(&map,GTK_RANGE(w)->adjustment->value),
                                        TAG_DONE));
 
   if(!GTK_MUI(w)->MuiObject) {
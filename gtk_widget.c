@@ -1765,7 +1765,7 @@ gtk_widget_init (GtkWidget *widget)
   widget->style = gtk_widget_get_default_style ();
   g_object_ref (widget->style);
 
-  GtkSetObj(widget, NewObject(CL_Custom->mcc_Class, NULL,MA_Widget,(ULONG) widget,TAG_DONE));
+  GtkSetObj(widget, NewObject(MGTK_CLASS(CL_Custom), NULL,MA_Widget,(ULONG) widget,TAG_DONE));
 
   GTK_MUI(widget)->mainclass=CL_OTHER;
 }
@@ -1995,6 +1995,9 @@ gtk_widget_unparent (GtkWidget *widget)
     toplevel = NULL;
 
   gtk_widget_queue_draw_child (widget);
+#else
+  /* no hierarchy_changed, so we hold no reference to the toplevel */
+  toplevel = NULL;
 #endif
 
   /* Reset the width and height here, to force reallocation if we
@@ -2020,6 +2023,13 @@ gtk_widget_unparent (GtkWidget *widget)
    * in the next parent.
    */
   GTK_PRIVATE_SET_FLAG (widget, GTK_CHILD_VISIBLE);
+
+  /* GTK-MUI: a plain remove takes the MUI object out of its group, so
+   * it can be packed again elsewhere. A destroyed widget keeps it there,
+   * mgtk_dispose_mui_objects removes it later.
+   */
+  if (!GTK_WIDGET_MUI_DISPOSING (widget))
+    mgtk_remove (GTK_MUI (widget->parent), GTK_MUI (widget));
     
   old_parent = widget->parent;
   widget->parent = NULL;
@@ -2082,8 +2092,10 @@ void gtk_widget_destroy (GtkWidget *widget) {
     win=GTK_MUI(widget)->MuiWin;
   }
 
-#warning TODO: gtk_object_destroy ..
-//  gtk_object_destroy ((GtkObject*) widget);
+  /* destroy signal, children and GTK side state. The MUI objects
+   * are disposed later from the main loop, see mgtk_dispose_mui_objects
+   */
+  gtk_object_destroy ((GtkObject*) widget);
 
   if(destroywin) {
     if(win) {
@@ -7022,7 +7034,12 @@ gtk_widget_dispose (GObject *object)
   GtkWidget *widget = GTK_WIDGET (object);
 
   if (widget->parent)
-    gtk_container_remove (GTK_CONTAINER (widget->parent), widget);
+    {
+      /* GTK-MUI: the MUI object stays in its group until it is buried */
+      GTK_PRIVATE_SET_FLAG (widget, GTK_MUI_DISPOSING);
+      gtk_container_remove (GTK_CONTAINER (widget->parent), widget);
+      GTK_PRIVATE_UNSET_FLAG (widget, GTK_MUI_DISPOSING);
+    }
   else if (GTK_WIDGET_VISIBLE (widget))
     gtk_widget_hide (widget);
 
@@ -580,13 +580,13 @@ GtkWidget* gtk_window_new   (GtkWindowType   type) {
 
       DebOut("  create GTK_WINDOW_TOPLEVEL\n");
 
-      obj = NewObject(CL_Window->mcc_Class, NULL,
+      obj = NewObject(MGTK_CLASS(CL_Window), NULL,
                       MUIA_Window_Menustrip, 
                       menu = (APTR)MenustripObject, 
                         MUIA_Menustrip_Enabled, (LONG) FALSE, 
                       End,
                       WindowContents, 
-                        root = (APTR)NewObject(CL_RootGroup->mcc_Class, NULL, TAG_DONE)
+                        root = (APTR)NewObject(MGTK_CLASS(CL_RootGroup), NULL, TAG_DONE)
                       );
 
       if(obj) {
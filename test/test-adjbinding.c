@@ -0,0 +1,210 @@
+/*
+ * host test for classes/adjbinding.c
+ *
+ * N fake views share one fake adjustment. A view behaves like a MUI
+ * numeric object: setting a new position triggers its notify hook,
+ * which - unless the binding is pushing - writes the value back into
+ * the adjustment and emits value_changed, like classes/scale.c does.
+ *
+ * Counts value_changed emissions and MUI sets for:
+ *  - a change from the program: one emission, one set per view
+ *  - a change from one view: one emission, no set back into it
+ *  - a change below the resolution of coarse views: no set for them
+ *  - the same value again: nothing at all
+ *  - unbinding and invalidating
+ *
+ * $Id: test-adjbinding.c,v 1.1 2026/10/19 22:00:00 o1i Exp $
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+
+#include "adjbinding.h"
+
+#define MAX_VIEWS 64
+
+typedef struct {
+  double value;
+  MgtkBinding *binding;
+} FakeAdjustment;
+
+typedef struct {
+  double resolution;  /* GTK value of one position */
+  double mui;         /* position the MUI object shows */
+  int    sets;
+} FakeView;
+
+static FakeAdjustment adj;
+static FakeView views[MAX_VIEWS];
+static int emissions;
+static int feedback;
+
+static int failed=0;
+
+#define CHECK(cond, ...) \
+  do { \
+    if(!(cond)) { \
+      if(failed++ < 10) { \
+        printf(__VA_ARGS__); \
+      } \
+    } \
+  } while(0)
+
+static void value_changed(FakeAdjustment *a, FakeView *source);
+
+/* MUI notify hook of a view */
+static void view_notify(FakeView *view) {
+
+  if(mgtk_binding_pushing(adj.binding)) {
+    return;
+  }
+  feedback++;
+  value_changed(&adj, view);
+}
+
+/* MUI set: notifies only, if the position really changes */
+static void mui_set(FakeView *view, double pos) {
+
+  view->sets++;
+  if(view->mui != pos) {
+    view->mui=pos;
+    view_notify(view);
+  }
+}
+
+static gboolean fake_position(MgtkBindingView *view, gpointer data, gdouble *pos) {
+  FakeView *fake=(FakeView *) view->widget;
+
+  *pos=floor(((FakeAdjustment *) data)->value/fake->resolution + 0.5);
+  return TRUE;
+}
+
+static void fake_show(MgtkBindingView *view, gpointer data, gdouble pos) {
+
+  mui_set((FakeView *) view->widget, pos);
+}
+
+static const MgtkBindingViewClass fake_class={ fake_position, fake_show, NULL };
+
+/* gtk_adjustment_value_changed resp. the flush of a queued change */
+static void value_changed(FakeAdjustment *a, FakeView *source) {
+
+  mgtk_binding_push(a->binding, a, source);
+  emissions++;
+}
+
+static void set_value(double value) {
+
+  if(value != adj.value) {
+    adj.value=value;
+    value_changed(&adj, NULL);
+  }
+}
+
+/* the user drags view v */
+static void user_drag(int v, double pos) {
+
+  views[v].mui=pos;
+  adj.value=pos*views[v].resolution;
+  view_notify(&views[v]);
+}
+
+static int total_sets(int n) {
+  int sum=0;
+  int i;
+
+  for(i=0;i<n;i++) {
+    sum+=views[i].sets;
+  }
+  return sum;
+}
+
+static void reset_counts(int n) {
+  int i;
+
+  for(i=0;i<n;i++) {
+    views[i].sets=0;
+  }
+  emissions=0;
+  feedback=0;
+}
+
+static void run(int n) {
+  int i;
+
+  adj.value=0;
+  adj.binding=mgtk_binding_new();
+  for(i=0;i<n;i++) {
+    /* every fourth view is a coarse one */
+    views[i].resolution=(i % 4 == 3) ? 1.0 : 0.01;
+    views[i].mui=0;
+    CHECK(mgtk_binding_add(adj.binding, &views[i], &fake_class) != NULL, "n=%d: view %d not added\n", n, i);
+  }
+  CHECK(mgtk_binding_add(adj.binding, &views[0], &fake_class) == NULL, "n=%d: view 0 added twice\n", n);
+
+  /* change from the program */
+  reset_counts(n);
+  set_value(5.0);
+  CHECK(emissions == 1, "n=%d: program change: %d emissions\n", n, emissions);
+  CHECK(total_sets(n) == n, "n=%d: program change: %d sets\n", n, total_sets(n));
+  CHECK(feedback == 0, "n=%d: program change: %d feedbacks\n", n, feedback);
+
+  /* same value again */
+  reset_counts(n);
+  set_value(5.0);
+  mgtk_binding_push(adj.binding, &adj, NULL);
+  CHECK(total_sets(n) == 0, "n=%d: same value: %d sets\n", n, total_sets(n));
+
+  /* below the resolution of the coarse views */
+  reset_counts(n);
+  set_value(5.2);
+  CHECK(emissions == 1, "n=%d: fine change: %d emissions\n", n, emissions);
+  CHECK(total_sets(n) == n - n/4, "n=%d: fine change: %d sets\n", n, total_sets(n));
+
+  /* change from view 0 */
+  reset_counts(n);
+  user_drag(0, 700);
+  CHECK(emissions == 1, "n=%d: drag: %d emissions\n", n, emissions);
+  CHECK(feedback == 1, "n=%d: drag: %d feedbacks\n", n, feedback);
+  CHECK(views[0].sets == 0, "n=%d: drag: %d sets back into the source\n", n, views[0].sets);
+  CHECK(total_sets(n) == n-1, "n=%d: drag: %d sets\n", n, total_sets(n));
+  for(i=0;i<n;i++) {
+    CHECK(views[i].mui == floor(7.0/views[i].resolution + 0.5), "n=%d: drag: view %d shows %g\n", n, i, views[i].mui);
+  }
+
+  /* the source forgot what it showed, so it gets the next value again */
+  reset_counts(n);
+  set_value(7.5);
+  CHECK(views[0].sets == 1, "n=%d: after drag: %d sets into the source\n", n, views[0].sets);
+
+  /* unbound views get nothing */
+  reset_counts(n);
+  CHECK(mgtk_binding_remove(adj.binding, &views[1]) == (n > 1), "n=%d: remove view 1\n", n);
+  CHECK(!mgtk_binding_remove(adj.binding, &views[1]), "n=%d: removed view 1 twice\n", n);
+  set_value(8.0);
+  CHECK(views[1].sets == 0 || n <= 1, "n=%d: unbound view got %d sets\n", n, views[1].sets);
+
+  /* invalidated views are all pushed again */
+  reset_counts(n);
+  mgtk_binding_invalidate(adj.binding, &adj);
+  mgtk_binding_push(adj.binding, &adj, NULL);
+  CHECK(total_sets(n) == n - (n > 1), "n=%d: invalidate: %d sets\n", n, total_sets(n));
+  CHECK(feedback == 0, "n=%d: invalidate: %d feedbacks\n", n, feedback);
+
+  CHECK(!mgtk_binding_pushing(adj.binding), "n=%d: still pushing\n", n);
+
+  mgtk_binding_free(adj.binding);
+}
+
+int main(void) {
+  int n;
+
+  for(n=1;n<=MAX_VIEWS;n*=2) {
+    run(n);
+  }
+  run(3);
+
+  printf("test-adjbinding: %s (%d failures)\n", failed ? "FAILED" : "PASSED", failed);
+  return failed ? EXIT_FAILURE : EXIT_SUCCESS;
+}
@@ -0,0 +1,165 @@
+/*
+ * host test for gdk/gdkeventpool.c
+ *
+ *  - every size up to beyond the pooled classes comes back zeroed,
+ *    owned, and can be freed exactly once
+ *  - freed events are reused within their size class
+ *  - events the pool did not hand out are refused, even if the bytes
+ *    in front of them look exactly like a pool header (an event
+ *    embedded in a structure, like the one of the Custom class)
+ *  - random alloc/free sequences never hand out overlapping memory
+ *    and keep the live count right
+ *  - cleanup leaves live events alone
+ *
+ * $Id: test-eventpool.c,v 1.1 2026/10/19 22:00:00 o1i Exp $
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "gdkeventpool.h"
+
+#define MAX_SIZE   (MGTK_EVENT_POOL_CLASSES*MGTK_EVENT_POOL_GRAIN + 40)
+#define N_RANDOM   2000
+#define STEPS      200000
+
+static int failed=0;
+
+#define CHECK(cond, ...) \
+  do { \
+    if(!(cond)) { \
+      if(failed++ < 10) { \
+        printf(__VA_ARGS__); \
+      } \
+    } \
+  } while(0)
+
+static int zeroed(const unsigned char *p, gsize size) {
+  gsize i;
+
+  for(i=0;i<size;i++) {
+    if(p[i]) {
+      return 0;
+    }
+  }
+  return 1;
+}
+
+static void check_sizes(void) {
+  unsigned char *e;
+  gsize size;
+
+  for(size=1;size<=MAX_SIZE;size++) {
+    e=mgtk_event_pool_alloc(size);
+    CHECK(zeroed(e, size), "size %d: not zeroed\n", (int) size);
+    CHECK(mgtk_event_pool_owns(e), "size %d: not owned\n", (int) size);
+    CHECK(mgtk_event_pool_live() == 1, "size %d: %d live\n", (int) size, mgtk_event_pool_live());
+    /* dirty it for the next one of this class */
+    memset(e, 0xa5, size);
+    CHECK(mgtk_event_pool_free(e), "size %d: free refused\n", (int) size);
+    CHECK(!mgtk_event_pool_owns(e), "size %d: still owned after free\n", (int) size);
+    CHECK(!mgtk_event_pool_free(e), "size %d: freed twice\n", (int) size);
+  }
+}
+
+static void check_reuse(void) {
+  gpointer a, b;
+
+  a=mgtk_event_pool_alloc(MGTK_EVENT_POOL_GRAIN*2);
+  mgtk_event_pool_free(a);
+  b=mgtk_event_pool_alloc(MGTK_EVENT_POOL_GRAIN+1);
+  CHECK(a == b, "freed event of the same class not reused\n");
+  mgtk_event_pool_free(b);
+}
+
+typedef struct {
+  guint32 tag;
+  unsigned char event[64];
+} Embedded;
+
+static void check_foreign(void) {
+  unsigned char *pooled;
+  unsigned char *copy;
+  Embedded embedded;
+  unsigned char stack[64];
+  gsize header;
+
+  memset(&embedded, 0, sizeof(embedded));
+  memset(stack, 0, sizeof(stack));
+  CHECK(!mgtk_event_pool_owns(embedded.event), "embedded event owned\n");
+  CHECK(!mgtk_event_pool_free(embedded.event), "embedded event freed\n");
+  CHECK(!mgtk_event_pool_free(stack), "stack event freed\n");
+  CHECK(!mgtk_event_pool_free(NULL), "NULL freed\n");
+
+  /* same bytes in front as a real pool event */
+  header=sizeof(gdouble);   /* the pool header */
+  pooled=mgtk_event_pool_alloc(32);
+  copy=g_malloc(header + 32);
+  memcpy(copy, pooled - header, header + 32);
+  CHECK(!mgtk_event_pool_owns(copy + header), "copy of a pool event owned\n");
+  CHECK(!mgtk_event_pool_free(copy + header), "copy of a pool event freed\n");
+  CHECK(mgtk_event_pool_live() == 1, "foreign events changed the live count to %d\n", mgtk_event_pool_live());
+  g_free(copy);
+  mgtk_event_pool_free(pooled);
+}
+
+static void check_random(void) {
+  unsigned char *events[N_RANDOM];
+  gsize sizes[N_RANDOM];
+  guint live=0;
+  gsize j;
+  int step;
+  int i;
+  int broken=0;
+
+  memset(events, 0, sizeof(events));
+  srand(1);
+
+  for(step=0;step<STEPS;step++) {
+    i=rand() % N_RANDOM;
+    if(events[i]) {
+      /* nobody else wrote into it */
+      for(j=0;j<sizes[i];j++) {
+        if(events[i][j] != (unsigned char) i) {
+          broken++;
+          break;
+        }
+      }
+      CHECK(mgtk_event_pool_free(events[i]), "random: free of %d refused\n", i);
+      events[i]=NULL;
+      live--;
+    }
+    else {
+      sizes[i]=1 + rand() % MAX_SIZE;
+      events[i]=mgtk_event_pool_alloc(sizes[i]);
+      CHECK(zeroed(events[i], sizes[i]), "random: event %d not zeroed\n", i);
+      memset(events[i], i, sizes[i]);
+      live++;
+    }
+  }
+  CHECK(!broken, "random: %d events overwritten\n", broken);
+  CHECK(mgtk_event_pool_live() == live, "random: %d live, should be %d\n", mgtk_event_pool_live(), live);
+
+  /* cleanup only drops the freelists */
+  mgtk_event_pool_cleanup();
+  for(i=0;i<N_RANDOM;i++) {
+    if(events[i]) {
+      CHECK(events[i][0] == (unsigned char) i, "cleanup: event %d overwritten\n", i);
+      CHECK(mgtk_event_pool_free(events[i]), "cleanup: event %d no longer owned\n", i);
+    }
+  }
+  CHECK(mgtk_event_pool_live() == 0, "cleanup: %d live\n", mgtk_event_pool_live());
+  mgtk_event_pool_cleanup();
+}
+
+int main(void) {
+
+  check_sizes();
+  check_reuse();
+  check_foreign();
+  check_random();
+
+  printf("test-eventpool: %s (%d failures)\n", failed ? "FAILED" : "PASSED", failed);
+  return failed ? EXIT_FAILURE : EXIT_SUCCESS;
+}
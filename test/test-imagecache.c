@@ -0,0 +1,420 @@
+/*
+ * host test for classes/imagecore.c
+ *
+ * A fake file system and decoder stand in for dos.library and the
+ * datatypes loader:
+ *  - hits share the entry and neither decode nor look at the file
+ *    again within the recheck time
+ *  - missing files give NULL, files which can't be decoded FAILED
+ *  - unused entries are dropped least recently used first, once the
+ *    budget is exceeded, entries in use never
+ *  - a changed stamp gives a new entry after the recheck time, users
+ *    of the old one keep their picture until the last unref
+ *  - asynchronous decoding: waiting objects are told, entries dropped
+ *    or changed while loading
+ *  - random sequences against the byte count and the budget, every
+ *    picture is released exactly once
+ *
+ * $Id: test-imagecache.c,v 1.1 2026/10/19 22:00:00 o1i Exp $
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "imagecore.h"
+
+#define N_FILES  8
+#define PIC_SIZE 100
+#define BUDGET   (3*PIC_SIZE)
+#define RECHECK  2.0
+#define ROUNDS   20000
+
+typedef struct {
+  gchar    path[16];
+  gboolean exists;
+  gboolean broken;
+  glong    days;
+} File;
+
+typedef struct {
+  gint     file;
+  gboolean released;
+} Pic;
+
+static File     files[N_FILES];
+static gint     stats;
+static gint     decodes;
+static gint     notified;
+static gint     live_pics;
+static gboolean async;
+static GSList  *loading;
+
+static int failed=0;
+
+#define CHECK(cond, ...) \
+  do { \
+    if(!(cond)) { \
+      if(failed++ < 10) { \
+        printf(__VA_ARGS__); \
+      } \
+    } \
+  } while(0)
+
+static gint file_of(const gchar *path) {
+  gint i;
+
+  for(i=0;i<N_FILES;i++) {
+    if(!strcmp(files[i].path, path)) {
+      return i;
+    }
+  }
+  return -1;
+}
+
+static gboolean fake_stamp(MgtkImageCore *core, const gchar *path, MgtkImageStamp *stamp) {
+  gint f=file_of(path);
+
+  stats++;
+  if(f < 0 || !files[f].exists) {
+    return FALSE;
+  }
+  stamp->days=files[f].days;
+  stamp->minute=0;
+  stamp->tick=0;
+  return TRUE;
+}
+
+static void finish(MgtkImageCore *core, MgtkImageEntry *entry) {
+  gint f=file_of(entry->path);
+  Pic *pic;
+
+  if(files[f].broken) {
+    mgtk_image_core_loaded(core, entry, NULL, 0, 0, 0);
+    return;
+  }
+  pic=g_new0(Pic, 1);
+  pic->file=f;
+  live_pics++;
+  mgtk_image_core_loaded(core, entry, pic, 10, 10, PIC_SIZE);
+}
+
+static void fake_decode(MgtkImageCore *core, MgtkImageEntry *entry) {
+
+  decodes++;
+  if(async) {
+    loading=g_slist_append(loading, entry);
+  }
+  else {
+    finish(core, entry);
+  }
+}
+
+static void fake_release(MgtkImageCore *core, gpointer data) {
+  Pic *pic=(Pic *) data;
+
+  CHECK(!pic->released, "picture of file %d released twice\n", pic->file);
+  pic->released=TRUE;
+  live_pics--;
+}
+
+static void fake_notify(MgtkImageCore *core, MgtkImageEntry *entry, gpointer object) {
+
+  CHECK(entry && entry->state != MGTK_IMAGE_LOADING, "notified while loading\n");
+  (*(gint *) object)++;
+  notified++;
+}
+
+static const MgtkImageCoreClass fake_class = {
+  fake_stamp,
+  fake_decode,
+  fake_release,
+  fake_notify
+};
+
+/* finish the oldest decode */
+static gboolean finish_one(MgtkImageCore *core) {
+  MgtkImageEntry *entry;
+
+  if(!loading) {
+    return FALSE;
+  }
+  entry=(MgtkImageEntry *) loading->data;
+  loading=g_slist_remove(loading, entry);
+  finish(core, entry);
+  return TRUE;
+}
+
+static void reset_files(void) {
+  gint i;
+
+  for(i=0;i<N_FILES;i++) {
+    sprintf(files[i].path, "file%d", i);
+    files[i].exists=TRUE;
+    files[i].broken=FALSE;
+    files[i].days=1;
+  }
+  stats=0;
+  decodes=0;
+  notified=0;
+}
+
+static gboolean is_unused(MgtkImageCore *core, MgtkImageEntry *entry) {
+  GList *l;
+
+  for(l=core->unused.head;l;l=l->next) {
+    if(l->data == entry) {
+      return TRUE;
+    }
+  }
+  return FALSE;
+}
+
+static void check_hits(void) {
+  MgtkImageCore core;
+  MgtkImageEntry *a, *b;
+
+  reset_files();
+  mgtk_image_core_init(&core, &fake_class, NULL, BUDGET, RECHECK);
+
+  a=mgtk_image_core_get(&core, "file0", 100.0);
+  CHECK(a && a->state == MGTK_IMAGE_READY, "hits: not ready\n");
+  CHECK(decodes == 1 && stats == 1, "hits: %d decodes, %d stats after the miss\n", decodes, stats);
+
+  b=mgtk_image_core_get(&core, "file0", 101.0);
+  CHECK(a == b && a->refcount == 2, "hits: second get is no hit\n");
+  CHECK(decodes == 1 && stats == 1, "hits: %d decodes, %d stats within recheck\n", decodes, stats);
+
+  b=mgtk_image_core_get(&core, "file0", 102.5);
+  CHECK(a == b, "hits: no hit after recheck\n");
+  CHECK(decodes == 1 && stats == 2, "hits: %d decodes, %d stats after recheck\n", decodes, stats);
+
+  /* the clock went back */
+  b=mgtk_image_core_get(&core, "file0", 50.0);
+  CHECK(a == b && stats == 3, "hits: clock going back is not checked\n");
+
+  CHECK(!mgtk_image_core_get(&core, "nofile", 200.0), "missing file has an entry\n");
+
+  files[1].broken=TRUE;
+  b=mgtk_image_core_get(&core, "file1", 200.0);
+  CHECK(b && b->state == MGTK_IMAGE_FAILED && !b->pic, "broken file is not FAILED\n");
+  CHECK(core.bytes == PIC_SIZE, "broken file: %lu bytes\n", core.bytes);
+  mgtk_image_core_unref(&core, b);
+
+  while(a->refcount) {
+    mgtk_image_core_unref(&core, a);
+  }
+  CHECK(is_unused(&core, a), "hits: unreferenced entry is not unused\n");
+
+  mgtk_image_core_cleanup(&core);
+  CHECK(live_pics == 0, "hits: %d pictures left\n", live_pics);
+}
+
+static void check_eviction(void) {
+  MgtkImageCore core;
+  MgtkImageEntry *e[N_FILES];
+  gint i;
+
+  reset_files();
+  mgtk_image_core_init(&core, &fake_class, NULL, BUDGET, RECHECK);
+
+  /* four in use, over budget, but nothing may go */
+  for(i=0;i<4;i++) {
+    e[i]=mgtk_image_core_get(&core, files[i].path, 0.0);
+  }
+  CHECK(core.bytes == 4*PIC_SIZE && live_pics == 4, "eviction: entries in use dropped\n");
+
+  /* unused in the order 0 1 2 3, 0 goes */
+  for(i=0;i<4;i++) {
+    mgtk_image_core_unref(&core, e[i]);
+  }
+  CHECK(core.bytes == BUDGET, "eviction: %lu bytes, budget %d\n", core.bytes, BUDGET);
+  CHECK(!g_hash_table_lookup(core.table, "file0"), "eviction: file0 still cached\n");
+
+  /* 1 is used again, so 2 is the oldest */
+  mgtk_image_core_unref(&core, mgtk_image_core_get(&core, "file1", 0.5));
+  mgtk_image_core_unref(&core, mgtk_image_core_get(&core, "file4", 0.5));
+  CHECK(!g_hash_table_lookup(core.table, "file2"), "eviction: file2 still cached\n");
+  CHECK(g_hash_table_lookup(core.table, "file1") && g_hash_table_lookup(core.table, "file3") &&
+        g_hash_table_lookup(core.table, "file4"), "eviction: wrong entry dropped\n");
+  CHECK(core.unused.head->data == g_hash_table_lookup(core.table, "file4") &&
+        core.unused.tail->data == g_hash_table_lookup(core.table, "file3"), "eviction: wrong LRU order\n");
+
+  decodes=0;
+  mgtk_image_core_unref(&core, mgtk_image_core_get(&core, "file0", 0.5));
+  CHECK(decodes == 1, "eviction: dropped file0 not decoded again\n");
+
+  mgtk_image_core_cleanup(&core);
+  CHECK(live_pics == 0, "eviction: %d pictures left\n", live_pics);
+}
+
+static void check_reload(void) {
+  MgtkImageCore core;
+  MgtkImageEntry *old, *new, *e;
+  Pic *old_pic;
+
+  reset_files();
+  mgtk_image_core_init(&core, &fake_class, NULL, BUDGET, RECHECK);
+
+  old=mgtk_image_core_get(&core, "file0", 10.0);
+  old_pic=(Pic *) old->pic;
+  files[0].days=2;
+
+  /* not looked at within the recheck time */
+  e=mgtk_image_core_get(&core, "file0", 11.0);
+  CHECK(e == old, "reload: changed within recheck time\n");
+  mgtk_image_core_unref(&core, e);
+
+  new=mgtk_image_core_get(&core, "file0", 12.0);
+  CHECK(new != old && decodes == 2, "reload: changed file not decoded again\n");
+  CHECK(old->stale && !old_pic->released, "reload: old entry in use not kept\n");
+  CHECK(g_hash_table_lookup(core.table, "file0") == new, "reload: new entry not in the table\n");
+  CHECK(core.bytes == 2*PIC_SIZE, "reload: %lu bytes\n", core.bytes);
+
+  mgtk_image_core_unref(&core, old);
+  CHECK(old_pic->released && live_pics == 1 && core.bytes == PIC_SIZE, "reload: stale entry not freed\n");
+  g_free(old_pic);
+
+  /* unused entry of a changed file goes right away */
+  mgtk_image_core_unref(&core, new);
+  files[0].days=3;
+  new=mgtk_image_core_get(&core, "file0", 20.0);
+  CHECK(live_pics == 1 && core.unused.length == 0, "reload: unused stale entry kept\n");
+
+  /* deleted file: NULL, the entry stays until it changes */
+  files[0].exists=FALSE;
+  CHECK(!mgtk_image_core_get(&core, "file0", 30.0), "reload: deleted file has an entry\n");
+  mgtk_image_core_unref(&core, new);
+
+  mgtk_image_core_cleanup(&core);
+  CHECK(live_pics == 0, "reload: %d pictures left\n", live_pics);
+}
+
+static void check_async(void) {
+  MgtkImageCore core;
+  MgtkImageEntry *a, *b;
+  gint obj1=0, obj2=0;
+
+  reset_files();
+  async=TRUE;
+  mgtk_image_core_init(&core, &fake_class, NULL, BUDGET, RECHECK);
+
+  a=mgtk_image_core_get(&core, "file0", 0.0);
+  CHECK(a->state == MGTK_IMAGE_LOADING, "async: not loading\n");
+  mgtk_image_core_wait(a, &obj1);
+  mgtk_image_core_ref(&core, a);
+  mgtk_image_core_wait(a, &obj2);
+  mgtk_image_core_unwait(a, &obj2);
+  mgtk_image_core_unref(&core, a);
+  CHECK(!is_unused(&core, a), "async: loading entry unused\n");
+
+  finish_one(&core);
+  CHECK(obj1 == 1 && obj2 == 0, "async: notified %d/%d\n", obj1, obj2);
+  CHECK(a->state == MGTK_IMAGE_READY && !a->waiting, "async: not ready\n");
+  mgtk_image_core_wait(a, &obj2);
+  CHECK(!a->waiting, "async: waiting for a ready entry\n");
+
+  /* nobody wants it anymore, before it is done */
+  b=mgtk_image_core_get(&core, "file1", 0.0);
+  mgtk_image_core_unref(&core, b);
+  CHECK(!is_unused(&core, b), "async: loading entry unused after unref\n");
+  finish_one(&core);
+  CHECK(is_unused(&core, b), "async: loaded unreferenced entry not unused\n");
+
+  /* file changes while loading, nobody uses the old one */
+  b=mgtk_image_core_get(&core, "file2", 0.0);
+  mgtk_image_core_unref(&core, b);
+  files[2].days=5;
+  mgtk_image_core_unref(&core, mgtk_image_core_get(&core, "file2", 10.0));
+  finish_one(&core);
+  finish_one(&core);
+  CHECK(live_pics == 3, "async: %d pictures, stale one not freed\n", live_pics);
+
+  mgtk_image_core_unref(&core, a);
+  mgtk_image_core_cleanup(&core);
+  CHECK(live_pics == 0, "async: %d pictures left\n", live_pics);
+  async=FALSE;
+}
+
+/* random gets, unrefs, file changes and decodes */
+static void check_random(void) {
+  MgtkImageCore core;
+  MgtkImageEntry *held[64];
+  gint n_held=0;
+  gulong unused_bytes;
+  gdouble now=0;
+  GList *l;
+  gint round, i, f;
+
+  reset_files();
+  mgtk_image_core_init(&core, &fake_class, NULL, BUDGET, RECHECK);
+  srand(1);
+
+  for(round=0;round<ROUNDS;round++) {
+    async=rand() % 2;
+    now+=(rand() % 10) / 10.0;
+
+    switch(rand() % 6) {
+      case 0:
+      case 1:
+        if(n_held < 64) {
+          f=rand() % N_FILES;
+          held[n_held]=mgtk_image_core_get(&core, files[f].path, now);
+          if(held[n_held]) {
+            CHECK(!strcmp(held[n_held]->path, files[f].path), "round %d: wrong path\n", round);
+            n_held++;
+          }
+        }
+        break;
+      case 2:
+      case 3:
+        if(n_held) {
+          i=rand() % n_held;
+          mgtk_image_core_unref(&core, held[i]);
+          held[i]=held[--n_held];
+        }
+        break;
+      case 4:
+        f=rand() % N_FILES;
+        files[f].days++;
+        files[f].exists=rand() % 8 != 0;
+        files[f].broken=rand() % 8 == 0;
+        break;
+      default:
+        finish_one(&core);
+        break;
+    }
+
+    /* bytes match the pictures, unused ones only over budget while none are left */
+    CHECK(core.bytes == (gulong) live_pics * PIC_SIZE, "round %d: %lu bytes for %d pictures\n",
+          round, core.bytes, live_pics);
+    unused_bytes=0;
+    for(l=core.unused.head;l;l=l->next) {
+      CHECK(!((MgtkImageEntry *) l->data)->refcount, "round %d: unused entry referenced\n", round);
+      CHECK(!((MgtkImageEntry *) l->data)->stale, "round %d: stale entry unused\n", round);
+      unused_bytes+=((MgtkImageEntry *) l->data)->bytes;
+    }
+    CHECK(unused_bytes <= core.budget, "round %d: %lu unused bytes over budget\n", round, unused_bytes);
+  }
+
+  while(finish_one(&core));
+  while(n_held) {
+    mgtk_image_core_unref(&core, held[--n_held]);
+  }
+  CHECK(core.bytes <= core.budget, "random: %lu bytes unused at the end\n", core.bytes);
+  mgtk_image_core_cleanup(&core);
+  CHECK(live_pics == 0, "random: %d pictures left\n", live_pics);
+  async=FALSE;
+}
+
+int main(void) {
+
+  check_hits();
+  check_eviction();
+  check_reload();
+  check_async();
+  check_random();
+
+  printf("test-imagecache: %s (%d failures)\n", failed ? "FAILED" : "PASSED", failed);
+  return failed ? EXIT_FAILURE : EXIT_SUCCESS;
+}
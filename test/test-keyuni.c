@@ -0,0 +1,251 @@
+/*
+ * host test for gdk/gdkkeyuni.c
+ *
+ * Exhaustive against the sources the tables were generated from:
+ *  - case conversion of every keyval below 0x10000 against the switch
+ *    gdk_keyval_convert_case had before the tables, plus the Latin 9
+ *    pairs the tables added
+ *  - every keysym -> unicode pair of keysymdef.h (keysympairs.h, made
+ *    by gen-keytab.py --pairs), and no other character for keyvals
+ *    below the function keys
+ *  - every unicode character: its keyval maps back to it, no exact
+ *    keysym is missed, Latin-1 never falls back to 0x01000000 | wc
+ *  - directly encoded keyvals and their case
+ *
+ * $Id: test-keyuni.c,v 1.1 2026/10/19 22:00:00 o1i Exp $
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#include <glib.h>
+
+/* gdkkeys.h pulls in all of gdk, only these are needed */
+#define __GDK_KEYS_H__
+guint32 gdk_keyval_to_unicode(guint keyval);
+guint gdk_unicode_to_keyval(guint32 wc);
+void gdk_keyval_convert_case(guint symbol, guint *lower, guint *upper);
+
+#include "../gdk/gdkkeyuni.c"
+#include "gdkkeysyms.h"
+
+#define KEYVALS 0x10000
+#define UNICODE 0x110000
+#define UCS(wc) ((wc) | 0x01000000)
+
+typedef struct {
+  guint keysym;
+  guint ucs;
+  gboolean exact;
+} Pair;
+
+static const Pair pairs[]={
+#include "keysympairs.h"
+};
+
+#define N_PAIRS (sizeof(pairs)/sizeof(pairs[0]))
+
+static int failed=0;
+
+#define CHECK(cond, ...) \
+  do { \
+    if(!(cond)) { \
+      if(failed++ < 10) { \
+        printf(__VA_ARGS__); \
+      } \
+    } \
+  } while(0)
+
+/* the switch of gdk_keyval_convert_case before gdkkeytab.h */
+static void ref_convert_case(guint symbol, guint *lower, guint *upper) {
+  guint xlower=symbol;
+  guint xupper=symbol;
+
+  switch(symbol >> 8) {
+    case 0: /* Latin 1 */
+      if(symbol >= GDK_A && symbol <= GDK_Z)
+        xlower+=GDK_a - GDK_A;
+      else if(symbol >= GDK_a && symbol <= GDK_z)
+        xupper-=GDK_a - GDK_A;
+      else if(symbol >= GDK_Agrave && symbol <= GDK_Odiaeresis)
+        xlower+=GDK_agrave - GDK_Agrave;
+      else if(symbol >= GDK_agrave && symbol <= GDK_odiaeresis)
+        xupper-=GDK_agrave - GDK_Agrave;
+      else if(symbol >= GDK_Ooblique && symbol <= GDK_Thorn)
+        xlower+=GDK_oslash - GDK_Ooblique;
+      else if(symbol >= GDK_oslash && symbol <= GDK_thorn)
+        xupper-=GDK_oslash - GDK_Ooblique;
+      break;
+
+    case 1: /* Latin 2 */
+      if(symbol == GDK_Aogonek)
+        xlower=GDK_aogonek;
+      else if(symbol >= GDK_Lstroke && symbol <= GDK_Sacute)
+        xlower+=GDK_lstroke - GDK_Lstroke;
+      else if(symbol >= GDK_Scaron && symbol <= GDK_Zacute)
+        xlower+=GDK_scaron - GDK_Scaron;
+      else if(symbol >= GDK_Zcaron && symbol <= GDK_Zabovedot)
+        xlower+=GDK_zcaron - GDK_Zcaron;
+      else if(symbol == GDK_aogonek)
+        xupper=GDK_Aogonek;
+      else if(symbol >= GDK_lstroke && symbol <= GDK_sacute)
+        xupper-=GDK_lstroke - GDK_Lstroke;
+      else if(symbol >= GDK_scaron && symbol <= GDK_zacute)
+        xupper-=GDK_scaron - GDK_Scaron;
+      else if(symbol >= GDK_zcaron && symbol <= GDK_zabovedot)
+        xupper-=GDK_zcaron - GDK_Zcaron;
+      else if(symbol >= GDK_Racute && symbol <= GDK_Tcedilla)
+        xlower+=GDK_racute - GDK_Racute;
+      else if(symbol >= GDK_racute && symbol <= GDK_tcedilla)
+        xupper-=GDK_racute - GDK_Racute;
+      break;
+
+    case 2: /* Latin 3 */
+      if(symbol >= GDK_Hstroke && symbol <= GDK_Hcircumflex)
+        xlower+=GDK_hstroke - GDK_Hstroke;
+      else if(symbol >= GDK_Gbreve && symbol <= GDK_Jcircumflex)
+        xlower+=GDK_gbreve - GDK_Gbreve;
+      else if(symbol >= GDK_hstroke && symbol <= GDK_hcircumflex)
+        xupper-=GDK_hstroke - GDK_Hstroke;
+      else if(symbol >= GDK_gbreve && symbol <= GDK_jcircumflex)
+        xupper-=GDK_gbreve - GDK_Gbreve;
+      else if(symbol >= GDK_Cabovedot && symbol <= GDK_Scircumflex)
+        xlower+=GDK_cabovedot - GDK_Cabovedot;
+      else if(symbol >= GDK_cabovedot && symbol <= GDK_scircumflex)
+        xupper-=GDK_cabovedot - GDK_Cabovedot;
+      break;
+
+    case 3: /* Latin 4 */
+      if(symbol >= GDK_Rcedilla && symbol <= GDK_Tslash)
+        xlower+=GDK_rcedilla - GDK_Rcedilla;
+      else if(symbol >= GDK_rcedilla && symbol <= GDK_tslash)
+        xupper-=GDK_rcedilla - GDK_Rcedilla;
+      else if(symbol == GDK_ENG)
+        xlower=GDK_eng;
+      else if(symbol == GDK_eng)
+        xupper=GDK_ENG;
+      else if(symbol >= GDK_Amacron && symbol <= GDK_Umacron)
+        xlower+=GDK_amacron - GDK_Amacron;
+      else if(symbol >= GDK_amacron && symbol <= GDK_umacron)
+        xupper-=GDK_amacron - GDK_Amacron;
+      break;
+
+    case 6: /* Cyrillic */
+      if(symbol >= GDK_Serbian_DJE && symbol <= GDK_Serbian_DZE)
+        xlower-=GDK_Serbian_DJE - GDK_Serbian_dje;
+      else if(symbol >= GDK_Serbian_dje && symbol <= GDK_Serbian_dze)
+        xupper+=GDK_Serbian_DJE - GDK_Serbian_dje;
+      else if(symbol >= GDK_Cyrillic_YU && symbol <= GDK_Cyrillic_HARDSIGN)
+        xlower-=GDK_Cyrillic_YU - GDK_Cyrillic_yu;
+      else if(symbol >= GDK_Cyrillic_yu && symbol <= GDK_Cyrillic_hardsign)
+        xupper+=GDK_Cyrillic_YU - GDK_Cyrillic_yu;
+      break;
+
+    case 7: /* Greek */
+      if(symbol >= GDK_Greek_ALPHAaccent && symbol <= GDK_Greek_OMEGAaccent)
+        xlower+=GDK_Greek_alphaaccent - GDK_Greek_ALPHAaccent;
+      else if(symbol >= GDK_Greek_alphaaccent && symbol <= GDK_Greek_omegaaccent &&
+              symbol != GDK_Greek_iotaaccentdieresis &&
+              symbol != GDK_Greek_upsilonaccentdieresis)
+        xupper-=GDK_Greek_alphaaccent - GDK_Greek_ALPHAaccent;
+      else if(symbol >= GDK_Greek_ALPHA && symbol <= GDK_Greek_OMEGA)
+        xlower+=GDK_Greek_alpha - GDK_Greek_ALPHA;
+      else if(symbol >= GDK_Greek_alpha && symbol <= GDK_Greek_omega &&
+              symbol != GDK_Greek_finalsmallsigma)
+        xupper-=GDK_Greek_alpha - GDK_Greek_ALPHA;
+      break;
+
+    case 0x13: /* Latin 9, new with the tables */
+      if(symbol == GDK_OE)
+        xlower=GDK_oe;
+      else if(symbol == GDK_oe)
+        xupper=GDK_OE;
+      else if(symbol == GDK_Ydiaeresis)
+        xlower=GDK_ydiaeresis;
+      break;
+  }
+
+  *lower=xlower;
+  *upper=xupper;
+}
+
+static void check_case(void) {
+  guint lower, upper;
+  guint ref_lower, ref_upper;
+  guint k;
+
+  for(k=0;k<KEYVALS;k++) {
+    ref_convert_case(k, &ref_lower, &ref_upper);
+    gdk_keyval_convert_case(k, &lower, &upper);
+    CHECK(lower == ref_lower && upper == ref_upper,
+          "case 0x%04x: 0x%04x/0x%04x, should be 0x%04x/0x%04x\n", k, lower, upper, ref_lower, ref_upper);
+  }
+
+  /* NULL for either is allowed */
+  gdk_keyval_convert_case(GDK_A, NULL, &upper);
+  CHECK(upper == GDK_A, "case: upper of A alone\n");
+  gdk_keyval_convert_case(GDK_A, &lower, NULL);
+  CHECK(lower == GDK_a, "case: lower of A alone\n");
+
+  /* directly encoded: Cyrillic be, Armenian Ayb, both without keysym */
+  gdk_keyval_convert_case(UCS(0x0431), &lower, &upper);
+  CHECK(lower == GDK_Cyrillic_be && upper == GDK_Cyrillic_BE, "case: U+0431 0x%x/0x%x\n", lower, upper);
+  gdk_keyval_convert_case(UCS(0x0531), &lower, &upper);
+  CHECK(lower == UCS(0x0561) && upper == UCS(0x0531), "case: U+0531 0x%x/0x%x\n", lower, upper);
+}
+
+static void check_to_unicode(void) {
+  static guint expected[KEYVALS];
+  guint k;
+  gsize i;
+
+  for(i=0;i<N_PAIRS;i++) {
+    expected[pairs[i].keysym]=pairs[i].ucs;
+  }
+
+  for(k=0;k<KEYVALS;k++) {
+    CHECK(gdk_keyval_to_unicode(k) == expected[k],
+          "to unicode 0x%04x: U+%04X, should be U+%04X\n", k, gdk_keyval_to_unicode(k), expected[k]);
+  }
+
+  CHECK(gdk_keyval_to_unicode(GDK_KP_5) == '5', "to unicode: KP_5\n");
+  CHECK(gdk_keyval_to_unicode(GDK_KP_Enter) == '\r', "to unicode: KP_Enter\n");
+  CHECK(gdk_keyval_to_unicode(GDK_Home) == 0, "to unicode: Home\n");
+  CHECK(gdk_keyval_to_unicode(UCS(0x20ac)) == 0x20ac, "to unicode: directly encoded\n");
+}
+
+static void check_from_unicode(void) {
+  static gboolean has_exact[UNICODE];
+  guint keyval;
+  guint wc;
+  gsize i;
+
+  /* the reverse table only covers the character pages */
+  for(i=0;i<N_PAIRS;i++) {
+    if(pairs[i].exact && pairs[i].keysym >= 0x100 && pairs[i].keysym < 0xfe00) {
+      has_exact[pairs[i].ucs]=TRUE;
+    }
+  }
+
+  for(wc=0;wc<UNICODE;wc++) {
+    keyval=gdk_unicode_to_keyval(wc);
+    if(keyval == UCS(wc)) {
+      CHECK(!has_exact[wc], "from unicode U+%04X: keysym missed\n", wc);
+      CHECK(!((wc >= 0x20 && wc <= 0x7e) || (wc >= 0xa0 && wc <= 0xff)),
+            "from unicode U+%04X: Latin-1 not 1:1\n", wc);
+      continue;
+    }
+    CHECK(gdk_keyval_to_unicode(keyval) == wc,
+          "from unicode U+%04X: 0x%04x goes back to U+%04X\n", wc, keyval, gdk_keyval_to_unicode(keyval));
+  }
+}
+
+int main(void) {
+
+  check_case();
+  check_to_unicode();
+  check_from_unicode();
+
+  printf("test-keyuni: %s (%d failures)\n", failed ? "FAILED" : "PASSED", failed);
+  return failed ? EXIT_FAILURE : EXIT_SUCCESS;
+}
@@ -0,0 +1,259 @@
+/*
+ * host test for gdk/gdkline.c
+ *
+ * Dashes have to continue across the vertices of a polyline: thin ones
+ * with the default pattern and with an offset, and wide ones, whose
+ * dash runs around a mitered corner. The results are compared with
+ * reference images ('#' is a set pixel).
+ *
+ * Miter joins have to turn into bevels below 11 degrees between the
+ * lines, like in X11: the tip of the join must reach as far as the
+ * miter goes above the limit and must not stick out below it.
+ *
+ * $Id: test-line.c,v 1.1 2026/10/19 22:00:00 o1i Exp $
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+
+#include "gdkline.h"
+
+#define W 32
+#define H 32
+
+static char image[H][W+1];
+static int  twice;
+static int  outside;
+
+static int failed=0;
+
+#define CHECK(cond, ...) \
+  do { \
+    if(!(cond)) { \
+      if(failed++ < 10) { \
+        printf(__VA_ARGS__); \
+      } \
+    } \
+  } while(0)
+
+static const char *thin_corner_image[]={
+  "..........",
+  ".####.....",
+  "..........",
+  "..........",
+  "......#...",
+  "......#...",
+  "......#...",
+  "......#...",
+  "..........",
+  "..........",
+  "..........",
+  "..........",
+  "...####...",
+  NULL
+};
+
+static const char *thin_corner_offset_image[]={
+  "..........",
+  ".##..##...",
+  "......#...",
+  "..........",
+  "..........",
+  "......#...",
+  "......#...",
+  "......#...",
+  "..........",
+  "..........",
+  "......#...",
+  "......#...",
+  ".###..#...",
+  NULL
+};
+
+static const char *wide_corner_image[]={
+  "..........................",
+  "...##########.....####....",
+  "...##########.....####....",
+  "...##########.....####....",
+  "...##########.....####....",
+  "..................####....",
+  "..................####....",
+  "..................####....",
+  "..................####....",
+  "..................####....",
+  "..................####....",
+  "..........................",
+  "..........................",
+  "..........................",
+  "..........................",
+  "..........................",
+  "..................####....",
+  "..................####....",
+  "..................####....",
+  "..................####....",
+  "..................####....",
+  "..................####....",
+  "..................####....",
+  "..................####....",
+  NULL
+};
+
+static void pixel(gint x, gint y) {
+
+  if(x < 0 || y < 0 || x >= W || y >= H) {
+    outside++;
+    return;
+  }
+  if(image[y][x] == '#') {
+    twice++;
+  }
+  image[y][x]='#';
+}
+
+/* thin runs are horizontal, vertical or diagonal in these fixtures */
+static void run(gint x1, gint y1, gint x2, gint y2, gpointer data) {
+  gint n;
+  gint i;
+
+  n=MAX(ABS(x2-x1), ABS(y2-y1));
+  for(i=0;i<=n;i++) {
+    pixel(x1 + (n ? (x2-x1)*i/n : 0), y1 + (n ? (y2-y1)*i/n : 0));
+  }
+}
+
+/* wide pieces and their joins may overlap */
+static void span(gint y, gint x1, gint x2, gpointer data) {
+  gint x;
+
+  for(x=x1;x<=x2;x++) {
+    if(x < 0 || y < 0 || x >= W || y >= H) {
+      outside++;
+    }
+    else {
+      image[y][x]='#';
+    }
+  }
+}
+
+static void clear(void) {
+  gint y;
+
+  for(y=0;y<H;y++) {
+    memset(image[y], '.', W);
+    image[y][W]=0;
+  }
+  twice=0;
+  outside=0;
+}
+
+static void compare(const char *name, const char **reference) {
+  size_t len;
+  int y;
+
+  CHECK(!twice, "%s: %d pixels set twice\n", name, twice);
+  CHECK(!outside, "%s: %d pixels outside\n", name, outside);
+
+  /* right of and below the reference everything is empty */
+  for(y=0;y<H && reference[y];y++) {
+    len=strlen(reference[y]);
+    CHECK(!strncmp(image[y], reference[y], len) && !strchr(image[y]+len, '#'),
+          "%s: row %2d is %s\n%*s should be %s\n", name, y, image[y], (int) strlen(name)+11, "", reference[y]);
+  }
+  for(;y<H;y++) {
+    CHECK(!strchr(image[y], '#'), "%s: row %2d is %s, should be empty\n", name, y, image[y]);
+  }
+}
+
+/*********************************
+ * miter limit
+ *********************************/
+#define MITER_LEN 200
+
+static gint tip;
+
+/* only the rightmost pixel matters */
+static void tip_span(gint y, gint x1, gint x2, gpointer data) {
+
+  if(x2 > tip) {
+    tip=x2;
+  }
+}
+
+/* a line to the right, then back at an angle of deg degrees to it */
+static void check_miter(MgtkLineAttr *attr, double deg) {
+  MgtkLinePoint p[3];
+  double t;
+  double half;
+  double reach;
+  double vertex;
+
+  t=deg*G_PI/180;
+  p[0].x=0;
+  p[0].y=MITER_LEN;
+  p[1].x=MITER_LEN;
+  p[1].y=MITER_LEN;
+  p[2].x=MITER_LEN - (gint) floor(MITER_LEN*cos(t) + 0.5);
+  p[2].y=MITER_LEN - (gint) floor(MITER_LEN*sin(t) + 0.5);
+
+  tip=-1;
+  mgtk_line_draw(attr, p, 3, NULL, tip_span, NULL);
+
+  /* the miter tip lies half/tan(t/2) right of the vertex, with t
+   * taken from the rounded end point
+   */
+  t=atan2(MITER_LEN - p[2].y, MITER_LEN - p[2].x);
+  half=attr->width/2.0;
+  vertex=MITER_LEN + 0.5;
+  reach=vertex + half/tan(t/2);
+
+  if(deg > 11) {
+    /* the spike covers no pixel centre, where it is thinner than a row */
+    CHECK(tip >= (gint) (reach - 0.5/tan(t/2)) - 1, "miter at %g degrees: tip at %d, should reach %g\n", deg, tip, reach);
+  }
+  else {
+    CHECK(tip <= (gint) (vertex + half) + 1, "bevel at %g degrees: tip at %d, miter would reach %g\n", deg, tip, reach);
+  }
+}
+
+int main(void) {
+  MgtkLineAttr attr={ 0, MGTK_LINE_ON_OFF_DASH, MGTK_CAP_BUTT, MGTK_JOIN_MITER, NULL, 0, 0 };
+  MgtkLinePoint thin[4]={ {1,1}, {6,1}, {6,12}, {1,12} };
+  MgtkLinePoint wide[3]={ {3,3}, {20,3}, {20,24} };
+  static const gint8 dashes[2]={ 3, 2 };
+  static const gint8 long_dashes[2]={ 10, 5 };
+  static const double angles[]={ 5, 8, 10, 12, 15, 30, 60, 90, 135 };
+  guint i;
+
+  /* default 4 on, 4 off around two corners */
+  clear();
+  mgtk_line_draw(&attr, thin, 4, run, span, NULL);
+  compare("thin dashes", thin_corner_image);
+
+  attr.dashes=dashes;
+  attr.n_dashes=2;
+  attr.dash_offset=1;
+  clear();
+  mgtk_line_draw(&attr, thin, 4, run, span, NULL);
+  compare("thin dashes, offset", thin_corner_offset_image);
+
+  /* the second dash starts before the corner and ends after it */
+  attr.dashes=long_dashes;
+  attr.dash_offset=0;
+  attr.width=4;
+  clear();
+  mgtk_line_draw(&attr, wide, 3, run, span, NULL);
+  compare("wide dashes", wide_corner_image);
+
+  attr.style=MGTK_LINE_SOLID;
+  attr.dashes=NULL;
+  attr.n_dashes=0;
+  attr.width=5;
+  for(i=0;i<sizeof(angles)/sizeof(angles[0]);i++) {
+    check_miter(&attr, angles[i]);
+  }
+
+  printf("test-line: %s (%d failures)\n", failed ? "FAILED" : "PASSED", failed);
+  return failed ? EXIT_FAILURE : EXIT_SUCCESS;
+}
@@ -0,0 +1,356 @@
+/*
+ * host test for classes/markup.c
+ *
+ *  - random documents of tags, entities, text, line breaks, embedded 0
+ *    and unbalanced close tags against a model of the parser: the plain
+ *    text and the style of every character
+ *  - every prefix of them (truncated tags and entities) and random
+ *    garbage: the plain text length and the runs stay consistent,
+ *    runs cover all characters but the line breaks exactly once, never
+ *    span a line and neighbours differ in style
+ *  - nesting deeper than the parser's stack
+ *  - time for a large document
+ *
+ * $Id: test-markup.c,v 1.1 2026/10/19 22:00:00 o1i Exp $
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "markup.h"
+
+#define ROUNDS     3000
+#define MAX_TOKENS 60
+#define MAX_DEPTH  32    /* as in markup.c */
+#define BIG_LINES  20000
+
+typedef struct {
+  guint   style;
+  gint    size;
+  guint32 rgb;
+} Style;
+
+/* the model of the parser */
+typedef struct {
+  GString *markup;
+  GString *text;
+  GArray  *styles;   /* Style of every byte of text, line breaks too */
+  Style    stack[MAX_DEPTH];
+  guint    depth;
+  guint    overflow;
+} Model;
+
+static int failed=0;
+
+#define CHECK(cond, ...) \
+  do { \
+    if(!(cond)) { \
+      if(failed++ < 10) { \
+        printf(__VA_ARGS__); \
+      } \
+    } \
+  } while(0)
+
+static void model_text(Model *m, const gchar *markup, const gchar *text, guint len) {
+  guint i;
+
+  g_string_append_len(m->markup, markup, strlen(markup));
+  g_string_append_len(m->text, text, len);
+  for(i=0;i<len;i++) {
+    g_array_append_val(m->styles, m->stack[m->depth]);
+  }
+}
+
+static Style *model_push(Model *m, const gchar *markup) {
+
+  g_string_append_len(m->markup, markup, strlen(markup));
+  if(m->depth + 1 >= MAX_DEPTH) {
+    m->overflow++;
+    return NULL;
+  }
+  m->stack[m->depth + 1]=m->stack[m->depth];
+  m->depth++;
+  return &m->stack[m->depth];
+}
+
+static void model_pop(Model *m, const gchar *markup) {
+
+  g_string_append_len(m->markup, markup, strlen(markup));
+  if(m->overflow) {
+    m->overflow--;
+  }
+  else if(m->depth) {
+    m->depth--;
+  }
+}
+
+static void random_token(Model *m) {
+  static const gchar *words[]={ "abc", "x y", "Hello", " ", ">", "a;b", "&#;", "& " };
+  const gchar *w;
+  Style *s;
+  gchar zero=0;
+
+  switch(rand() % 23) {
+    case 0:  if((s=model_push(m, "<b>"))) s->style|=MGTK_MARKUP_BOLD; break;
+    case 1:  if((s=model_push(m, "<i>"))) s->style|=MGTK_MARKUP_ITALIC; break;
+    case 2:  if((s=model_push(m, "<u>"))) s->style|=MGTK_MARKUP_UNDERLINE; break;
+    case 3:  if((s=model_push(m, "<tt>"))) s->style|=MGTK_MARKUP_MONOSPACE; break;
+    case 4:
+      if((s=model_push(m, "<sub>"))) {
+        s->style=(s->style & ~MGTK_MARKUP_SUPERSCRIPT) | MGTK_MARKUP_SUBSCRIPT;
+      }
+      break;
+    case 5:
+      if((s=model_push(m, "<sup>"))) {
+        s->style=(s->style & ~MGTK_MARKUP_SUBSCRIPT) | MGTK_MARKUP_SUPERSCRIPT;
+      }
+      break;
+    case 6:  if((s=model_push(m, "<big>"))) s->size++; break;
+    case 7:  if((s=model_push(m, "<small>"))) s->size--; break;
+    case 8:
+      if((s=model_push(m, "<span foreground=\"#f00\" weight='bold'>"))) {
+        s->style|=MGTK_MARKUP_COLOR | MGTK_MARKUP_BOLD;
+        s->rgb=0xff0000;
+      }
+      break;
+    case 9:
+      if((s=model_push(m, "<span size=\"larger\" style=\"normal\" bogus=\"1\">"))) {
+        s->size++;
+        s->style&=~MGTK_MARKUP_ITALIC;
+      }
+      break;
+    case 10: model_push(m, "<unknown attr=\"x\">"); break;
+    case 21:
+      if((s=model_push(m, "<span color=\"Blue\">"))) {
+        s->style|=MGTK_MARKUP_COLOR;
+        s->rgb=0x0000ff;
+      }
+      break;
+    case 11:
+    case 12: model_pop(m, rand() % 2 ? "</b>" : "</>"); break;
+    case 13: model_text(m, "<empty/>", "", 0); break;
+    case 14: model_text(m, "&amp;", "&", 1); break;
+    case 15: model_text(m, "&lt;", "<", 1); break;
+    case 16: model_text(m, "&#65;", "A", 1); break;
+    case 17: model_text(m, "&#x263a;", "\xe2\x98\xba", 3); break;
+    case 18: model_text(m, "&bogus;", "&bogus;", 7); break;
+    case 19: model_text(m, "\n", "\n", 1); break;
+    case 20:
+      g_string_append_len(m->markup, &zero, 1);
+      break;
+    default:
+      w=words[rand() % 8];
+      model_text(m, w, w, strlen(w));
+      break;
+  }
+}
+
+/* true for every result, whatever the input */
+static void check_consistent(const gchar *what, gint round, const MgtkMarkup *r) {
+  const MgtkMarkupRun *run, *prev;
+  guint covered=0;
+  guint newlines=0;
+  guint line=0;
+  guint pos=0;
+  guint i, k;
+
+  CHECK(r->text && strlen(r->text) == r->text_len, "%s %d: text_len %u, strlen %u\n",
+        what, round, r->text_len, r->text ? (guint) strlen(r->text) : 0);
+
+  for(i=0;i<r->text_len;i++) {
+    newlines+=r->text[i] == '\n';
+  }
+  CHECK(r->n_lines == newlines + 1, "%s %d: %u lines, %u line breaks\n", what, round, r->n_lines, newlines);
+
+  prev=NULL;
+  for(i=0;i<r->n_runs;i++) {
+    run=&r->runs[i];
+    CHECK(run->length > 0, "%s %d: empty run %u\n", what, round, i);
+    CHECK(run->offset >= pos && run->offset + run->length <= r->text_len,
+          "%s %d: run %u at %u+%u, text %u, previous end %u\n", what, round, i,
+          run->offset, run->length, r->text_len, pos);
+    if(run->offset < pos || run->offset + run->length > r->text_len) {
+      return;
+    }
+
+    /* line of the run from the line breaks before it */
+    for(k=pos;k<run->offset;k++) {
+      line+=r->text[k] == '\n';
+    }
+    CHECK(run->line == line, "%s %d: run %u on line %u, should be %u\n", what, round, i, run->line, line);
+    CHECK(!memchr(r->text + run->offset, '\n', run->length), "%s %d: run %u spans a line\n", what, round, i);
+    CHECK(!((run->style & MGTK_MARKUP_SUBSCRIPT) && (run->style & MGTK_MARKUP_SUPERSCRIPT)),
+          "%s %d: run %u sub and superscript\n", what, round, i);
+
+    if(prev && prev->offset + prev->length == run->offset && prev->line == run->line) {
+      CHECK(prev->style != run->style || prev->size != run->size || prev->rgb != run->rgb,
+            "%s %d: runs %u and %u not merged\n", what, round, i-1, i);
+    }
+
+    covered+=run->length;
+    pos=run->offset + run->length;
+    prev=run;
+  }
+
+  CHECK(covered + newlines == r->text_len, "%s %d: runs cover %u of %u bytes, %u line breaks\n",
+        what, round, covered, r->text_len, newlines);
+}
+
+static void check_model(gint round, const Model *m, const MgtkMarkup *r) {
+  const MgtkMarkupRun *run;
+  const Style *want;
+  guint i, k;
+
+  CHECK(r->text_len == m->text->len && !memcmp(r->text, m->text->str, m->text->len),
+        "model %d: text \"%s\", should be \"%s\"\n", round, r->text, m->text->str);
+  if(r->text_len != m->text->len) {
+    return;
+  }
+
+  for(i=0;i<r->n_runs;i++) {
+    run=&r->runs[i];
+    for(k=run->offset;k<run->offset + run->length && k<r->text_len;k++) {
+      want=&g_array_index(m->styles, Style, k);
+      CHECK(run->style == want->style && run->size == want->size && run->rgb == want->rgb,
+            "model %d: byte %u style 0x%x/%d/%06x, should be 0x%x/%d/%06x\n", round, k,
+            run->style, run->size, run->rgb, want->style, want->size, want->rgb);
+    }
+  }
+}
+
+/* parse exactly len bytes, in a buffer without anything behind it */
+static MgtkMarkup *parse_exact(const gchar *markup, guint len) {
+  MgtkMarkup *r;
+  gchar *buf;
+
+  buf=g_malloc(len ? len : 1);
+  memcpy(buf, markup, len);
+  r=mgtk_markup_parse(buf, len);
+  g_free(buf);
+
+  return r;
+}
+
+static void check_random(void) {
+  MgtkMarkup *r;
+  Model m;
+  gint round, n, i;
+  guint len;
+
+  srand(1);
+
+  for(round=0;round<ROUNDS;round++) {
+    memset(&m, 0, sizeof(m));
+    m.markup=g_string_sized_new(256);
+    m.text=g_string_sized_new(256);
+    m.styles=g_array_new(FALSE, FALSE, sizeof(Style));
+
+    n=rand() % MAX_TOKENS;
+    for(i=0;i<n;i++) {
+      random_token(&m);
+    }
+
+    r=parse_exact(m.markup->str, m.markup->len);
+    check_consistent("model", round, r);
+    check_model(round, &m, r);
+    mgtk_markup_free(r);
+
+    /* truncated anywhere */
+    for(len=0;len<m.markup->len;len++) {
+      r=parse_exact(m.markup->str, len);
+      check_consistent("prefix", round, r);
+      mgtk_markup_free(r);
+    }
+
+    g_string_free(m.markup, TRUE);
+    g_string_free(m.text, TRUE);
+    g_array_free(m.styles, TRUE);
+  }
+}
+
+static void check_garbage(void) {
+  static const gchar alphabet[]="<>&;/#xX\"'= abspan0123456789\n";
+  MgtkMarkup *r;
+  gchar buf[80];
+  gint round;
+  guint len, i;
+
+  for(round=0;round<ROUNDS*10;round++) {
+    len=rand() % sizeof(buf);
+    for(i=0;i<len;i++) {
+      buf[i]=rand() % 16 ? alphabet[rand() % (sizeof(alphabet)-1)] : (gchar) (rand() & 0xff);
+    }
+    r=parse_exact(buf, len);
+    check_consistent("garbage", round, r);
+    mgtk_markup_free(r);
+  }
+
+  r=mgtk_markup_parse(NULL, -1);
+  CHECK(r && r->text_len == 0 && r->n_runs == 0 && r->n_lines == 1, "NULL markup\n");
+  mgtk_markup_free(r);
+}
+
+static void check_deep(void) {
+  GString *markup;
+  MgtkMarkup *r;
+  gint i;
+
+  markup=g_string_sized_new(1024);
+  for(i=0;i<100;i++) {
+    g_string_append_len(markup, "<b>", 3);
+  }
+  g_string_append_len(markup, "deep", 4);
+  for(i=0;i<100;i++) {
+    g_string_append_len(markup, "</b>", 4);
+  }
+  g_string_append_len(markup, "flat</i></i>", 12);
+
+  r=mgtk_markup_parse(markup->str, markup->len);
+  check_consistent("deep", 0, r);
+  CHECK(r->n_runs == 2 && r->runs[0].length == 4 && r->runs[0].style == MGTK_MARKUP_BOLD &&
+        r->runs[1].style == 0, "deep: %u runs, wrong styles\n", r->n_runs);
+  mgtk_markup_free(r);
+  g_string_free(markup, TRUE);
+}
+
+static void bench(void) {
+  static const gchar line[]=
+    "<b>bold</b> and <span foreground=\"#ff0000\" size=\"larger\">red &amp; big</span> "
+    "<i>text <tt>mono</tt></i> &#x263a;\n";
+  GString *markup;
+  MgtkMarkup *r;
+  GTimer *timer;
+  gdouble t;
+  gint i;
+
+  markup=g_string_sized_new(sizeof(line) * BIG_LINES);
+  for(i=0;i<BIG_LINES;i++) {
+    g_string_append_len(markup, line, sizeof(line)-1);
+  }
+
+  timer=g_timer_new();
+  r=mgtk_markup_parse(markup->str, markup->len);
+  t=g_timer_elapsed(timer, NULL);
+  g_timer_destroy(timer);
+
+  check_consistent("big", 0, r);
+  CHECK(r->n_lines == BIG_LINES + 1, "big: %u lines\n", r->n_lines);
+
+  printf("%u bytes markup, %u runs: %8.4fs, %.1f MB/s\n", (guint) markup->len, r->n_runs, t,
+         t > 0 ? markup->len / t / (1024*1024) : 0.0);
+
+  mgtk_markup_free(r);
+  g_string_free(markup, TRUE);
+}
+
+int main(void) {
+
+  check_random();
+  check_garbage();
+  check_deep();
+  bench();
+
+  printf("test-markup: %s (%d failures)\n", failed ? "FAILED" : "PASSED", failed);
+  return failed ? EXIT_FAILURE : EXIT_SUCCESS;
+}
@@ -0,0 +1,162 @@
+/*
+ * host test for gdk/gdkmonitor.c
+ *
+ * Random layouts of up to MGTK_MAX_MONITORS monitors (overlapping,
+ * empty, partly off screen, none at all) are compared with a plain
+ * search over all monitors, the way GTK+ does it:
+ *  - the monitor at every point in and around the screen
+ *  - the monitor at a random rectangle at every point
+ *  - the layout differs from a changed description, but not from the
+ *    one it was built from
+ *
+ * $Id: test-monitor.c,v 1.1 2026/10/19 22:00:00 o1i Exp $
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "gdkmonitor.h"
+
+#define ROUNDS 3000
+#define SIZE   40
+#define MARGIN 10
+
+static int failed=0;
+
+#define CHECK(cond, ...) \
+  do { \
+    if(!(cond)) { \
+      if(failed++ < 10) { \
+        printf(__VA_ARGS__); \
+      } \
+    } \
+  } while(0)
+
+/* distance along the nearer axis, 0 inside */
+static gint ref_nearest(const MgtkDisplayDesc *d, gint x, gint y) {
+  const MgtkMonitorRect *m;
+  gint dx, dy, dist;
+  gint best=0;
+  gint best_dist=G_MAXINT;
+  gint i;
+
+  for(i=0;i<d->n_monitors;i++) {
+    m=&d->monitors[i];
+    if(x < m->x)
+      dx=m->x - x;
+    else if(x >= m->x + m->width)
+      dx=x - (m->x + m->width) + 1;
+    else
+      dx=0;
+    if(y < m->y)
+      dy=m->y - y;
+    else if(y >= m->y + m->height)
+      dy=y - (m->y + m->height) + 1;
+    else
+      dy=0;
+    dist=MIN(dx, dy);
+    if(dist < best_dist) {
+      best_dist=dist;
+      best=i;
+    }
+  }
+  return best;
+}
+
+static gint ref_point(const MgtkDisplayDesc *d, gint x, gint y) {
+  const MgtkMonitorRect *m;
+  gint i;
+
+  for(i=0;i<d->n_monitors;i++) {
+    m=&d->monitors[i];
+    if(x >= m->x && x < m->x + m->width && y >= m->y && y < m->y + m->height) {
+      return i;
+    }
+  }
+  return ref_nearest(d, x, y);
+}
+
+static gint ref_rect(const MgtkDisplayDesc *d, const MgtkMonitorRect *r) {
+  const MgtkMonitorRect *m;
+  gint x1, y1, x2, y2;
+  gint best=-1;
+  gint best_area=0;
+  gint i;
+
+  for(i=0;i<d->n_monitors;i++) {
+    m=&d->monitors[i];
+    x1=MAX(r->x, m->x);
+    y1=MAX(r->y, m->y);
+    x2=MIN(r->x + r->width, m->x + m->width);
+    y2=MIN(r->y + r->height, m->y + m->height);
+    if(x2 > x1 && y2 > y1 && (x2-x1)*(y2-y1) > best_area) {
+      best_area=(x2-x1)*(y2-y1);
+      best=i;
+    }
+  }
+  if(best >= 0) {
+    return best;
+  }
+  return ref_nearest(d, r->x + r->width/2, r->y + r->height/2);
+}
+
+static void random_desc(MgtkDisplayDesc *d) {
+  gint i;
+
+  memset(d, 0, sizeof(*d));
+  d->width=SIZE;
+  d->height=SIZE;
+  d->n_monitors=rand() % (MGTK_MAX_MONITORS+1);
+  for(i=0;i<d->n_monitors;i++) {
+    d->monitors[i].x=rand() % 30 - 5;
+    d->monitors[i].y=rand() % 30 - 5;
+    d->monitors[i].width=rand() % 15;
+    d->monitors[i].height=rand() % 15;
+  }
+}
+
+int main(void) {
+  static MgtkMonitorLayout layout;
+  MgtkDisplayDesc desc;
+  const MgtkDisplayDesc *built;
+  MgtkMonitorRect r;
+  gint got, want;
+  gint round;
+  gint x, y;
+
+  srand(1);
+
+  for(round=0;round<ROUNDS;round++) {
+    random_desc(&desc);
+    mgtk_monitor_layout_build(&layout, &desc);
+    CHECK(!mgtk_monitor_layout_differs(&layout, &desc), "round %d: differs from its own description\n", round);
+
+    /* without monitors the layout has one covering the screen */
+    built=&layout.desc;
+    CHECK(built->n_monitors >= 1, "round %d: %d monitors\n", round, built->n_monitors);
+
+    for(x=-MARGIN;x<SIZE+MARGIN;x++) {
+      for(y=-MARGIN;y<SIZE+MARGIN;y++) {
+        got=mgtk_monitor_at_point(&layout, x, y);
+        want=ref_point(built, x, y);
+        CHECK(got == want, "round %d: point %d,%d on monitor %d, should be %d\n", round, x, y, got, want);
+
+        r.x=x;
+        r.y=y;
+        r.width=rand() % 12;
+        r.height=rand() % 12;
+        got=mgtk_monitor_at_rect(&layout, &r);
+        want=ref_rect(built, &r);
+        CHECK(got == want, "round %d: rect %d,%d %dx%d on monitor %d, should be %d\n",
+              round, r.x, r.y, r.width, r.height, got, want);
+      }
+    }
+
+    desc.width++;
+    CHECK(mgtk_monitor_layout_differs(&layout, &desc), "round %d: wider screen does not differ\n", round);
+  }
+
+  printf("test-monitor: %s (%d failures)\n", failed ? "FAILED" : "PASSED", failed);
+  return failed ? EXIT_FAILURE : EXIT_SUCCESS;
+}
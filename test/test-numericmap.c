@@ -0,0 +1,117 @@
+/*
+ * host test for classes/numericmap.c
+ *
+ * Random adjustments (with and without step, page size and digits,
+ * tiny and huge ranges) must map:
+ *  - every MUI position to a value and back to the same position
+ *  - values monotonically to positions
+ *  - every value to a position, whose value is at most half a MUI step
+ *    (plus half a quantum) away
+ * and snapping must be monotonic and idempotent.
+ *
+ * $Id: test-numericmap.c,v 1.1 2026/10/19 21:00:00 o1i Exp $
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+
+#include "numericmap.h"
+
+#define ROUNDS  3000
+#define SAMPLES 2000
+
+static int failed=0;
+
+#define CHECK(cond, ...) \
+  do { \
+    if(!(cond)) { \
+      if(failed++ < 10) { \
+        printf(__VA_ARGS__); \
+      } \
+    } \
+  } while(0)
+
+static double rnd(void) {
+  return rand()/(double) RAND_MAX;
+}
+
+static int near(double a, double b) {
+  return fabs(a-b) <= 1e-9*fmax(1, fabs(a));
+}
+
+static void check_round_trip(const MgtkNumericMap *m, int round) {
+  long skip;
+  long i;
+  long j;
+  double v;
+
+  /* all positions of small maps, the ends and a sample of big ones */
+  skip=m->max > 200000 ? m->max/100000 : 1;
+
+  for(i=0;i<=m->max;i+=(i<5 || i>m->max-5) ? 1 : skip) {
+    v=mgtk_numeric_map_from_mui(m, i);
+    j=mgtk_numeric_map_to_mui(m, v);
+    CHECK(j == i, "round %d: position %ld -> %g -> %ld (max %ld)\n", round, i, v, j, m->max);
+    CHECK(near(mgtk_numeric_map_snap(m, v), v), "round %d: value %g of position %ld not snapped\n", round, v, i);
+  }
+}
+
+static void check_monotonic(const MgtkNumericMap *m, double lower, int round) {
+  double prev_snap=-HUGE_VAL;
+  long prev=-1;
+  double v, back, clamped, s;
+  long j;
+  int k;
+
+  for(k=0;k<SAMPLES;k++) {
+    /* a bit below lower up to a bit above the end */
+    v=lower - m->span*0.1 + m->span*1.2*k/(SAMPLES-1);
+
+    j=mgtk_numeric_map_to_mui(m, v);
+    CHECK(j >= prev, "round %d: %g maps to %ld, below %ld\n", round, v, j, prev);
+    CHECK(j >= 0 && j <= m->max, "round %d: %g maps to %ld, out of 0..%ld\n", round, v, j, m->max);
+    prev=j;
+
+    back=mgtk_numeric_map_from_mui(m, j);
+    clamped=fmin(fmax(v, lower), lower + m->span);
+    CHECK(fabs(back-clamped) <= m->unit*0.5 + m->quantum*0.5 + 1e-9*fmax(1, fabs(v)),
+          "round %d: %g comes back as %g (unit %g)\n", round, v, back, m->unit);
+
+    s=mgtk_numeric_map_snap(m, v);
+    CHECK(s >= prev_snap - 1e-9*fabs(s), "round %d: snap(%g)=%g below %g\n", round, v, s, prev_snap);
+    CHECK(near(mgtk_numeric_map_snap(m, s), s), "round %d: snap(%g) not idempotent\n", round, s);
+    prev_snap=s;
+  }
+}
+
+int main(void) {
+  MgtkNumericMap m;
+  double lower, span, step, page;
+  int digits;
+  int round;
+
+  srand(1);
+
+  for(round=0;round<ROUNDS;round++) {
+    lower=(rnd()-0.5)*pow(10, rand()%12);
+    span=rnd()*pow(10, rand()%12 - 3);
+    step=rand()%5 == 0 ? 0 : rnd()*pow(10, rand()%10 - 6);
+    page=rand()%3 == 0 ? rnd()*span*0.5 : 0;
+    digits=rand()%5 - 1;
+    if(rand()%4 == 0) {
+      /* exact multiples of a decimal step, like most real sliders */
+      step=pow(10, rand()%5 - 2);
+      span=step*(rand()%1000);
+    }
+
+    mgtk_numeric_map_init(&m, lower, lower + span + page, step, page, digits);
+
+    CHECK(m.max >= 0 && m.max <= MGTK_NUMERIC_MAP_MAX, "round %d: max %ld out of range\n", round, m.max);
+    check_round_trip(&m, round);
+    check_monotonic(&m, lower, round);
+  }
+
+  printf("test-numericmap: %s (%d failures)\n", failed ? "FAILED" : "PASSED", failed);
+  return failed ? EXIT_FAILURE : EXIT_SUCCESS;
+}
@@ -0,0 +1,407 @@
+/*
+ * host test for gdk/gdkpixbuf.c
+ *
+ * gdk_pixbuf_scale, gdk_pixbuf_composite and gdk_pixbuf_scale_simple
+ * against a naive reference, which computes every destination pixel on
+ * its own in doubles (with the same 8 bit bilinear weights):
+ *  - NEAREST and BILINEAR (TILES and HYPER are BILINEAR), RGB and RGBA
+ *    sources and destinations, random scales and offsets
+ *  - sources and destinations, which are subpixbufs of larger ones,
+ *    and destination rectangles inside the destination; nothing outside
+ *    may change
+ *  - overall alpha of the composite
+ * and times both on a large picture.
+ *
+ * $Id: test-pixbuf.c,v 1.1 2026/10/19 22:00:00 o1i Exp $
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+
+#include "gdkpixbuf.h"
+
+#define ROUNDS    3000
+#define MAX_SIZE  40
+#define TOL_SCALE 1
+#define TOL_COMP  2
+
+#define BENCH_SRC_W  640
+#define BENCH_SRC_H  480
+#define BENCH_DEST_W 1000
+#define BENCH_DEST_H 700
+
+static int failed=0;
+static gint max_error=0;
+
+#define CHECK(cond, ...) \
+  do { \
+    if(!(cond)) { \
+      if(failed++ < 10) { \
+        printf(__VA_ARGS__); \
+      } \
+    } \
+  } while(0)
+
+static const gchar *interp_name[]={ "NEAREST", "TILES", "BILINEAR", "HYPER" };
+
+/*********************************
+ * reference
+ *********************************/
+static const guchar *ref_pixel(const GdkPixbuf *p, gint x, gint y) {
+
+  return p->pixels + y*p->rowstride + x*p->n_channels;
+}
+
+/* source pixels and weight of the second one along one axis */
+static void ref_position(gdouble s, gint size, GdkInterpType interp, gint *p0, gint *p1, gdouble *w) {
+  gint p;
+
+  if(interp == GDK_INTERP_NEAREST) {
+    p=(gint) floor(s);
+    *p0=*p1=CLAMP(p, 0, size-1);
+    *w=0;
+    return;
+  }
+
+  s-=0.5;
+  p=(gint) floor(s);
+  *w=floor((s-p)*256.0 + 0.5) / 256.0;
+  if(*w >= 1.0) {
+    p++;
+    *w=0;
+  }
+  if(p < 0 || p >= size-1) {
+    *p0=*p1=p < 0 ? 0 : size-1;
+    *w=0;
+    return;
+  }
+  *p0=p;
+  *p1=p+1;
+}
+
+/* RGBA at source position sx, sy, rounded to 8 bit */
+static void ref_sample(const GdkPixbuf *src, gdouble sx, gdouble sy, GdkInterpType interp, gint *out) {
+  const guchar *px[4];
+  gdouble weight[4];
+  gdouble alpha, sum, wx, wy;
+  gint x0, x1, y0, y1;
+  gint i, k;
+
+  ref_position(sx, src->width, interp, &x0, &x1, &wx);
+  ref_position(sy, src->height, interp, &y0, &y1, &wy);
+
+  /* nearest keeps the colour of transparent pixels */
+  if(interp == GDK_INTERP_NEAREST) {
+    px[0]=ref_pixel(src, x0, y0);
+    for(k=0;k<src->n_channels;k++) {
+      out[k]=px[0][k];
+    }
+    if(src->n_channels == 3) {
+      out[3]=255;
+    }
+    return;
+  }
+
+  px[0]=ref_pixel(src, x0, y0);
+  px[1]=ref_pixel(src, x1, y0);
+  px[2]=ref_pixel(src, x0, y1);
+  px[3]=ref_pixel(src, x1, y1);
+  weight[0]=(1-wx)*(1-wy);
+  weight[1]=wx*(1-wy);
+  weight[2]=(1-wx)*wy;
+  weight[3]=wx*wy;
+
+  if(src->n_channels == 3) {
+    for(k=0;k<3;k++) {
+      sum=0;
+      for(i=0;i<4;i++) {
+        sum+=weight[i]*px[i][k];
+      }
+      out[k]=(gint) floor(sum + 0.5);
+    }
+    out[3]=255;
+    return;
+  }
+
+  /* premultiplied */
+  alpha=0;
+  for(i=0;i<4;i++) {
+    alpha+=weight[i]*px[i][3];
+  }
+  if(alpha == 0) {
+    out[0]=out[1]=out[2]=out[3]=0;
+    return;
+  }
+  for(k=0;k<3;k++) {
+    sum=0;
+    for(i=0;i<4;i++) {
+      sum+=weight[i]*px[i][3]*px[i][k];
+    }
+    out[k]=(gint) floor(sum/alpha + 0.5);
+  }
+  out[3]=(gint) floor(alpha + 0.5);
+}
+
+static void ref_scale(const GdkPixbuf *src, GdkPixbuf *dest, gint dest_x, gint dest_y,
+                      gint dest_width, gint dest_height, gdouble offset_x, gdouble offset_y,
+                      gdouble scale_x, gdouble scale_y, GdkInterpType interp,
+                      gint overall_alpha, gboolean composite) {
+  gdouble a, w0, w1, w;
+  guchar *d;
+  gint in[4];
+  gint x, y, k;
+
+  for(y=dest_y;y<dest_y+dest_height;y++) {
+    for(x=dest_x;x<dest_x+dest_width;x++) {
+      ref_sample(src, (x + 0.5 - offset_x)/scale_x, (y + 0.5 - offset_y)/scale_y, interp, in);
+      d=dest->pixels + y*dest->rowstride + x*dest->n_channels;
+
+      if(!composite) {
+        for(k=0;k<dest->n_channels;k++) {
+          d[k]=in[k];
+        }
+        continue;
+      }
+
+      /* alpha of the source pixel is 8 bit again */
+      a=floor(in[3]*overall_alpha/255.0 + 0.5);
+      if(!a) {
+        continue;
+      }
+      if(dest->n_channels == 3) {
+        for(k=0;k<3;k++) {
+          d[k]=(guchar) floor((in[k]*a + d[k]*(255-a))/255 + 0.5);
+        }
+        continue;
+      }
+      w0=a*255;
+      w1=(255-a)*d[3];
+      w=w0+w1;
+      for(k=0;k<3;k++) {
+        d[k]=(guchar) floor((in[k]*w0 + d[k]*w1)/w + 0.5);
+      }
+      d[3]=(guchar) floor(w/255 + 0.5);
+    }
+  }
+}
+
+/*********************************
+ * test pictures
+ *********************************/
+static void random_fill(GdkPixbuf *p) {
+  guchar *d;
+  gint x, y;
+
+  for(y=0;y<p->height;y++) {
+    d=p->pixels + y*p->rowstride;
+    for(x=0;x<p->width*p->n_channels;x++) {
+      d[x]=rand() & 0xff;
+    }
+    /* lots of fully transparent and opaque pixels */
+    if(p->n_channels == 4) {
+      for(x=3;x<p->width*4;x+=4) {
+        switch(rand() % 4) {
+          case 0: d[x]=0; break;
+          case 1: d[x]=255; break;
+        }
+      }
+    }
+  }
+}
+
+/* a subpixbuf of a larger one sometimes, so rowstride is not width */
+static GdkPixbuf *new_picture(gboolean alpha, gint width, gint height, gboolean sub) {
+  GdkPixbuf *parent;
+  GdkPixbuf *p;
+  gint mx, my;
+
+  if(!sub) {
+    p=gdk_pixbuf_new(GDK_COLORSPACE_RGB, alpha, 8, width, height);
+    random_fill(p);
+    return p;
+  }
+
+  mx=rand() % 5;
+  my=rand() % 5;
+  parent=gdk_pixbuf_new(GDK_COLORSPACE_RGB, alpha, 8, width + mx + rand() % 5, height + my + rand() % 5);
+  random_fill(parent);
+  p=gdk_pixbuf_new_subpixbuf(parent, mx, my, width, height);
+  g_object_unref(parent);
+
+  return p;
+}
+
+/* a copy with the same layout, so outside pixels can be compared too */
+static GdkPixbuf *copy_picture(const GdkPixbuf *p) {
+
+  return gdk_pixbuf_copy(p);
+}
+
+static gint compare(const GdkPixbuf *got, const GdkPixbuf *want) {
+  const guchar *g, *w;
+  gint x, y, err, worst;
+
+  worst=0;
+  for(y=0;y<got->height;y++) {
+    g=got->pixels + y*got->rowstride;
+    w=want->pixels + y*want->rowstride;
+    for(x=0;x<got->width*got->n_channels;x++) {
+      err=ABS(g[x] - w[x]);
+      worst=MAX(worst, err);
+    }
+  }
+  return worst;
+}
+
+/*********************************
+ * checks
+ *********************************/
+static void check_random(void) {
+  GdkPixbuf *src, *dest, *want;
+  GdkInterpType interp;
+  gboolean composite;
+  gdouble scale_x, scale_y, offset_x, offset_y;
+  gint dest_x, dest_y, dest_width, dest_height;
+  gint overall, err, tol;
+  gint round;
+
+  srand(1);
+
+  for(round=0;round<ROUNDS;round++) {
+    interp=(GdkInterpType) (rand() % 4);
+    composite=rand() % 2;
+
+    src=new_picture(rand() % 2, 1 + rand() % MAX_SIZE, 1 + rand() % MAX_SIZE, rand() % 2);
+    dest=new_picture(rand() % 2, 1 + rand() % MAX_SIZE, 1 + rand() % MAX_SIZE, rand() % 2);
+
+    dest_x=rand() % dest->width;
+    dest_y=rand() % dest->height;
+    dest_width=rand() % (dest->width - dest_x + 1);
+    dest_height=rand() % (dest->height - dest_y + 1);
+    scale_x=0.1 + (rand() % 400) / 100.0;
+    scale_y=0.1 + (rand() % 400) / 100.0;
+    offset_x=(rand() % 2001 - 1000) / 100.0;
+    offset_y=(rand() % 2001 - 1000) / 100.0;
+    overall=rand() % 3 ? 255 : rand() % 256;
+
+    want=copy_picture(dest);
+
+    if(composite) {
+      gdk_pixbuf_composite(src, dest, dest_x, dest_y, dest_width, dest_height,
+                           offset_x, offset_y, scale_x, scale_y, interp, overall);
+    }
+    else {
+      gdk_pixbuf_scale(src, dest, dest_x, dest_y, dest_width, dest_height,
+                       offset_x, offset_y, scale_x, scale_y, interp);
+    }
+    ref_scale(src, want, dest_x, dest_y, dest_width, dest_height,
+              offset_x, offset_y, scale_x, scale_y, interp, composite ? overall : 255, composite);
+
+    err=compare(dest, want);
+    tol=composite ? TOL_COMP : TOL_SCALE;
+    max_error=MAX(max_error, err);
+    CHECK(err <= tol, "round %d: %s %s %s %dx%d -> %s %dx%d at %d,%d %dx%d scale %g,%g offset %g,%g alpha %d: error %d\n",
+          round, composite ? "composite" : "scale", interp_name[interp],
+          src->has_alpha ? "RGBA" : "RGB", src->width, src->height,
+          dest->has_alpha ? "RGBA" : "RGB", dest->width, dest->height,
+          dest_x, dest_y, dest_width, dest_height, scale_x, scale_y, offset_x, offset_y, overall, err);
+
+    g_object_unref(want);
+    g_object_unref(dest);
+    g_object_unref(src);
+  }
+}
+
+static void check_simple(void) {
+  GdkPixbuf *src, *got, *want;
+  GdkInterpType interp;
+  gint round, err;
+
+  for(round=0;round<ROUNDS/10;round++) {
+    interp=rand() % 2 ? GDK_INTERP_NEAREST : GDK_INTERP_BILINEAR;
+    src=new_picture(rand() % 2, 1 + rand() % MAX_SIZE, 1 + rand() % MAX_SIZE, rand() % 2);
+
+    got=gdk_pixbuf_scale_simple(src, 1 + rand() % (2*MAX_SIZE), 1 + rand() % (2*MAX_SIZE), interp);
+    CHECK(got && got->has_alpha == src->has_alpha, "simple %d: wrong pixbuf\n", round);
+    if(!got) {
+      g_object_unref(src);
+      continue;
+    }
+
+    want=copy_picture(got);
+    ref_scale(src, want, 0, 0, got->width, got->height, 0, 0,
+              (gdouble) got->width / src->width, (gdouble) got->height / src->height,
+              interp, 255, FALSE);
+    err=compare(got, want);
+    max_error=MAX(max_error, err);
+    CHECK(err <= TOL_SCALE, "simple %d: %s %dx%d -> %dx%d: error %d\n", round, interp_name[interp],
+          src->width, src->height, got->width, got->height, err);
+
+    g_object_unref(want);
+    g_object_unref(got);
+    g_object_unref(src);
+  }
+}
+
+/*********************************
+ * timing
+ *********************************/
+static void bench(GdkInterpType interp, gboolean alpha, gboolean composite) {
+  GdkPixbuf *src, *dest, *want;
+  GTimer *timer;
+  gdouble scale_x, scale_y;
+  gdouble t_fast, t_ref;
+
+  src=new_picture(alpha, BENCH_SRC_W, BENCH_SRC_H, FALSE);
+  dest=new_picture(TRUE, BENCH_DEST_W, BENCH_DEST_H, FALSE);
+  want=copy_picture(dest);
+  scale_x=(gdouble) BENCH_DEST_W / BENCH_SRC_W;
+  scale_y=(gdouble) BENCH_DEST_H / BENCH_SRC_H;
+
+  timer=g_timer_new();
+  if(composite) {
+    gdk_pixbuf_composite(src, dest, 0, 0, BENCH_DEST_W, BENCH_DEST_H, 0, 0, scale_x, scale_y, interp, 200);
+  }
+  else {
+    gdk_pixbuf_scale(src, dest, 0, 0, BENCH_DEST_W, BENCH_DEST_H, 0, 0, scale_x, scale_y, interp);
+  }
+  t_fast=g_timer_elapsed(timer, NULL);
+
+  g_timer_start(timer);
+  ref_scale(src, want, 0, 0, BENCH_DEST_W, BENCH_DEST_H, 0, 0, scale_x, scale_y, interp,
+            composite ? 200 : 255, composite);
+  t_ref=g_timer_elapsed(timer, NULL);
+  g_timer_destroy(timer);
+
+  CHECK(compare(dest, want) <= (composite ? TOL_COMP : TOL_SCALE), "bench: %s %s differs\n",
+        interp_name[interp], alpha ? "RGBA" : "RGB");
+
+  printf("  %-9s %-8s %-4s %8.4fs %8.4fs\n", composite ? "composite" : "scale",
+         interp_name[interp], alpha ? "RGBA" : "RGB", t_fast, t_ref);
+
+  g_object_unref(want);
+  g_object_unref(dest);
+  g_object_unref(src);
+}
+
+int main(void) {
+
+  check_random();
+  check_simple();
+
+  printf("%dx%d -> %dx%d:              pixbuf reference\n", BENCH_SRC_W, BENCH_SRC_H,
+         BENCH_DEST_W, BENCH_DEST_H);
+  bench(GDK_INTERP_NEAREST, FALSE, FALSE);
+  bench(GDK_INTERP_NEAREST, TRUE, FALSE);
+  bench(GDK_INTERP_BILINEAR, FALSE, FALSE);
+  bench(GDK_INTERP_BILINEAR, TRUE, FALSE);
+  bench(GDK_INTERP_NEAREST, TRUE, TRUE);
+  bench(GDK_INTERP_BILINEAR, FALSE, TRUE);
+  bench(GDK_INTERP_BILINEAR, TRUE, TRUE);
+
+  printf("test-pixbuf: %s (%d failures, largest difference %d)\n",
+         failed ? "FAILED" : "PASSED", failed, max_error);
+  return failed ? EXIT_FAILURE : EXIT_SUCCESS;
+}
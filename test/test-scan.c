@@ -0,0 +1,273 @@
+/*
+ * host test for gdk/gdkscan.c
+ *
+ * Renders small shapes into a character image and compares them with
+ * reference images ('#' is a set pixel): a rectangle, a self
+ * intersecting star with the even-odd and the non-zero winding rule,
+ * an ellipse and two pie slices. No pixel may be set twice or land
+ * outside the image.
+ *
+ * Besides that, shapes sharing edges must neither overlap nor leave
+ * gaps: two triangles making up a square and four quarter pies making
+ * up a circle.
+ *
+ * $Id: test-scan.c,v 1.1 2026/10/19 22:00:00 o1i Exp $
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+
+#include "gdkscan.h"
+
+#define W 24
+#define H 24
+
+static char image[H][W+1];
+static int  twice;
+static int  outside;
+
+static int failed=0;
+
+#define CHECK(cond, ...) \
+  do { \
+    if(!(cond)) { \
+      if(failed++ < 10) { \
+        printf(__VA_ARGS__); \
+      } \
+    } \
+  } while(0)
+
+static const char *rect_image[]={
+  "........................",
+  "........................",
+  "........................",
+  "..########..............",
+  "..########..............",
+  "..########..............",
+  "..########..............",
+  "..########..............",
+  "........................",
+  "........................",
+  NULL
+};
+
+static const char *star_even_odd_image[]={
+  "........................",
+  "........................",
+  "........................",
+  "...........##...........",
+  "...........##...........",
+  "...........##...........",
+  "..........####..........",
+  "..........####..........",
+  "..........####..........",
+  "..#######......#######..",
+  "...######......######...",
+  ".....####......####.....",
+  "......##........##......",
+  "........................",
+  "........#......#........",
+  ".......###....###.......",
+  ".......##########.......",
+  ".......####..####.......",
+  "......####....####......",
+  "......##........##......",
+  "......#..........#......",
+  "........................",
+  NULL
+};
+
+static const char *star_winding_image[]={
+  "........................",
+  "........................",
+  "........................",
+  "...........##...........",
+  "...........##...........",
+  "...........##...........",
+  "..........####..........",
+  "..........####..........",
+  "..........####..........",
+  "..####################..",
+  "...##################...",
+  ".....##############.....",
+  "......############......",
+  "........########........",
+  "........########........",
+  ".......##########.......",
+  ".......##########.......",
+  ".......####..####.......",
+  "......####....####......",
+  "......##........##......",
+  "......#..........#......",
+  "........................",
+  NULL
+};
+
+static const char *ellipse_image[]={
+  "........................",
+  "........................",
+  "........................",
+  "........................",
+  "........########........",
+  ".....##############.....",
+  "....################....",
+  "..####################..",
+  "..####################..",
+  ".######################.",
+  ".######################.",
+  ".######################.",
+  ".######################.",
+  "..####################..",
+  "..####################..",
+  "....################....",
+  ".....##############.....",
+  "........########........",
+  "........................",
+  NULL
+};
+
+static const char *pies_image[]={
+  "...........###..........",
+  "...........######.......",
+  "...........#######......",
+  "...........########.....",
+  "...........#########....",
+  "...........##########...",
+  "...........##########...",
+  "...........##########...",
+  "...........###########..",
+  "...........###########..",
+  "...........###########..",
+  "##########..............",
+  "#########...............",
+  "########................",
+  ".######.................",
+  ".#####..................",
+  "..###...................",
+  "..##....................",
+  "........................",
+  NULL
+};
+
+static void span(gint y, gint x1, gint x2, gpointer data) {
+  gint x;
+
+  if(y < 0 || y >= H || x1 < 0 || x2 >= W) {
+    outside++;
+    return;
+  }
+  for(x=x1;x<=x2;x++) {
+    if(image[y][x] == '#') {
+      twice++;
+    }
+    image[y][x]='#';
+  }
+}
+
+static void clear(void) {
+  gint y;
+
+  for(y=0;y<H;y++) {
+    memset(image[y], '.', W);
+    image[y][W]=0;
+  }
+  twice=0;
+  outside=0;
+}
+
+static int count(void) {
+  int n=0;
+  int x, y;
+
+  for(y=0;y<H;y++) {
+    for(x=0;x<W;x++) {
+      n+=image[y][x] == '#';
+    }
+  }
+  return n;
+}
+
+static void compare(const char *name, const char **reference) {
+  int y;
+
+  CHECK(!twice, "%s: %d pixels set twice\n", name, twice);
+  CHECK(!outside, "%s: %d spans outside\n", name, outside);
+
+  for(y=0;y<H && reference[y];y++) {
+    CHECK(!strcmp(image[y], reference[y]), "%s: row %2d is %s\n%*s should be %s\n",
+          name, y, image[y], (int) strlen(name)+11, "", reference[y]);
+  }
+  /* below the reference everything is empty */
+  for(;y<H;y++) {
+    CHECK(!strchr(image[y], '#'), "%s: row %2d is %s, should be empty\n", name, y, image[y]);
+  }
+}
+
+static void star(MgtkScanPoint *p) {
+  int i;
+  double a;
+
+  /* every second corner of a pentagon, so the edges cross */
+  for(i=0;i<5;i++) {
+    a=-G_PI/2 + i*4*G_PI/5;
+    p[i].x=12 + 11*cos(a);
+    p[i].y=12.5 + 11*sin(a);
+  }
+}
+
+int main(void) {
+  MgtkScanPoint rect[4]={ {2,3}, {10,3}, {10,8}, {2,8} };
+  MgtkScanPoint t1[3]={ {1,1}, {21,1}, {1,21} };
+  MgtkScanPoint t2[3]={ {21,1}, {21,21}, {1,21} };
+  MgtkScanPoint st[5];
+  int full;
+  int q;
+
+  clear();
+  mgtk_scan_polygon(rect, 4, span, NULL);
+  compare("rectangle", rect_image);
+
+  star(st);
+  clear();
+  mgtk_scan_polygon_rule(st, 5, FALSE, span, NULL);
+  compare("star, even-odd", star_even_odd_image);
+  clear();
+  mgtk_scan_polygon(st, 5, span, NULL);
+  compare("star, default rule", star_even_odd_image);
+  clear();
+  mgtk_scan_polygon_rule(st, 5, TRUE, span, NULL);
+  compare("star, winding", star_winding_image);
+
+  clear();
+  mgtk_scan_ellipse(1, 4, 22, 14, span, NULL);
+  compare("ellipse", ellipse_image);
+
+  clear();
+  mgtk_scan_pie(0, 0, 22, 22, 0, 90*64, span, NULL);
+  mgtk_scan_pie(0, 0, 22, 22, 180*64, 45*64, span, NULL);
+  compare("pies", pies_image);
+
+  /* shared edges */
+  clear();
+  mgtk_scan_polygon(t1, 3, span, NULL);
+  mgtk_scan_polygon(t2, 3, span, NULL);
+  CHECK(!twice && count() == 400, "triangles: %d pixels, %d twice\n", count(), twice);
+
+  clear();
+  mgtk_scan_ellipse(0, 0, 22, 22, span, NULL);
+  full=count();
+  clear();
+  for(q=0;q<4;q++) {
+    mgtk_scan_pie(0, 0, 22, 22, q*90*64, 90*64, span, NULL);
+  }
+  CHECK(!twice, "quarter pies: %d pixels set twice\n", twice);
+  CHECK(abs(count()-full) <= full/50, "quarter pies: %d pixels, circle %d\n", count(), full);
+  clear();
+  mgtk_scan_pie(0, 0, 22, 22, 0, 360*64, span, NULL);
+  CHECK(count() == full, "full pie: %d pixels, circle %d\n", count(), full);
+
+  printf("test-scan: %s (%d failures)\n", failed ? "FAILED" : "PASSED", failed);
+  return failed ? EXIT_FAILURE : EXIT_SUCCESS;
+}